@@ -0,0 +1,118 @@
+//
+//  BRBIP32Chain.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRBIP32Chain.h"
+#include "sph/sph_sha2.h"
+#include "sph/sph_ripemd.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BR_BIP32_RUN 256 // children per batch, enough to make the shared inversion cheap
+
+struct br_bip32_chain {
+    uint8_t pubkey[33];
+    sph_sha512_context inner, outer; // HMAC-SHA512 keyed with the chain code, inner already fed serP(K)
+};
+
+br_bip32_chain *br_bip32_chain_new(const uint8_t *pubkey, const uint8_t *chain_code)
+{
+    br_bip32_chain *chain = calloc(1, sizeof(*chain));
+    uint8_t pad[128];
+
+    if (! chain) return NULL;
+    memcpy(chain->pubkey, pubkey, 33);
+
+    memset(pad, 0x36, sizeof(pad));
+    for (size_t i = 0; i < 32; i++) pad[i] ^= chain_code[i];
+    sph_sha512_init(&chain->inner);
+    sph_sha512(&chain->inner, pad, sizeof(pad));
+    sph_sha512(&chain->inner, pubkey, 33);
+
+    memset(pad, 0x5c, sizeof(pad));
+    for (size_t i = 0; i < 32; i++) pad[i] ^= chain_code[i];
+    sph_sha512_init(&chain->outer);
+    sph_sha512(&chain->outer, pad, sizeof(pad));
+
+    memset(pad, 0, sizeof(pad));
+    return chain;
+}
+
+void br_bip32_chain_free(br_bip32_chain *chain)
+{
+    if (! chain) return;
+    memset(chain, 0, sizeof(*chain));
+    free(chain);
+}
+
+// I = HMAC-SHA512(c, serP(K) || ser32(i)), of which only IL, the tweak, is needed for a public key
+static void br_bip32_chain_tweak(const br_bip32_chain *chain, uint32_t i, uint8_t *tweak)
+{
+    sph_sha512_context sha = chain->inner;
+    uint8_t index[4] = { (uint8_t)(i >> 24), (uint8_t)(i >> 16), (uint8_t)(i >> 8), (uint8_t)i }, md[64];
+
+    sph_sha512(&sha, index, sizeof(index));
+    sph_sha512_close(&sha, md);
+    sha = chain->outer;
+    sph_sha512(&sha, md, sizeof(md));
+    sph_sha512_close(&sha, md);
+    memcpy(tweak, md, 32);
+    memset(md, 0, sizeof(md));
+}
+
+static void br_bip32_hash160(const uint8_t *pubkey, uint8_t *hash160)
+{
+    sph_sha256_context sha;
+    sph_ripemd160_context rmd;
+    uint8_t md[32];
+
+    sph_sha256_init(&sha);
+    sph_sha256(&sha, pubkey, 33);
+    sph_sha256_close(&sha, md);
+    sph_ripemd160_init(&rmd);
+    sph_ripemd160(&rmd, md, sizeof(md));
+    sph_ripemd160_close(&rmd, hash160);
+}
+
+size_t br_bip32_chain_derive(const br_bip32_chain *chain, const secp256k1_context *ctx, uint32_t first, size_t n,
+                             uint8_t *pubkeys, uint8_t *hash160s)
+{
+    uint8_t tweaks[BR_BIP32_RUN*32], keys[BR_BIP32_RUN*33];
+    size_t ok = 0;
+
+    for (size_t done = 0, run; done < n; done += run) {
+        run = (n - done < BR_BIP32_RUN) ? n - done : BR_BIP32_RUN;
+        for (size_t i = 0; i < run; i++) br_bip32_chain_tweak(chain, first + (uint32_t)(done + i), tweaks + i*32);
+        ok += br_secp_pubkey_tweak_add_all(ctx, keys, chain->pubkey, tweaks, run);
+        if (pubkeys) memcpy(pubkeys + done*33, keys, run*33);
+
+        for (size_t i = 0; hash160s && i < run; i++) {
+            if (keys[i*33] == 0) memset(hash160s + (done + i)*20, 0, 20); // failed, zeroed
+            else br_bip32_hash160(keys + i*33, hash160s + (done + i)*20);
+        }
+    }
+
+    memset(tweaks, 0, sizeof(tweaks));
+    return ok;
+}
@@ -0,0 +1,53 @@
+//
+//  BRBIP32Chain.h
+//  SolarisWallet
+//
+//  Runs of non-hardened BIP32 children of one extended public key, for generating addresses
+//  up to the gap limit with one batched field inversion per run.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRBIP32Chain_h
+#define BRBIP32Chain_h
+
+#include "BRSecp256k1.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BR_BIP32_HARD 0x80000000u
+
+typedef struct br_bip32_chain br_bip32_chain;
+
+// returns the children of the extended public key with the 33 byte compressed pubkey and 32 byte chain_code, or NULL
+// if out of memory
+br_bip32_chain *br_bip32_chain_new(const uint8_t *pubkey, const uint8_t *chain_code);
+
+void br_bip32_chain_free(br_bip32_chain *chain);
+
+// derives children first to first + n - 1, all below BR_BIP32_HARD, on ctx, which must be able to sign: writes their
+// compressed public keys to pubkeys + i*33 and their hash160s to hash160s + i*20, either of which may be NULL;
+// returns how many succeeded, a child BIP32 deems invalid (odds below 1 in 2^127) is zeroed, as are all of them if
+// memory runs out
+size_t br_bip32_chain_derive(const br_bip32_chain *chain, const secp256k1_context *ctx, uint32_t first, size_t n,
+                             uint8_t *pubkeys, uint8_t *hash160s);
+
+#endif /* BRBIP32Chain_h */
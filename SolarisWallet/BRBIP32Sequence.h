@@ -36,6 +36,7 @@
 - (NSData * _Nullable)deprecatedIncorrectExtendedPublicKeyForAccount:(uint32_t)account fromSeed:(NSData * _Nullable)seed purpose:(uint32_t)purpose;
 - (NSData * _Nullable)extendedPublicKeyForAccount:(uint32_t)account fromSeed:(NSData * _Nullable)seed purpose:(uint32_t)purpose;
 - (NSData * _Nullable)publicKey:(uint32_t)n internal:(BOOL)internal masterPublicKey:(NSData * _Nonnull)masterPublicKey;
+- (NSData * _Nullable)hash160s:(NSRange)range internal:(BOOL)internal masterPublicKey:(NSData * _Nonnull)masterPublicKey;
 - (NSString * _Nullable)privateKey:(uint32_t)n purpose:(uint32_t)purpose internal:(BOOL)internal fromSeed:(NSData * _Nonnull)seed;
 - (NSArray * _Nullable)privateKeys:(NSArray * _Nonnull)n purpose:(uint32_t)purpose internal:(BOOL)internal fromSeed:(NSData * _Nonnull)seed;
 
@@ -238,6 +238,24 @@ static BOOL deserialize(NSString * string, uint8_t * depth, uint32_t * fingerpri
     return [NSData dataWithBytes:&pubKey length:sizeof(pubKey)];
 }
 
+// the hash160s of keys range.location to NSMaxRange(range) - 1 in the chain, packed, derived as one batch from the chain
+// key so the chain key and HMAC state are only computed once
+- (NSData *)hash160s:(NSRange)range internal:(BOOL)internal masterPublicKey:(NSData *)masterPublicKey
+{
+    if (masterPublicKey.length < 4 + sizeof(UInt256) + sizeof(BRECPoint)) return nil;
+    if (range.length > BIP32_HARD || range.location > BIP32_HARD - range.length) return nil;
+
+    UInt256 chain = *(const UInt256 *)((const uint8_t *)masterPublicKey.bytes + 4);
+    BRECPoint pubKey = *(const BRECPoint *)((const uint8_t *)masterPublicKey.bytes + 36);
+    NSMutableData *hash160s = [NSMutableData dataWithLength:range.length*sizeof(UInt160)];
+
+    CKDpub(&pubKey, &chain, internal ? 1 : 0); // internal or external chain
+
+    if (BRSecp256k1ChildHash160s(hash160s.mutableBytes, &pubKey, &chain, (uint32_t)range.location, range.length) !=
+        range.length) return nil;
+    return hash160s;
+}
+
 - (NSString *)privateKey:(uint32_t)n purpose:(uint32_t)purpose internal:(BOOL)internal fromSeed:(NSData *)seed
 {
     return seed ? [self privateKeys:@[@(n)] purpose:purpose internal:internal fromSeed:seed].lastObject : nil;
@@ -0,0 +1,422 @@
+//
+//  BRBalance.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRBalance.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BR_IN_SPENT    1 // the input spent an output nothing had spent before
+#define BR_IN_STALE    2 // and that output was unspent, left in place by a pending transaction
+#define BR_OUT_UNSPENT 1 // the output went to the unspent ones
+
+// an input of a transaction, or an unspent output taken out by it, flagged BR_IN_STALE if a pending one spent it
+typedef struct {
+    uint8_t outpoint[BR_OUTPOINT_SIZE];
+    uint8_t flags;
+} br_balance_io;
+
+typedef struct {
+    uint8_t hash[32];
+    uint8_t state, unconfirmed;
+    uint32_t height;
+    size_t in, removed, out; // where its records start in ins, removed and amounts, counting dropped ones
+    size_t in_count, removed_count, out_count;
+    uint64_t balance, sent, received; // after it
+} br_balance_step;
+
+struct br_balance {
+    br_balance_step *steps;
+    size_t count, cap, checkpoint, unconfirmed;
+    br_balance_io *ins, *removed; // undo records of the transactions from the checkpoint on
+    size_t in_base, in_count, in_cap, removed_base, removed_count, removed_cap; // base: records dropped before [0]
+    uint64_t *amounts; // the outputs of applied transactions, looked up when one of the wallet's is spent
+    uint8_t *outs; // BR_OUT_UNSPENT flags of the same outputs
+    size_t out_count, out_cap;
+    br_txstore *index; // transaction hash to position + 1
+    br_outset *spent, *utxos, *stale; // stale: unspent outputs that pending transactions spent since the last applied
+};
+
+static void br_balance_pack(uint8_t *outpoint, const uint8_t *hash, uint32_t n)
+{
+    memcpy(outpoint, hash, 32);
+    outpoint[32] = (uint8_t)n;
+    outpoint[33] = (uint8_t)(n >> 8);
+    outpoint[34] = (uint8_t)(n >> 16);
+    outpoint[35] = (uint8_t)(n >> 24);
+}
+
+static uint32_t br_balance_index(const uint8_t *outpoint)
+{
+    return outpoint[32] | ((uint32_t)outpoint[33] << 8) | ((uint32_t)outpoint[34] << 16) |
+           ((uint32_t)outpoint[35] << 24);
+}
+
+// makes room for count more items of the given size after *used, returns 0 if out of memory
+static int br_balance_reserve(void **p, size_t *cap, size_t used, size_t count, size_t size)
+{
+    size_t c = (*cap) ? *cap : 64;
+    void *q;
+
+    if (used + count <= *cap) return 1;
+    while (c < used + count) c *= 2;
+    q = realloc(*p, c*size);
+    if (! q) return 0;
+    *p = q;
+    *cap = c;
+    return 1;
+}
+
+br_balance *br_balance_new(void)
+{
+    br_balance *b = calloc(1, sizeof(*b));
+
+    if (! b) return NULL;
+    b->unconfirmed = SIZE_MAX;
+    b->index = br_txstore_new(NULL);
+    b->spent = br_outset_new();
+    b->utxos = br_outset_new();
+    b->stale = br_outset_new();
+
+    if (! b->index || ! b->spent || ! b->utxos || ! b->stale) {
+        br_balance_free(b);
+        return NULL;
+    }
+
+    return b;
+}
+
+void br_balance_free(br_balance *b)
+{
+    if (! b) return;
+    br_txstore_free(b->index);
+    br_outset_free(b->spent);
+    br_outset_free(b->utxos);
+    br_outset_free(b->stale);
+    free(b->steps);
+    free(b->ins);
+    free(b->removed);
+    free(b->amounts);
+    free(b->outs);
+    free(b);
+}
+
+void br_balance_clear(br_balance *b)
+{
+    for (size_t i = 0; i < b->count; i++) br_txstore_remove(b->index, b->steps[i].hash);
+    br_outset_clear(b->spent);
+    br_outset_clear(b->utxos);
+    br_outset_clear(b->stale);
+    b->count = b->checkpoint = 0;
+    b->unconfirmed = SIZE_MAX;
+    b->in_base = b->in_count = b->removed_base = b->removed_count = b->out_count = 0;
+}
+
+size_t br_balance_count(const br_balance *b)
+{
+    return b->count;
+}
+
+static int br_balance_oom(br_balance *b)
+{
+    br_balance_clear(b);
+    return 0;
+}
+
+static const br_balance_step *br_balance_step_of(const br_balance *b, const uint8_t *hash)
+{
+    size_t i = (size_t)(uintptr_t)br_txstore_get(b->index, hash);
+
+    return (i > 0) ? &b->steps[i - 1] : NULL;
+}
+
+// the amount of an output of an applied transaction
+static uint64_t br_balance_amount(const br_balance *b, const uint8_t *outpoint)
+{
+    const br_balance_step *s = br_balance_step_of(b, outpoint);
+
+    return b->amounts[s->out + br_balance_index(outpoint)];
+}
+
+// takes an unspent output out, recording it with the given flags
+static void br_balance_spend(br_balance *b, br_balance_step *s, const uint8_t *outpoint, uint8_t flags)
+{
+    br_balance_io *r = &b->removed[b->removed_count++];
+
+    memcpy(r->outpoint, outpoint, BR_OUTPOINT_SIZE);
+    r->flags = flags;
+    s->removed_count++;
+    s->balance -= br_balance_amount(b, outpoint);
+    br_outset_remove(b->utxos, outpoint, br_balance_index(outpoint));
+}
+
+int br_balance_apply(br_balance *b, const br_balance_tx *tx)
+{
+    size_t stale = br_outset_count(b->stale), before;
+    br_balance_step *s, *prev;
+    br_balance_io *ins;
+    const uint8_t *outpoint;
+
+    if (! br_balance_reserve((void **)&b->steps, &b->cap, b->count, 1, sizeof(*b->steps)) ||
+        ! br_balance_reserve((void **)&b->ins, &b->in_cap, b->in_count, tx->in_count, sizeof(*b->ins)) ||
+        ! br_balance_reserve((void **)&b->removed, &b->removed_cap, b->removed_count, tx->in_count + stale,
+                             sizeof(*b->removed))) return br_balance_oom(b);
+
+    if (b->out_cap < b->out_count + tx->out_count) {
+        size_t cap = b->out_cap;
+
+        if (! br_balance_reserve((void **)&b->amounts, &cap, b->out_count, tx->out_count, sizeof(*b->amounts)) ||
+            ! br_balance_reserve((void **)&b->outs, &b->out_cap, b->out_count, tx->out_count, sizeof(*b->outs))) {
+            return br_balance_oom(b);
+        }
+    }
+
+    s = &b->steps[b->count];
+    prev = (b->count > 0) ? &b->steps[b->count - 1] : NULL;
+    ins = &b->ins[b->in_count];
+    memcpy(s->hash, tx->hash, sizeof(s->hash));
+    s->state = BR_BALANCE_APPLIED;
+    s->unconfirmed = (tx->unconfirmed) ? 1 : 0;
+    s->height = tx->height;
+    s->in = b->in_base + b->in_count;
+    s->removed = b->removed_base + b->removed_count;
+    s->out = b->out_count;
+    s->in_count = s->removed_count = s->out_count = 0;
+    s->balance = (prev) ? prev->balance : 0;
+    s->sent = (prev) ? prev->sent : 0;
+    s->received = (prev) ? prev->received : 0;
+
+    // check if any inputs are invalid or already spent
+    for (size_t i = 0; tx->unconfirmed && i < tx->in_count && s->state != BR_BALANCE_INVALID; i++) {
+        const br_balance_step *in = br_balance_step_of(b, tx->in_hash + i*32);
+
+        if (br_outset_contains(b->spent, tx->in_hash + i*32, tx->in_index[i]) ||
+            (in && in->state == BR_BALANCE_INVALID)) s->state = BR_BALANCE_INVALID;
+    }
+
+    for (size_t i = 0; s->state != BR_BALANCE_INVALID && i < tx->in_count; i++) { // add inputs to the spent outputs
+        const br_balance_step *in = br_balance_step_of(b, tx->in_hash + i*32);
+
+        br_balance_pack(ins[i].outpoint, tx->in_hash + i*32, tx->in_index[i]);
+        ins[i].flags = 0;
+        before = br_outset_count(b->spent);
+        if (! br_outset_add(b->spent, tx->in_hash + i*32, tx->in_index[i])) return br_balance_oom(b);
+        if (br_outset_count(b->spent) > before) ins[i].flags = BR_IN_SPENT;
+        if (tx->unconfirmed && (tx->pending || (in && in->state == BR_BALANCE_PENDING))) s->state = BR_BALANCE_PENDING;
+        s->in_count++;
+    }
+
+    if (tx->unconfirmed && tx->pending && s->state == BR_BALANCE_APPLIED) s->state = BR_BALANCE_PENDING;
+    b->in_count += s->in_count;
+
+    if (s->state == BR_BALANCE_PENDING) { // the outputs it spends stay unspent until the next applied transaction
+        for (size_t i = 0; i < s->in_count; i++) {
+            if (! (ins[i].flags & BR_IN_SPENT) || ! br_outset_contains(b->utxos, ins[i].outpoint, tx->in_index[i])) {
+                continue;
+            }
+
+            if (! br_outset_add(b->stale, ins[i].outpoint, tx->in_index[i])) return br_balance_oom(b);
+            ins[i].flags |= BR_IN_STALE;
+        }
+    }
+    else if (s->state == BR_BALANCE_APPLIED) {
+        uint64_t balance = s->balance;
+        size_t it = 0;
+
+        for (size_t i = 0; i < s->in_count; i++) {
+            if (! (ins[i].flags & BR_IN_SPENT) || ! br_outset_contains(b->utxos, ins[i].outpoint, tx->in_index[i])) {
+                continue;
+            }
+
+            br_balance_spend(b, s, ins[i].outpoint, 0);
+        }
+
+        for (size_t n = 0; n < tx->out_count; n++) { // add outputs to the unspent ones unless they are spent already
+            b->amounts[b->out_count + n] = tx->out_amount[n];
+            b->outs[b->out_count + n] = 0;
+            if (! tx->out_mine[n] || br_outset_contains(b->spent, tx->hash, (uint32_t)n)) continue;
+            if (! br_outset_add(b->utxos, tx->hash, (uint32_t)n)) return br_balance_oom(b);
+            b->outs[b->out_count + n] = BR_OUT_UNSPENT;
+            s->balance += tx->out_amount[n];
+        }
+
+        s->out_count = tx->out_count;
+        b->out_count += tx->out_count;
+        while ((outpoint = br_outset_next(b->stale, &it))) br_balance_spend(b, s, outpoint, BR_IN_STALE);
+        br_outset_clear(b->stale);
+        if (balance < s->balance) s->received += s->balance - balance;
+        if (s->balance < balance) s->sent += balance - s->balance;
+    }
+
+    if (! br_txstore_put(b->index, s->hash, (void *)(uintptr_t)(b->count + 1), 0)) return br_balance_oom(b);
+    if (s->unconfirmed && b->unconfirmed == SIZE_MAX) b->unconfirmed = b->count;
+    b->count++;
+    return s->state;
+}
+
+int br_balance_revert(br_balance *b)
+{
+    br_balance_step *s;
+    br_balance_io *ins, *removed;
+
+    if (b->count <= b->checkpoint) return 0;
+    s = &b->steps[b->count - 1];
+    ins = &b->ins[s->in - b->in_base];
+    removed = &b->removed[s->removed - b->removed_base];
+
+    for (size_t i = 0; i < s->removed_count; i++) { // put back the unspent outputs it took out
+        uint32_t n = br_balance_index(removed[i].outpoint);
+
+        if (! br_outset_add(b->utxos, removed[i].outpoint, n)) return br_balance_oom(b);
+        if ((removed[i].flags & BR_IN_STALE) && ! br_outset_add(b->stale, removed[i].outpoint, n)) {
+            return br_balance_oom(b);
+        }
+    }
+
+    for (size_t n = 0; n < s->out_count; n++) {
+        if (b->outs[s->out + n] & BR_OUT_UNSPENT) br_outset_remove(b->utxos, s->hash, (uint32_t)n);
+    }
+
+    for (size_t i = 0; i < s->in_count; i++) {
+        uint32_t n = br_balance_index(ins[i].outpoint);
+
+        if (ins[i].flags & BR_IN_STALE) br_outset_remove(b->stale, ins[i].outpoint, n);
+        if (ins[i].flags & BR_IN_SPENT) br_outset_remove(b->spent, ins[i].outpoint, n);
+    }
+
+    br_txstore_remove(b->index, s->hash);
+    b->in_count -= s->in_count;
+    b->removed_count -= s->removed_count;
+    b->out_count = s->out;
+    if (b->unconfirmed == --b->count) b->unconfirmed = SIZE_MAX;
+    return 1;
+}
+
+size_t br_balance_checkpoint(const br_balance *b)
+{
+    return b->checkpoint;
+}
+
+void br_balance_set_checkpoint(br_balance *b, size_t n)
+{
+    size_t in, removed;
+
+    if (n <= b->checkpoint || n > b->count) return;
+    in = ((n < b->count) ? b->steps[n].in : b->in_base + b->in_count) - b->in_base;
+    removed = ((n < b->count) ? b->steps[n].removed : b->removed_base + b->removed_count) - b->removed_base;
+    memmove(b->ins, b->ins + in, (b->in_count - in)*sizeof(*b->ins));
+    memmove(b->removed, b->removed + removed, (b->removed_count - removed)*sizeof(*b->removed));
+    b->in_base += in;
+    b->in_count -= in;
+    b->removed_base += removed;
+    b->removed_count -= removed;
+    b->checkpoint = n;
+}
+
+size_t br_balance_unconfirmed(const br_balance *b)
+{
+    return (b->unconfirmed < b->count) ? b->unconfirmed : b->count;
+}
+
+const uint8_t *br_balance_hash(const br_balance *b, size_t i)
+{
+    return b->steps[i].hash;
+}
+
+uint32_t br_balance_height(const br_balance *b, size_t i)
+{
+    return b->steps[i].height;
+}
+
+int br_balance_state(const br_balance *b, const uint8_t *hash)
+{
+    const br_balance_step *s = br_balance_step_of(b, hash);
+
+    return (s) ? s->state : 0;
+}
+
+uint64_t br_balance_after(const br_balance *b, size_t i)
+{
+    return b->steps[i].balance;
+}
+
+uint64_t br_balance_total(const br_balance *b)
+{
+    return (b->count > 0) ? b->steps[b->count - 1].balance : 0;
+}
+
+uint64_t br_balance_sent(const br_balance *b)
+{
+    return (b->count > 0) ? b->steps[b->count - 1].sent : 0;
+}
+
+uint64_t br_balance_received(const br_balance *b)
+{
+    return (b->count > 0) ? b->steps[b->count - 1].received : 0;
+}
+
+int br_balance_spent(const br_balance *b, const uint8_t *hash, uint32_t n)
+{
+    return br_outset_contains(b->spent, hash, n);
+}
+
+size_t br_balance_utxo_count(const br_balance *b)
+{
+    return br_outset_count(b->utxos);
+}
+
+typedef struct {
+    size_t pos;
+    uint32_t n;
+    const uint8_t *outpoint;
+} br_balance_utxo;
+
+static int br_balance_utxo_cmp(const void *x, const void *y)
+{
+    const br_balance_utxo *a = x, *c = y;
+
+    if (a->pos != c->pos) return (a->pos < c->pos) ? -1 : 1;
+    return (a->n < c->n) ? -1 : (a->n > c->n);
+}
+
+int br_balance_utxos(const br_balance *b, uint8_t *outpoints)
+{
+    size_t count = br_outset_count(b->utxos), it = 0, i = 0;
+    br_balance_utxo *u = malloc((count + 1)*sizeof(*u));
+    const uint8_t *outpoint;
+
+    if (! u) return 0;
+
+    // reverting puts outputs back at the end of the set, so order them by the transaction and index they came from
+    while ((outpoint = br_outset_next(b->utxos, &it))) {
+        u[i].pos = (size_t)(br_balance_step_of(b, outpoint) - b->steps);
+        u[i].n = br_balance_index(outpoint);
+        u[i++].outpoint = outpoint;
+    }
+
+    qsort(u, count, sizeof(*u), br_balance_utxo_cmp);
+    for (i = 0; i < count; i++) memcpy(outpoints + i*BR_OUTPOINT_SIZE, u[i].outpoint, BR_OUTPOINT_SIZE);
+    free(u);
+    return 1;
+}
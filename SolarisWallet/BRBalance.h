@@ -0,0 +1,107 @@
+//
+//  BRBalance.h
+//  SolarisWallet
+//
+//  The wallet's balance, spent outputs and UTXOs kept as a journal of its transactions, so the
+//  most recent one can be applied or reverted without walking all of them again.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRBalance_h
+#define BRBalance_h
+
+#include "BRTxStore.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BR_BALANCE_APPLIED 1 // the transaction's inputs are spent and its outputs to the wallet are unspent
+#define BR_BALANCE_PENDING 2 // its inputs are spent, its outputs are not counted
+#define BR_BALANCE_INVALID 3 // neither
+
+typedef struct br_balance br_balance;
+
+typedef struct {
+    const uint8_t *hash; // 32 bytes
+    uint32_t height; // kept for the caller, see br_balance_height()
+    int unconfirmed; // only unconfirmed transactions are checked for double spends and pending inputs
+    int pending; // unconfirmed and failing the wallet's own checks: size, sequence numbers, lock time or dust outputs
+    size_t in_count;
+    const uint8_t *in_hash; // in_count packed 32 byte hashes of the transactions being spent
+    const uint32_t *in_index;
+    size_t out_count;
+    const uint64_t *out_amount;
+    const uint8_t *out_mine; // nonzero for outputs to wallet addresses
+} br_balance_tx;
+
+// returns an empty journal, or NULL if out of memory
+br_balance *br_balance_new(void);
+
+void br_balance_free(br_balance *b);
+
+// empties the journal, keeping its memory
+void br_balance_clear(br_balance *b);
+
+// the number of transactions applied
+size_t br_balance_count(const br_balance *b);
+
+// applies tx as the most recent transaction, returns its BR_BALANCE_ state, or 0 if out of memory, in which case the
+// journal is emptied
+int br_balance_apply(br_balance *b, const br_balance_tx *tx);
+
+// reverts the most recent transaction, returns 0 if there is none above the checkpoint
+int br_balance_revert(br_balance *b);
+
+// the number of transactions below the checkpoint, which can no longer be reverted
+size_t br_balance_checkpoint(const br_balance *b);
+
+// moves the checkpoint up to the first n transactions, dropping their undo records; n is at most br_balance_count()
+void br_balance_set_checkpoint(br_balance *b, size_t n);
+
+// the position of the oldest transaction that was applied as unconfirmed, br_balance_count() if there is none
+size_t br_balance_unconfirmed(const br_balance *b);
+
+// the hash and block height of the transaction at position i, oldest first
+const uint8_t *br_balance_hash(const br_balance *b, size_t i);
+uint32_t br_balance_height(const br_balance *b, size_t i);
+
+// the BR_BALANCE_ state of the applied transaction with the given hash, 0 if it is not applied
+int br_balance_state(const br_balance *b, const uint8_t *hash);
+
+// the balance after the transaction at position i
+uint64_t br_balance_after(const br_balance *b, size_t i);
+
+// the current balance, and the totals of every increase and decrease of it
+uint64_t br_balance_total(const br_balance *b);
+uint64_t br_balance_sent(const br_balance *b);
+uint64_t br_balance_received(const br_balance *b);
+
+// returns 1 if an applied or pending transaction spends output n of the transaction with the given hash
+int br_balance_spent(const br_balance *b, const uint8_t *hash, uint32_t n);
+
+// the number of unspent outputs
+size_t br_balance_utxo_count(const br_balance *b);
+
+// writes the unspent outputs as packed BR_OUTPOINT_SIZE byte outpoints in the order they were received, returns 0 if
+// out of memory; outpoints must have room for br_balance_utxo_count() of them
+int br_balance_utxos(const br_balance *b, uint8_t *outpoints);
+
+#endif /* BRBalance_h */
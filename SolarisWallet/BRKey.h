@@ -52,6 +52,18 @@ int BRSecp256k1PointAdd(BRECPoint * _Nonnull p, const UInt256 * _Nonnull i);
 // returns true on success
 int BRSecp256k1PointMul(BRECPoint * _Nonnull p, const UInt256 * _Nonnull i);
 
+// signs each of the count digests mds with the secret key at the same index of seckeys, on several cores when there
+// are enough of them; DER signatures of up to BR_SECP_DER_SIG_MAX bytes (BRSecp256k1.h) go to
+// sigs + i*BR_SECP_DER_SIG_MAX and their lengths to lens[i], 0 on failure
+// returns the number of signatures made
+size_t BRSecp256k1SignMany(uint8_t * _Nonnull sigs, size_t * _Nonnull lens, const UInt256 * _Nonnull mds,
+                           const UInt256 * _Nonnull seckeys, size_t count);
+
+// derives the non-hardened children first to first + n - 1 of the extended public key (K, c) in one batch and stores
+// their hash160s in hash160s, zeroed for a child that fails; returns the number of children derived
+size_t BRSecp256k1ChildHash160s(UInt160 * _Nonnull hash160s, const BRECPoint * _Nonnull K, const UInt256 * _Nonnull c,
+                                uint32_t first, size_t n);
+
 @interface BRKey : NSObject
 
 @property (nullable, nonatomic, readonly) NSString *privateKey;
@@ -71,6 +83,7 @@ int BRSecp256k1PointMul(BRECPoint * _Nonnull p, const UInt256 * _Nonnull i);
 - (nullable instancetype)initWithCompactSig:(nonnull NSData *)compactSig andMessageDigest:(UInt256)md;
 
 - (nullable NSData *)sign:(UInt256)md;
+// accepts high s signatures like the consensus rules do, sign: only makes low s ones
 - (BOOL)verify:(UInt256)md signature:(nonnull NSData *)sig;
 
 // Pieter Wuille's compact signature encoding used for bitcoin message signing
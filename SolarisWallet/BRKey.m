@@ -30,29 +30,42 @@
 #import "NSData+Bitcoin.h"
 #import "NSMutableData+Bitcoin.h"
 
-#define USE_BASIC_CONFIG       1
-#define ENABLE_MODULE_RECOVERY 1
-#define DETERMINISTIC          1
-#if __BIG_ENDIAN__
-#define WORDS_BIGENDIAN        1
-#endif
-
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wconversion"
-#pragma clang diagnostic ignored "-Wunused-function"
-#pragma clang diagnostic ignored "-Wconditional-uninitialized"
-#include "secp256k1/src/basic-config.h"
-#include "secp256k1/src/secp256k1.c"
-#pragma clang diagnostic pop
+#import "BRSecp256k1.h"
+#import "BRBIP32Chain.h"
+#import "secp256k1/include/secp256k1_recovery.h"
 
-static secp256k1_context *_ctx = NULL;
+static secp256k1_context *_ctx = NULL; // shared by operations on public data only, which never change it
+static br_secp_pool *_pool = NULL; // contexts for operations on secret keys, one thread each, see BRSecp256k1.h
 static dispatch_once_t _ctx_once = 0;
 
+static void BRSecp256k1Init(void)
+{
+    dispatch_once(&_ctx_once, ^{
+        _ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+        _pool = br_secp_pool_new(_ctx, 0, 0);
+    });
+}
+
+// a context for blinded work on a secret key, falls back to the shared one if the pool is out of memory
+static secp256k1_context *BRSecp256k1Acquire(void)
+{
+    secp256k1_context *ctx;
+
+    BRSecp256k1Init();
+    ctx = (_pool) ? br_secp_pool_acquire(_pool) : NULL;
+    return (ctx) ? ctx : _ctx;
+}
+
+static void BRSecp256k1Release(secp256k1_context *ctx)
+{
+    if (ctx != _ctx) br_secp_pool_release(_pool, ctx);
+}
+
 // adds 256bit big endian ints a and b (mod secp256k1 order) and stores the result in a
 // returns true on success
 int BRSecp256k1ModAdd(UInt256 *a, const UInt256 *b)
 {
-    dispatch_once(&_ctx_once, ^{ _ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY); });
+    BRSecp256k1Init();
     return secp256k1_ec_privkey_tweak_add(_ctx, (unsigned char *)a, (const unsigned char *)b);
 }
 
@@ -60,7 +73,7 @@ int BRSecp256k1ModAdd(UInt256 *a, const UInt256 *b)
 // returns true on success
 int BRSecp256k1ModMul(UInt256 *a, const UInt256 *b)
 {
-    dispatch_once(&_ctx_once, ^{ _ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY); });
+    BRSecp256k1Init();
     return secp256k1_ec_privkey_tweak_mul(_ctx, (unsigned char *)a, (const unsigned char *)b);
 }
 
@@ -68,12 +81,14 @@ int BRSecp256k1ModMul(UInt256 *a, const UInt256 *b)
 // returns true on success
 int BRSecp256k1PointGen(BRECPoint *p, const UInt256 *i)
 {
+    secp256k1_context *ctx = BRSecp256k1Acquire();
     secp256k1_pubkey pubkey;
     size_t pLen = sizeof(*p);
+    int r = (secp256k1_ec_pubkey_create(ctx, &pubkey, (const unsigned char *)i) &&
+             secp256k1_ec_pubkey_serialize(ctx, (unsigned char *)p, &pLen, &pubkey, SECP256K1_EC_COMPRESSED));
     
-    dispatch_once(&_ctx_once, ^{ _ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY); });
-    return (secp256k1_ec_pubkey_create(_ctx, &pubkey, (const unsigned char *)i) &&
-            secp256k1_ec_pubkey_serialize(_ctx, (unsigned char *)p, &pLen, &pubkey, SECP256K1_EC_COMPRESSED));
+    BRSecp256k1Release(ctx);
+    return r;
 }
 
 // multiplies secp256k1 generator by 256bit big endian int i and adds the result to ec-point p
@@ -83,7 +98,7 @@ int BRSecp256k1PointAdd(BRECPoint *p, const UInt256 *i)
     secp256k1_pubkey pubkey;
     size_t pLen = sizeof(*p);
     
-    dispatch_once(&_ctx_once, ^{ _ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY); });
+    BRSecp256k1Init();
     return (secp256k1_ec_pubkey_parse(_ctx, &pubkey, (const unsigned char *)p, sizeof(*p)) &&
             secp256k1_ec_pubkey_tweak_add(_ctx, &pubkey, (const unsigned char *)i) &&
             secp256k1_ec_pubkey_serialize(_ctx, (unsigned char *)p, &pLen, &pubkey, SECP256K1_EC_COMPRESSED));
@@ -96,12 +111,44 @@ int BRSecp256k1PointMul(BRECPoint *p, const UInt256 *i)
     secp256k1_pubkey pubkey;
     size_t pLen = sizeof(*p);
     
-    dispatch_once(&_ctx_once, ^{ _ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY); });
+    BRSecp256k1Init();
     return (secp256k1_ec_pubkey_parse(_ctx, &pubkey, (const unsigned char *)p, sizeof(*p)) &&
             secp256k1_ec_pubkey_tweak_mul(_ctx, &pubkey, (const unsigned char *)i) &&
             secp256k1_ec_pubkey_serialize(_ctx, (unsigned char *)p, &pLen, &pubkey, SECP256K1_EC_COMPRESSED));
 }
 
+size_t BRSecp256k1SignMany(uint8_t *sigs, size_t *lens, const UInt256 *mds, const UInt256 *seckeys, size_t count)
+{
+    BRSecp256k1Init();
+    if (_pool) return br_secp_pool_sign(_pool, sigs, lens, mds->u8, seckeys->u8, count);
+
+    size_t r = 0;
+
+    for (size_t i = 0; i < count; i++) { // no pool, sign in turn on the shared context
+        secp256k1_ecdsa_signature s;
+
+        lens[i] = BR_SECP_DER_SIG_MAX;
+
+        if (secp256k1_ecdsa_sign(_ctx, &s, mds[i].u8, seckeys[i].u8, secp256k1_nonce_function_rfc6979, NULL) &&
+            secp256k1_ecdsa_signature_serialize_der(_ctx, sigs + i*BR_SECP_DER_SIG_MAX, &lens[i], &s)) r++;
+        else lens[i] = 0;
+    }
+
+    return r;
+}
+
+size_t BRSecp256k1ChildHash160s(UInt160 *hash160s, const BRECPoint *K, const UInt256 *c, uint32_t first, size_t n)
+{
+    br_bip32_chain *chain = br_bip32_chain_new(K->p, c->u8);
+    size_t r;
+
+    if (! chain) return 0;
+    BRSecp256k1Init();
+    r = br_bip32_chain_derive(chain, _ctx, first, n, NULL, hash160s->u8);
+    br_bip32_chain_free(chain);
+    return r;
+}
+
 @interface BRKey ()
 
 @property (nonatomic, assign) UInt256 seckey;
@@ -134,7 +181,7 @@ int BRSecp256k1PointMul(BRECPoint *p, const UInt256 *i)
 
 - (instancetype)init
 {
-    dispatch_once(&_ctx_once, ^{ _ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY); });
+    BRSecp256k1Init();
     return (self = [super init]);
 }
 
@@ -240,13 +287,16 @@ int BRSecp256k1PointMul(BRECPoint *p, const UInt256 *i)
     if (self.pubkey.length == 0 && ! uint256_is_zero(_seckey)) {
         NSMutableData *d = [NSMutableData secureDataWithLength:self.compressed ? 33 : 65];
         size_t len = d.length;
+        secp256k1_context *ctx = BRSecp256k1Acquire();
         secp256k1_pubkey pk;
 
-        if (secp256k1_ec_pubkey_create(_ctx, &pk, _seckey.u8)) {
-            secp256k1_ec_pubkey_serialize(_ctx, d.mutableBytes, &len, &pk,
+        if (secp256k1_ec_pubkey_create(ctx, &pk, _seckey.u8)) {
+            secp256k1_ec_pubkey_serialize(ctx, d.mutableBytes, &len, &pk,
                                           (self.compressed ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED));
             if (len == d.length) self.pubkey = d;
         }
+
+        BRSecp256k1Release(ctx);
     }
     
     return self.pubkey;
@@ -264,17 +314,7 @@ int BRSecp256k1PointMul(BRECPoint *p, const UInt256 *i)
 
 - (NSString *)address
 {
-    NSMutableData *d = [NSMutableData secureDataWithCapacity:160/8 + 1];
-    uint8_t version = DASH_PUBKEY_ADDRESS;
-    UInt160 hash160 = self.hash160;
-
-#if DASH_TESTNET
-    version = DASH_PUBKEY_ADDRESS_TEST;
-#endif
-    
-    [d appendBytes:&version length:1];
-    [d appendBytes:&hash160 length:sizeof(hash160)];
-    return [NSString base58checkWithData:d];
+    return [NSString addressWithHash160:self.hash160];
 }
 
 - (NSData *)sign:(UInt256)md
@@ -286,14 +326,16 @@ int BRSecp256k1PointMul(BRECPoint *p, const UInt256 *i)
 
     NSMutableData *sig = [NSMutableData dataWithLength:72];
     size_t len = sig.length;
+    secp256k1_context *ctx = BRSecp256k1Acquire();
     secp256k1_ecdsa_signature s;
     
-    if (secp256k1_ecdsa_sign(_ctx, &s, md.u8, _seckey.u8, secp256k1_nonce_function_rfc6979, NULL) &&
-        secp256k1_ecdsa_signature_serialize_der(_ctx, sig.mutableBytes, &len, &s)) {
+    if (secp256k1_ecdsa_sign(ctx, &s, md.u8, _seckey.u8, secp256k1_nonce_function_rfc6979, NULL) &&
+        secp256k1_ecdsa_signature_serialize_der(ctx, sig.mutableBytes, &len, &s)) {
         sig.length = len;
     }
     else sig = nil;
     
+    BRSecp256k1Release(ctx);
     return sig;
 }
 
@@ -304,9 +346,9 @@ int BRSecp256k1PointMul(BRECPoint *p, const UInt256 *i)
     BOOL r = NO;
     
     if (secp256k1_ec_pubkey_parse(_ctx, &pk, self.publicKey.bytes, self.publicKey.length) &&
-        secp256k1_ecdsa_signature_parse_der(_ctx, &s, sig.bytes, sig.length) &&
-        secp256k1_ecdsa_verify(_ctx, &s, md.u8, &pk) == 1) { // success is 1, all other values are fail
-        r = YES;
+        secp256k1_ecdsa_signature_parse_der(_ctx, &s, sig.bytes, sig.length)) {
+        secp256k1_ecdsa_signature_normalize(_ctx, &s, &s); // high s is valid by consensus, libsecp256k1 rejects it
+        r = (secp256k1_ecdsa_verify(_ctx, &s, md.u8, &pk) == 1) ? YES : NO; // success is 1, all other values are fail
     }
     
     return r;
@@ -323,14 +365,16 @@ int BRSecp256k1PointMul(BRECPoint *p, const UInt256 *i)
     
     NSMutableData *sig = [NSMutableData dataWithLength:65];
     secp256k1_ecdsa_recoverable_signature s;
+    secp256k1_context *ctx = BRSecp256k1Acquire();
     int recid = 0;
     
-    if (secp256k1_ecdsa_sign_recoverable(_ctx, &s, md.u8, _seckey.u8, secp256k1_nonce_function_rfc6979, NULL) &&
-        secp256k1_ecdsa_recoverable_signature_serialize_compact(_ctx, (uint8_t *)sig.mutableBytes + 1, &recid, &s)) {
+    if (secp256k1_ecdsa_sign_recoverable(ctx, &s, md.u8, _seckey.u8, secp256k1_nonce_function_rfc6979, NULL) &&
+        secp256k1_ecdsa_recoverable_signature_serialize_compact(ctx, (uint8_t *)sig.mutableBytes + 1, &recid, &s)) {
         ((uint8_t *)sig.mutableBytes)[0] = 27 + recid + (self.compressed ? 4 : 0);
     }
     else sig = nil;
     
+    BRSecp256k1Release(ctx);
     return sig;
 }
 
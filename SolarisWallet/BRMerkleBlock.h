@@ -61,6 +61,8 @@ typedef union _UInt256 UInt256;
 
 // message can be either a merkleblock or header message
 + (instancetype)blockWithMessage:(NSData *)message;
+// same as blockWithMessage: for a header whose hash was already computed, e.g. by xevan_hash_many()
++ (instancetype)blockWithMessage:(NSData *)message blockHash:(UInt256)blockHash;
 
 - (instancetype)initWithMessage:(NSData *)message;
 - (instancetype)initWithBlockHash:(UInt256)blockHash version:(uint32_t)version prevBlock:(UInt256)prevBlock
@@ -27,6 +27,8 @@
 #import "NSMutableData+Bitcoin.h"
 #import "NSData+Bitcoin.h"
 #import "NSData+Dash.h"
+#import "xevan.h"
+#import "BRMerkleTree.h"
 
 #define MAX_TIME_DRIFT    (2*60*60)     // the furthest in the future a block is allowed to be timestamped
 #define MAX_PROOF_OF_WORK 0x1e0fffffu   // highest value for difficulty target (higher values are less difficult)
@@ -57,19 +59,15 @@
 //
 // flag bits (little endian): 00001011 [merkleRoot = 1, m1 = 1, tx1 = 0, tx2 = 1, m2 = 0, byte padding = 000]
 // hashes: [tx1, tx2, m2]
-
-inline static int ceil_log2(int x)
-{
-    int r = (x & (x - 1)) ? 1 : 0;
-    
-    while ((x >>= 1) != 0) r++;
-    return r;
-}
+//
+// br_merkle_tree_walk() in BRMerkleTree.c does the decoding
 
 @interface BRMerkleBlock ()
 
 @property (nonatomic, assign) UInt256 blockHash;
-    
+
+- (instancetype)initWithMessage:(NSData *)message knownBlockHash:(const UInt256 *)blockHash;
+
 @end
 
 @implementation BRMerkleBlock
@@ -80,13 +78,23 @@ inline static int ceil_log2(int x)
     return [[self alloc] initWithMessage:message];
 }
 
+// the block hash of a header that was already hashed in a batch, message is parsed but not hashed again
++ (instancetype)blockWithMessage:(NSData *)message blockHash:(UInt256)blockHash
+{
+    return [[self alloc] initWithMessage:message knownBlockHash:&blockHash];
+}
+
 - (instancetype)initWithMessage:(NSData *)message
+{
+    return [self initWithMessage:message knownBlockHash:NULL];
+}
+
+- (instancetype)initWithMessage:(NSData *)message knownBlockHash:(const UInt256 *)blockHash
 {
     if (! (self = [self init])) return nil;
     if (message.length < 80) return nil;
     NSNumber * l = nil;
     NSUInteger off = 0, len = 0, header = 0;
-    NSMutableData *d = [NSMutableData data]; // NSMutableData
 
     //NSLog(@"############################");
     
@@ -130,15 +138,13 @@ inline static int ceil_log2(int x)
     _flags = [message dataAtOffset:off length:&l];
     _height = BLOCK_UNKNOWN_HEIGHT;
     
-    [d appendBytes:message.bytes length:header];    
-
-    if(![ self isZerocoin ]){
-        _blockHash = d.XEVAN;
-    }else{
-        //[d appendBytes:&_zerocoinAccumulator length:sizeof(_zerocoinAccumulator)];
-        //[d appendData:[NSData dataWithUInt256:_zerocoinAccumulator]];
-        _blockHash = d.XEVAN;
+    if (blockHash) {
+        _blockHash = *blockHash;
+        return self;
     }
+
+    // hashed in place, header already covers the accumulator; a headers message slice can be shorter than a v4 header
+    _blockHash = xevan_header_cached(message.bytes, MIN(header, message.length));
     //NSString* s = [NSData dataWithUInt256: *(const UInt256 *)((const char *)[NSData dataWithUInt256:_blockHash].reverse.bytes)].hexString;
     //NSLog(@"Received block hash %@   %d",s, _timestamp);
     
@@ -176,26 +182,12 @@ totalTransactions:(uint32_t)totalTransactions hashes:(NSData *)hashes flags:(NSD
     // bit is the sign, and the remaining 23bits is the value after having been right shifted by (size - 3)*8 bits
     static const uint32_t maxsize = MAX_PROOF_OF_WORK >> 24, maxtarget = MAX_PROOF_OF_WORK & 0x00ffffffu;
     const uint32_t size = _target >> 24, target = _target & 0x00ffffffu;
-    NSMutableData *d = [NSMutableData data];
     UInt256 merkleRoot, t = UINT256_ZERO;
-    int hashIdx = 0, flagIdx = 0;
-    NSValue *root =
-        [self _walk:&hashIdx :&flagIdx :0 :^id (id hash, BOOL flag) {
-            return hash;
-        } :^id (id left, id right) {
-            UInt256 l, r;
-
-            if (! right) right = left; // if right branch is missing, duplicate left branch
-            [left getValue:&l];
-            [right getValue:&r];
-            d.length = 0;
-            [d appendBytes:&l length:sizeof(l)];
-            [d appendBytes:&r length:sizeof(r)];
-            return uint256_obj(d.SHA256_2);
-        }];
     
-    [root getValue:&merkleRoot];
-    if (_totalTransactions > 0 && ! uint256_eq(merkleRoot, _merkleRoot)) return NO; // merkle root check failed
+    if (_totalTransactions > 0 &&
+        (! br_merkle_tree_walk(merkleRoot.u8, NULL, NULL, _totalTransactions, _hashes.bytes,
+                               _hashes.length/sizeof(UInt256), _flags.bytes, _flags.length) ||
+         ! uint256_eq(merkleRoot, _merkleRoot))) return NO; // merkle root check failed
     
     // check if timestamp is too far in future
     //TODO: use estimated network time instead of system time (avoids timejacking attacks and misconfigured time)
@@ -272,14 +264,18 @@ totalTransactions:(uint32_t)totalTransactions hashes:(NSData *)hashes flags:(NSD
 // returns an array of the matched tx hashes
 - (NSArray *)txHashes
 {
-    int hashIdx = 0, flagIdx = 0;
-    NSArray *txHashes =
-        [self _walk:&hashIdx :&flagIdx :0 :^id (id hash, BOOL flag) {
-            return (flag && hash) ? @[hash] : @[];
-        } :^id (id left, id right) {
-            return [left arrayByAddingObjectsFromArray:right];
-        }];
-    
+    NSUInteger count = _hashes.length/sizeof(UInt256);
+    NSMutableData *matches = [NSMutableData dataWithLength:count*sizeof(UInt256)];
+    NSMutableArray *txHashes;
+    UInt256 merkleRoot;
+    size_t matched = 0;
+    
+    if (_totalTransactions == 0 ||
+        ! br_merkle_tree_walk(merkleRoot.u8, matches.mutableBytes, &matched, _totalTransactions, _hashes.bytes, count,
+                              _flags.bytes, _flags.length)) return @[];
+    
+    txHashes = [NSMutableArray arrayWithCapacity:matched];
+    for (size_t i = 0; i < matched; i++) [txHashes addObject:uint256_obj(((const UInt256 *)matches.bytes)[i])];
     return txHashes;
 }
 
@@ -502,29 +498,6 @@ UInt256 multiplyThis32 (UInt256 a,uint32_t b)
     return compact;
 }
 
-// recursively walks the merkle tree in depth first order, calling leaf(hash, flag) for each stored hash, and
-// branch(left, right) with the result from each branch
-- (id)_walk:(int *)hashIdx :(int *)flagIdx :(int)depth :(id (^)(id, BOOL))leaf :(id (^)(id, id))branch
-{
-    if ((*flagIdx)/8 >= _flags.length || (*hashIdx + 1)*sizeof(UInt256) > _hashes.length) return leaf(nil, NO);
-    
-    BOOL flag = (((const uint8_t *)_flags.bytes)[*flagIdx/8] & (1 << (*flagIdx % 8)));
-    
-    (*flagIdx)++;
-    
-    if (! flag || depth == ceil_log2(_totalTransactions)) {
-        UInt256 hash = [_hashes hashAtOffset:(*hashIdx)*sizeof(UInt256)];
-        
-        (*hashIdx)++;
-        return leaf(uint256_obj(hash), flag);
-    }
-    
-    id left = [self _walk:hashIdx :flagIdx :depth + 1 :leaf :branch];
-    id right = [self _walk:hashIdx :flagIdx :depth + 1 :leaf :branch];
-    
-    return branch(left, right);
-}
-
 - (NSUInteger)hash
 {
     if (uint256_is_zero(_blockHash)) return super.hash;
@@ -0,0 +1,136 @@
+//
+//  BRMerkleTree.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRMerkleTree.h"
+#include "BRSha256.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BR_MERKLE_LEVELS 33 // leaves up to the root of a tree of UINT32_MAX transactions
+
+typedef struct {
+    const uint8_t *hashes, *flags;
+    size_t n, flags_len;
+    uint32_t total;
+    int height;
+    size_t count[BR_MERKLE_LEVELS]; // the nodes walked at each level, leaves at level 0
+    size_t off[BR_MERKLE_LEVELS]; // where each level starts in the slots, a spare slot after each
+} br_merkle_walk;
+
+// the number of nodes at the level of a tree of total transactions
+static uint64_t br_merkle_width(uint32_t total, int level)
+{
+    return ((uint64_t)total + ((uint64_t)1 << level) - 1) >> level;
+}
+
+// walks the tree depth first the way BIP37 lays it out; on the first walk collects the matches and counts the nodes
+// at each level, on the second, with slots, places the given hashes at their level and marks the nodes to be hashed
+static int br_merkle_tree_dfs(br_merkle_walk *w, uint8_t *matches, size_t *matched, uint8_t *slots, uint8_t *inner)
+{
+    struct { int level; uint32_t pos; } stack[BR_MERKLE_LEVELS + 1]; // a right sibling pending at each level at most
+    size_t sp = 0, bits = 0, used = 0, found = 0, next[BR_MERKLE_LEVELS] = { 0 };
+
+    stack[sp].level = w->height, stack[sp++].pos = 0;
+
+    while (sp > 0) {
+        int level = stack[--sp].level, flag;
+        uint32_t pos = stack[sp].pos;
+        size_t i = w->off[level] + next[level]++;
+
+        if (bits >= w->flags_len*8) return 0;
+        flag = (w->flags[bits/8] >> (bits % 8)) & 1;
+        bits++;
+
+        if (! flag || level == 0) { // a hash given in the message, a matched txid if flagged
+            if (used >= w->n) return 0;
+            if (slots) memcpy(slots + i*32, w->hashes + used*32, 32);
+            if (flag && matches) memcpy(matches + found*32, w->hashes + used*32, 32);
+            if (flag) found++;
+            used++;
+        }
+        else { // the hash of its children, which the walk visits next, left first
+            if (inner) inner[i] = 1;
+
+            if ((uint64_t)pos*2 + 1 < br_merkle_width(w->total, level - 1)) {
+                stack[sp].level = level - 1, stack[sp++].pos = pos*2 + 1;
+            }
+
+            stack[sp].level = level - 1, stack[sp++].pos = pos*2;
+        }
+    }
+
+    if (used != w->n || (bits + 7)/8 != w->flags_len) return 0; // hashes or whole bytes of flags left over
+    if (! slots) memcpy(w->count, next, sizeof(next));
+    if (matched) *matched = found;
+    return 1;
+}
+
+int br_merkle_tree_walk(uint8_t *root, uint8_t *matches, size_t *matched, uint32_t total, const uint8_t *hashes,
+                        size_t n, const uint8_t *flags, size_t flags_len)
+{
+    br_merkle_walk w;
+    size_t nodes = 0;
+    uint8_t *slots, *inner;
+    int r = 1;
+
+    if (total == 0 || n == 0 || n > total || n > flags_len*8) return 0;
+    memset(&w, 0, sizeof(w));
+    w.hashes = hashes, w.flags = flags, w.n = n, w.flags_len = flags_len, w.total = total;
+    while (((uint64_t)1 << w.height) < total) w.height++;
+    if (! br_merkle_tree_dfs(&w, matches, matched, NULL, NULL)) return 0;
+
+    for (int level = 0; level <= w.height; level++) {
+        w.off[level] = nodes + level;
+        nodes += w.count[level];
+    }
+
+    nodes += w.height + 1; // the spare slots
+    if (! (slots = malloc(nodes*33))) return 0; // a hash, and whether to hash it from its children, per slot
+    inner = slots + nodes*32;
+    memset(inner, 0, nodes);
+    br_merkle_tree_dfs(&w, NULL, NULL, slots, inner);
+
+    for (int level = 1; r && level <= w.height; level++) {
+        uint8_t *kids = slots + w.off[level - 1]*32;
+        size_t c = w.count[level - 1], pairs = (c + 1)/2;
+
+        // the left sibling paired with itself where the level has no right one, only ever at its right end
+        if (c % 2) memcpy(kids + c*32, kids + (c - 1)*32, 32);
+
+        for (size_t j = 0; r && j < c/2; j++) {
+            if (memcmp(kids + j*64, kids + j*64 + 32, 32) == 0) r = 0; // duplicated transactions, CVE-2012-2459
+        }
+
+        br_sha256d64(kids, kids, pairs);
+
+        for (size_t i = w.off[level], j = 0; i < w.off[level] + w.count[level]; i++) {
+            if (inner[i]) memcpy(slots + i*32, kids + (j++)*32, 32);
+        }
+    }
+
+    if (r) memcpy(root, slots + w.off[w.height]*32, 32);
+    free(slots);
+    return r;
+}
@@ -0,0 +1,41 @@
+//
+//  BRMerkleTree.h
+//  SolarisWallet
+//
+//  Checks the BIP37 partial merkle tree of a merkleblock message and extracts the txids it matches.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRMerkleTree_h
+#define BRMerkleTree_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// walks the partial merkle tree of a block of total transactions, given as the n 32 byte hashes and flags_len bytes of
+// flags a merkleblock message carries; writes the 32 byte root to root and, if matches is not NULL, the matched txids in
+// block order to matches, which needs room for n of them, and their number to *matched if it is not NULL
+// returns 0 if the tree is malformed: hashes or flag bits running out or left over, identical sibling hashes, or a
+// total of 0; or if out of memory
+int br_merkle_tree_walk(uint8_t *root, uint8_t *matches, size_t *matched, uint32_t total, const uint8_t *hashes,
+                        size_t n, const uint8_t *flags, size_t flags_len);
+
+#endif /* BRMerkleTree_h */
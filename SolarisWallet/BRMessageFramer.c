@@ -0,0 +1,300 @@
+//
+//  BRMessageFramer.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRMessageFramer.h"
+#include "sph/sph_sha2.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BR_FRAMER_INITIAL_CAP 0x10000 // buffer size while no large message is in flight
+#define BR_FRAMER_MIN_SPACE   0x1000  // smallest read window handed out
+
+struct br_framer {
+    uint8_t magic[4];
+    uint8_t *buf; // received bytes not yet framed live in buf[head, tail)
+    size_t cap, head, tail;
+    size_t consume; // bytes of the last message handed out, released on the next call
+    int in_payload; // the header is parsed into msg and its payload is being hashed
+    uint8_t *payload; // block a long payload is read into, while in_payload and after it is handed out until released
+    size_t received; // bytes of msg.length in payload
+    br_message msg;
+    size_t hashed; // payload bytes fed to sha so far
+    sph_sha256_context sha;
+    uint64_t skipped;
+};
+
+br_framer *br_framer_new(uint32_t magic)
+{
+    br_framer *framer = calloc(1, sizeof(*framer));
+
+    if (! framer) return NULL;
+    sph_enc32le(framer->magic, magic);
+    framer->buf = malloc(BR_FRAMER_INITIAL_CAP);
+
+    if (! framer->buf) {
+        free(framer);
+        return NULL;
+    }
+
+    framer->cap = BR_FRAMER_INITIAL_CAP;
+    return framer;
+}
+
+void br_framer_free(br_framer *framer)
+{
+    if (! framer) return;
+    free(framer->payload);
+    free(framer->buf);
+    free(framer);
+}
+
+// drops the message handed out by the previous br_framer_next(), its payload view is no longer valid afterwards
+static void br_framer_release(br_framer *framer)
+{
+    if (framer->payload && ! framer->in_payload) { // handed out and not detached
+        free(framer->payload);
+        framer->payload = NULL;
+    }
+
+    framer->head += framer->consume;
+    framer->consume = 0;
+    if (framer->head < framer->tail) return;
+    framer->head = framer->tail = 0;
+
+    // give back the room a large message needed once it is gone
+    if (framer->cap > BR_FRAMER_INITIAL_CAP && ! framer->in_payload) {
+        uint8_t *buf = realloc(framer->buf, BR_FRAMER_INITIAL_CAP);
+
+        if (buf) {
+            framer->buf = buf;
+            framer->cap = BR_FRAMER_INITIAL_CAP;
+        }
+    }
+}
+
+uint8_t *br_framer_buffer(br_framer *framer, size_t *space)
+{
+    size_t need;
+
+    br_framer_release(framer);
+
+    // the rest of a long payload is read straight into its own block
+    if (framer->payload && framer->received < framer->msg.length) {
+        *space = framer->msg.length - framer->received;
+        return framer->payload + framer->received;
+    }
+
+    // a short message has to end up contiguous, so that its payload can be handed out as one view
+    need = (framer->in_payload && ! framer->payload) ? BR_FRAMER_HEADER_LENGTH + framer->msg.length :
+           BR_FRAMER_HEADER_LENGTH;
+
+    if (framer->head > 0 && (framer->cap - framer->tail < BR_FRAMER_MIN_SPACE || framer->head + need > framer->cap)) {
+        // slide the unframed bytes to the front, at most once per message since only whole messages are consumed
+        memmove(framer->buf, framer->buf + framer->head, framer->tail - framer->head);
+        framer->tail -= framer->head;
+        framer->head = 0;
+    }
+
+    if (framer->cap - framer->tail < BR_FRAMER_MIN_SPACE || framer->cap < need) {
+        size_t cap = framer->cap;
+        uint8_t *buf;
+
+        while (cap - framer->tail < BR_FRAMER_MIN_SPACE || cap < need) cap *= 2;
+        buf = realloc(framer->buf, cap);
+        if (! buf) return NULL;
+        framer->buf = buf;
+        framer->cap = cap;
+    }
+
+    *space = framer->cap - framer->tail;
+    return framer->buf + framer->tail;
+}
+
+void br_framer_commit(br_framer *framer, size_t len)
+{
+    if (framer->payload && framer->received < framer->msg.length) framer->received += len;
+    else framer->tail += len;
+}
+
+int br_framer_write(br_framer *framer, const void *data, size_t len)
+{
+    const uint8_t *d = data;
+
+    while (len > 0) {
+        size_t space = 0, l;
+        uint8_t *buf = br_framer_buffer(framer, &space);
+
+        if (! buf) return 0;
+        l = (len < space) ? len : space;
+        memcpy(buf, d, l);
+        br_framer_commit(framer, l);
+        d += l;
+        len -= l;
+    }
+
+    return 1;
+}
+
+// moves head to the next occurrence of the magic number, or as close to the end as a partial match allows
+// returns 1 when a magic number starts at head
+static int br_framer_seek(br_framer *framer)
+{
+    while (framer->tail - framer->head >= sizeof(framer->magic)) {
+        size_t start = framer->head, n = framer->tail - framer->head - (sizeof(framer->magic) - 1);
+        const uint8_t *p = memchr(framer->buf + start, framer->magic[0], n);
+
+        if (! p) { // keep the last bytes, they may begin a magic number whose rest has not arrived yet
+            framer->head += n;
+            framer->skipped += n;
+            return 0;
+        }
+
+        framer->head = (size_t)(p - framer->buf);
+        framer->skipped += framer->head - start;
+        if (memcmp(p, framer->magic, sizeof(framer->magic)) == 0) return 1;
+        framer->head++;
+        framer->skipped++;
+    }
+
+    return 0;
+}
+
+br_framer_status br_framer_next(br_framer *framer, br_message *msg)
+{
+    br_message *m = &framer->msg;
+    const uint8_t *header;
+    uint8_t *payload, hash[32];
+    size_t avail;
+
+    br_framer_release(framer);
+
+    if (! framer->in_payload) {
+        if (! br_framer_seek(framer) || framer->tail - framer->head < BR_FRAMER_HEADER_LENGTH) {
+            return BR_FRAMER_NEED_MORE;
+        }
+
+        header = framer->buf + framer->head;
+        memcpy(m->type, header + 4, BR_FRAMER_TYPE_LENGTH);
+        m->type[BR_FRAMER_TYPE_LENGTH] = '\0';
+        m->length = sph_dec32le(header + 16);
+        m->checksum = sph_dec32le(header + 20);
+        m->payload = NULL;
+
+        if (header[15] != 0) { // verify msg type field is null terminated
+            *msg = *m;
+            framer->head += BR_FRAMER_HEADER_LENGTH;
+            return BR_FRAMER_ERROR_HEADER;
+        }
+
+        if (m->length > BR_FRAMER_MAX_MSG_LENGTH) {
+            *msg = *m;
+            framer->head += BR_FRAMER_HEADER_LENGTH;
+            return BR_FRAMER_ERROR_LENGTH;
+        }
+
+        if (m->length >= BR_FRAMER_DETACH_LENGTH) {
+            // move what already arrived behind the header into the payload's own block, the rest is read there
+            framer->payload = malloc(m->length);
+            if (! framer->payload) return BR_FRAMER_NEED_MORE; // the header is parsed again on the next call
+            avail = framer->tail - framer->head - BR_FRAMER_HEADER_LENGTH;
+            if (avail > m->length) avail = m->length;
+            memcpy(framer->payload, header + BR_FRAMER_HEADER_LENGTH, avail);
+            framer->received = avail;
+            framer->head += BR_FRAMER_HEADER_LENGTH + avail;
+        }
+
+        framer->in_payload = 1;
+        framer->hashed = 0;
+        sph_sha256_init(&framer->sha);
+    }
+
+    // hash whatever part of the payload arrived since the last call, so completing a message costs no extra pass
+    if (framer->payload) {
+        payload = framer->payload;
+        avail = framer->received;
+    }
+    else {
+        payload = framer->buf + framer->head + BR_FRAMER_HEADER_LENGTH;
+        avail = framer->tail - framer->head - BR_FRAMER_HEADER_LENGTH;
+        if (avail > m->length) avail = m->length;
+    }
+
+    if (avail > framer->hashed) {
+        sph_sha256(&framer->sha, payload + framer->hashed, avail - framer->hashed);
+        framer->hashed = avail;
+    }
+
+    if (framer->hashed < m->length) return BR_FRAMER_NEED_MORE;
+
+    sph_sha256_close(&framer->sha, hash); // close leaves the context initialised for the second round
+    sph_sha256(&framer->sha, hash, sizeof(hash));
+    sph_sha256_close(&framer->sha, hash);
+
+    framer->in_payload = 0;
+    *msg = *m;
+    msg->payload = payload;
+
+    if (sph_dec32le(hash) != m->checksum) {
+        if (! framer->payload) framer->head += BR_FRAMER_HEADER_LENGTH + m->length; // a long one goes on release
+        return BR_FRAMER_ERROR_CHECKSUM;
+    }
+
+    if (! framer->payload) framer->consume = BR_FRAMER_HEADER_LENGTH + m->length;
+    return BR_FRAMER_MESSAGE;
+}
+
+br_framer_status br_framer_drain(br_framer *framer, br_message *msg,
+                                 int (*deliver)(void *info, const br_message *msg), void *info)
+{
+    br_framer_status status;
+
+    while ((status = br_framer_next(framer, msg)) == BR_FRAMER_MESSAGE) {
+        if (! deliver(info, msg)) break;
+    }
+
+    return status;
+}
+
+uint8_t *br_framer_detach(br_framer *framer)
+{
+    uint8_t *payload = framer->payload;
+    size_t len;
+
+    if (payload && ! framer->in_payload) {
+        framer->payload = NULL;
+        return payload;
+    }
+
+    if (framer->consume <= BR_FRAMER_HEADER_LENGTH) return NULL;
+    len = framer->consume - BR_FRAMER_HEADER_LENGTH;
+    payload = malloc(len);
+    if (payload) memcpy(payload, framer->buf + framer->head + BR_FRAMER_HEADER_LENGTH, len);
+    return payload;
+}
+
+uint64_t br_framer_skipped(const br_framer *framer)
+{
+    return framer->skipped;
+}
@@ -0,0 +1,91 @@
+//
+//  BRMessageFramer.h
+//  SolarisWallet
+//
+//  Splits a peer's byte stream into p2p messages, checking magic, length and checksum as the bytes
+//  arrive.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRMessageFramer_h
+#define BRMessageFramer_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BR_FRAMER_HEADER_LENGTH  24
+#define BR_FRAMER_MAX_MSG_LENGTH 0x02000000
+#define BR_FRAMER_TYPE_LENGTH    12
+#define BR_FRAMER_DETACH_LENGTH  0x1000 // payloads this long are read into a block of their own, see br_framer_detach()
+
+typedef enum {
+    BR_FRAMER_NEED_MORE = 0, // no complete message buffered, read more input
+    BR_FRAMER_MESSAGE = 1, // a message was framed
+    BR_FRAMER_ERROR_HEADER = -1, // message type is not null terminated, the header was dropped
+    BR_FRAMER_ERROR_LENGTH = -2, // payload length above BR_FRAMER_MAX_MSG_LENGTH, the header was dropped
+    BR_FRAMER_ERROR_CHECKSUM = -3, // payload checksum mismatch, the message was dropped
+} br_framer_status;
+
+typedef struct {
+    char type[BR_FRAMER_TYPE_LENGTH + 1]; // null terminated message type
+    uint32_t length; // payload length
+    uint32_t checksum; // checksum from the header
+    const uint8_t *payload; // view into the framer's storage, valid until the framer is called again
+} br_message;
+
+typedef struct br_framer br_framer;
+
+// returns a framer for a network with the given magic number, or NULL if out of memory
+br_framer *br_framer_new(uint32_t magic);
+
+void br_framer_free(br_framer *framer);
+
+// returns where the next input bytes should be read to, with room for *space bytes, or NULL if out of memory
+// reading straight into this buffer saves a copy; follow the read with br_framer_commit()
+uint8_t *br_framer_buffer(br_framer *framer, size_t *space);
+
+// marks len bytes written to the br_framer_buffer() region as received
+void br_framer_commit(br_framer *framer, size_t len);
+
+// copies len bytes of input into the framer, for callers that already hold the bytes elsewhere; returns 0 if out of
+// memory, otherwise 1
+int br_framer_write(br_framer *framer, const void *data, size_t len);
+
+// frames the next message from the buffered input into msg; call until it returns BR_FRAMER_NEED_MORE
+// on an error status msg describes the offending header, and the framer has already moved past it
+br_framer_status br_framer_next(br_framer *framer, br_message *msg);
+
+// frames the buffered input like br_framer_next() and hands each message to deliver, until more input is needed, deliver
+// returns 0 or a header or checksum is bad; returns BR_FRAMER_NEED_MORE, BR_FRAMER_MESSAGE when deliver stopped it, or
+// the error status with msg describing the offending header, in which case nothing after it has been delivered and the
+// stream should be dropped
+br_framer_status br_framer_drain(br_framer *framer, br_message *msg,
+                                 int (*deliver)(void *info, const br_message *msg), void *info);
+
+// hands the payload of the message br_framer_next() just framed over to the caller, as a malloc'd block to free();
+// a payload of BR_FRAMER_DETACH_LENGTH bytes or more is the block it was read into, msg->payload itself, smaller ones
+// arrive batched in the framer's buffer and are copied out; returns NULL for an empty payload or when out of memory
+uint8_t *br_framer_detach(br_framer *framer);
+
+// bytes thrown away so far while looking for the magic number
+uint64_t br_framer_skipped(const br_framer *framer);
+
+#endif /* BRMessageFramer_h */
@@ -0,0 +1,157 @@
+//
+//  BRParallel.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRParallel.h"
+
+#include <pthread.h>
+
+typedef struct {
+    void (*fn)(void *info, unsigned chunk, size_t first, size_t count);
+    void *info;
+    unsigned pending; // chunks handed to the queue and not finished yet
+} br_parallel_call;
+
+typedef struct br_parallel_task br_parallel_task;
+
+struct br_parallel_task {
+    br_parallel_task *next;
+    br_parallel_call *call;
+    unsigned chunk;
+    size_t first, count;
+};
+
+// the queue and its workers are shared by every caller; tasks live on their caller's stack until pending drops
+static pthread_mutex_t br_parallel_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t br_parallel_work = PTHREAD_COND_INITIALIZER; // signalled when a task is queued
+static pthread_cond_t br_parallel_done = PTHREAD_COND_INITIALIZER; // broadcast when a call's last task finishes
+static br_parallel_task *br_parallel_head, *br_parallel_tail;
+static unsigned br_parallel_workers;
+
+// removes the first queued task, or the first one of call if it isn't NULL; the lock has to be held
+static br_parallel_task *br_parallel_take(br_parallel_call *call)
+{
+    br_parallel_task **p = &br_parallel_head, *prev = NULL, *task;
+
+    while (*p && call && (*p)->call != call) {
+        prev = *p;
+        p = &prev->next;
+    }
+
+    task = *p;
+    if (! task) return NULL;
+    *p = task->next;
+    if (br_parallel_tail == task) br_parallel_tail = prev;
+    return task;
+}
+
+// runs task with the lock released and counts it done, the lock has to be held
+static void br_parallel_run(br_parallel_task *task)
+{
+    br_parallel_call *call = task->call;
+
+    pthread_mutex_unlock(&br_parallel_lock);
+    call->fn(call->info, task->chunk, task->first, task->count);
+    pthread_mutex_lock(&br_parallel_lock);
+    if (--call->pending == 0) pthread_cond_broadcast(&br_parallel_done); // task and call may be gone after this
+}
+
+static void *br_parallel_worker(void *arg)
+{
+    pthread_mutex_lock(&br_parallel_lock);
+
+    for (;;) {
+        br_parallel_task *task = br_parallel_take(NULL);
+
+        if (task) br_parallel_run(task);
+        else pthread_cond_wait(&br_parallel_work, &br_parallel_lock);
+    }
+
+    return NULL;
+}
+
+void br_parallel_for(size_t n, size_t grain, unsigned threads,
+                     void (*fn)(void *info, unsigned chunk, size_t first, size_t count), void *info)
+{
+    br_parallel_task task[BR_PARALLEL_MAX_THREADS];
+    br_parallel_call call = { fn, info, 0 };
+    pthread_attr_t attr;
+    pthread_t tid;
+    size_t chunk;
+    unsigned t;
+
+    if (grain < 1) grain = 1;
+    if (threads > BR_PARALLEL_MAX_THREADS) threads = BR_PARALLEL_MAX_THREADS;
+    if (threads > n/grain) threads = (unsigned)(n/grain);
+
+    if (threads <= 1) {
+        if (n > 0) fn(info, 0, 0, n);
+        return;
+    }
+
+    chunk = (n + threads - 1)/threads;
+    chunk = (chunk + grain - 1)/grain*grain; // only the last chunk can be short
+    threads = (unsigned)((n + chunk - 1)/chunk);
+
+    pthread_mutex_lock(&br_parallel_lock);
+
+    // the pool only grows, to one worker less than the most threads any call asked for
+    if (br_parallel_workers < threads - 1 && pthread_attr_init(&attr) == 0) {
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+        while (br_parallel_workers < threads - 1 && pthread_create(&tid, &attr, br_parallel_worker, NULL) == 0) {
+            br_parallel_workers++;
+        }
+
+        pthread_attr_destroy(&attr);
+    }
+
+    for (t = 1; t < threads; t++) {
+        task[t].next = NULL;
+        task[t].call = &call;
+        task[t].chunk = t;
+        task[t].first = t*chunk;
+        task[t].count = (n - t*chunk < chunk) ? n - t*chunk : chunk;
+        if (br_parallel_tail) br_parallel_tail->next = &task[t];
+        else br_parallel_head = &task[t];
+        br_parallel_tail = &task[t];
+        call.pending++;
+    }
+
+    pthread_cond_broadcast(&br_parallel_work);
+    pthread_mutex_unlock(&br_parallel_lock);
+
+    fn(info, 0, 0, chunk);
+
+    // chunks no worker has picked up yet are run here, so a call completes even if no worker could be started
+    pthread_mutex_lock(&br_parallel_lock);
+
+    while (call.pending > 0) {
+        br_parallel_task *own = br_parallel_take(&call);
+
+        if (own) br_parallel_run(own);
+        else pthread_cond_wait(&br_parallel_done, &br_parallel_lock);
+    }
+
+    pthread_mutex_unlock(&br_parallel_lock);
+}
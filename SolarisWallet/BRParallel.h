@@ -0,0 +1,38 @@
+//
+//  BRParallel.h
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRParallel_h
+#define BRParallel_h
+
+#include <stddef.h>
+
+#define BR_PARALLEL_MAX_THREADS 16 // upper bound on threads one call uses, the calling thread included
+
+// runs fn over items 0..n-1 split into up to threads chunks of whole multiples of grain items, returning when all of
+// them are done; chunk 0 runs on the calling thread and the others on a pool of worker threads that is started on
+// first use and kept for later calls; fn gets the chunk number, below threads, along with its first item and count
+void br_parallel_for(size_t n, size_t grain, unsigned threads,
+                     void (*fn)(void *info, unsigned chunk, size_t first, size_t count), void *info);
+
+#endif /* BRParallel_h */
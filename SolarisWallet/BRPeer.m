@@ -30,13 +30,14 @@
 #import "NSData+Bitcoin.h"
 #import "NSData+Dash.h"
 #import "Reachability.h"
+#import "xevan.h"
+#import "BRMessageFramer.h"
 #import <arpa/inet.h>
 
 #if ! PEER_LOGGING
 #define NSLog(...)
 #endif
 
-#define HEADER_LENGTH      24
 #define MAX_MSG_LENGTH     0x02000000
 #define MAX_GETDATA_HASHES 50000
 #define ENABLED_SERVICES   0     // we don't provide full blocks to remote nodes
@@ -60,7 +61,8 @@ typedef enum : uint32_t {
 @property (nonatomic, strong) dispatch_queue_t delegateQueue;
 @property (nonatomic, strong) NSInputStream *inputStream;
 @property (nonatomic, strong) NSOutputStream *outputStream;
-@property (nonatomic, strong) NSMutableData *msgHeader, *msgPayload, *outputBuffer;
+@property (nonatomic, strong) NSMutableData *outputBuffer;
+@property (nonatomic, assign) br_framer *framer; // frames the input stream into messages
 @property (nonatomic, assign) BOOL sentVerack, gotVerack;
 @property (nonatomic, assign) BOOL sentGetaddr, sentFilter, sentGetdata, sentMempool, sentGetblocks;
 @property (nonatomic, strong) Reachability *reachability;
@@ -74,8 +76,30 @@ typedef enum : uint32_t {
 @property (nonatomic, strong) void (^mempoolCompletion)(BOOL);
 @property (nonatomic, strong) NSRunLoop *runLoop;
 
+- (void)acceptMessage:(NSData *)message type:(NSString *)type;
+- (void)error:(NSString *)message, ... NS_FORMAT_FUNCTION(1,2);
+
 @end
 
+// hands a framed message to the peer, and stops the framer once the peer is disconnected
+static int BRPeerDeliver(void *info, const br_message *msg)
+{
+    BRPeer *peer = (__bridge BRPeer *)info;
+    uint8_t *payload = br_framer_detach(peer.framer); // messages outlive the payload view, so take the payload over
+
+    if (! payload && msg->length > 0) {
+        [peer error:@"error reading %@, out of memory for a %u byte payload", @(msg->type), msg->length];
+        return 0;
+    }
+
+    @autoreleasepool {
+        [peer acceptMessage:(payload) ? [NSData dataWithBytesNoCopy:payload length:msg->length freeWhenDone:YES] :
+         [NSData data] type:@(msg->type)];
+    }
+
+    return (peer.status != BRPeerStatusDisconnected);
+}
+
 @implementation BRPeer
 
 @dynamic host;
@@ -133,6 +157,7 @@ services:(uint64_t)services
     [self.reachability stopNotifier];
     if (self.reachabilityObserver) [[NSNotificationCenter defaultCenter] removeObserver:self.reachabilityObserver];
     [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    br_framer_free(self.framer);
 }
 
 - (void)setDelegate:(id<BRPeerDelegate>)delegate queue:(dispatch_queue_t)delegateQueue
@@ -185,8 +210,8 @@ services:(uint64_t)services
         self.reachabilityObserver = nil;
     }
 
-    self.msgHeader = [NSMutableData data];
-    self.msgPayload = [NSMutableData data];
+    br_framer_free(self.framer);
+    self.framer = br_framer_new(DASH_MAGIC_NUMBER);
     self.outputBuffer = [NSMutableData data];
     self.gotVerack = self.sentVerack = NO;
     self.sentFilter = self.sentGetaddr = self.sentGetdata = self.sentMempool = self.sentGetblocks = NO;
@@ -829,6 +854,17 @@ services:(uint64_t)services
     }
     NSLog(@"%@:%u got %u headers", self.host, self.port, (int)count);
 
+    // hash the whole message in one batch, the locators and the blocks below all pick their hash from here
+    // headers already seen, e.g. resent after a locator rebuild, come from the shared header hash cache
+    NSMutableData *hashData = [NSMutableData dataWithLength:count*sizeof(UInt256)];
+    const UInt256 *hashes = hashData.bytes;
+    uint64_t hits, misses;
+
+    xevan_hash_many_cached((const uint8_t *)message.bytes + l, 81, count, hashData.mutableBytes,
+                           (unsigned)[NSProcessInfo processInfo].activeProcessorCount);
+    xevan_cache_stats(&hits, &misses);
+    NSLog(@"%@:%u header hash cache: %llu hits, %llu misses", self.host, self.port, hits, misses);
+
     if (_relayStartTime != 0) { // keep track of relay peformance
         NSTimeInterval speed = count/([NSDate timeIntervalSinceReferenceDate] - self.relayStartTime);
         
@@ -840,10 +876,8 @@ services:(uint64_t)services
     // immediately, and switch to requesting blocks when we receive a header newer than earliestKeyTime
     NSTimeInterval t = [message UInt32AtOffset:l + 81*(count - 1) + 68] - NSTimeIntervalSince1970;
     if (count >= 2000 || t >= self.earliestKeyTime - (2*HOUR_TIME_INTERVAL + WEEK_TIME_INTERVAL)/4) {
-        UInt256 firstX11 = [message subdataWithRange:NSMakeRange(l, 80)].XEVAN;
-        UInt256 lastX11 = [message subdataWithRange:NSMakeRange(l + 81*(count - 1), 80)].XEVAN;
-        NSValue *firstHash = uint256_obj(firstX11);
-        NSValue *lastHash = uint256_obj(lastX11);
+        NSValue *firstHash = uint256_obj(hashes[0]);
+        NSValue *lastHash = uint256_obj(hashes[count - 1]);
 
         if (t >= self.earliestKeyTime - (2*HOUR_TIME_INTERVAL + WEEK_TIME_INTERVAL)/4) { // request blocks for the remainder of the chain
             t = [message UInt32AtOffset:l + 81 + 68] - NSTimeIntervalSince1970;
@@ -853,7 +887,7 @@ services:(uint64_t)services
                 t = [message UInt32AtOffset:off + 81 + 68] - NSTimeIntervalSince1970;
             }
 
-            lastHash = uint256_obj([message subdataWithRange:NSMakeRange(off, 80)].XEVAN);
+            lastHash = uint256_obj(hashes[(off - l)/81]);
             NSLog(@"%@:%u calling getblocks with locators: %@", self.host, self.port, @[lastHash, firstHash]);
             [self sendGetblocksMessageWithLocators:@[lastHash, firstHash] andHashStop:UINT256_ZERO];
         }
@@ -868,7 +902,8 @@ services:(uint64_t)services
         return;
     }
     for (NSUInteger off = l; off < l + 81*count; off += 81) {
-        BRMerkleBlock *block = [BRMerkleBlock blockWithMessage:[message subdataWithRange:NSMakeRange(off, 81)]];
+        BRMerkleBlock *block = [BRMerkleBlock blockWithMessage:[message subdataWithRange:NSMakeRange(off, 81)]
+                                                     blockHash:hashes[(off - l)/81]];
         if (! block.valid) {
             [self error:@"invalid block header %@", uint256_obj(block.blockHash)];
             return;
@@ -1154,78 +1189,46 @@ services:(uint64_t)services
             if (aStream != self.inputStream) return;
 
             while (self.inputStream.hasBytesAvailable) {
-                @autoreleasepool {
-                    NSData *message = nil;
-                    NSString *type = nil;
-                    NSInteger headerLen = self.msgHeader.length, payloadLen = self.msgPayload.length, l = 0;
-                    uint32_t length = 0, checksum = 0;
-                    
-                    if (headerLen < HEADER_LENGTH) { // read message header
-                        self.msgHeader.length = HEADER_LENGTH;
-                        l = [self.inputStream read:(uint8_t *)self.msgHeader.mutableBytes + headerLen
-                             maxLength:self.msgHeader.length - headerLen];
-                        
-                        if (l < 0) {
-                            NSLog(@"%@:%u error reading message", self.host, self.port);
-                            goto reset;
-                        }
-                        
-                        self.msgHeader.length = headerLen + l;
-                        
-                        // consume one byte at a time, up to the magic number that starts a new message header
-                        while (self.msgHeader.length >= sizeof(uint32_t) &&
-                               [self.msgHeader UInt32AtOffset:0] != DASH_MAGIC_NUMBER) {
-#if DEBUG
-                            printf("%c", *(const char *)self.msgHeader.bytes);
-#endif
-                            [self.msgHeader replaceBytesInRange:NSMakeRange(0, 1) withBytes:NULL length:0];
-                        }
-                        
-                        if (self.msgHeader.length < HEADER_LENGTH) continue; // wait for more stream input
-                    }
-                    
-                    if ([self.msgHeader UInt8AtOffset:15] != 0) { // verify msg type field is null terminated
-                        [self error:@"malformed message header: %@", self.msgHeader];
-                        goto reset;
-                    }
-                    
-                    type = @((const char *)self.msgHeader.bytes + 4);
-                    length = [self.msgHeader UInt32AtOffset:16];
-                    checksum = [self.msgHeader UInt32AtOffset:20];
-                    
-                    if (length > MAX_MSG_LENGTH) { // check message length
-                        [self error:@"error reading %@, message length %u is too long", type, length];
-                        goto reset;
-                    }
-                    
-                    if (payloadLen < length) { // read message payload
-                        self.msgPayload.length = length;
-                        l = [self.inputStream read:(uint8_t *)self.msgPayload.mutableBytes + payloadLen
-                             maxLength:self.msgPayload.length - payloadLen];
-                        
-                        if (l < 0) {
-                            NSLog(@"%@:%u error reading %@", self.host, self.port, type);
-                            goto reset;
-                        }
-                        
-                        self.msgPayload.length = payloadLen + l;
-                        if (self.msgPayload.length < length) continue; // wait for more stream input
-                    }
-                    
-                    if (CFSwapInt32LittleToHost(self.msgPayload.SHA256_2.u32[0]) != checksum) { // verify checksum
-                        [self error:@"error reading %@, invalid checksum %x, expected %x, payload length:%u, expected "
-                         "length:%u, SHA256_2:%@", type, self.msgPayload.SHA256_2.u32[0], checksum,
-                         (int)self.msgPayload.length, length, uint256_obj(self.msgPayload.SHA256_2)];
-                        goto reset;
-                    }
-                    
-                    message = self.msgPayload;
-                    self.msgPayload = [NSMutableData data];
-                    [self acceptMessage:message type:type]; // process message
-                    
-reset:              // reset for next message
-                    self.msgHeader.length = self.msgPayload.length = 0;
+                size_t space = 0;
+                uint8_t *buf = (self.framer) ? br_framer_buffer(self.framer, &space) : NULL;
+                NSInteger l = (buf) ? [self.inputStream read:buf maxLength:space] : -1;
+                br_framer_status status;
+                br_message msg;
+
+                if (l < 0) {
+                    NSLog(@"%@:%u error reading message", self.host, self.port);
+                    break;
                 }
+
+                br_framer_commit(self.framer, (size_t)l);
+
+                // the framer resyncs on the magic number, checks the header and has the payload hashed by the time it
+                // completes, so each framed message is ready to be accepted; it stops at the first bad header or
+                // checksum, and nothing buffered after it reaches the peer once it is disconnected
+                status = br_framer_drain(self.framer, &msg, BRPeerDeliver, (__bridge void *)self);
+
+                switch (status) {
+                    case BR_FRAMER_NEED_MORE:
+                        continue;
+
+                    case BR_FRAMER_ERROR_HEADER:
+                        [self error:@"malformed message header, type: %@", @(msg.type)];
+                        break;
+
+                    case BR_FRAMER_ERROR_LENGTH:
+                        [self error:@"error reading %@, message length %u is too long", @(msg.type), msg.length];
+                        break;
+
+                    case BR_FRAMER_ERROR_CHECKSUM:
+                        [self error:@"error reading %@, invalid checksum, expected %x, payload length:%u",
+                         @(msg.type), msg.checksum, msg.length];
+                        break;
+
+                    default: // a message disconnected the peer
+                        break;
+                }
+
+                return;
             }
 
             break;
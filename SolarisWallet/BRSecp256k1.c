@@ -0,0 +1,399 @@
+//
+//  BRSecp256k1.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#define USE_BASIC_CONFIG       1
+#define ENABLE_MODULE_RECOVERY 1
+#define DETERMINISTIC          1
+#if __BIG_ENDIAN__
+#define WORDS_BIGENDIAN        1
+#endif
+
+// with the tables generated ahead of time the first key operation no longer builds them, which takes several ms
+// generate them with: cd secp256k1 && ./autogen.sh && ./configure && make src/ecmult_static_context.h
+// ECMULT_WINDOW_SIZE and ECMULT_GEN_PREC_BITS pick the table sizes, see basic-config.h; configure them to match
+#if __has_include("secp256k1/src/ecmult_static_context.h")
+#define USE_ECMULT_STATIC_PRECOMPUTATION 1
+#endif
+
+#if __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wconversion"
+#pragma clang diagnostic ignored "-Wunused-function"
+#pragma clang diagnostic ignored "-Wconditional-uninitialized"
+#elif __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wnonnull-compare"
+#endif
+#include "secp256k1/src/basic-config.h"
+#include "secp256k1/src/secp256k1.c"
+#if __clang__
+#pragma clang diagnostic pop
+#elif __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+#include "BRSecp256k1.h"
+#include "BRParallel.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BR_SECP_MIN_CHUNK 4 // fewest items worth a thread of their own, a signature takes tens of microseconds
+
+struct br_secp_pool {
+    pthread_mutex_t lock;
+    pthread_cond_t cond; // signalled whenever a context is given back
+    secp256k1_context *tmpl; // private clone of the caller's context, never handed out
+    secp256k1_context *ctx[BR_SECP_POOL_MAX_CONTEXTS]; // the first count are cloned
+    unsigned uses[BR_SECP_POOL_MAX_CONTEXTS]; // operations since the context was last re-randomised
+    int busy[BR_SECP_POOL_MAX_CONTEXTS];
+    unsigned size, count, reseed;
+};
+
+// fills seed with 32 bytes from the system's random source, returns 0 if none could be read
+static int br_secp_entropy(uint8_t *seed)
+{
+#if __APPLE__
+    arc4random_buf(seed, 32);
+    return 1;
+#else
+    FILE *f = fopen("/dev/urandom", "rb");
+    int ok = (f && fread(seed, 1, 32, f) == 32);
+
+    if (f) fclose(f);
+    return ok;
+#endif
+}
+
+// replaces the blinding of ctx, which the caller must hold exclusively
+// returns 0 if it kept the old one because no entropy was available
+static int br_secp_randomize(secp256k1_context *ctx)
+{
+    uint8_t seed[32];
+    int r = (br_secp_entropy(seed) && secp256k1_context_randomize(ctx, seed));
+
+    memset(seed, 0, sizeof(seed));
+    return r;
+}
+
+br_secp_pool *br_secp_pool_new(const secp256k1_context *tmpl, unsigned size, unsigned reseed_uses)
+{
+    br_secp_pool *pool = calloc(1, sizeof(*pool));
+
+    if (! pool) return NULL;
+
+    if (size == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+        size = (cpus > 0) ? (unsigned)cpus : 1;
+    }
+
+    pool->size = (size < BR_SECP_POOL_MAX_CONTEXTS) ? size : BR_SECP_POOL_MAX_CONTEXTS;
+    pool->reseed = (reseed_uses) ? reseed_uses : BR_SECP_POOL_RESEED_USES;
+    pool->tmpl = secp256k1_context_clone(tmpl);
+
+    if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+        secp256k1_context_destroy(pool->tmpl);
+        free(pool);
+        return NULL;
+    }
+
+    if (pthread_cond_init(&pool->cond, NULL) != 0) {
+        pthread_mutex_destroy(&pool->lock);
+        secp256k1_context_destroy(pool->tmpl);
+        free(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+void br_secp_pool_free(br_secp_pool *pool)
+{
+    if (! pool) return;
+    for (unsigned i = 0; i < pool->count; i++) secp256k1_context_destroy(pool->ctx[i]);
+    secp256k1_context_destroy(pool->tmpl);
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+unsigned br_secp_pool_size(const br_secp_pool *pool)
+{
+    return pool->size;
+}
+
+// takes a free context, cloning another while the pool is below its size and waiting otherwise
+// returns its slot, or -1 if a clone was needed and could not be made
+static int br_secp_pool_take(br_secp_pool *pool)
+{
+    int slot = -1, fresh = 0;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (slot < 0) {
+        for (unsigned i = 0; slot < 0 && i < pool->count; i++) {
+            if (! pool->busy[i]) slot = (int)i;
+        }
+
+        if (slot < 0 && pool->count < pool->size) {
+            // cloning under the lock keeps slots dense, it happens at most size times per pool
+            secp256k1_context *ctx = secp256k1_context_clone(pool->tmpl);
+
+            if (! ctx) break;
+            slot = (int)pool->count++;
+            pool->ctx[slot] = ctx;
+            fresh = 1;
+        }
+
+        if (slot < 0) pthread_cond_wait(&pool->cond, &pool->lock);
+    }
+
+    if (slot >= 0) pool->busy[slot] = 1;
+    pthread_mutex_unlock(&pool->lock);
+
+    // a clone shares the template's blinding, give every context its own before it touches a secret
+    if (fresh) br_secp_randomize(pool->ctx[slot]);
+    return slot;
+}
+
+// counts one use of the context in slot, re-randomising it when due; only its holder may call this
+static void br_secp_pool_use(br_secp_pool *pool, int slot)
+{
+    if (++pool->uses[slot] < pool->reseed) return;
+    br_secp_randomize(pool->ctx[slot]);
+    pool->uses[slot] = 0;
+}
+
+static void br_secp_pool_give(br_secp_pool *pool, int slot)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->busy[slot] = 0;
+    pthread_cond_signal(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+secp256k1_context *br_secp_pool_acquire(br_secp_pool *pool)
+{
+    int slot = br_secp_pool_take(pool);
+
+    return (slot >= 0) ? pool->ctx[slot] : NULL;
+}
+
+void br_secp_pool_release(br_secp_pool *pool, secp256k1_context *ctx)
+{
+    unsigned i = 0, count;
+
+    pthread_mutex_lock(&pool->lock);
+    count = pool->count;
+    pthread_mutex_unlock(&pool->lock);
+    while (i < count && pool->ctx[i] != ctx) i++; // slots below count never change
+    if (i == count) return;
+    br_secp_pool_use(pool, (int)i);
+    br_secp_pool_give(pool, (int)i);
+}
+
+typedef struct br_secp_batch br_secp_batch;
+
+struct br_secp_batch {
+    br_secp_pool *pool;
+    int (*op)(const secp256k1_context *ctx, const br_secp_batch *batch, size_t i); // runs item i, 0 on failure
+    void (*fail)(const br_secp_batch *batch, size_t i); // zeroes the outputs of item i
+    uint8_t *out;
+    size_t *outlens;
+    const uint8_t *in, *in2;
+    int flag;
+};
+
+typedef struct {
+    const br_secp_batch *batch;
+    size_t ok[BR_PARALLEL_MAX_THREADS]; // items that succeeded, by chunk
+} br_secp_batch_job;
+
+// runs one chunk of items on a context of its own
+static void br_secp_batch_chunk(void *info, unsigned chunk, size_t first, size_t count)
+{
+    br_secp_batch_job *job = info;
+    const br_secp_batch *batch = job->batch;
+    int slot = br_secp_pool_take(batch->pool);
+
+    job->ok[chunk] = 0;
+
+    for (size_t i = first; i < first + count; i++) {
+        if (slot >= 0 && batch->op(batch->pool->ctx[slot], batch, i)) job->ok[chunk]++;
+        else batch->fail(batch, i);
+        if (slot >= 0) br_secp_pool_use(batch->pool, slot);
+    }
+
+    if (slot >= 0) br_secp_pool_give(batch->pool, slot);
+}
+
+static size_t br_secp_batch_run(const br_secp_batch *batch, size_t n)
+{
+    br_secp_batch_job job = { batch, { 0 } };
+    size_t ok = 0;
+
+    br_parallel_for(n, BR_SECP_MIN_CHUNK, batch->pool->size, br_secp_batch_chunk, &job);
+    for (unsigned t = 0; t < BR_PARALLEL_MAX_THREADS; t++) ok += job.ok[t];
+    return ok;
+}
+
+static int br_secp_sign_op(const secp256k1_context *ctx, const br_secp_batch *batch, size_t i)
+{
+    secp256k1_ecdsa_signature s;
+
+    batch->outlens[i] = BR_SECP_DER_SIG_MAX;
+    return (secp256k1_ecdsa_sign(ctx, &s, batch->in + i*32, batch->in2 + i*32, secp256k1_nonce_function_rfc6979,
+                                 NULL) &&
+            secp256k1_ecdsa_signature_serialize_der(ctx, batch->out + i*BR_SECP_DER_SIG_MAX, &batch->outlens[i], &s));
+}
+
+static void br_secp_sign_fail(const br_secp_batch *batch, size_t i)
+{
+    memset(batch->out + i*BR_SECP_DER_SIG_MAX, 0, BR_SECP_DER_SIG_MAX);
+    batch->outlens[i] = 0;
+}
+
+size_t br_secp_pool_sign(br_secp_pool *pool, uint8_t *sigs, size_t *siglens, const uint8_t *md32s,
+                         const uint8_t *seckeys, size_t n)
+{
+    br_secp_batch batch = { pool, br_secp_sign_op, br_secp_sign_fail, sigs, siglens, md32s, seckeys, 0 };
+
+    return br_secp_batch_run(&batch, n);
+}
+
+static int br_secp_pubkey_create_op(const secp256k1_context *ctx, const br_secp_batch *batch, size_t i)
+{
+    secp256k1_pubkey pk;
+    size_t len = (batch->flag) ? 33 : 65;
+
+    return (secp256k1_ec_pubkey_create(ctx, &pk, batch->in + i*32) &&
+            secp256k1_ec_pubkey_serialize(ctx, batch->out + i*len, &len, &pk,
+                                          (batch->flag) ? SECP256K1_EC_COMPRESSED : SECP256K1_EC_UNCOMPRESSED));
+}
+
+static void br_secp_pubkey_create_fail(const br_secp_batch *batch, size_t i)
+{
+    size_t len = (batch->flag) ? 33 : 65;
+
+    memset(batch->out + i*len, 0, len);
+}
+
+size_t br_secp_pool_pubkey_create(br_secp_pool *pool, uint8_t *pubkeys, int compressed, const uint8_t *seckeys,
+                                  size_t n)
+{
+    br_secp_batch batch = { pool, br_secp_pubkey_create_op, br_secp_pubkey_create_fail, pubkeys, NULL, seckeys, NULL,
+                            (compressed != 0) };
+
+    return br_secp_batch_run(&batch, n);
+}
+
+static int br_secp_privkey_tweak_add_op(const secp256k1_context *ctx, const br_secp_batch *batch, size_t i)
+{
+    // tweak_add takes a zero key, which BIP32 derivation must not turn into a valid one
+    return (secp256k1_ec_seckey_verify(ctx, batch->out + i*32) &&
+            secp256k1_ec_privkey_tweak_add(ctx, batch->out + i*32, batch->in + i*32));
+}
+
+static void br_secp_privkey_tweak_add_fail(const br_secp_batch *batch, size_t i)
+{
+    memset(batch->out + i*32, 0, 32);
+}
+
+size_t br_secp_pool_privkey_tweak_add(br_secp_pool *pool, uint8_t *seckeys, const uint8_t *tweaks, size_t n)
+{
+    br_secp_batch batch = { pool, br_secp_privkey_tweak_add_op, br_secp_privkey_tweak_add_fail, seckeys, NULL, tweaks,
+                            NULL, 0 };
+
+    return br_secp_batch_run(&batch, n);
+}
+
+static int br_secp_pubkey_tweak_add_op(const secp256k1_context *ctx, const br_secp_batch *batch, size_t i)
+{
+    secp256k1_pubkey pk;
+    size_t len = 33;
+
+    return (secp256k1_ec_pubkey_parse(ctx, &pk, batch->out + i*33, 33) &&
+            secp256k1_ec_pubkey_tweak_add(ctx, &pk, batch->in + i*32) &&
+            secp256k1_ec_pubkey_serialize(ctx, batch->out + i*33, &len, &pk, SECP256K1_EC_COMPRESSED));
+}
+
+static void br_secp_pubkey_tweak_add_fail(const br_secp_batch *batch, size_t i)
+{
+    memset(batch->out + i*33, 0, 33);
+}
+
+size_t br_secp_pool_pubkey_tweak_add(br_secp_pool *pool, uint8_t *pubkeys, const uint8_t *tweaks, size_t n)
+{
+    br_secp_batch batch = { pool, br_secp_pubkey_tweak_add_op, br_secp_pubkey_tweak_add_fail, pubkeys, NULL, tweaks,
+                            NULL, 0 };
+
+    return br_secp_batch_run(&batch, n);
+}
+
+size_t br_secp_pubkey_tweak_add_all(const secp256k1_context *ctx, uint8_t *pubkeys, const uint8_t *pubkey,
+                                    const uint8_t *tweaks, size_t n)
+{
+    secp256k1_gej *sums = malloc((n + 1)*sizeof(*sums));
+    secp256k1_ge *points = malloc((n + 1)*sizeof(*points)), base;
+    size_t ok = 0;
+
+    memset(pubkeys, 0, n*33);
+
+    if (sums && points && secp256k1_ecmult_gen_context_is_built(&ctx->ecmult_gen_ctx) &&
+        secp256k1_eckey_pubkey_parse(&base, pubkey, 33)) {
+        for (size_t i = 0; i < n; i++) {
+            secp256k1_scalar t;
+            int overflow = 0;
+
+            secp256k1_scalar_set_b32(&t, tweaks + i*32, &overflow);
+
+            if (overflow) secp256k1_gej_set_infinity(&sums[i]);
+            else {
+                secp256k1_ecmult_gen(&ctx->ecmult_gen_ctx, &sums[i], &t);
+                secp256k1_gej_add_ge_var(&sums[i], &sums[i], &base, NULL);
+            }
+
+            secp256k1_scalar_clear(&t);
+        }
+
+        // one field inversion for all of the sums instead of one each
+        secp256k1_ge_set_all_gej_var(points, sums, n, &ctx->error_callback);
+
+        for (size_t i = 0; i < n; i++) {
+            size_t len = 33;
+
+            if (! secp256k1_ge_is_infinity(&points[i]) &&
+                secp256k1_eckey_pubkey_serialize(&points[i], pubkeys + i*33, &len, 1)) ok++;
+        }
+    }
+
+    free(sums);
+    free(points);
+    return ok;
+}
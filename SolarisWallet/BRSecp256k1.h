@@ -0,0 +1,83 @@
+//
+//  BRSecp256k1.h
+//  SolarisWallet
+//
+//  libsecp256k1 built into the app, with a pool of contexts for signing on several threads.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRSecp256k1_h
+#define BRSecp256k1_h
+
+#include "secp256k1/include/secp256k1.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BR_SECP_POOL_MAX_CONTEXTS 16 // upper bound on contexts, and so on threads, in one pool
+#define BR_SECP_POOL_RESEED_USES  64 // default number of operations between re-randomisations of a context
+#define BR_SECP_DER_SIG_MAX       72 // longest DER signature br_secp_pool_sign() writes
+
+typedef struct br_secp_pool br_secp_pool;
+
+// returns a pool of up to size contexts cloned from tmpl, which must be a SIGN | VERIFY context; NULL if out of memory
+// size 0 means one per online cpu, reseed_uses 0 means BR_SECP_POOL_RESEED_USES; contexts are cloned when first needed
+// tmpl is only read during the call, it may be used or destroyed afterwards
+br_secp_pool *br_secp_pool_new(const secp256k1_context *tmpl, unsigned size, unsigned reseed_uses);
+
+// destroys the pool and its contexts, none of which may still be acquired
+void br_secp_pool_free(br_secp_pool *pool);
+
+// the number of contexts, and so of threads, the batch calls below use at most
+unsigned br_secp_pool_size(const br_secp_pool *pool);
+
+// returns a context for the calling thread's exclusive use, waiting while all of them are taken; NULL if out of memory
+secp256k1_context *br_secp_pool_acquire(br_secp_pool *pool);
+
+// gives back a context from br_secp_pool_acquire(), counting one use of it
+void br_secp_pool_release(br_secp_pool *pool, secp256k1_context *ctx);
+
+// the batch calls split items i = 0..n-1 over the pool's contexts and threads, and return how many succeeded
+// a failed item, from an invalid key or tweak, has its output zeroed
+
+// signs the 32 byte digest md32s + i*32 with the secret key seckeys + i*32 (rfc6979 nonce, low s)
+// the DER signature is written to sigs + i*BR_SECP_DER_SIG_MAX and its length to siglens[i]
+size_t br_secp_pool_sign(br_secp_pool *pool, uint8_t *sigs, size_t *siglens, const uint8_t *md32s,
+                         const uint8_t *seckeys, size_t n);
+
+// writes the public key of seckeys + i*32 to pubkeys + i*33 if compressed, otherwise to pubkeys + i*65
+size_t br_secp_pool_pubkey_create(br_secp_pool *pool, uint8_t *pubkeys, int compressed, const uint8_t *seckeys,
+                                  size_t n);
+
+// adds tweaks + i*32 to the secret key seckeys + i*32 (mod the group order), in place
+size_t br_secp_pool_privkey_tweak_add(br_secp_pool *pool, uint8_t *seckeys, const uint8_t *tweaks, size_t n);
+
+// adds tweaks + i*32 times the generator to the compressed public key pubkeys + i*33, in place
+size_t br_secp_pool_pubkey_tweak_add(br_secp_pool *pool, uint8_t *pubkeys, const uint8_t *tweaks, size_t n);
+
+// writes tweaks + i*32 times the generator plus the compressed public key pubkey to pubkeys + i*33, in the calling
+// thread on ctx, which must be able to sign; the n sums are brought to affine coordinates together, at the cost of a
+// single field inversion; returns how many succeeded, a failed item, from a tweak not below the group order or a sum
+// at infinity, has its output zeroed, and all of them are if pubkey is invalid or memory runs out
+size_t br_secp_pubkey_tweak_add_all(const secp256k1_context *ctx, uint8_t *pubkeys, const uint8_t *pubkey,
+                                    const uint8_t *tweaks, size_t n);
+
+#endif /* BRSecp256k1_h */
@@ -0,0 +1,393 @@
+//
+//  BRSha256.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRSha256.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BR_SHA256_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#define BR_SHANI __attribute__((target("sha,sse4.1")))
+#define BR_AVX2  __attribute__((target("avx2")))
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2))
+#define BR_SHA256_ARMV8 1
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+typedef void (*br_sha256_blocks)(uint32_t *s, const uint8_t *blocks, size_t n);
+typedef void (*br_sha256_d64)(uint8_t *out, const uint8_t *in, size_t n);
+
+#define BR_SHA256_SHANI 1
+#define BR_SHA256_AVX2  2
+#define BR_SHA256_ARM   4
+
+static void br_sha256_generic(uint32_t *s, const uint8_t *blocks, size_t n);
+
+static br_sha256_blocks _blocks = br_sha256_generic;
+static br_sha256_d64 _d64 = NULL; // NULL runs _blocks one input at a time
+static const char *_impl = "generic";
+static pthread_once_t _once = PTHREAD_ONCE_INIT;
+
+static const uint32_t br_sha256_iv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+static const uint32_t br_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+// the second block of a 64 byte message, and the block of a 32 byte one after its first 32 bytes
+static const uint8_t br_sha256_pad64[64] = { 0x80, [62] = 0x02 }, br_sha256_pad32[32] = { 0x80, [30] = 0x01 };
+
+static uint32_t br_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void br_set_be32(uint8_t *p, uint32_t x)
+{
+    p[0] = (uint8_t)(x >> 24), p[1] = (uint8_t)(x >> 16), p[2] = (uint8_t)(x >> 8), p[3] = (uint8_t)x;
+}
+
+#define br_ror32(a, b) (((a) >> (b)) | ((a) << (32 - (b))))
+
+static void br_sha256_generic(uint32_t *s, const uint8_t *blocks, size_t n)
+{
+    for (; n > 0; n--, blocks += 64) {
+        uint32_t a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7], t1, t2, w[64];
+        size_t i;
+
+        for (i = 0; i < 16; i++) w[i] = br_be32(blocks + 4*i);
+
+        for (; i < 64; i++) {
+            w[i] = (br_ror32(w[i - 2], 17) ^ br_ror32(w[i - 2], 19) ^ (w[i - 2] >> 10)) + w[i - 7] +
+                   (br_ror32(w[i - 15], 7) ^ br_ror32(w[i - 15], 18) ^ (w[i - 15] >> 3)) + w[i - 16];
+        }
+
+        for (i = 0; i < 64; i++) {
+            t1 = h + (br_ror32(e, 6) ^ br_ror32(e, 11) ^ br_ror32(e, 25)) + ((e & f) ^ (~e & g)) + br_sha256_k[i] + w[i];
+            t2 = (br_ror32(a, 2) ^ br_ror32(a, 13) ^ br_ror32(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g, g = f, f = e, e = d + t1, d = c, c = b, b = a, a = t1 + t2;
+        }
+
+        s[0] += a, s[1] += b, s[2] += c, s[3] += d, s[4] += e, s[5] += f, s[6] += g, s[7] += h;
+    }
+}
+
+#if BR_SHA256_X86
+// four rounds at a time; the state is kept as the word pairs ABEF and CDGH, the order sha256rnds2 takes them in
+BR_SHANI static void br_sha256_shani(uint32_t *s, const uint8_t *blocks, size_t n)
+{
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+    __m128i t = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)s), 0xb1), // CDAB
+            state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(s + 4)), 0x1b), // EFGH
+            state0 = _mm_alignr_epi8(t, state1, 8); // ABEF
+
+    state1 = _mm_blend_epi16(state1, t, 0xf0); // CDGH
+
+    for (; n > 0; n--, blocks += 64) {
+        __m128i abef = state0, cdgh = state1, m[4];
+
+        for (int i = 0; i < 16; i++) {
+            if (i < 4) m[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks + 16*i)), bswap);
+            else { // m holds w[i - 4] to w[i - 1] in groups of four, the oldest at i % 4
+                t = _mm_add_epi32(_mm_sha256msg1_epu32(m[i % 4], m[(i + 1) % 4]),
+                                  _mm_alignr_epi8(m[(i + 3) % 4], m[(i + 2) % 4], 4));
+                m[i % 4] = _mm_sha256msg2_epu32(t, m[(i + 3) % 4]);
+            }
+
+            t = _mm_add_epi32(m[i % 4], _mm_loadu_si128((const __m128i *)(br_sha256_k + 4*i)));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, t);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(t, 0x0e));
+        }
+
+        state0 = _mm_add_epi32(state0, abef);
+        state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    t = _mm_shuffle_epi32(state0, 0x1b); // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xb1); // DCHG
+    _mm_storeu_si128((__m128i *)s, _mm_blend_epi16(t, state1, 0xf0)); // DCBA
+    _mm_storeu_si128((__m128i *)(s + 4), _mm_alignr_epi8(state1, t, 8)); // HGFE
+}
+
+BR_AVX2 static inline __m256i br_ror8x(__m256i x, int n)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+// the block function on eight independent states, a lane each; w is the message schedule, which is overwritten
+BR_AVX2 static void br_sha256_x8(__m256i *s, __m256i *w)
+{
+    __m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7], t1, t2, x, y;
+
+    for (int i = 0; i < 64; i++) {
+        if (i >= 16) {
+            x = w[(i - 15) & 15];
+            y = w[(i - 2) & 15];
+            x = _mm256_xor_si256(_mm256_xor_si256(br_ror8x(x, 7), br_ror8x(x, 18)), _mm256_srli_epi32(x, 3));
+            y = _mm256_xor_si256(_mm256_xor_si256(br_ror8x(y, 17), br_ror8x(y, 19)), _mm256_srli_epi32(y, 10));
+            w[i & 15] = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], x), _mm256_add_epi32(w[(i - 7) & 15], y));
+        }
+
+        t1 = _mm256_xor_si256(_mm256_xor_si256(br_ror8x(e, 6), br_ror8x(e, 11)), br_ror8x(e, 25));
+        t1 = _mm256_add_epi32(_mm256_add_epi32(h, t1), _mm256_xor_si256(_mm256_and_si256(e, f),
+                                                                         _mm256_andnot_si256(e, g)));
+        t1 = _mm256_add_epi32(t1, _mm256_add_epi32(_mm256_set1_epi32((int)br_sha256_k[i]), w[i & 15]));
+        t2 = _mm256_xor_si256(_mm256_xor_si256(br_ror8x(a, 2), br_ror8x(a, 13)), br_ror8x(a, 22));
+        x = _mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_xor_si256(a, b))); // maj(a, b, c)
+        t2 = _mm256_add_epi32(t2, x);
+        h = g, g = f, f = e, e = _mm256_add_epi32(d, t1), d = c, c = b, b = a, a = _mm256_add_epi32(t1, t2);
+    }
+
+    s[0] = _mm256_add_epi32(s[0], a), s[1] = _mm256_add_epi32(s[1], b);
+    s[2] = _mm256_add_epi32(s[2], c), s[3] = _mm256_add_epi32(s[3], d);
+    s[4] = _mm256_add_epi32(s[4], e), s[5] = _mm256_add_epi32(s[5], f);
+    s[6] = _mm256_add_epi32(s[6], g), s[7] = _mm256_add_epi32(s[7], h);
+}
+
+static void br_sha256d64_blocks(br_sha256_blocks blocks, uint8_t *out, const uint8_t *in, size_t n);
+
+// eight inputs at a time, the rest one by one with the block function in use
+BR_AVX2 static void br_sha256d64_avx2(uint8_t *out, const uint8_t *in, size_t n)
+{
+    for (; n >= 8; n -= 8, in += 8*64, out += 8*32) {
+        __m256i s[8], w[16];
+        uint32_t lanes[8];
+
+        for (int j = 0; j < 8; j++) s[j] = _mm256_set1_epi32((int)br_sha256_iv[j]);
+
+        for (int j = 0; j < 16; j++) {
+            w[j] = _mm256_setr_epi32((int)br_be32(in + 4*j), (int)br_be32(in + 64 + 4*j), (int)br_be32(in + 128 + 4*j),
+                                     (int)br_be32(in + 192 + 4*j), (int)br_be32(in + 256 + 4*j),
+                                     (int)br_be32(in + 320 + 4*j), (int)br_be32(in + 384 + 4*j),
+                                     (int)br_be32(in + 448 + 4*j));
+        }
+
+        br_sha256_x8(s, w);
+        for (int j = 0; j < 16; j++) w[j] = _mm256_set1_epi32((int)br_be32(br_sha256_pad64 + 4*j));
+        br_sha256_x8(s, w);
+
+        for (int j = 0; j < 8; j++) { // the second hash, of the 32 byte first one
+            w[j] = s[j];
+            w[j + 8] = _mm256_set1_epi32((int)br_be32(br_sha256_pad32 + 4*j));
+            s[j] = _mm256_set1_epi32((int)br_sha256_iv[j]);
+        }
+
+        br_sha256_x8(s, w);
+
+        for (int j = 0; j < 8; j++) {
+            _mm256_storeu_si256((__m256i *)lanes, s[j]);
+            for (int l = 0; l < 8; l++) br_set_be32(out + l*32 + 4*j, lanes[l]);
+        }
+    }
+
+    br_sha256d64_blocks(_blocks, out, in, n);
+}
+
+// BR_SHA256_SHANI if the cpu has the sha extensions, BR_SHA256_AVX2 if it has avx2 the os saves the registers of
+static int br_sha256_x86_features(void)
+{
+    unsigned a, b, c, d, lo = 0, hi = 0;
+    int ssse3_sse41 = 0, avx = 0, r = 0;
+
+    if (__get_cpuid(1, &a, &b, &c, &d)) {
+        ssse3_sse41 = (c & (1u << 9)) && (c & (1u << 19));
+
+        if ((c & (1u << 27)) && (c & (1u << 28))) { // osxsave and avx, then ask whether ymm state is saved
+            __asm__ ("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+            avx = ((lo & 6) == 6);
+        }
+    }
+
+    if (__get_cpuid_count(7, 0, &a, &b, &c, &d)) {
+        if (ssse3_sse41 && (b & (1u << 29))) r |= BR_SHA256_SHANI;
+        if (avx && (b & (1u << 5))) r |= BR_SHA256_AVX2;
+    }
+
+    (void)hi;
+    return r;
+}
+#endif
+
+#if BR_SHA256_ARMV8
+// four rounds at a time on the state as the word quads ABCD and EFGH
+static void br_sha256_armv8(uint32_t *s, const uint8_t *blocks, size_t n)
+{
+    uint32x4_t state0 = vld1q_u32(s), state1 = vld1q_u32(s + 4);
+
+    for (; n > 0; n--, blocks += 64) {
+        uint32x4_t abcd = state0, efgh = state1, m[4], t, prev;
+
+        for (int i = 0; i < 16; i++) {
+            if (i < 4) m[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16*i)));
+            else { // m holds w[i - 4] to w[i - 1] in groups of four, the oldest at i % 4
+                m[i % 4] = vsha256su1q_u32(vsha256su0q_u32(m[i % 4], m[(i + 1) % 4]), m[(i + 2) % 4], m[(i + 3) % 4]);
+            }
+
+            t = vaddq_u32(m[i % 4], vld1q_u32(br_sha256_k + 4*i));
+            prev = state0;
+            state0 = vsha256hq_u32(state0, state1, t);
+            state1 = vsha256h2q_u32(state1, prev, t);
+        }
+
+        state0 = vaddq_u32(state0, abcd);
+        state1 = vaddq_u32(state1, efgh);
+    }
+
+    vst1q_u32(s, state0);
+    vst1q_u32(s + 4, state1);
+}
+
+static int br_sha256_armv8_available(void)
+{
+#if defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+    return 1; // built for a cpu with the sha2 instructions
+#endif
+}
+#endif
+
+// the double hash of each input with the given block function, one at a time
+static void br_sha256d64_blocks(br_sha256_blocks blocks, uint8_t *out, const uint8_t *in, size_t n)
+{
+    for (; n > 0; n--, in += 64, out += 32) {
+        uint32_t s[8];
+        uint8_t b[64];
+
+        memcpy(s, br_sha256_iv, sizeof(s));
+        blocks(s, in, 1);
+        blocks(s, br_sha256_pad64, 1);
+        for (int j = 0; j < 8; j++) br_set_be32(b + 4*j, s[j]);
+        memcpy(b + 32, br_sha256_pad32, sizeof(br_sha256_pad32));
+        memcpy(s, br_sha256_iv, sizeof(s));
+        blocks(s, b, 1);
+        for (int j = 0; j < 8; j++) br_set_be32(out + 4*j, s[j]);
+    }
+}
+
+// in order of preference; eight avx2 lanes double hash faster than the sha extensions one input at a time
+static const struct {
+    const char *name;
+    int needs;
+    br_sha256_blocks blocks;
+    br_sha256_d64 d64;
+} br_sha256_impls[] = {
+#if BR_SHA256_X86
+    { "shani+avx2", BR_SHA256_SHANI | BR_SHA256_AVX2, br_sha256_shani, br_sha256d64_avx2 },
+    { "shani", BR_SHA256_SHANI, br_sha256_shani, NULL },
+    { "avx2", BR_SHA256_AVX2, br_sha256_generic, br_sha256d64_avx2 },
+#elif BR_SHA256_ARMV8
+    { "armv8", BR_SHA256_ARM, br_sha256_armv8, NULL },
+#endif
+    { "generic", 0, br_sha256_generic, NULL }
+};
+
+static int br_sha256_features(void)
+{
+#if BR_SHA256_X86
+    return br_sha256_x86_features();
+#elif BR_SHA256_ARMV8
+    return (br_sha256_armv8_available()) ? BR_SHA256_ARM : 0;
+#else
+    return 0;
+#endif
+}
+
+static int br_sha256_use(const char *impl)
+{
+    int features = br_sha256_features();
+
+    for (size_t i = 0; i < sizeof(br_sha256_impls)/sizeof(*br_sha256_impls); i++) {
+        if (impl && strcmp(impl, br_sha256_impls[i].name) != 0) continue;
+        if ((features & br_sha256_impls[i].needs) != br_sha256_impls[i].needs) continue;
+        _blocks = br_sha256_impls[i].blocks, _d64 = br_sha256_impls[i].d64, _impl = br_sha256_impls[i].name;
+        return 1;
+    }
+
+    return 0;
+}
+
+static void br_sha256_best(void)
+{
+    br_sha256_use(NULL);
+}
+
+void br_sha256_transform(uint32_t *s, const uint8_t *blocks, size_t n)
+{
+    pthread_once(&_once, br_sha256_best);
+    _blocks(s, blocks, n);
+}
+
+void br_sha256(uint8_t *md, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    uint32_t s[8];
+    uint8_t b[128];
+    size_t full = len/64, rest = len % 64, padded = (rest < 56) ? 64 : 128;
+
+    pthread_once(&_once, br_sha256_best);
+    memcpy(s, br_sha256_iv, sizeof(s));
+    if (full > 0) _blocks(s, p, full);
+    memset(b, 0, padded);
+    if (rest > 0) memcpy(b, p + full*64, rest);
+    b[rest] = 0x80;
+    for (int j = 0; j < 8; j++) b[padded - 1 - j] = (uint8_t)((uint64_t)len*8 >> 8*j); // length in bits
+    _blocks(s, b, padded/64);
+    for (int j = 0; j < 8; j++) br_set_be32(md + 4*j, s[j]);
+}
+
+void br_sha256d64(uint8_t *out, const uint8_t *in, size_t n)
+{
+    pthread_once(&_once, br_sha256_best);
+    if (_d64) _d64(out, in, n);
+    else br_sha256d64_blocks(_blocks, out, in, n);
+}
+
+const char *br_sha256_impl(void)
+{
+    pthread_once(&_once, br_sha256_best);
+    return _impl;
+}
+
+int br_sha256_select(const char *impl)
+{
+    pthread_once(&_once, br_sha256_best); // so the first hash does not replace the choice
+    return br_sha256_use(impl);
+}
@@ -0,0 +1,51 @@
+//
+//  BRSha256.h
+//  SolarisWallet
+//
+//  SHA-256 on the cpu's sha instructions where it has them, and double SHA-256 of many 64 byte inputs
+//  at once for merkle tree levels.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRSha256_h
+#define BRSha256_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// writes the sha256 of the len bytes at data to the 32 bytes at md
+void br_sha256(uint8_t *md, const void *data, size_t len);
+
+// writes the sha256 of the sha256 of each of the n 64 byte inputs at in to out + i*32, out may be in
+void br_sha256d64(uint8_t *out, const uint8_t *in, size_t n);
+
+// runs the block function over n 64 byte blocks, updating the eight word state s
+void br_sha256_transform(uint32_t *s, const uint8_t *blocks, size_t n);
+
+// the implementation in use: "generic", "shani", "avx2" (generic blocks, eight lane br_sha256d64), "shani+avx2" or
+// "armv8"
+const char *br_sha256_impl(void);
+
+// switches to the named implementation, or with NULL back to the best one, for tests and benchmarks while no other
+// thread hashes; returns 0 if it is not available on this cpu
+int br_sha256_select(const char *impl);
+
+#endif /* BRSha256_h */
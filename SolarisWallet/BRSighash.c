@@ -0,0 +1,248 @@
+//
+//  BRSighash.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRSighash.h"
+#include "BRParallel.h"
+#include "sph/sph_sha2.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BR_SIGHASH_MIN_BYTES   0x10000 // least hashing worth a thread of its own
+
+typedef struct {
+    size_t pos; // offset of the input's empty script length in buf
+    size_t script_off, script_len; // its script in scripts, script_off is SIZE_MAX without one
+    sph_sha256_context mid; // sha256 of buf up to pos, set by br_sighash_end()
+} br_sighash_input;
+
+struct br_sighash {
+    uint8_t *buf; // the unsigned transaction with every input script empty
+    size_t len, cap;
+    uint8_t *scripts;
+    size_t scripts_len, scripts_cap;
+    br_sighash_input *in;
+    size_t in_count, in_cap, inputs, outputs, out_count;
+};
+
+br_sighash *br_sighash_new(void)
+{
+    return calloc(1, sizeof(br_sighash));
+}
+
+void br_sighash_free(br_sighash *sh)
+{
+    if (! sh) return;
+    free(sh->buf);
+    free(sh->scripts);
+    free(sh->in);
+    free(sh);
+}
+
+// makes room for more bytes after the len used ones, doubling the buffer as needed
+static int br_sighash_reserve(uint8_t **buf, size_t *cap, size_t len, size_t more)
+{
+    size_t c = (*cap) ? *cap : 0x1000;
+    uint8_t *b;
+
+    if (len + more <= *cap) return 1;
+    while (c < len + more) c *= 2;
+    b = realloc(*buf, c);
+    if (! b) return 0;
+    *buf = b;
+    *cap = c;
+    return 1;
+}
+
+static void br_sighash_put32(uint8_t *p, uint32_t u)
+{
+    p[0] = (uint8_t)u;
+    p[1] = (uint8_t)(u >> 8);
+    p[2] = (uint8_t)(u >> 16);
+    p[3] = (uint8_t)(u >> 24);
+}
+
+static size_t br_sighash_put_varint(uint8_t *p, uint64_t u)
+{
+    if (u < 0xfd) {
+        p[0] = (uint8_t)u;
+        return 1;
+    }
+
+    if (u <= 0xffff) {
+        p[0] = 0xfd;
+        p[1] = (uint8_t)u;
+        p[2] = (uint8_t)(u >> 8);
+        return 3;
+    }
+
+    if (u <= 0xffffffffu) {
+        p[0] = 0xfe;
+        br_sighash_put32(p + 1, (uint32_t)u);
+        return 5;
+    }
+
+    p[0] = 0xff;
+    br_sighash_put32(p + 1, (uint32_t)u);
+    br_sighash_put32(p + 5, (uint32_t)(u >> 32));
+    return 9;
+}
+
+int br_sighash_begin(br_sighash *sh, uint32_t version, size_t inputs, size_t outputs)
+{
+    if (inputs > sh->in_cap) {
+        br_sighash_input *in = realloc(sh->in, inputs*sizeof(*in));
+
+        if (! in) return 0;
+        sh->in = in;
+        sh->in_cap = inputs;
+    }
+
+    sh->len = sh->scripts_len = sh->in_count = sh->out_count = 0;
+    sh->inputs = inputs;
+    sh->outputs = outputs;
+    if (! br_sighash_reserve(&sh->buf, &sh->cap, 0, 4 + 9 + 41*inputs + 9 + 4)) return 0;
+    br_sighash_put32(sh->buf, version);
+    sh->len = 4 + br_sighash_put_varint(sh->buf + 4, inputs);
+    if (inputs == 0) sh->len += br_sighash_put_varint(sh->buf + sh->len, outputs);
+    return 1;
+}
+
+int br_sighash_add_input(br_sighash *sh, const uint8_t *hash, uint32_t index, const uint8_t *script, size_t script_len,
+                         uint32_t sequence)
+{
+    br_sighash_input *in = &sh->in[sh->in_count];
+    uint8_t *p;
+
+    if (sh->in_count >= sh->inputs || ! br_sighash_reserve(&sh->buf, &sh->cap, sh->len, 41)) return 0;
+    if (script && ! br_sighash_reserve(&sh->scripts, &sh->scripts_cap, sh->scripts_len, script_len)) return 0;
+
+    p = sh->buf + sh->len;
+    memcpy(p, hash, 32);
+    br_sighash_put32(p + 32, index);
+    p[36] = 0; // empty script
+    br_sighash_put32(p + 37, sequence);
+    in->pos = sh->len + 36;
+    sh->len += 41;
+
+    if (script) {
+        if (script_len > 0) memcpy(sh->scripts + sh->scripts_len, script, script_len);
+        in->script_off = sh->scripts_len;
+        in->script_len = script_len;
+        sh->scripts_len += script_len;
+    }
+    else {
+        in->script_off = SIZE_MAX;
+        in->script_len = 0;
+    }
+
+    if (++sh->in_count == sh->inputs) sh->len += br_sighash_put_varint(sh->buf + sh->len, sh->outputs);
+    return 1;
+}
+
+int br_sighash_add_output(br_sighash *sh, uint64_t amount, const uint8_t *script, size_t script_len)
+{
+    uint8_t *p;
+
+    if (sh->in_count < sh->inputs || sh->out_count >= sh->outputs ||
+        ! br_sighash_reserve(&sh->buf, &sh->cap, sh->len, 8 + 9 + script_len)) return 0;
+
+    p = sh->buf + sh->len;
+    br_sighash_put32(p, (uint32_t)amount);
+    br_sighash_put32(p + 4, (uint32_t)(amount >> 32));
+    sh->len += 8 + br_sighash_put_varint(p + 8, script_len);
+    if (script_len > 0) memcpy(sh->buf + sh->len, script, script_len);
+    sh->len += script_len;
+    sh->out_count++;
+    return 1;
+}
+
+int br_sighash_end(br_sighash *sh, uint32_t lock_time)
+{
+    sph_sha256_context sha;
+    size_t pos = 0;
+
+    if (sh->in_count < sh->inputs || sh->out_count < sh->outputs ||
+        ! br_sighash_reserve(&sh->buf, &sh->cap, sh->len, 4)) return 0;
+    br_sighash_put32(sh->buf + sh->len, lock_time);
+    sh->len += 4;
+
+    // every digest starts with the layout up to its input's script, so hash that prefix once, keeping the midstate at
+    // each input; what follows the script differs in alignment from one input to the next and has to be hashed anew
+    sph_sha256_init(&sha);
+
+    for (size_t i = 0; i < sh->inputs; i++) {
+        sph_sha256(&sha, sh->buf + pos, sh->in[i].pos - pos);
+        sh->in[i].mid = sha;
+        pos = sh->in[i].pos;
+    }
+
+    return 1;
+}
+
+void br_sighash_digest(const br_sighash *sh, size_t input, uint32_t hash_type, uint8_t *md)
+{
+    const br_sighash_input *in = &sh->in[input];
+    sph_sha256_context sha = in->mid;
+    uint8_t var[9], type[4];
+
+    if (in->script_off != SIZE_MAX) {
+        sph_sha256(&sha, var, br_sighash_put_varint(var, in->script_len));
+        sph_sha256(&sha, sh->scripts + in->script_off, in->script_len);
+    }
+    else sph_sha256(&sha, sh->buf + in->pos, 1);
+
+    sph_sha256(&sha, sh->buf + in->pos + 1, sh->len - in->pos - 1);
+    br_sighash_put32(type, hash_type);
+    sph_sha256(&sha, type, sizeof(type));
+    sph_sha256_close(&sha, md); // close leaves the context initialised for the second round
+    sph_sha256(&sha, md, 32);
+    sph_sha256_close(&sha, md);
+}
+
+typedef struct {
+    const br_sighash *sh;
+    const size_t *inputs;
+    uint32_t hash_type;
+    uint8_t *md32s;
+} br_sighash_job;
+
+static void br_sighash_chunk(void *info, unsigned chunk, size_t first, size_t count)
+{
+    const br_sighash_job *job = info;
+
+    for (size_t j = first; j < first + count; j++) {
+        br_sighash_digest(job->sh, (job->inputs) ? job->inputs[j] : j, job->hash_type, job->md32s + j*32);
+    }
+}
+
+void br_sighash_digests(const br_sighash *sh, const size_t *inputs, size_t n, uint32_t hash_type, uint8_t *md32s,
+                        unsigned threads)
+{
+    br_sighash_job job = { sh, inputs, hash_type, md32s };
+    size_t bytes = n*sh->len;
+
+    if (threads > bytes/BR_SIGHASH_MIN_BYTES) threads = (unsigned)(bytes/BR_SIGHASH_MIN_BYTES);
+    br_parallel_for(n, 1, threads, br_sighash_chunk, &job);
+}
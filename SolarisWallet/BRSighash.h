@@ -0,0 +1,69 @@
+//
+//  BRSighash.h
+//  SolarisWallet
+//
+//  Legacy signature hashes for every input of a transaction from a single serialisation of it.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRSighash_h
+#define BRSighash_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BR_SIGHASH_ALL 0x00000001u
+
+typedef struct br_sighash br_sighash;
+
+// returns an empty sighash engine, or NULL if out of memory; its buffers are kept and reused across transactions
+br_sighash *br_sighash_new(void);
+
+void br_sighash_free(br_sighash *sh);
+
+// starts laying out a transaction with the given version and numbers of inputs and outputs, dropping the previous one
+// returns 0 if out of memory
+int br_sighash_begin(br_sighash *sh, uint32_t version, size_t inputs, size_t outputs);
+
+// adds the next input, spending output index of the transaction hash; script is the output script it spends, which
+// its digest signs in place of the input script, and may be NULL if the input is not to be signed
+// returns 0 if out of memory or if all the inputs given to br_sighash_begin() were added already
+int br_sighash_add_input(br_sighash *sh, const uint8_t *hash, uint32_t index, const uint8_t *script, size_t script_len,
+                         uint32_t sequence);
+
+// adds the next output, returns 0 if out of memory or if all the outputs were added already
+int br_sighash_add_output(br_sighash *sh, uint64_t amount, const uint8_t *script, size_t script_len);
+
+// finishes the layout and hashes it up to each input once, returns 0 unless every input and output was added
+int br_sighash_end(br_sighash *sh, uint32_t lock_time);
+
+// writes the double sha256 that signs input with hash_type to md, the layout has to be finished
+// only BR_SIGHASH_ALL is supported: hash_type is appended to the digest as given, the layout is always the one ALL signs,
+// so any other type gives a digest that nothing verifies against
+void br_sighash_digest(const br_sighash *sh, size_t input, uint32_t hash_type, uint8_t *md);
+
+// writes the digests of the n inputs listed in inputs, or of inputs 0..n-1 if it is NULL, to md32s + j*32, with the
+// same restriction on hash_type
+// splits them over up to threads threads, the calling thread included
+void br_sighash_digests(const br_sighash *sh, const size_t *inputs, size_t n, uint32_t hash_type, uint8_t *md32s,
+                        unsigned threads);
+
+#endif /* BRSighash_h */
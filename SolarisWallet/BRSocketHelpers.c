@@ -26,81 +26,239 @@
 #include "BRSocketHelpers.h"
 #include <fcntl.h>
 #include <errno.h>
-#include <sys/socket.h>
-#include <sys/select.h>
+#include <stdint.h>
 #include <stdlib.h>
-#include <sys/time.h>
+#include <string.h>
+#include <unistd.h>
+
+#if defined(__linux__) && ! defined(BW_EVENT_POLL) // BW_EVENT_POLL builds the poll() fallback on linux too
+#include <sys/epoll.h>
+#define BW_EVENT_EPOLL 1
+#else
+#include <poll.h>
+#define BW_EVENT_EPOLL 0
+#endif
+
+#define BW_EVENT_BATCH 64 // ready events collected per wait
 
 int bw_nbioify(int fd) {
     int flags = fcntl(fd, F_GETFL, 0);
     if (flags < 0) return flags;
-    flags = flags &~ O_NONBLOCK;
+    flags = flags | O_NONBLOCK;
     return fcntl(fd, F_SETFL, flags);
 }
 
-struct bw_select_result bw_select(struct bw_select_request request) {
-    fd_set read_fds, write_fds, err_fds;
-    FD_ZERO(&read_fds);
-    FD_ZERO(&write_fds);
-    FD_ZERO(&err_fds);
-    int max_fd = 0;
-    // copy requested file descriptors from request to fd_sets
-    for (int i = 0; i < request.read_fd_len; i++) {
-        int fd = request.read_fds[i];
-        if (fd > max_fd) max_fd = fd;
-        // printf("bw_select: read fd=%i open=%i\n", fd, fcntl(fd, F_GETFD));
-        FD_SET(fd, &read_fds);
+// per fd registration, indexed by fd; only grows on add, so waiting never allocates
+struct bw_event_reg {
+    int events; // registered BW_EVENT_* flags, 0 when fd is not registered
+    int index; // slot in the pollfd array (poll fallback only)
+    void *info;
+};
+
+struct bw_event_loop {
+    struct bw_event_reg *regs;
+    int reg_len;
+#if BW_EVENT_EPOLL
+    int epfd;
+    struct epoll_event ready[BW_EVENT_BATCH];
+#else
+    struct pollfd *pfds;
+    int pfd_len, pfd_cap;
+#endif
+};
+
+static struct bw_event_reg *bw_event_reg_get(struct bw_event_loop *loop, int fd, int grow) {
+    if (fd < 0) return NULL;
+    if (fd >= loop->reg_len) {
+        int len = (loop->reg_len > 0) ? loop->reg_len : 64;
+        struct bw_event_reg *regs;
+        
+        if (! grow) return NULL;
+        while (len <= fd) len *= 2;
+        regs = realloc(loop->regs, len*sizeof(*regs));
+        if (! regs) return NULL;
+        memset(regs + loop->reg_len, 0, (len - loop->reg_len)*sizeof(*regs));
+        loop->regs = regs;
+        loop->reg_len = len;
     }
-    for (int i = 0; i < request.write_fd_len; i++) {
-        int fd = request.write_fds[i];
-        if (fd > max_fd) max_fd = fd;
-        // printf("bw_select: write fd=%i open=%i\n", fd, fcntl(fd, F_GETFD));
-        FD_SET(fd, &write_fds);
+    return &loop->regs[fd];
+}
+
+struct bw_event_loop *bw_event_loop_new(void) {
+    struct bw_event_loop *loop = calloc(1, sizeof(*loop));
+    if (! loop) return NULL;
+#if BW_EVENT_EPOLL
+    loop->epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epfd < 0) {
+        free(loop);
+        return NULL;
     }
+#endif
+    return loop;
+}
+
+void bw_event_loop_free(struct bw_event_loop *loop) {
+    if (! loop) return;
+#if BW_EVENT_EPOLL
+    close(loop->epfd);
+#else
+    free(loop->pfds);
+#endif
+    free(loop->regs);
+    free(loop);
+}
+
+#if BW_EVENT_EPOLL
+
+static int bw_event_ctl(struct bw_event_loop *loop, int op, int fd, int events) {
+    // EPOLLERR and EPOLLHUP are always reported, EPOLLRDHUP makes a half close show up as readable
+    struct epoll_event ev;
     
-    struct bw_select_result result = { 0, 0, 0, 0, NULL, NULL, NULL };
-    // printf("bw_select max_fd=%i\n", max_fd);
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLET | EPOLLRDHUP;
+    if (events & BW_EVENT_READ) ev.events |= EPOLLIN;
+    if (events & BW_EVENT_WRITE) ev.events |= EPOLLOUT;
+    ev.data.fd = fd;
+    return epoll_ctl(loop->epfd, op, fd, &ev);
+}
+
+#else
+
+static short bw_event_poll_events(int events) {
+    short pev = 0;
+    if (events & BW_EVENT_READ) pev |= POLLIN;
+    if (events & BW_EVENT_WRITE) pev |= POLLOUT;
+    return pev;
+}
+
+#endif
+
+int bw_event_loop_add(struct bw_event_loop *loop, int fd, int events, void *info) {
+    struct bw_event_reg *reg = bw_event_reg_get(loop, fd, 1);
     
-    // initiate a select
-    struct timeval tv;
-    tv.tv_sec = 0;
-    tv.tv_usec = 10000; // 10ms
-    int activity = select(max_fd + 1, &read_fds, &write_fds, &err_fds, &tv);
-    if (activity < 0 && errno != EINTR) {
-        result.error = errno;
-        perror("select");
-        return result;
+    if (! reg) {
+        errno = (fd < 0) ? EBADF : ENOMEM;
+        return -1;
     }
-    // indicate to the caller which file descriptors are ready for reading
-    for (int i = 0; i < request.read_fd_len; i++) {
-        int fd = request.read_fds[i];
-        // printf("bw_select: i=%i read_ready_fd=%i\n", i, fd);
-        if (FD_ISSET(fd, &read_fds)) {
-            result.read_fd_len += 1;
-            result.read_fds = (int *)realloc(result.read_fds, result.read_fd_len * sizeof(int));
-            result.read_fds[result.read_fd_len - 1] = fd;
-        }
-        // ... which ones are erroring
-        if (FD_ISSET(fd, &err_fds)) {
-            result.error_fd_len += 1;
-            result.error_fds = (int *)realloc(result.error_fds, result.error_fd_len * sizeof(int));
-            result.error_fds[result.error_fd_len - 1] = fd;
-        }
+    if (reg->events) {
+        errno = EEXIST;
+        return -1;
     }
-    // ... and which ones are ready for writing
-    for (int i = 0; i < request.write_fd_len; i++) {
-        int fd = request.write_fds[i];
-        // printf("bw_select: write_ready_fd=%i\n", fd);
-        if (FD_ISSET(fd, &write_fds)) {
-            result.write_fd_len += 1;
-            result.write_fds = (int *)realloc(result.write_fds, result.write_fd_len * sizeof(int));
-            result.write_fds[result.write_fd_len - 1] = fd;
-        }
-        if (FD_ISSET(fd, &err_fds)) {
-            result.error_fd_len += 1;
-            result.error_fds = (int *)realloc(result.error_fds, result.error_fd_len * sizeof(int));
-            result.error_fds[result.error_fd_len - 1] = fd;
+    events &= BW_EVENT_READ | BW_EVENT_WRITE;
+    if (! events) {
+        errno = EINVAL;
+        return -1;
+    }
+#if BW_EVENT_EPOLL
+    if (bw_event_ctl(loop, EPOLL_CTL_ADD, fd, events) < 0) return -1;
+#else
+    if (loop->pfd_len == loop->pfd_cap) {
+        int cap = (loop->pfd_cap > 0) ? loop->pfd_cap*2 : 16;
+        struct pollfd *pfds = realloc(loop->pfds, cap*sizeof(*pfds));
+        
+        if (! pfds) {
+            errno = ENOMEM;
+            return -1;
         }
+        loop->pfds = pfds;
+        loop->pfd_cap = cap;
+    }
+    reg->index = loop->pfd_len++;
+    loop->pfds[reg->index].fd = fd;
+    loop->pfds[reg->index].events = bw_event_poll_events(events);
+    loop->pfds[reg->index].revents = 0;
+#endif
+    reg->events = events;
+    reg->info = info;
+    return 0;
+}
+
+int bw_event_loop_mod(struct bw_event_loop *loop, int fd, int events, void *info) {
+    struct bw_event_reg *reg = bw_event_reg_get(loop, fd, 0);
+    
+    if (! reg || ! reg->events) {
+        errno = ENOENT;
+        return -1;
+    }
+    events &= BW_EVENT_READ | BW_EVENT_WRITE;
+    if (! events) {
+        errno = EINVAL;
+        return -1;
+    }
+#if BW_EVENT_EPOLL
+    // re-arming also re-reports a readiness the caller has not drained yet
+    if (bw_event_ctl(loop, EPOLL_CTL_MOD, fd, events) < 0) return -1;
+#else
+    loop->pfds[reg->index].events = bw_event_poll_events(events);
+#endif
+    reg->events = events;
+    reg->info = info;
+    return 0;
+}
+
+int bw_event_loop_del(struct bw_event_loop *loop, int fd) {
+    struct bw_event_reg *reg = bw_event_reg_get(loop, fd, 0);
+    
+    if (! reg || ! reg->events) {
+        errno = ENOENT;
+        return -1;
+    }
+#if BW_EVENT_EPOLL
+    // an fd that was already closed has left the epoll set by itself
+    if (bw_event_ctl(loop, EPOLL_CTL_DEL, fd, 0) < 0 && errno != EBADF) return -1;
+#else
+    // move the last pollfd into the freed slot to keep the array dense
+    loop->pfds[reg->index] = loop->pfds[--loop->pfd_len];
+    if (reg->index < loop->pfd_len) loop->regs[loop->pfds[reg->index].fd].index = reg->index;
+#endif
+    memset(reg, 0, sizeof(*reg));
+    return 0;
+}
+
+int bw_event_loop_wait(struct bw_event_loop *loop, struct bw_event *events, int max_events, int timeout_ms) {
+    int n = 0;
+    
+    if (max_events <= 0) {
+        errno = EINVAL;
+        return -1;
+    }
+#if BW_EVENT_EPOLL
+    int ready = epoll_wait(loop->epfd, loop->ready, (max_events < BW_EVENT_BATCH) ? max_events : BW_EVENT_BATCH,
+                           timeout_ms);
+    
+    if (ready < 0) return (errno == EINTR) ? 0 : -1;
+    for (int i = 0; i < ready; i++) {
+        struct bw_event_reg *reg = bw_event_reg_get(loop, loop->ready[i].data.fd, 0);
+        uint32_t ev = loop->ready[i].events;
+        
+        // the caller closed fd and then took it out with bw_event_loop_del(), but a dup of it still open keeps it in
+        // the epoll set, which goes on reporting it under the old number
+        if (! reg || ! reg->events) continue;
+        events[n].fd = loop->ready[i].data.fd;
+        events[n].events = 0;
+        if (ev & (EPOLLIN | EPOLLRDHUP)) events[n].events |= BW_EVENT_READ;
+        if (ev & EPOLLOUT) events[n].events |= BW_EVENT_WRITE;
+        if (ev & (EPOLLERR | EPOLLHUP)) events[n].events |= BW_EVENT_ERROR;
+        events[n].info = reg->info;
+        n++;
+    }
+#else
+    int ready = poll(loop->pfds, (nfds_t)loop->pfd_len, timeout_ms);
+    
+    if (ready < 0) return (errno == EINTR) ? 0 : -1;
+    for (int i = 0; i < loop->pfd_len && n < max_events && ready > 0; i++) {
+        short rev = loop->pfds[i].revents;
+        
+        if (! rev) continue;
+        ready--;
+        events[n].fd = loop->pfds[i].fd;
+        events[n].events = 0;
+        if (rev & POLLIN) events[n].events |= BW_EVENT_READ;
+        if (rev & POLLOUT) events[n].events |= BW_EVENT_WRITE;
+        if (rev & (POLLERR | POLLHUP | POLLNVAL)) events[n].events |= BW_EVENT_ERROR;
+        events[n].info = loop->regs[loop->pfds[i].fd].info;
+        n++;
     }
-    return result;
+#endif
+    return n;
 }
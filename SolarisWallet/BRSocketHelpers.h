@@ -28,25 +28,41 @@
 
 #include <stdio.h>
 
+// puts fd in non-blocking mode, which edge-triggered readiness from bw_event_loop requires
 int bw_nbioify(int fd);
 
-struct bw_select_request {
-    int write_fd_len;
-    int read_fd_len;
-    int *write_fds;
-    int *read_fds;
-};
+#define BW_EVENT_READ   0x01 // fd is readable, or the peer closed its end
+#define BW_EVENT_WRITE  0x02 // fd is writable, e.g. a non-blocking connect() finished
+#define BW_EVENT_ERROR  0x04 // fd has a pending error or was hung up, only ever reported, never registered
 
-struct bw_select_result {
-    int error; // if > 0 there is an error
-    int write_fd_len;
-    int read_fd_len;
-    int error_fd_len;
-    int *write_fds;
-    int *read_fds;
-    int *error_fds;
+struct bw_event {
+    int fd;
+    int events; // BW_EVENT_* flags that are ready
+    void *info; // the pointer fd was registered with
 };
 
-struct bw_select_result bw_select(struct bw_select_request);
+// persistent set of file descriptors and the events each one is interested in
+// backed by epoll on linux, where readiness is edge-triggered: an event is reported once per transition, so the
+// caller has to read/write until EAGAIN before waiting again. elsewhere, or built with BW_EVENT_POLL defined, it falls
+// back to poll(), which reports the same events level-triggered; code written for the edge-triggered contract works
+// unchanged on either
+struct bw_event_loop;
+
+// returns a new empty loop, or NULL with errno set
+struct bw_event_loop *bw_event_loop_new(void);
+
+// closes the loop, registered file descriptors are left open
+void bw_event_loop_free(struct bw_event_loop *loop);
+
+// registers fd for events (BW_EVENT_READ and/or BW_EVENT_WRITE), info is handed back with every event on fd
+// all three return 0 on success, or -1 with errno set
+int bw_event_loop_add(struct bw_event_loop *loop, int fd, int events, void *info);
+int bw_event_loop_mod(struct bw_event_loop *loop, int fd, int events, void *info);
+int bw_event_loop_del(struct bw_event_loop *loop, int fd);
+
+// waits up to timeout_ms milliseconds (-1 blocks until an event, 0 returns at once) and fills in at most max_events
+// ready events, returns their count, 0 on timeout or when interrupted by a signal, or -1 with errno set
+// nothing is allocated per call; on linux a timerfd registered for BW_EVENT_READ can stand in for the timeout
+int bw_event_loop_wait(struct bw_event_loop *loop, struct bw_event *events, int max_events, int timeout_ms);
 
 #endif /* BRSocketHelpers_h */
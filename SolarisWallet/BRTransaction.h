@@ -86,6 +86,12 @@ sequence:(uint32_t)sequence;
 - (void)shuffleOutputOrder;
 - (BOOL)signWithPrivateKeys:(NSArray *)privateKeys;
 
+// checks every input signature against scripts, the output scripts the inputs spend in input order, hashing all inputs
+// from one layout of the transaction; a transaction read from a message does not carry them, so they have to be looked
+// up by the caller. only pay-to-pubkey-hash and pay-to-pubkey inputs are understood, others count as invalid; inputs
+// signed with a hash type other than SIGHASH_ALL can't be hashed here and are passed unchecked
+- (BOOL)verifySignaturesWithScripts:(NSArray *)scripts;
+
 - (NSString*)shapeshiftOutboundAddress;
 - (NSString*)shapeshiftOutboundAddressForceScript;
 + (NSString*)shapeshiftOutboundAddressForScript:(NSData*)script;
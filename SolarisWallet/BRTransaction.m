@@ -32,13 +32,47 @@
 #import "NSData+Bitcoin.h"
 #import "BRAddressEntity.h"
 #import "NSManagedObject+Sugar.h"
+#import "BRSecp256k1.h"
+#import "BRSighash.h"
+#import "BRTxCodec.h"
+#import <pthread.h>
+#import <stdatomic.h>
 
 #define TX_VERSION    0x00000001u
 #define TX_LOCKTIME   0x00000000u
 #define TXIN_SEQUENCE UINT32_MAX
 #define SIGHASH_ALL   0x00000001u
 
+#define TX_PACKED_ARRAYS    1 // the input and output arrays are still to be built from the message
+#define TX_PACKED_ADDRESSES 2 // the output addresses are still to be derived from the output scripts
+
+static pthread_key_t _parserKey;
+
+static void BRTxParserFree(void *tx)
+{
+    br_tx_free(tx);
+}
+
+// a parser per thread, reused from one transaction to the next so parsing allocates nothing once it has grown
+static br_tx *BRTxParser(void)
+{
+    static dispatch_once_t once = 0;
+    br_tx *tx;
+
+    dispatch_once(&once, ^{
+        pthread_key_create(&_parserKey, BRTxParserFree);
+    });
+
+    tx = pthread_getspecific(_parserKey);
+    if (! tx && (tx = br_tx_new())) pthread_setspecific(_parserKey, tx);
+    return tx;
+}
+
 @interface BRTransaction ()
+{
+    NSData *_message; // the serialized transaction it was parsed from, never changed once set
+    atomic_int _packed; // TX_PACKED_* flags for what has not been built from _message yet
+}
 
 @property (nonatomic, strong) NSMutableArray *hashes, *indexes, *inScripts, *signatures, *sequences;
 @property (nonatomic, strong) NSMutableArray *amounts, *addresses, *outScripts;
@@ -72,50 +106,28 @@
 
 - (instancetype)initWithMessage:(NSData *)message
 {
-    if (! (self = [self init])) return nil;
- 
-    NSString *address = nil;
-    NSNumber * l = 0;
-    NSUInteger off = 0, count = 0;
-    NSData *d = nil;
-
-    @autoreleasepool {
-        _version = [message UInt32AtOffset:off]; // tx version
-        off += sizeof(uint32_t);
-        count = (NSUInteger)[message varIntAtOffset:off length:&l]; // input count
-        if (count == 0) return nil; // at least one input is required
-        off += l.unsignedIntegerValue;
-
-        for (NSUInteger i = 0; i < count; i++) { // inputs
-            [self.hashes addObject:uint256_obj([message hashAtOffset:off])];
-            off += sizeof(UInt256);
-            [self.indexes addObject:@([message UInt32AtOffset:off])]; // input index
-            off += sizeof(uint32_t);
-            [self.inScripts addObject:[NSNull null]]; // placeholder for input script (comes from input transaction)
-            d = [message dataAtOffset:off length:&l];
-            [self.signatures addObject:(d.length > 0) ? d : [NSNull null]]; // input signature
-            off += l.unsignedIntegerValue;
-            [self.sequences addObject:@([message UInt32AtOffset:off])]; // input sequence number (for replacement tx)
-            off += sizeof(uint32_t);
-        }
+    if (! (self = [self init])) return nil; // -init's defaults, -unpack: replaces its empty arrays
 
-        count = (NSUInteger)[message varIntAtOffset:off length:&l]; // output count
-        off += l.unsignedIntegerValue;
-
-        for (NSUInteger i = 0; i < count; i++) { // outputs
-            [self.amounts addObject:@([message UInt64AtOffset:off])]; // output amount
-            off += sizeof(uint64_t);
-            d = [message dataAtOffset:off length:&l];
-            [self.outScripts addObject:(d) ? d : [NSNull null]]; // output script
-            off += l.unsignedIntegerValue;
-            address = [NSString addressWithScriptPubKey:d]; // address from output script if applicable
-            [self.addresses addObject:(address) ? address : [NSNull null]];
-        }
+    br_tx *tx = BRTxParser();
+    size_t len = (tx) ? br_tx_parse(tx, message.bytes, message.length) : 0;
+    BOOL hasDataOutput = NO;
+
+    if (len == 0) return nil; // malformed, or without any input
+    _message = (len < message.length) ? [message subdataWithRange:NSMakeRange(0, len)] : [message copy];
+    _version = tx->version;
+    _lockTime = tx->lock_time;
+    br_tx_hash(tx, _txHash.u8);
 
-        _lockTime = [message UInt32AtOffset:off]; // tx locktime
-        _txHash = self.data.SHA256_2;
+    // the arrays and addresses are built from the message the first time they are asked for, most relayed
+    // transactions are dropped before that
+    atomic_init(&_packed, TX_PACKED_ARRAYS | TX_PACKED_ADDRESSES);
+
+    for (size_t i = 0; i < tx->out_count; i++) {
+        if (tx->out_script[i].len > 0 && tx->out_script[i].p[0] == OP_RETURN) hasDataOutput = YES;
     }
-    
+
+    if (! hasDataOutput) return self; // shapeshift memos are OP_RETURN outputs
+
     NSString * outboundShapeshiftAddress = [self shapeshiftOutboundAddress];
     if (outboundShapeshiftAddress) {
         self.associatedShapeshift = [DSShapeshiftEntity shapeshiftHavingWithdrawalAddress:outboundShapeshiftAddress];
@@ -132,6 +144,8 @@
         if (!self.associatedShapeshift && [self.outputAddresses count]) {
             NSString * mainOutputAddress = nil;
             NSMutableArray * allAddresses = [NSMutableArray array];
+            NSString * address = self.outputAddresses.lastObject; // the last output's, as parsing used to leave it
+            if (! [address isKindOfClass:[NSString class]]) address = nil;
             for (BRAddressEntity *e in [BRAddressEntity allObjects]) {
                 [allAddresses addObject:e.address];
             }
@@ -194,6 +208,119 @@ outputAddresses:(NSArray *)addresses outputAmounts:(NSArray *)amounts
     return self;
 }
 
+// builds what is still packed of parts from the message, the first time it is needed
+- (void)unpack:(int)parts
+{
+    @synchronized (self) {
+        int packed = atomic_load_explicit(&_packed, memory_order_relaxed) & parts;
+
+        if (packed & TX_PACKED_ARRAYS) {
+            br_tx *tx = BRTxParser();
+            size_t inputs = 0, outputs = 0;
+            UInt256 hash;
+
+            if (tx && br_tx_parse(tx, _message.bytes, _message.length) == _message.length) {
+                inputs = tx->in_count;
+                outputs = tx->out_count;
+            }
+
+            _hashes = [NSMutableArray arrayWithCapacity:inputs];
+            _indexes = [NSMutableArray arrayWithCapacity:inputs];
+            _inScripts = [NSMutableArray arrayWithCapacity:inputs];
+            _signatures = [NSMutableArray arrayWithCapacity:inputs];
+            _sequences = [NSMutableArray arrayWithCapacity:inputs];
+            _amounts = [NSMutableArray arrayWithCapacity:outputs];
+            _outScripts = [NSMutableArray arrayWithCapacity:outputs];
+
+            for (size_t i = 0; i < inputs; i++) {
+                memcpy(&hash, tx->in_hash[i], sizeof(hash));
+                [_hashes addObject:uint256_obj(hash)];
+                [_indexes addObject:@(tx->in_index[i])];
+                [_inScripts addObject:[NSNull null]]; // placeholder for input script (comes from input transaction)
+                [_signatures addObject:(tx->in_script[i].len > 0) ?
+                 [NSData dataWithBytes:tx->in_script[i].p length:tx->in_script[i].len] : [NSNull null]];
+                [_sequences addObject:@(tx->in_sequence[i])];
+            }
+
+            for (size_t i = 0; i < outputs; i++) {
+                [_amounts addObject:@(tx->out_amount[i])];
+                [_outScripts addObject:[NSData dataWithBytes:tx->out_script[i].p length:tx->out_script[i].len]];
+            }
+        }
+
+        if (packed & TX_PACKED_ADDRESSES) {
+            _addresses = [NSMutableArray arrayWithCapacity:_outScripts.count];
+
+            for (NSData *script in _outScripts) {
+                NSString *address = nil;
+                uint8_t d[1 + sizeof(UInt160)];
+
+                switch (br_tx_script_hash160(script.bytes, script.length, d + 1)) {
+                    case BR_TX_SCRIPT_PUBKEY_HASH: d[0] = DASH_PUBKEY_ADDRESS; break;
+                    case BR_TX_SCRIPT_HASH: d[0] = DASH_SCRIPT_ADDRESS; break;
+                    default: d[0] = 0; break;
+                }
+#if DASH_TESTNET
+                if (d[0] == DASH_PUBKEY_ADDRESS) d[0] = DASH_PUBKEY_ADDRESS_TEST;
+                if (d[0] == DASH_SCRIPT_ADDRESS) d[0] = DASH_SCRIPT_ADDRESS_TEST;
+#endif
+                if (d[0] != 0) address = [NSString base58checkWithData:[NSData dataWithBytes:d length:sizeof(d)]];
+                [_addresses addObject:(address) ? address : [NSNull null]];
+            }
+        }
+
+        atomic_fetch_and_explicit(&_packed, ~packed, memory_order_release);
+    }
+}
+
+- (NSMutableArray *)hashes
+{
+    if (atomic_load_explicit(&_packed, memory_order_acquire) & TX_PACKED_ARRAYS) [self unpack:TX_PACKED_ARRAYS];
+    return _hashes;
+}
+
+- (NSMutableArray *)indexes
+{
+    if (atomic_load_explicit(&_packed, memory_order_acquire) & TX_PACKED_ARRAYS) [self unpack:TX_PACKED_ARRAYS];
+    return _indexes;
+}
+
+- (NSMutableArray *)inScripts
+{
+    if (atomic_load_explicit(&_packed, memory_order_acquire) & TX_PACKED_ARRAYS) [self unpack:TX_PACKED_ARRAYS];
+    return _inScripts;
+}
+
+- (NSMutableArray *)signatures
+{
+    if (atomic_load_explicit(&_packed, memory_order_acquire) & TX_PACKED_ARRAYS) [self unpack:TX_PACKED_ARRAYS];
+    return _signatures;
+}
+
+- (NSMutableArray *)sequences
+{
+    if (atomic_load_explicit(&_packed, memory_order_acquire) & TX_PACKED_ARRAYS) [self unpack:TX_PACKED_ARRAYS];
+    return _sequences;
+}
+
+- (NSMutableArray *)amounts
+{
+    if (atomic_load_explicit(&_packed, memory_order_acquire) & TX_PACKED_ARRAYS) [self unpack:TX_PACKED_ARRAYS];
+    return _amounts;
+}
+
+- (NSMutableArray *)outScripts
+{
+    if (atomic_load_explicit(&_packed, memory_order_acquire) & TX_PACKED_ARRAYS) [self unpack:TX_PACKED_ARRAYS];
+    return _outScripts;
+}
+
+- (NSMutableArray *)addresses
+{
+    if (atomic_load_explicit(&_packed, memory_order_acquire)) [self unpack:TX_PACKED_ARRAYS | TX_PACKED_ADDRESSES];
+    return _addresses;
+}
+
 - (NSArray *)inputHashes
 {
     return self.hashes;
@@ -278,6 +405,8 @@ outputAddresses:(NSArray *)addresses outputAmounts:(NSArray *)amounts
 
 - (NSData *)toData
 {
+    // until the arrays are built nothing can have changed, so the parsed message is still the transaction
+    if (atomic_load_explicit(&_packed, memory_order_acquire) & TX_PACKED_ARRAYS) return _message;
     return [self toDataWithSubscriptIndex:NSNotFound];
 }
 
@@ -298,6 +427,7 @@ sequence:(uint32_t)sequence
 
 - (void)addOutputAddress:(NSString *)address amount:(uint64_t)amount
 {
+    [self unpack:TX_PACKED_ARRAYS | TX_PACKED_ADDRESSES]; // addresses follow the scripts as they are now
     [self.amounts addObject:@(amount)];
     [self.addresses addObject:address];
     [self.outScripts addObject:[NSMutableData data]];
@@ -306,6 +436,7 @@ sequence:(uint32_t)sequence
 
 - (void)addOutputShapeshiftAddress:(NSString *)address
 {
+    [self unpack:TX_PACKED_ARRAYS | TX_PACKED_ADDRESSES]; // addresses follow the scripts as they are now
     [self.amounts addObject:@(0)];
     [self.addresses addObject:[NSNull null]];
     [self.outScripts addObject:[NSMutableData data]];
@@ -316,6 +447,8 @@ sequence:(uint32_t)sequence
 {
     NSString *address = [NSString addressWithScriptPubKey:script];
 
+    [self unpack:TX_PACKED_ARRAYS | TX_PACKED_ADDRESSES]; // addresses follow the scripts as they are now
+
     [self.amounts addObject:@(amount)];
     [self.outScripts addObject:script];
     [self.addresses addObject:(address) ? address : [NSNull null]];
@@ -347,6 +480,8 @@ sequence:(uint32_t)sequence
 
 - (void)shuffleOutputOrder
 {    
+    [self unpack:TX_PACKED_ARRAYS | TX_PACKED_ADDRESSES]; // addresses follow the scripts as they are now
+
     for (NSUInteger i = 0; i + 1 < self.amounts.count; i++) { // fischer-yates shuffle
         NSUInteger j = i + arc4random_uniform((uint32_t)(self.amounts.count - i));
         
@@ -400,6 +535,33 @@ sequence:(uint32_t)sequence
     return d;
 }
 
+// Returns the unsigned transaction laid out for computing the signature hash of each input, or NULL if out of memory.
+// scripts holds the output script each input spends, or NSNull for an input not to be hashed.
+// The caller must free it with br_sighash_free().
+- (br_sighash *)sighashWithScripts:(NSArray *)scripts
+{
+    br_sighash *sh = br_sighash_new();
+    UInt256 hash;
+    int ok = (sh && br_sighash_begin(sh, self.version, self.hashes.count, self.amounts.count));
+
+    for (NSUInteger i = 0; ok && i < self.hashes.count; i++) {
+        NSData *script = (scripts[i] != [NSNull null]) ? scripts[i] : nil;
+
+        [self.hashes[i] getValue:&hash];
+        ok = br_sighash_add_input(sh, hash.u8, [self.indexes[i] unsignedIntValue], script.bytes, script.length,
+                                  [self.sequences[i] unsignedIntValue]);
+    }
+
+    for (NSUInteger i = 0; ok && i < self.amounts.count; i++) {
+        ok = br_sighash_add_output(sh, [self.amounts[i] unsignedLongLongValue], [self.outScripts[i] bytes],
+                                   [self.outScripts[i] length]);
+    }
+
+    if (ok && br_sighash_end(sh, self.lockTime)) return sh;
+    br_sighash_free(sh);
+    return NULL;
+}
+
 - (BOOL)signWithPrivateKeys:(NSArray *)privateKeys
 {
     NSMutableArray *addresses = [NSMutableArray arrayWithCapacity:privateKeys.count],
@@ -413,25 +575,50 @@ sequence:(uint32_t)sequence
         [addresses addObject:key.address];
     }
     
+    NSMutableData *inputData = [NSMutableData dataWithLength:self.hashes.count*sizeof(size_t)],
+                  *keyIdxData = [NSMutableData dataWithLength:self.hashes.count*sizeof(NSUInteger)];
+    size_t *inputs = inputData.mutableBytes;
+    NSUInteger count = 0, *keyIdxs = keyIdxData.mutableBytes;
+
     for (NSUInteger i = 0; i < self.hashes.count; i++) {
         NSString *addr = [NSString addressWithScriptPubKey:self.inScripts[i]];
         NSUInteger keyIdx = (addr) ? [addresses indexOfObject:addr] : NSNotFound;
         
         if (keyIdx == NSNotFound) continue;
+        inputs[count] = i;
+        keyIdxs[count++] = keyIdx;
+    }
+    
+    // lay the transaction out once and hash, then sign, every input from that on all cores
+    br_sighash *sh = [self sighashWithScripts:self.inScripts];
+    NSMutableData *mds = [NSMutableData dataWithLength:count*sizeof(UInt256)],
+                  *seckeys = [NSMutableData secureDataWithLength:count*sizeof(UInt256)],
+                  *sigs = [NSMutableData dataWithLength:count*BR_SECP_DER_SIG_MAX],
+                  *lenData = [NSMutableData dataWithLength:count*sizeof(size_t)];
+    size_t *lens = lenData.mutableBytes;
+    
+    if (! sh) return NO;
+    br_sighash_digests(sh, inputs, count, SIGHASH_ALL, mds.mutableBytes,
+                       (unsigned)[NSProcessInfo processInfo].activeProcessorCount);
+    br_sighash_free(sh);
+    for (NSUInteger j = 0; j < count; j++) ((UInt256 *)seckeys.mutableBytes)[j] = *[keys[keyIdxs[j]] secretKey];
+    BRSecp256k1SignMany(sigs.mutableBytes, lens, mds.bytes, seckeys.bytes, count);
+    
+    for (NSUInteger j = 0; j < count; j++) {
+        if (lens[j] == 0) continue;
         
         NSMutableData *sig = [NSMutableData data];
-        UInt256 hash = [self toDataWithSubscriptIndex:i].SHA256_2;
-        NSMutableData *s = [NSMutableData dataWithData:[keys[keyIdx] sign:hash]];
-        NSArray *elem = [self.inScripts[i] scriptElements];
+        NSMutableData *s = [NSMutableData dataWithBytes:(const uint8_t *)sigs.bytes + j*BR_SECP_DER_SIG_MAX length:lens[j]];
+        NSArray *elem = [self.inScripts[inputs[j]] scriptElements];
         
         [s appendUInt8:SIGHASH_ALL];
         [sig appendScriptPushData:s];
         
         if (elem.count >= 2 && [elem[elem.count - 2] intValue] == OP_EQUALVERIFY) { // pay-to-pubkey-hash scriptSig
-            [sig appendScriptPushData:[keys[keyIdx] publicKey]];
+            [sig appendScriptPushData:[keys[keyIdxs[j]] publicKey]];
         }
         
-        self.signatures[i] = sig;
+        self.signatures[inputs[j]] = sig;
     }
     
     if (! self.isSigned) return NO;
@@ -439,6 +626,44 @@ sequence:(uint32_t)sequence
     return YES;
 }
 
+- (BOOL)verifySignaturesWithScripts:(NSArray *)scripts
+{
+    if (! self.isSigned || scripts.count != self.hashes.count) return NO;
+
+    br_sighash *sh = [self sighashWithScripts:scripts];
+    NSMutableData *mds = [NSMutableData dataWithLength:self.hashes.count*sizeof(UInt256)];
+    BOOL r = (sh) ? YES : NO;
+
+    if (sh) {
+        br_sighash_digests(sh, NULL, self.hashes.count, SIGHASH_ALL, mds.mutableBytes,
+                           (unsigned)[NSProcessInfo processInfo].activeProcessorCount);
+        br_sighash_free(sh);
+    }
+
+    for (NSUInteger i = 0; r && i < self.hashes.count; i++) {
+        NSArray *elem = [self.signatures[i] scriptElements],
+                *outElem = (scripts[i] != [NSNull null]) ? [scripts[i] scriptElements] : nil;
+        NSData *sig = elem.firstObject;
+        BRKey *key = nil;
+
+        if (elem.count == 2 && [elem[1] isKindOfClass:[NSData class]]) { // pay-to-pubkey-hash scriptSig
+            key = [BRKey keyWithPublicKey:elem[1]];
+            if (! [key.address isEqual:[NSString addressWithScriptPubKey:scripts[i]]]) key = nil;
+        }
+        else if (elem.count == 1 && outElem.count == 2 && [outElem[1] isEqual:@(OP_CHECKSIG)] &&
+                 [outElem[0] isKindOfClass:[NSData class]]) { // pay-to-pubkey
+            key = [BRKey keyWithPublicKey:outElem[0]];
+        }
+
+        if (! key || ! [sig isKindOfClass:[NSData class]] || sig.length < 2) r = NO;
+        else if (((const uint8_t *)sig.bytes)[sig.length - 1] != SIGHASH_ALL) continue; // no digest to check it with
+        else r = [key verify:((const UInt256 *)mds.bytes)[i]
+                   signature:[sig subdataWithRange:NSMakeRange(0, sig.length - 1)]];
+    }
+
+    return r;
+}
+
 // priority = sum(input_amount_in_satoshis*input_age_in_blocks)/size_in_bytes
 - (uint64_t)priorityForAmounts:(NSArray *)amounts withAges:(NSArray *)ages
 {
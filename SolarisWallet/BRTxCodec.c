@@ -0,0 +1,384 @@
+//
+//  BRTxCodec.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRTxCodec.h"
+#include "sph/sph_sha2.h"
+#include "sph/sph_ripemd.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define BR_OP_PUSHDATA1   0x4c
+#define BR_OP_PUSHDATA2   0x4d
+#define BR_OP_PUSHDATA4   0x4e
+#define BR_OP_DUP         0x76
+#define BR_OP_EQUAL       0x87
+#define BR_OP_EQUALVERIFY 0x88
+#define BR_OP_HASH160     0xa9
+#define BR_OP_CHECKSIG    0xac
+
+br_tx *br_tx_new(void)
+{
+    return calloc(1, sizeof(br_tx));
+}
+
+void br_tx_free(br_tx *tx)
+{
+    if (! tx) return;
+    free(tx->mem);
+    free(tx);
+}
+
+// the arrays in the order they are carved from mem, the widest elements first so each one stays aligned
+#define BR_TX_IN_SIZE  (sizeof(const uint8_t *) + sizeof(br_span) + 2*sizeof(uint32_t))
+#define BR_TX_OUT_SIZE (sizeof(uint64_t) + sizeof(br_span))
+
+int br_tx_resize(br_tx *tx, size_t inputs, size_t outputs)
+{
+    tx->raw = NULL;
+    tx->raw_len = 0;
+
+    if (inputs > tx->in_cap || outputs > tx->out_cap) {
+        size_t in_cap = (inputs > tx->in_cap) ? inputs + inputs/2 : tx->in_cap,
+               out_cap = (outputs > tx->out_cap) ? outputs + outputs/2 : tx->out_cap;
+        uint8_t *mem;
+        br_tx old;
+        size_t n;
+
+        if (in_cap > SIZE_MAX/BR_TX_IN_SIZE/2 || out_cap > SIZE_MAX/BR_TX_OUT_SIZE/2) return 0;
+        mem = malloc(in_cap*BR_TX_IN_SIZE + out_cap*BR_TX_OUT_SIZE + 1);
+        if (! mem) return 0;
+        old = *tx;
+        tx->mem = mem;
+        tx->in_cap = in_cap;
+        tx->out_cap = out_cap;
+        tx->in_hash = (const uint8_t **)mem;
+        tx->in_script = (br_span *)(tx->in_hash + in_cap);
+        tx->out_script = (br_span *)(tx->in_script + in_cap);
+        tx->out_amount = (uint64_t *)(tx->out_script + out_cap);
+        tx->in_index = (uint32_t *)(tx->out_amount + out_cap);
+        tx->in_sequence = tx->in_index + in_cap;
+
+        // keep the inputs and outputs there are, the parser sizes the outputs only once it has read the inputs
+        n = (old.in_count < inputs) ? old.in_count : inputs;
+
+        if (n > 0) {
+            memcpy(tx->in_hash, old.in_hash, n*sizeof(*tx->in_hash));
+            memcpy(tx->in_script, old.in_script, n*sizeof(*tx->in_script));
+            memcpy(tx->in_index, old.in_index, n*sizeof(*tx->in_index));
+            memcpy(tx->in_sequence, old.in_sequence, n*sizeof(*tx->in_sequence));
+        }
+
+        n = (old.out_count < outputs) ? old.out_count : outputs;
+
+        if (n > 0) {
+            memcpy(tx->out_script, old.out_script, n*sizeof(*tx->out_script));
+            memcpy(tx->out_amount, old.out_amount, n*sizeof(*tx->out_amount));
+        }
+
+        free(old.mem);
+    }
+
+    tx->in_count = inputs;
+    tx->out_count = outputs;
+    return 1;
+}
+
+static uint32_t br_tx_get32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t br_tx_get64(const uint8_t *p)
+{
+    return br_tx_get32(p) | ((uint64_t)br_tx_get32(p + 4) << 32);
+}
+
+// reads a varint at off, moving off past it; returns 0 and leaves off alone if it does not fit in len
+static int br_tx_varint(const uint8_t *buf, size_t len, size_t *off, uint64_t *u)
+{
+    size_t o = *off, l;
+
+    if (o >= len) return 0;
+    l = (buf[o] < 0xfd) ? 1 : (buf[o] == 0xfd) ? 3 : (buf[o] == 0xfe) ? 5 : 9;
+    if (len - o < l) return 0;
+
+    if (l == 1) *u = buf[o];
+    else if (l == 3) *u = buf[o + 1] | ((uint64_t)buf[o + 2] << 8);
+    else if (l == 5) *u = br_tx_get32(buf + o + 1);
+    else *u = br_tx_get64(buf + o + 1);
+
+    *off = o + l;
+    return 1;
+}
+
+static int br_tx_span_at(const uint8_t *buf, size_t len, size_t *off, br_span *s)
+{
+    size_t o = *off;
+    uint64_t l;
+
+    if (! br_tx_varint(buf, len, &o, &l) || l > len - o) return 0;
+    s->p = buf + o;
+    s->len = (size_t)l;
+    *off = o + (size_t)l;
+    return 1;
+}
+
+size_t br_tx_parse(br_tx *tx, const uint8_t *buf, size_t len)
+{
+    size_t off = 4;
+    uint64_t inputs, outputs;
+
+    if (len > BR_TX_MAX_SIZE) len = BR_TX_MAX_SIZE;
+    // bound the counts by the smallest input (41 bytes) and output (9 bytes) before sizing anything by them
+    if (len < 4 || ! br_tx_varint(buf, len, &off, &inputs) || inputs == 0 || inputs > len/41) return 0;
+    if (! br_tx_resize(tx, (size_t)inputs, 0)) return 0;
+    tx->version = br_tx_get32(buf);
+
+    for (size_t i = 0; i < tx->in_count; i++) {
+        if (len - off < 36) return 0;
+        tx->in_hash[i] = buf + off;
+        tx->in_index[i] = br_tx_get32(buf + off + 32);
+        off += 36;
+        if (! br_tx_span_at(buf, len, &off, &tx->in_script[i]) || len - off < 4) return 0;
+        tx->in_sequence[i] = br_tx_get32(buf + off);
+        off += 4;
+    }
+
+    if (! br_tx_varint(buf, len, &off, &outputs) || outputs > (len - off)/9) return 0;
+    if (! br_tx_resize(tx, tx->in_count, (size_t)outputs)) return 0;
+
+    for (size_t i = 0; i < tx->out_count; i++) {
+        if (len - off < 8) return 0;
+        tx->out_amount[i] = br_tx_get64(buf + off);
+        off += 8;
+        if (! br_tx_span_at(buf, len, &off, &tx->out_script[i])) return 0;
+    }
+
+    if (len - off < 4) return 0;
+    tx->lock_time = br_tx_get32(buf + off);
+    off += 4;
+    tx->raw = buf;
+    tx->raw_len = off;
+    return off;
+}
+
+static size_t br_tx_varint_size(uint64_t u)
+{
+    return (u < 0xfd) ? 1 : (u <= 0xffff) ? 3 : (u <= 0xffffffffu) ? 5 : 9;
+}
+
+size_t br_tx_size(const br_tx *tx)
+{
+    size_t size;
+
+    if (tx->raw) return tx->raw_len;
+    size = 4 + br_tx_varint_size(tx->in_count) + br_tx_varint_size(tx->out_count) + 4;
+
+    for (size_t i = 0; i < tx->in_count; i++) {
+        size += 36 + br_tx_varint_size(tx->in_script[i].len) + tx->in_script[i].len + 4;
+    }
+
+    for (size_t i = 0; i < tx->out_count; i++) {
+        size += 8 + br_tx_varint_size(tx->out_script[i].len) + tx->out_script[i].len;
+    }
+
+    return size;
+}
+
+static size_t br_tx_put_varint(uint8_t *p, uint64_t u)
+{
+    size_t l = br_tx_varint_size(u);
+
+    p[0] = (l == 1) ? (uint8_t)u : (l == 3) ? 0xfd : (l == 5) ? 0xfe : 0xff;
+    for (size_t i = 1; i < l; i++) p[i] = (uint8_t)(u >> 8*(i - 1));
+    return l;
+}
+
+static size_t br_tx_put32(uint8_t *p, uint32_t u)
+{
+    for (size_t i = 0; i < 4; i++) p[i] = (uint8_t)(u >> 8*i);
+    return 4;
+}
+
+void br_tx_serialize(const br_tx *tx, int with_scripts, br_tx_writer write, void *info)
+{
+    uint8_t b[64]; // fixed size fields are gathered here between the scripts, which are handed out in place
+    size_t l;
+
+    if (tx->raw && with_scripts) {
+        write(info, tx->raw, tx->raw_len);
+        return;
+    }
+
+    l = br_tx_put32(b, tx->version);
+    l += br_tx_put_varint(b + l, tx->in_count);
+
+    for (size_t i = 0; i < tx->in_count; i++) {
+        size_t script_len = (with_scripts) ? tx->in_script[i].len : 0;
+
+        write(info, b, l);
+        write(info, tx->in_hash[i], 32);
+        l = br_tx_put32(b, tx->in_index[i]);
+        l += br_tx_put_varint(b + l, script_len);
+        write(info, b, l);
+        if (script_len > 0) write(info, tx->in_script[i].p, script_len);
+        l = br_tx_put32(b, tx->in_sequence[i]);
+    }
+
+    l += br_tx_put_varint(b + l, tx->out_count);
+
+    for (size_t i = 0; i < tx->out_count; i++) {
+        l += br_tx_put32(b + l, (uint32_t)tx->out_amount[i]);
+        l += br_tx_put32(b + l, (uint32_t)(tx->out_amount[i] >> 32));
+        l += br_tx_put_varint(b + l, tx->out_script[i].len);
+        write(info, b, l);
+        if (tx->out_script[i].len > 0) write(info, tx->out_script[i].p, tx->out_script[i].len);
+        l = 0;
+    }
+
+    l += br_tx_put32(b + l, tx->lock_time);
+    write(info, b, l);
+}
+
+static void br_tx_sha256_writer(void *info, const uint8_t *bytes, size_t len)
+{
+    sph_sha256(info, bytes, len);
+}
+
+void br_tx_hash(const br_tx *tx, uint8_t *md)
+{
+    sph_sha256_context sha;
+
+    sph_sha256_init(&sha);
+    br_tx_serialize(tx, 1, br_tx_sha256_writer, &sha);
+    sph_sha256_close(&sha, md); // close leaves the context initialised for the second round
+    sph_sha256(&sha, md, 32);
+    sph_sha256_close(&sha, md);
+}
+
+// reads the script element at *i, moving *i past it; returns 0 at the end of the script, or where it stops being well
+// formed; *op is the opcode, or for pushed data the opcode that pushes its length, and data is what is pushed
+static int br_tx_script_next(br_span script, size_t *i, int *op, br_span *data)
+{
+    const uint8_t *b = script.p;
+    size_t l, k = *i;
+
+    if (k >= script.len) return 0;
+
+    if (b[k] > BR_OP_PUSHDATA4 || b[k] == 0) {
+        *op = b[k];
+        *i = k + 1;
+        return 1;
+    }
+
+    if (b[k] < BR_OP_PUSHDATA1) l = b[k++];
+    else if (b[k] == BR_OP_PUSHDATA1 && script.len - k > 1) l = b[k + 1], k += 2;
+    else if (b[k] == BR_OP_PUSHDATA2 && script.len - k > 2) l = b[k + 1] | (b[k + 2] << 8), k += 3;
+    else if (b[k] == BR_OP_PUSHDATA4 && script.len - k > 4) l = br_tx_get32(b + k + 1), k += 5;
+    else return 0;
+
+    if (l > script.len - k) return 0;
+    *op = (l < BR_OP_PUSHDATA1) ? (int)l : (l <= 0xff) ? BR_OP_PUSHDATA1 : (l <= 0xffff) ? BR_OP_PUSHDATA2 :
+          BR_OP_PUSHDATA4;
+    data->p = b + k;
+    data->len = l;
+    *i = k + l;
+    return 1;
+}
+
+// splits a script into at most max elements the way -[NSData scriptElements] does, returns how many there are, or
+// max + 1 if there are more; ops[i] is the opcode, or for pushed data the opcode that pushes its length
+static size_t br_tx_script_elements(br_span script, size_t max, int *ops, br_span *data)
+{
+    size_t n = 0, i = 0;
+    br_span d;
+    int op;
+
+    while (n <= max && br_tx_script_next(script, &i, &op, &d)) {
+        if (n < max) ops[n] = op, data[n] = d;
+        n++;
+    }
+
+    return n;
+}
+
+static void br_tx_hash160(const uint8_t *data, size_t len, uint8_t *h160)
+{
+    sph_sha256_context sha;
+    sph_ripemd160_context rmd;
+    uint8_t md[32];
+
+    sph_sha256_init(&sha);
+    sph_sha256(&sha, data, len);
+    sph_sha256_close(&sha, md);
+    sph_ripemd160_init(&rmd);
+    sph_ripemd160(&rmd, md, sizeof(md));
+    sph_ripemd160_close(&rmd, h160);
+}
+
+br_tx_script_type br_tx_script_hash160(const uint8_t *script, size_t len, uint8_t *h160)
+{
+    br_span s = { script, len }, data[5];
+    int ops[5];
+    size_t n = br_tx_script_elements(s, 5, ops, data);
+
+    if (n == 5 && ops[0] == BR_OP_DUP && ops[1] == BR_OP_HASH160 && ops[2] == 20 && ops[3] == BR_OP_EQUALVERIFY &&
+        ops[4] == BR_OP_CHECKSIG) {
+        memcpy(h160, data[2].p, 20);
+        return BR_TX_SCRIPT_PUBKEY_HASH;
+    }
+
+    if (n == 3 && ops[0] == BR_OP_HASH160 && ops[1] == 20 && ops[2] == BR_OP_EQUAL) {
+        memcpy(h160, data[1].p, 20);
+        return BR_TX_SCRIPT_HASH;
+    }
+
+    if (n == 2 && (ops[0] == 65 || ops[0] == 33) && ops[1] == BR_OP_CHECKSIG) {
+        br_tx_hash160(data[0].p, data[0].len, h160);
+        return BR_TX_SCRIPT_PUBKEY_HASH;
+    }
+
+    return BR_TX_SCRIPT_OTHER;
+}
+
+br_tx_script_type br_tx_sig_hash160(const uint8_t *script, size_t len, uint8_t *h160)
+{
+    br_span s = { script, len }, data[2] = { { NULL, 0 }, { NULL, 0 } }, d;
+    int ops[2] = { 0, 0 }, op;
+    size_t i = 0, n = 0;
+
+    while (br_tx_script_next(s, &i, &op, &d)) { // only the last two elements matter
+        ops[0] = ops[1], data[0] = data[1];
+        ops[1] = op, data[1] = d;
+        n++;
+    }
+
+    if (n < 2 || ops[0] <= 0 || ops[0] > BR_OP_PUSHDATA4 || ops[1] <= 0 || ops[1] > BR_OP_PUSHDATA4) {
+        return BR_TX_SCRIPT_OTHER;
+    }
+
+    br_tx_hash160(data[1].p, data[1].len, h160);
+    return (ops[1] == 65 || ops[1] == 33) ? BR_TX_SCRIPT_PUBKEY_HASH : BR_TX_SCRIPT_HASH;
+}
@@ -0,0 +1,97 @@
+//
+//  BRTxCodec.h
+//  SolarisWallet
+//
+//  Parses and serialises transactions in wire format without an object per field.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRTxCodec_h
+#define BRTxCodec_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BR_TX_MAX_SIZE 0x02000000 // no message is larger, see BR_FRAMER_MAX_MSG_LENGTH
+
+typedef struct {
+    const uint8_t *p;
+    size_t len;
+} br_span;
+
+typedef struct {
+    uint32_t version, lock_time;
+    size_t in_count, out_count;
+    const uint8_t **in_hash; // 32 byte hash of the transaction each input spends from
+    uint32_t *in_index; // index of the output each input spends
+    br_span *in_script; // signature scripts, empty while unsigned
+    uint32_t *in_sequence;
+    uint64_t *out_amount;
+    br_span *out_script;
+    const uint8_t *raw; // the serialised transaction br_tx_parse() read, NULL once any field may have changed
+    size_t raw_len;
+    void *mem; // the block the arrays live in
+    size_t in_cap, out_cap;
+} br_tx;
+
+typedef enum {
+    BR_TX_SCRIPT_OTHER = 0,
+    BR_TX_SCRIPT_PUBKEY_HASH = 1, // pay-to-pubkey-hash, or pay-to-pubkey with the hash of the pubkey
+    BR_TX_SCRIPT_HASH = 2, // pay-to-script-hash
+} br_tx_script_type;
+
+// writes len bytes of a serialisation to wherever info points
+typedef void (*br_tx_writer)(void *info, const uint8_t *bytes, size_t len);
+
+// returns an empty transaction, or NULL if out of memory
+br_tx *br_tx_new(void);
+
+// frees the transaction's arrays, not the buffers its hashes and scripts point into
+void br_tx_free(br_tx *tx);
+
+// sets the numbers of inputs and outputs, growing the arrays if needed; the fields of the inputs and outputs kept are
+// unchanged, those of new ones are left to the caller; returns 0 if out of memory
+int br_tx_resize(br_tx *tx, size_t inputs, size_t outputs);
+
+// reads one transaction from the start of buf, pointing tx's hashes and scripts into buf, which has to outlive the use
+// of tx; returns the number of bytes read, or 0 if buf does not start with a well formed transaction with at least one
+// input, or if out of memory
+size_t br_tx_parse(br_tx *tx, const uint8_t *buf, size_t len);
+
+// the length of the serialised transaction
+size_t br_tx_size(const br_tx *tx);
+
+// hands the serialised transaction to write in pieces, with the signature scripts included if with_scripts is set
+void br_tx_serialize(const br_tx *tx, int with_scripts, br_tx_writer write, void *info);
+
+// writes the double sha256 of the serialised transaction, its txid in internal byte order, to md
+void br_tx_hash(const br_tx *tx, uint8_t *md);
+
+// classifies an output script the way +[NSString addressWithScriptPubKey:] does and writes the hash160 the address is
+// made of to h160, for pay-to-pubkey scripts the hash160 of the pubkey; nothing is written for BR_TX_SCRIPT_OTHER
+br_tx_script_type br_tx_script_hash160(const uint8_t *script, size_t len, uint8_t *h160);
+
+// classifies an input's signature script the way +[NSString addressWithScriptSig:] does and writes the hash160 of the
+// address it spends from to h160: of the pubkey it ends with, or of the redeem script; nothing is written for
+// BR_TX_SCRIPT_OTHER
+br_tx_script_type br_tx_sig_hash160(const uint8_t *script, size_t len, uint8_t *h160);
+
+#endif /* BRTxCodec_h */
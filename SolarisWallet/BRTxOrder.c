@@ -0,0 +1,214 @@
+//
+//  BRTxOrder.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRTxOrder.h"
+#include "BRTxStore.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const br_txorder_tx *txs;
+    const int *rank;
+    size_t *a, count;
+} br_txorder_heap;
+
+// returns 1 if transaction x goes ahead of transaction y when the spends leave them unordered
+static int br_txorder_ahead(const br_txorder_heap *h, size_t x, size_t y)
+{
+    if (h->rank[x] != h->rank[y]) return h->rank[x] > h->rank[y];
+    if (h->txs[x].tie != h->txs[y].tie) return h->txs[x].tie > h->txs[y].tie;
+    return x < y;
+}
+
+static void br_txorder_push(br_txorder_heap *h, size_t x)
+{
+    size_t i = h->count++;
+
+    while (i > 0 && br_txorder_ahead(h, x, h->a[(i - 1)/2])) {
+        h->a[i] = h->a[(i - 1)/2];
+        i = (i - 1)/2;
+    }
+
+    h->a[i] = x;
+}
+
+static size_t br_txorder_pop(br_txorder_heap *h)
+{
+    size_t top = h->a[0], x = h->a[--h->count], i = 0, c;
+
+    while ((c = 2*i + 1) < h->count) {
+        if (c + 1 < h->count && br_txorder_ahead(h, h->a[c + 1], h->a[c])) c++;
+        if (! br_txorder_ahead(h, h->a[c], x)) break;
+        h->a[i] = h->a[c];
+        i = c;
+    }
+
+    h->a[i] = x;
+    return top;
+}
+
+// sorts the positions by block height, highest first, keeping them in order within a block
+static void br_txorder_by_height(const br_txorder_tx *txs, size_t n, size_t *a, size_t *tmp)
+{
+    size_t *src = a, *dst = tmp, *t;
+
+    for (size_t i = 0; i < n; i++) a[i] = i;
+
+    for (unsigned shift = 0; n > 0 && shift < 32; shift += 8) { // radix sort on the complement of the height
+        size_t counts[257] = { 0 };
+
+        for (size_t i = 0; i < n; i++) counts[((~txs[src[i]].height >> shift) & 0xff) + 1]++;
+        if (counts[((~txs[src[0]].height >> shift) & 0xff) + 1] == n) continue; // all in one bucket
+        for (size_t d = 1; d < 257; d++) counts[d] += counts[d - 1];
+        for (size_t i = 0; i < n; i++) dst[counts[(~txs[src[i]].height >> shift) & 0xff]++] = src[i];
+        t = src, src = dst, dst = t;
+    }
+
+    if (src != a) memcpy(a, src, n*sizeof(*a));
+}
+
+typedef struct {
+    br_txstore *index; // transaction hash to position + 1
+    size_t *by_height, *queue, *first, *parents, *kid_first, *kids, *left;
+    int *rank;
+    uint8_t *done;
+} br_txorder_work;
+
+static int br_txorder_run(const br_txorder_tx *txs, size_t n, size_t *order, br_txorder_work *w)
+{
+    br_txorder_heap h = { txs, w->rank, w->queue, 0 };
+    size_t *first = w->first, *parents = w->parents, *kid_first = w->kid_first, *kids = w->kids, *left = w->left;
+    int *rank = w->rank;
+
+    for (size_t i = 0; i < n; i++) {
+        if (! br_txstore_put(w->index, txs[i].hash, (void *)(uintptr_t)(i + 1), 0)) return 0;
+    }
+
+    // the transactions each one spends in its own block, and the ones spending each one
+    for (size_t i = 0, e = 0; i < n; i++) {
+        first[i] = e;
+
+        for (size_t j = 0; j < txs[i].in_count; j++) {
+            size_t p = (size_t)(uintptr_t)br_txstore_get(w->index, txs[i].in_hash + j*32);
+
+            if (p == 0 || p - 1 == i || txs[p - 1].height != txs[i].height) continue;
+            parents[e++] = p - 1;
+            kid_first[p]++;
+        }
+
+        first[i + 1] = e;
+    }
+
+    for (size_t i = 0; i < n; i++) kid_first[i + 1] += kid_first[i];
+    memcpy(left, kid_first, n*sizeof(*left));
+
+    for (size_t i = 0; i < n; i++) {
+        for (size_t e = first[i]; e < first[i + 1]; e++) kids[left[parents[e]]++] = i;
+    }
+
+    // raise each transaction's rank to those of what it spends, oldest first
+    for (size_t i = 0; i < n; i++) {
+        rank[i] = txs[i].rank;
+        left[i] = first[i + 1] - first[i];
+        if (left[i] == 0) h.a[h.count++] = i;
+    }
+
+    for (size_t q = 0; q < h.count; q++) {
+        size_t i = h.a[q];
+
+        for (size_t e = kid_first[i]; e < kid_first[i + 1]; e++) {
+            if (rank[kids[e]] < rank[i]) rank[kids[e]] = rank[i];
+            if (--left[kids[e]] == 0) h.a[h.count++] = kids[e];
+        }
+    }
+
+    // then emit each block most recent first, a transaction once every one spending it is out
+    br_txorder_by_height(txs, n, w->by_height, order);
+    h.count = 0;
+
+    for (size_t lo = 0, hi, k = 0; lo < n; lo = hi) {
+        size_t next = lo;
+
+        for (hi = lo; hi < n && txs[w->by_height[hi]].height == txs[w->by_height[lo]].height; hi++) {
+            size_t i = w->by_height[hi];
+
+            left[i] = kid_first[i + 1] - kid_first[i];
+            if (left[i] == 0) br_txorder_push(&h, i);
+        }
+
+        while (k < hi) {
+            size_t i;
+
+            if (h.count == 0) { // what is left of the block spends in a circle
+                while (w->done[w->by_height[next]]) next++;
+                br_txorder_push(&h, w->by_height[next]);
+            }
+
+            i = br_txorder_pop(&h);
+            w->done[i] = 1;
+            order[k++] = i;
+
+            for (size_t e = first[i]; e < first[i + 1]; e++) {
+                if (! w->done[parents[e]] && --left[parents[e]] == 0) br_txorder_push(&h, parents[e]);
+            }
+        }
+    }
+
+    return 1;
+}
+
+int br_txorder_sort(const br_txorder_tx *txs, size_t n, size_t *order)
+{
+    br_txorder_work w;
+    size_t edges = 0;
+    int r = 0;
+
+    for (size_t i = 0; i < n; i++) edges += txs[i].in_count;
+    w.index = br_txstore_new(NULL);
+    w.by_height = malloc((n + 1)*sizeof(*w.by_height));
+    w.queue = malloc((n + 1)*sizeof(*w.queue));
+    w.first = malloc((n + 1)*sizeof(*w.first));
+    w.parents = malloc((edges + 1)*sizeof(*w.parents));
+    w.kid_first = calloc(n + 1, sizeof(*w.kid_first));
+    w.kids = malloc((edges + 1)*sizeof(*w.kids));
+    w.left = malloc((n + 1)*sizeof(*w.left));
+    w.rank = malloc((n + 1)*sizeof(*w.rank));
+    w.done = calloc(n + 1, 1);
+
+    if (w.index && w.by_height && w.queue && w.first && w.parents && w.kid_first && w.kids && w.left && w.rank &&
+        w.done) r = br_txorder_run(txs, n, order, &w);
+
+    br_txstore_free(w.index);
+    free(w.by_height);
+    free(w.queue);
+    free(w.first);
+    free(w.parents);
+    free(w.kid_first);
+    free(w.kids);
+    free(w.left);
+    free(w.rank);
+    free(w.done);
+    return r;
+}
@@ -0,0 +1,46 @@
+//
+//  BRTxOrder.h
+//  SolarisWallet
+//
+//  Orders the wallet's transactions most recent first, each ahead of the transactions it spends.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRTxOrder_h
+#define BRTxOrder_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct {
+    const uint8_t *hash; // 32 bytes
+    uint32_t height;
+    int rank; // BRWallet ranks invalid transactions 2, pending ones 1 and the others 0
+    uint64_t tie; // BRWallet uses 1 + the position in its address chains of the first output address found there
+    size_t in_count;
+    const uint8_t *in_hash; // in_count packed 32 byte hashes of the transactions being spent
+} br_txorder_tx;
+
+// writes to order the positions in txs of the n transactions, most recent first; spends that go around in a circle,
+// which real transactions cannot, are broken at the one given first; returns 0 if out of memory
+int br_txorder_sort(const br_txorder_tx *txs, size_t n, size_t *order);
+
+#endif /* BRTxOrder_h */
@@ -0,0 +1,695 @@
+//
+//  BRTxStore.c
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRTxStore.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define BR_TXSTORE_NEON 1
+#endif
+
+#define BR_GROUP        16 // slots whose tags are compared at once, one sse2 or neon register
+#define BR_CTRL_EMPTY   0x80
+#define BR_CTRL_DELETED 0xfe
+#define BR_MIN_SLOTS    (4*BR_GROUP)
+#define BR_MIN_ENTRIES  64
+
+// the slots of a table are split in groups of BR_GROUP, probed group by group in triangular steps, which visit every
+// group of a power of two count; a group with an empty slot ends the probe, so a slot is only marked empty again on
+// removal if its group has an empty one already, and deleted otherwise
+typedef struct {
+    uint8_t *ctrl; // a tag per slot, the top 7 bits of the key's hash, or BR_CTRL_EMPTY or BR_CTRL_DELETED
+    uint32_t *idx; // the entry each tagged slot holds
+    size_t cap, used, deleted; // cap is a power of two multiple of BR_GROUP
+} br_table;
+
+typedef struct {
+    uint8_t hash[32];
+    void *tx;
+    uint32_t height, pos; // pos is the entry's place in list, UINT32_MAX if not listed
+} br_txentry;
+
+struct br_txstore {
+    br_table t;
+    br_txentry *e; // dense, removing an entry moves the last one into its place
+    size_t count, cap;
+    uint32_t *list; // entry indexes, the most recent transaction last so that listing a new one appends it
+    size_t list_count, list_cap;
+    void (*release)(void *tx);
+    uint64_t salt;
+};
+
+struct br_outset {
+    br_table t;
+    uint8_t *keys; // packed outpoints in the order they were added, removed ones included until compacted
+    uint64_t *dead; // a bit per outpoint in keys, set once it is removed
+    size_t count, cap, live;
+    uint64_t salt;
+};
+
+struct br_addrset {
+    br_table t;
+    uint8_t *keys; // packed address keys in the order they were added
+    uint32_t *values;
+    size_t count, cap;
+    uint64_t salt;
+};
+
+static uint64_t _salt;
+static pthread_once_t _salt_once = PTHREAD_ONCE_INIT;
+
+// a random key for the table hashes, so that nobody can pick transaction hashes that pile up in one group
+static void br_txstore_salt_init(void)
+{
+#if __APPLE__
+    arc4random_buf(&_salt, sizeof(_salt));
+#else
+    FILE *f = fopen("/dev/urandom", "rb");
+
+    if (! f || fread(&_salt, sizeof(_salt), 1, f) != 1) _salt = (uint64_t)(uintptr_t)&_salt ^ 0x9e3779b97f4a7c15ull;
+    if (f) fclose(f);
+#endif
+}
+
+// transaction hashes and hash160s are uniformly distributed already, so the first and last 8 of their len bytes mixed
+// with the salt and the output index or script type are enough; taking both ends keeps hashes that happen to share a
+// prefix out of each other's groups
+static uint64_t br_table_hash(uint64_t salt, const uint8_t *hash, size_t len, uint32_t n)
+{
+    uint64_t h, t;
+
+    memcpy(&h, hash, sizeof(h));
+    memcpy(&t, hash + len - sizeof(t), sizeof(t));
+    h = (h ^ salt ^ (((uint64_t)n << 32) | n))*0x9e3779b97f4a7c15ull;
+    h = (h ^ (h >> 29) ^ t)*0xbf58476d1ce4e5b9ull;
+    return h ^ (h >> 31);
+}
+
+#if BR_TXSTORE_NEON
+// a bit per lane that is all ones, like _mm_movemask_epi8()
+static uint32_t br_neon_mask(uint8x16_t v)
+{
+    static const uint8_t bit[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t m = vandq_u8(v, vld1q_u8(bit));
+
+    return vaddv_u8(vget_low_u8(m)) | ((uint32_t)vaddv_u8(vget_high_u8(m)) << 8);
+}
+#endif
+
+// a bit per slot of the group whose tag is tag
+static uint32_t br_group_match(const uint8_t *g, uint8_t tag)
+{
+#if defined(__SSE2__)
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)g), _mm_set1_epi8((char)tag)));
+#elif BR_TXSTORE_NEON
+    return br_neon_mask(vceqq_u8(vld1q_u8(g), vdupq_n_u8(tag)));
+#else
+    uint32_t m = 0;
+
+    for (int i = 0; i < BR_GROUP; i++) m |= (uint32_t)(g[i] == tag) << i;
+    return m;
+#endif
+}
+
+// a bit per slot of the group that is empty or deleted, the two tags with the top bit set
+static uint32_t br_group_free(const uint8_t *g)
+{
+#if defined(__SSE2__)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)g));
+#elif BR_TXSTORE_NEON
+    return br_neon_mask(vtstq_u8(vld1q_u8(g), vdupq_n_u8(0x80)));
+#else
+    uint32_t m = 0;
+
+    for (int i = 0; i < BR_GROUP; i++) m |= (uint32_t)(g[i] >> 7) << i;
+    return m;
+#endif
+}
+
+// replaces the table's slots with cap empty ones, returns 0 if out of memory, leaving the table as it was
+static int br_table_alloc(br_table *t, size_t cap)
+{
+    uint8_t *ctrl = malloc(cap);
+    uint32_t *idx = malloc(cap*sizeof(*idx));
+
+    if (! ctrl || ! idx) {
+        free(ctrl);
+        free(idx);
+        return 0;
+    }
+
+    memset(ctrl, BR_CTRL_EMPTY, cap);
+    free(t->ctrl);
+    free(t->idx);
+    t->ctrl = ctrl;
+    t->idx = idx;
+    t->cap = cap;
+    t->used = t->deleted = 0;
+    return 1;
+}
+
+// the size a table holding used + 1 entries is rehashed to, or 0 if there is room without rehashing; the load,
+// deleted slots included, stays under 7/8, and a rehash leaves it under 7/16
+static size_t br_table_rehash_size(const br_table *t)
+{
+    size_t cap = t->cap;
+
+    if (t->used + t->deleted + 1 <= cap - cap/8) return 0;
+    if (cap < BR_MIN_SLOTS) cap = BR_MIN_SLOTS;
+    while (t->used + 1 > (cap - cap/8)/2) cap *= 2;
+    return cap;
+}
+
+// the slot holding the entry whose key is key, or SIZE_MAX
+static size_t br_table_find(const br_table *t, uint64_t h, const uint8_t *key, size_t key_len,
+                            const uint8_t *entries, size_t stride)
+{
+    size_t mask = t->cap/BR_GROUP - 1, g = h & mask;
+    uint8_t tag = (uint8_t)(h >> 57);
+
+    for (size_t step = 0; t->cap > 0 && step <= mask; g = (g + ++step) & mask) {
+        const uint8_t *c = t->ctrl + g*BR_GROUP;
+
+        for (uint32_t m = br_group_match(c, tag); m; m &= m - 1) {
+            size_t slot = g*BR_GROUP + (size_t)__builtin_ctz(m);
+
+            if (memcmp(entries + t->idx[slot]*stride, key, key_len) == 0) return slot;
+        }
+
+        if (br_group_match(c, BR_CTRL_EMPTY)) break;
+    }
+
+    return SIZE_MAX;
+}
+
+// puts entry in the first free slot on its probe sequence, the key must not be in the table and there must be room
+static void br_table_insert(br_table *t, uint64_t h, uint32_t entry)
+{
+    size_t mask = t->cap/BR_GROUP - 1, g = h & mask, step = 0, slot;
+    uint32_t m;
+
+    while (! (m = br_group_free(t->ctrl + g*BR_GROUP))) g = (g + ++step) & mask;
+    slot = g*BR_GROUP + (size_t)__builtin_ctz(m);
+    if (t->ctrl[slot] == BR_CTRL_DELETED) t->deleted--;
+    t->ctrl[slot] = (uint8_t)(h >> 57);
+    t->idx[slot] = entry;
+    t->used++;
+}
+
+static void br_table_erase(br_table *t, size_t slot)
+{
+    if (br_group_match(t->ctrl + (slot & ~(size_t)(BR_GROUP - 1)), BR_CTRL_EMPTY)) t->ctrl[slot] = BR_CTRL_EMPTY;
+    else t->ctrl[slot] = BR_CTRL_DELETED, t->deleted++;
+    t->used--;
+}
+
+static void br_table_free(br_table *t)
+{
+    free(t->ctrl);
+    free(t->idx);
+}
+
+br_txstore *br_txstore_new(void (*release)(void *tx))
+{
+    br_txstore *s = calloc(1, sizeof(*s));
+
+    if (! s) return NULL;
+    pthread_once(&_salt_once, br_txstore_salt_init);
+    s->release = release;
+    s->salt = _salt;
+    return s;
+}
+
+void br_txstore_free(br_txstore *s)
+{
+    if (! s) return;
+
+    for (size_t i = 0; s->release && i < s->count; i++) {
+        s->release(s->e[i].tx);
+    }
+
+    br_table_free(&s->t);
+    free(s->e);
+    free(s->list);
+    free(s);
+}
+
+size_t br_txstore_count(const br_txstore *s)
+{
+    return s->count;
+}
+
+static size_t br_txstore_slot(const br_txstore *s, const uint8_t *hash)
+{
+    return br_table_find(&s->t, br_table_hash(s->salt, hash, 32, 0), hash, 32, (const uint8_t *)s->e, sizeof(*s->e));
+}
+
+static br_txentry *br_txstore_entry(const br_txstore *s, const uint8_t *hash)
+{
+    size_t slot = br_txstore_slot(s, hash);
+
+    return (slot != SIZE_MAX) ? &s->e[s->t.idx[slot]] : NULL;
+}
+
+// makes room for one more entry, returns 0 if out of memory
+static int br_txstore_reserve(br_txstore *s)
+{
+    size_t cap = br_table_rehash_size(&s->t);
+
+    if (s->count == s->cap) {
+        size_t c = (s->cap) ? s->cap*2 : BR_MIN_ENTRIES;
+        br_txentry *e = (s->count < UINT32_MAX) ? realloc(s->e, c*sizeof(*e)) : NULL;
+
+        if (! e) return 0;
+        s->e = e;
+        s->cap = c;
+    }
+
+    if (cap == 0) return 1;
+    if (! br_table_alloc(&s->t, cap)) return 0;
+
+    for (size_t i = 0; i < s->count; i++) {
+        br_table_insert(&s->t, br_table_hash(s->salt, s->e[i].hash, 32, 0), (uint32_t)i);
+    }
+
+    return 1;
+}
+
+int br_txstore_put(br_txstore *s, const uint8_t *hash, void *tx, uint32_t height)
+{
+    br_txentry *e = br_txstore_entry(s, hash);
+
+    if (e) {
+        if (s->release) s->release(e->tx);
+        e->tx = tx;
+        e->height = height;
+        return 1;
+    }
+
+    if (! br_txstore_reserve(s)) return 0;
+    e = &s->e[s->count];
+    memcpy(e->hash, hash, sizeof(e->hash));
+    e->tx = tx;
+    e->height = height;
+    e->pos = UINT32_MAX;
+    br_table_insert(&s->t, br_table_hash(s->salt, hash, 32, 0), (uint32_t)s->count++);
+    return 1;
+}
+
+void *br_txstore_get(const br_txstore *s, const uint8_t *hash)
+{
+    br_txentry *e = br_txstore_entry(s, hash);
+
+    return (e) ? e->tx : NULL;
+}
+
+uint32_t br_txstore_height(const br_txstore *s, const uint8_t *hash)
+{
+    br_txentry *e = br_txstore_entry(s, hash);
+
+    return (e) ? e->height : UINT32_MAX;
+}
+
+int br_txstore_set_height(br_txstore *s, const uint8_t *hash, uint32_t height)
+{
+    br_txentry *e = br_txstore_entry(s, hash);
+
+    if (! e) return 0;
+    e->height = height;
+    return 1;
+}
+
+// takes entry i off the list, renumbering the places of those after it
+static void br_txstore_unlist(br_txstore *s, size_t i)
+{
+    size_t pos = s->e[i].pos;
+
+    memmove(s->list + pos, s->list + pos + 1, (s->list_count - pos - 1)*sizeof(*s->list));
+    s->list_count--;
+    for (size_t p = pos; p < s->list_count; p++) s->e[s->list[p]].pos = (uint32_t)p;
+    s->e[i].pos = UINT32_MAX;
+}
+
+int br_txstore_remove(br_txstore *s, const uint8_t *hash)
+{
+    size_t slot = br_txstore_slot(s, hash), i, last;
+
+    if (slot == SIZE_MAX) return 0;
+    i = s->t.idx[slot];
+    if (s->e[i].pos != UINT32_MAX) br_txstore_unlist(s, i);
+    br_table_erase(&s->t, slot);
+    if (s->release) s->release(s->e[i].tx);
+    last = --s->count;
+
+    if (i != last) { // move the last entry into the hole, pointing its slot and its place in the list at it
+        s->e[i] = s->e[last];
+        s->t.idx[br_txstore_slot(s, s->e[i].hash)] = (uint32_t)i;
+        if (s->e[i].pos != UINT32_MAX) s->list[s->e[i].pos] = (uint32_t)i;
+    }
+
+    return 1;
+}
+
+size_t br_txstore_list_count(const br_txstore *s)
+{
+    return s->list_count;
+}
+
+void *br_txstore_list_get(const br_txstore *s, size_t i)
+{
+    return s->e[s->list[s->list_count - 1 - i]].tx;
+}
+
+const uint8_t *br_txstore_list_hash(const br_txstore *s, size_t i)
+{
+    return s->e[s->list[s->list_count - 1 - i]].hash;
+}
+
+size_t br_txstore_list_index(const br_txstore *s, const uint8_t *hash)
+{
+    br_txentry *e = br_txstore_entry(s, hash);
+
+    return (e && e->pos != UINT32_MAX) ? s->list_count - 1 - e->pos : SIZE_MAX;
+}
+
+int br_txstore_list_insert(br_txstore *s, const uint8_t *hash, size_t i)
+{
+    br_txentry *e = br_txstore_entry(s, hash);
+    size_t pos;
+
+    if (! e || e->pos != UINT32_MAX) return 0;
+
+    if (s->list_count == s->list_cap) {
+        size_t c = (s->list_cap) ? s->list_cap*2 : BR_MIN_ENTRIES;
+        uint32_t *list = realloc(s->list, c*sizeof(*list));
+
+        if (! list) return 0;
+        s->list = list;
+        s->list_cap = c;
+    }
+
+    pos = (i < s->list_count) ? s->list_count - i : 0;
+    memmove(s->list + pos + 1, s->list + pos, (s->list_count - pos)*sizeof(*s->list));
+    s->list[pos] = (uint32_t)(e - s->e);
+    s->list_count++;
+    for (size_t p = pos; p < s->list_count; p++) s->e[s->list[p]].pos = (uint32_t)p;
+    return 1;
+}
+
+int br_txstore_list_remove(br_txstore *s, const uint8_t *hash)
+{
+    br_txentry *e = br_txstore_entry(s, hash);
+
+    if (! e || e->pos == UINT32_MAX) return 0;
+    br_txstore_unlist(s, (size_t)(e - s->e));
+    return 1;
+}
+
+int br_txstore_list_reorder(br_txstore *s, const size_t *order)
+{
+    size_t n = s->list_count;
+    uint32_t *list = malloc((n + 1)*sizeof(*list));
+
+    if (! list) return 0;
+    for (size_t k = 0; k < n; k++) list[n - 1 - k] = s->list[n - 1 - order[k]]; // order is most recent first
+
+    for (size_t p = 0; p < n; p++) {
+        s->list[p] = list[p];
+        s->e[list[p]].pos = (uint32_t)p;
+    }
+
+    free(list);
+    return 1;
+}
+
+size_t br_txstore_memory(const br_txstore *s)
+{
+    return sizeof(*s) + s->t.cap*(1 + sizeof(*s->t.idx)) + s->cap*sizeof(*s->e) + s->list_cap*sizeof(*s->list);
+}
+
+br_outset *br_outset_new(void)
+{
+    br_outset *o = calloc(1, sizeof(*o));
+
+    if (! o) return NULL;
+    pthread_once(&_salt_once, br_txstore_salt_init);
+    o->salt = _salt;
+    return o;
+}
+
+void br_outset_free(br_outset *o)
+{
+    if (! o) return;
+    br_table_free(&o->t);
+    free(o->keys);
+    free(o->dead);
+    free(o);
+}
+
+size_t br_outset_count(const br_outset *o)
+{
+    return o->live;
+}
+
+static uint32_t br_outset_index(const uint8_t *key)
+{
+    return key[32] | ((uint32_t)key[33] << 8) | ((uint32_t)key[34] << 16) | ((uint32_t)key[35] << 24);
+}
+
+static size_t br_outset_slot(const br_outset *o, const uint8_t *hash, uint32_t n, uint8_t *key)
+{
+    memcpy(key, hash, 32);
+    key[32] = (uint8_t)n;
+    key[33] = (uint8_t)(n >> 8);
+    key[34] = (uint8_t)(n >> 16);
+    key[35] = (uint8_t)(n >> 24);
+    return br_table_find(&o->t, br_table_hash(o->salt, hash, 32, n), key, BR_OUTPOINT_SIZE, o->keys, BR_OUTPOINT_SIZE);
+}
+
+// rebuilds the table into cap slots from the live outpoints, moving them to the front of keys if compact is set
+// returns 0 if out of memory, leaving the set as it was
+static int br_outset_rehash(br_outset *o, size_t cap, int compact)
+{
+    size_t j = 0;
+
+    if (! br_table_alloc(&o->t, cap)) return 0;
+
+    for (size_t i = 0; i < o->count; i++) {
+        const uint8_t *key = o->keys + i*BR_OUTPOINT_SIZE;
+
+        if ((o->dead[i/64] >> (i % 64)) & 1) continue;
+        if (compact && j != i) memcpy(o->keys + j*BR_OUTPOINT_SIZE, key, BR_OUTPOINT_SIZE);
+        key = o->keys + ((compact) ? j : i)*BR_OUTPOINT_SIZE;
+        br_table_insert(&o->t, br_table_hash(o->salt, key, 32, br_outset_index(key)), (uint32_t)((compact) ? j : i));
+        j++;
+    }
+
+    if (compact) {
+        memset(o->dead, 0, (o->cap + 63)/64*sizeof(*o->dead));
+        o->count = j;
+    }
+
+    return 1;
+}
+
+// makes room for one more outpoint, returns 0 if out of memory
+static int br_outset_reserve(br_outset *o)
+{
+    size_t cap = br_table_rehash_size(&o->t);
+
+    // drop removed outpoints rather than grow while they are a quarter or more of the entries
+    if (o->count == o->cap && o->count - o->live >= o->count/4 && o->count > 0) {
+        return br_outset_rehash(o, (cap) ? cap : o->t.cap, 1);
+    }
+
+    if (o->count == o->cap) {
+        size_t c = (o->cap) ? o->cap*2 : BR_MIN_ENTRIES;
+        uint8_t *keys = (o->count < UINT32_MAX) ? realloc(o->keys, c*BR_OUTPOINT_SIZE) : NULL;
+        uint64_t *dead;
+
+        if (! keys) return 0;
+        o->keys = keys;
+        dead = realloc(o->dead, (c + 63)/64*sizeof(*dead));
+        if (! dead) return 0;
+        memset(dead + (o->cap + 63)/64, 0, ((c + 63)/64 - (o->cap + 63)/64)*sizeof(*dead));
+        o->dead = dead;
+        o->cap = c;
+    }
+
+    return (cap == 0 || br_outset_rehash(o, cap, 0));
+}
+
+int br_outset_add(br_outset *o, const uint8_t *hash, uint32_t n)
+{
+    uint8_t key[BR_OUTPOINT_SIZE];
+
+    if (br_outset_slot(o, hash, n, key) != SIZE_MAX) return 1;
+    if (! br_outset_reserve(o)) return 0;
+    memcpy(o->keys + o->count*BR_OUTPOINT_SIZE, key, BR_OUTPOINT_SIZE);
+    br_table_insert(&o->t, br_table_hash(o->salt, hash, 32, n), (uint32_t)o->count++);
+    o->live++;
+    return 1;
+}
+
+int br_outset_contains(const br_outset *o, const uint8_t *hash, uint32_t n)
+{
+    uint8_t key[BR_OUTPOINT_SIZE];
+
+    return (br_outset_slot(o, hash, n, key) != SIZE_MAX);
+}
+
+int br_outset_remove(br_outset *o, const uint8_t *hash, uint32_t n)
+{
+    uint8_t key[BR_OUTPOINT_SIZE];
+    size_t slot = br_outset_slot(o, hash, n, key), i;
+
+    if (slot == SIZE_MAX) return 0;
+    i = o->t.idx[slot];
+    br_table_erase(&o->t, slot);
+    o->dead[i/64] |= 1ull << (i % 64);
+    o->live--;
+    return 1;
+}
+
+void br_outset_clear(br_outset *o)
+{
+    if (o->t.cap > 0) memset(o->t.ctrl, BR_CTRL_EMPTY, o->t.cap);
+    if (o->cap > 0) memset(o->dead, 0, (o->cap + 63)/64*sizeof(*o->dead));
+    o->t.used = o->t.deleted = 0;
+    o->count = o->live = 0;
+}
+
+const uint8_t *br_outset_next(const br_outset *o, size_t *i)
+{
+    while (*i < o->count && ((o->dead[*i/64] >> (*i % 64)) & 1)) (*i)++;
+    if (*i >= o->count) return NULL;
+    return o->keys + (*i)++*BR_OUTPOINT_SIZE;
+}
+
+size_t br_outset_memory(const br_outset *o)
+{
+    return sizeof(*o) + o->t.cap*(1 + sizeof(*o->t.idx)) + o->cap*BR_OUTPOINT_SIZE +
+           (o->cap + 63)/64*sizeof(*o->dead);
+}
+
+br_addrset *br_addrset_new(void)
+{
+    br_addrset *a = calloc(1, sizeof(*a));
+
+    if (! a) return NULL;
+    pthread_once(&_salt_once, br_txstore_salt_init);
+    a->salt = _salt;
+    return a;
+}
+
+void br_addrset_free(br_addrset *a)
+{
+    if (! a) return;
+    br_table_free(&a->t);
+    free(a->keys);
+    free(a->values);
+    free(a);
+}
+
+size_t br_addrset_count(const br_addrset *a)
+{
+    return a->count;
+}
+
+static size_t br_addrset_slot(const br_addrset *a, uint8_t type, const uint8_t *h160, uint8_t *key)
+{
+    key[0] = type;
+    memcpy(key + 1, h160, 20);
+    return br_table_find(&a->t, br_table_hash(a->salt, h160, 20, type), key, BR_ADDRESS_KEY_SIZE, a->keys,
+                         BR_ADDRESS_KEY_SIZE);
+}
+
+// makes room for one more address, returns 0 if out of memory
+static int br_addrset_reserve(br_addrset *a)
+{
+    size_t cap = br_table_rehash_size(&a->t);
+
+    if (a->count == a->cap) {
+        size_t c = (a->cap) ? a->cap*2 : BR_MIN_ENTRIES;
+        uint8_t *keys = (a->count < UINT32_MAX) ? realloc(a->keys, c*BR_ADDRESS_KEY_SIZE) : NULL;
+        uint32_t *values;
+
+        if (! keys) return 0;
+        a->keys = keys;
+        values = realloc(a->values, c*sizeof(*values));
+        if (! values) return 0;
+        a->values = values;
+        a->cap = c;
+    }
+
+    if (cap == 0) return 1;
+    if (! br_table_alloc(&a->t, cap)) return 0;
+
+    for (size_t i = 0; i < a->count; i++) {
+        const uint8_t *key = a->keys + i*BR_ADDRESS_KEY_SIZE;
+
+        br_table_insert(&a->t, br_table_hash(a->salt, key + 1, 20, key[0]), (uint32_t)i);
+    }
+
+    return 1;
+}
+
+int br_addrset_add(br_addrset *a, uint8_t type, const uint8_t *h160, uint32_t value)
+{
+    uint8_t key[BR_ADDRESS_KEY_SIZE];
+
+    if (br_addrset_slot(a, type, h160, key) != SIZE_MAX) return 1;
+    if (! br_addrset_reserve(a)) return 0;
+    memcpy(a->keys + a->count*BR_ADDRESS_KEY_SIZE, key, BR_ADDRESS_KEY_SIZE);
+    a->values[a->count] = value;
+    br_table_insert(&a->t, br_table_hash(a->salt, h160, 20, type), (uint32_t)a->count++);
+    return 1;
+}
+
+uint32_t br_addrset_get(const br_addrset *a, uint8_t type, const uint8_t *h160)
+{
+    uint8_t key[BR_ADDRESS_KEY_SIZE];
+    size_t slot = br_addrset_slot(a, type, h160, key);
+
+    return (slot == SIZE_MAX) ? UINT32_MAX : a->values[a->t.idx[slot]];
+}
+
+int br_addrset_contains(const br_addrset *a, uint8_t type, const uint8_t *h160)
+{
+    uint8_t key[BR_ADDRESS_KEY_SIZE];
+
+    return (br_addrset_slot(a, type, h160, key) != SIZE_MAX);
+}
+
+size_t br_addrset_memory(const br_addrset *a)
+{
+    return sizeof(*a) + a->t.cap*(1 + sizeof(*a->t.idx)) + a->cap*(BR_ADDRESS_KEY_SIZE + sizeof(*a->values));
+}
@@ -0,0 +1,142 @@
+//
+//  BRTxStore.h
+//  SolarisWallet
+//
+//  The wallet's transactions, outpoints and addresses in flat hash tables instead of an object per entry.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef BRTxStore_h
+#define BRTxStore_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BR_OUTPOINT_SIZE 36 // transaction hash, then the output index as 4 little endian bytes
+#define BR_ADDRESS_KEY_SIZE 21 // script type, then the 20 byte hash160
+
+typedef struct br_txstore br_txstore;
+typedef struct br_outset br_outset;
+typedef struct br_addrset br_addrset;
+
+// returns an empty store, or NULL if out of memory; release, if not NULL, is called on every transaction pointer the
+// store lets go of, when it is replaced or removed or when the store is freed
+br_txstore *br_txstore_new(void (*release)(void *tx));
+
+void br_txstore_free(br_txstore *s);
+
+// the number of transactions stored, listed or not
+size_t br_txstore_count(const br_txstore *s);
+
+// stores tx under hash with its block height, replacing and releasing what was there, which keeps its place in the
+// list; returns 0 if out of memory, in which case tx is not released
+int br_txstore_put(br_txstore *s, const uint8_t *hash, void *tx, uint32_t height);
+
+// the transaction stored under hash, or NULL
+void *br_txstore_get(const br_txstore *s, const uint8_t *hash);
+
+// removes and releases the transaction stored under hash, taking it off the list; returns 0 if there was none
+int br_txstore_remove(br_txstore *s, const uint8_t *hash);
+
+// the block height stored with the transaction, UINT32_MAX if there is none
+uint32_t br_txstore_height(const br_txstore *s, const uint8_t *hash);
+
+// updates the block height stored with the transaction, returns 0 if there is none; a listed transaction keeps its
+// place until the list is reordered
+int br_txstore_set_height(br_txstore *s, const uint8_t *hash, uint32_t height);
+
+// the number of listed transactions; the list is the wallet's own transactions, the most recent at index 0
+size_t br_txstore_list_count(const br_txstore *s);
+
+// the listed transaction at index i, which must be below br_txstore_list_count()
+void *br_txstore_list_get(const br_txstore *s, size_t i);
+
+// the hash of the listed transaction at index i, which must be below br_txstore_list_count()
+const uint8_t *br_txstore_list_hash(const br_txstore *s, size_t i);
+
+// the index of the stored transaction in the list, or SIZE_MAX if it is not listed
+size_t br_txstore_list_index(const br_txstore *s, const uint8_t *hash);
+
+// lists the stored transaction at index i, moving the ones from i on back by one; inserting at 0 takes constant time
+// returns 0 if it is not stored, is listed already, or if out of memory
+int br_txstore_list_insert(br_txstore *s, const uint8_t *hash, size_t i);
+
+// takes the transaction off the list, it stays stored; returns 0 if it was not listed
+int br_txstore_list_remove(br_txstore *s, const uint8_t *hash);
+
+// rearranges the list so that index k holds what was at index order[k], order being a permutation of the indexes;
+// returns 0 if out of memory, leaving the list as it was
+int br_txstore_list_reorder(br_txstore *s, const size_t *order);
+
+// bytes allocated by the store, not counting what its transaction pointers point to
+size_t br_txstore_memory(const br_txstore *s);
+
+// returns an empty set, or NULL if out of memory
+br_outset *br_outset_new(void);
+
+void br_outset_free(br_outset *o);
+
+// the number of outpoints in the set
+size_t br_outset_count(const br_outset *o);
+
+// adds output n of the transaction with the given hash, if it is not in the set yet; returns 0 if out of memory
+int br_outset_add(br_outset *o, const uint8_t *hash, uint32_t n);
+
+// returns 1 if output n of the transaction with the given hash is in the set
+int br_outset_contains(const br_outset *o, const uint8_t *hash, uint32_t n);
+
+// takes output n of the transaction with the given hash out of the set, returns 0 if it was not in it
+// removing does not move the other outpoints, so it is safe while iterating with br_outset_next()
+int br_outset_remove(br_outset *o, const uint8_t *hash, uint32_t n);
+
+// empties the set, keeping its memory
+void br_outset_clear(br_outset *o);
+
+// iterates over the outpoints in the order they were added: returns the first one at or after position *i, moving *i
+// past it, or NULL when there are no more; start with *i = 0
+const uint8_t *br_outset_next(const br_outset *o, size_t *i);
+
+// bytes allocated by the set
+size_t br_outset_memory(const br_outset *o);
+
+// returns an empty set, or NULL if out of memory
+br_addrset *br_addrset_new(void);
+
+void br_addrset_free(br_addrset *a);
+
+// the number of addresses in the set
+size_t br_addrset_count(const br_addrset *a);
+
+// adds the address paying to the 20 byte h160 with scripts of the given type, which is the caller's to number, along
+// with value, which has to be below UINT32_MAX; an address in the set already keeps its value; returns 0 if out of
+// memory
+int br_addrset_add(br_addrset *a, uint8_t type, const uint8_t *h160, uint32_t value);
+
+// the value the address was added with, or UINT32_MAX if it is not in the set
+uint32_t br_addrset_get(const br_addrset *a, uint8_t type, const uint8_t *h160);
+
+// returns 1 if the address is in the set
+int br_addrset_contains(const br_addrset *a, uint8_t type, const uint8_t *h160);
+
+// bytes allocated by the set
+size_t br_addrset_memory(const br_addrset *a);
+
+#endif /* BRTxStore_h */
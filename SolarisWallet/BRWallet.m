@@ -35,30 +35,135 @@
 #import "BRKeySequence.h"
 #import "NSData+Bitcoin.h"
 #import "NSMutableData+Bitcoin.h"
+#import "NSString+Bitcoin.h"
+#import "NSString+Dash.h"
 #import "NSManagedObject+Sugar.h"
+#import "BRTxStore.h"
+#import "BRBalance.h"
+#import "BRTxOrder.h"
+#import "BRTxCodec.h"
 
-// chain position of first tx output address that appears in chain
-static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
-    for (NSString *addr in tx.outputAddresses) {
-        NSUInteger i = [chain indexOfObject:addr];
+// undo records are kept for transactions less than this many blocks deep, a reorg deeper than that rebuilds the balance
+#define BALANCE_UNDO_DEPTH 100
+
+// wallet addresses are kept by hash160 with their place in the chains: the chain, then the index in it
+#define ADDRESS_INTERNAL 0x80000000u
+#define ADDRESS_BIP44    0x40000000u
+#define ADDRESS_INDEX    0x3fffffffu
+
+// the script type and hash160 of an address of this network, BR_TX_SCRIPT_OTHER if it is none
+static br_tx_script_type addressHash160(id address, uint8_t *h160)
+{
+    NSData *d = ([address isKindOfClass:[NSString class]]) ? [address base58checkToData] : nil;
+    uint8_t pubkeyVersion = DASH_PUBKEY_ADDRESS, scriptVersion = DASH_SCRIPT_ADDRESS, version;
+    
+#if DASH_TESTNET
+    pubkeyVersion = DASH_PUBKEY_ADDRESS_TEST;
+    scriptVersion = DASH_SCRIPT_ADDRESS_TEST;
+#endif
+    
+    if (d.length != 1 + sizeof(UInt160)) return BR_TX_SCRIPT_OTHER;
+    version = *(const uint8_t *)d.bytes;
+    memcpy(h160, (const uint8_t *)d.bytes + 1, sizeof(UInt160));
+    return (version == pubkeyVersion) ? BR_TX_SCRIPT_PUBKEY_HASH :
+           (version == scriptVersion) ? BR_TX_SCRIPT_HASH : BR_TX_SCRIPT_OTHER;
+}
+
+// the script type and hash160 of the address an output script pays to, BR_TX_SCRIPT_OTHER if it is none
+static br_tx_script_type scriptHash160(id script, uint8_t *h160)
+{
+    if (! [script isKindOfClass:[NSData class]]) return BR_TX_SCRIPT_OTHER;
+    return br_tx_script_hash160([script bytes], [script length], h160);
+}
+
+// the value the address an output script pays to is kept with in set, UINT32_MAX if it is not in it
+static uint32_t scriptValue(const br_addrset *set, id script)
+{
+    uint8_t h160[sizeof(UInt160)];
+    br_tx_script_type type = scriptHash160(script, h160);
+    
+    return (type == BR_TX_SCRIPT_OTHER) ? UINT32_MAX : br_addrset_get(set, type, h160);
+}
+
+// adds the addresses tx spends from and pays to to set
+static void addTxAddresses(br_addrset *set, BRTransaction *tx)
+{
+    NSArray *signatures = tx.inputSignatures;
+    uint8_t h160[sizeof(UInt160)];
+    br_tx_script_type type;
+    NSUInteger i = 0;
+    
+    for (id script in tx.inputScripts) { // the script of the output spent, or else the signature spending it
+        id sig = (i < signatures.count) ? signatures[i] : nil;
+        
+        type = scriptHash160(script, h160);
+        
+        if (type == BR_TX_SCRIPT_OTHER && [sig isKindOfClass:[NSData class]]) {
+            type = br_tx_sig_hash160([sig bytes], [sig length], h160);
+        }
+        
+        if (type != BR_TX_SCRIPT_OTHER) br_addrset_add(set, type, h160, 0);
+        i++;
+    }
+    
+    for (id script in tx.outputScripts) {
+        type = scriptHash160(script, h160);
+        if (type != BR_TX_SCRIPT_OTHER) br_addrset_add(set, type, h160, 0);
+    }
+}
+
+// chain position of the first tx output address in the internal chain, or else in the external one
+static NSUInteger txAddressIndex(BRTransaction *tx, const br_addrset *addresses) {
+    NSUInteger external = NSNotFound;
+    
+    for (id script in tx.outputScripts) {
+        uint32_t v = scriptValue(addresses, script);
         
-        if (i != NSNotFound) return i;
+        if (v == UINT32_MAX) continue;
+        if (v & ADDRESS_INTERNAL) return v & ~ADDRESS_INTERNAL; // BIP44 ones after all BIP32 ones, as in the chains
+        if (external == NSNotFound) external = v;
     }
     
-    return NSNotFound;
+    return external;
+}
+
+static void txRelease(void *tx)
+{
+    CFRelease(tx);
+}
+
+// the stored transaction with the given hash, or nil
+static BRTransaction *txForHash(br_txstore *store, NSValue *hash)
+{
+    UInt256 h;
+    
+    if (! hash) return nil;
+    [hash getValue:&h];
+    return (__bridge BRTransaction *)br_txstore_get(store, h.u8);
 }
 
-@interface BRWallet ()
+static BRUTXO utxoForOutpoint(const uint8_t *outpoint)
+{
+    BRUTXO o;
+    
+    memcpy(&o.hash, outpoint, sizeof(o.hash));
+    o.n = outpoint[32] | ((uint32_t)outpoint[33] << 8) | ((uint32_t)outpoint[34] << 16) |
+          ((uint32_t)outpoint[35] << 24);
+    return o;
+}
+
+@interface BRWallet () {
+    br_txstore *_txStore; // every known transaction, the wallet's own listed by block height with the most recent first
+    br_balance *_journal; // the listed transactions applied oldest first, with the balance and UTXOs they leave
+    size_t _journalSynced; // how many of the oldest applied transactions still match the list
+    br_addrset *_allAddresses; // the wallet's addresses with their chain positions
+    br_addrset *_usedAddresses; // addresses that wallet transactions spend from or pay to
+}
 
 @property (nonatomic, strong) id<BRKeySequence> sequence;
 @property (nonatomic, strong) NSData *masterPublicKey,*masterBIP32PublicKey;
 @property (nonatomic, strong) NSMutableArray *internalBIP44Addresses,*internalBIP32Addresses, *externalBIP44Addresses,*externalBIP32Addresses;
-@property (nonatomic, strong) NSMutableSet *allAddresses, *usedAddresses;
-@property (nonatomic, strong) NSSet *spentOutputs, *invalidTx, *pendingTx;
-@property (nonatomic, strong) NSMutableOrderedSet *transactions;
-@property (nonatomic, strong) NSOrderedSet *utxos;
-@property (nonatomic, strong) NSMutableDictionary *allTx;
-@property (nonatomic, strong) NSArray *balanceHistory;
+@property (nonatomic, strong) NSArray *transactions; // the listed transactions, rebuilt when nil
 @property (nonatomic, assign) uint32_t bestBlockHeight;
 @property (nonatomic, strong) SeedRequestBlock seed;
 @property (nonatomic, strong) NSManagedObjectContext *moc;
@@ -79,14 +184,15 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     self.masterPublicKey = masterPublicKey;
     self.masterBIP32PublicKey = masterBIP32PublicKey;
     self.seed = seed;
-    self.allTx = [NSMutableDictionary dictionary];
-    self.transactions = [NSMutableOrderedSet orderedSet];
+    _txStore = br_txstore_new(txRelease);
+    _journal = br_balance_new();
+    _allAddresses = br_addrset_new();
+    _usedAddresses = br_addrset_new();
+    if (! _txStore || ! _journal || ! _allAddresses || ! _usedAddresses) return nil;
     self.internalBIP32Addresses = [NSMutableArray array];
     self.internalBIP44Addresses = [NSMutableArray array];
     self.externalBIP32Addresses = [NSMutableArray array];
     self.externalBIP44Addresses = [NSMutableArray array];
-    self.allAddresses = [NSMutableSet set];
-    self.usedAddresses = [NSMutableSet set];
     
     [self.moc performBlockAndWait:^{
         [BRAddressEntity setContext:self.moc];
@@ -96,10 +202,16 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
         for (BRAddressEntity *e in [BRAddressEntity allObjects]) {
             @autoreleasepool {
                 NSMutableArray *a = (e.purpose == 44)?((e.internal) ? self.internalBIP44Addresses : self.externalBIP44Addresses) : ((e.internal) ? self.internalBIP32Addresses : self.externalBIP32Addresses);
+                uint8_t h160[sizeof(UInt160)];
+                br_tx_script_type type = addressHash160(e.address, h160);
                 
                 while (e.index >= a.count) [a addObject:[NSNull null]];
                 a[e.index] = e.address;
-                [self.allAddresses addObject:e.address];
+                
+                if (type != BR_TX_SCRIPT_OTHER) {
+                    br_addrset_add(_allAddresses, type, h160, ((e.internal) ? ADDRESS_INTERNAL : 0) |
+                                   ((e.purpose == 44) ? ADDRESS_BIP44 : 0) | (e.index & ADDRESS_INDEX));
+                }
             }
         }
         
@@ -108,17 +220,14 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
                 if (e.type != TX_MDTYPE_MSG) continue;
                 
                 BRTransaction *tx = e.transaction;
-                NSValue *hash = (tx) ? uint256_obj(tx.txHash) : nil;
                 
-                if (! tx) continue;
-                self.allTx[hash] = tx;
-                [self.transactions addObject:tx];
-                [self.usedAddresses addObjectsFromArray:tx.inputAddresses];
-                [self.usedAddresses addObjectsFromArray:tx.outputAddresses];
+                if (! tx || ! [self storeTransaction:tx]) continue;
+                br_txstore_list_insert(_txStore, tx.txHash.u8, 0); // fetch order is arbitrary, sorted below
+                addTxAddresses(_usedAddresses, tx);
             }
         }
         
-        if ([BRTransactionEntity countAllObjects] > self.allTx.count) {
+        if ([BRTransactionEntity countAllObjects] > br_txstore_count(_txStore)) {
             // pre-fetch transaction inputs and outputs
             [BRTxInputEntity allObjects];
             [BRTxOutputEntity allObjects];
@@ -126,15 +235,12 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
             for (BRTransactionEntity *e in [BRTransactionEntity allObjects]) {
                 @autoreleasepool {
                     BRTransaction *tx = e.transaction;
-                    NSValue *hash = (tx) ? uint256_obj(tx.txHash) : nil;
                     
-                    if (! tx || self.allTx[hash] != nil) continue;
+                    if (! tx || br_txstore_get(_txStore, tx.txHash.u8) || ! [self storeTransaction:tx]) continue;
                     
                     [updateTx addObject:tx];
-                    self.allTx[hash] = tx;
-                    [self.transactions addObject:tx];
-                    [self.usedAddresses addObjectsFromArray:tx.inputAddresses];
-                    [self.usedAddresses addObjectsFromArray:tx.outputAddresses];
+                    br_txstore_list_insert(_txStore, tx.txHash.u8, 0);
+                    addTxAddresses(_usedAddresses, tx);
                 }
             }
         }
@@ -160,6 +266,28 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
 - (void)dealloc
 {
     [NSObject cancelPreviousPerformRequestsWithTarget:self];
+    br_txstore_free(_txStore);
+    br_balance_free(_journal);
+    br_addrset_free(_allAddresses);
+    br_addrset_free(_usedAddresses);
+}
+
+// the journal no longer matches the list from the listed transaction with the given hash on
+- (void)invalidateJournalFrom:(const uint8_t *)hash
+{
+    size_t i = br_txstore_list_index(_txStore, hash), count = br_txstore_list_count(_txStore);
+    
+    if (i < count && count - 1 - i < _journalSynced) _journalSynced = count - 1 - i;
+}
+
+// stores the transaction under its hash with its block height, replacing any with the same hash
+- (BOOL)storeTransaction:(BRTransaction *)transaction
+{
+    void *tx = (__bridge_retained void *)transaction;
+    
+    if (br_txstore_put(_txStore, transaction.txHash.u8, tx, transaction.blockHeight)) return YES;
+    CFRelease(tx);
+    return NO;
 }
 
 -(NSArray*)internalAddresses {
@@ -170,6 +298,51 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     return [self.externalBIP32Addresses arrayByAddingObjectsFromArray:self.externalBIP44Addresses];
 }
 
+// derives count addresses of a chain starting at index n from their hash160s, computed in one batch, adds them to the
+// wallet's addresses and stores them all in core data in a single block; returns nil if any of them could not be
+// derived
+- (NSArray *)generateAddresses:(NSUInteger)count from:(uint32_t)n purpose:(uint32_t)purpose internal:(BOOL)internal
+               masterPublicKey:(NSData *)masterPublicKey
+{
+    NSData *hash160s = [self.sequence hash160s:NSMakeRange(n, count) internal:internal masterPublicKey:masterPublicKey];
+    NSMutableArray *addrs = [NSMutableArray arrayWithCapacity:count];
+    const UInt160 *h160 = hash160s.bytes;
+    
+    if (hash160s.length != count*sizeof(UInt160)) return nil;
+    
+    for (NSUInteger i = 0; i < count; i++) {
+        NSString *addr = [NSString addressWithHash160:h160[i]];
+        
+        if (! addr) return nil;
+        [addrs addObject:addr];
+    }
+    
+    for (NSUInteger i = 0; i < count; i++) { // the wallet addresses are kept by hash160, their text is for display
+        uint32_t value = ((internal) ? ADDRESS_INTERNAL : 0) | ((purpose == 44) ? ADDRESS_BIP44 : 0) |
+                         ((n + (uint32_t)i) & ADDRESS_INDEX);
+        
+        if (! br_addrset_add(_allAddresses, BR_TX_SCRIPT_PUBKEY_HASH, h160[i].u8, value)) return nil;
+        if (br_addrset_contains(_usedAddresses, BR_TX_SCRIPT_PUBKEY_HASH, h160[i].u8)) {
+            _journalSynced = 0; // known transactions may pay to it
+        }
+    }
+    
+    [self.moc performBlock:^{ // store the new addresses in core data
+        uint32_t index = n;
+        
+        for (NSString *addr in addrs) {
+            BRAddressEntity *e = [BRAddressEntity managedObject];
+            e.purpose = purpose;
+            e.account = 0;
+            e.address = addr;
+            e.index = index++;
+            e.internal = internal;
+        }
+    }];
+    
+    return addrs;
+}
+
 // Wallets are composed of chains of addresses. Each chain is traversed until a gap of a certain number of addresses is
 // found that haven't been used in any transactions. This method returns an array of <gapLimit> unused addresses
 // following the last used address in the chain. The internal chain is used for change addresses and the external chain
@@ -180,7 +353,7 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     NSUInteger i = a.count;
     
     // keep only the trailing contiguous block of addresses with no transactions
-    while (i > 0 && ! [self.usedAddresses containsObject:a[i - 1]]) {
+    while (i > 0 && ! [self addressIsUsed:a[i - 1]]) {
         i--;
     }
     
@@ -199,35 +372,24 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
         unsigned n = (unsigned)i;
         
         // keep only the trailing contiguous block of addresses with no transactions
-        while (i > 0 && ! [self.usedAddresses containsObject:a[i - 1]]) {
+        while (i > 0 && ! [self addressIsUsed:a[i - 1]]) {
             i--;
         }
         
         if (i > 0) [a removeObjectsInRange:NSMakeRange(0, i)];
         if (a.count >= gapLimit) return [a subarrayWithRange:NSMakeRange(0, gapLimit)];
         
-        while (a.count < gapLimit) { // generate new addresses up to gapLimit
-            NSData *pubKey = [self.sequence publicKey:n internal:internal masterPublicKey:self.masterPublicKey];
-            NSString *addr = [BRKey keyWithPublicKey:pubKey].address;
+        if (a.count < gapLimit) { // generate new addresses up to gapLimit
+            NSArray *addrs = [self generateAddresses:gapLimit - a.count from:n purpose:44 internal:internal
+                                     masterPublicKey:self.masterPublicKey];
             
-            if (! addr) {
+            if (! addrs) {
                 NSLog(@"error generating keys");
                 return nil;
             }
             
-            [self.moc performBlock:^{ // store new address in core data
-                BRAddressEntity *e = [BRAddressEntity managedObject];
-                e.purpose = 44;
-                e.account = 0;
-                e.address = addr;
-                e.index = n;
-                e.internal = internal;
-            }];
-            
-            [self.allAddresses addObject:addr];
-            [(internal) ? self.internalBIP44Addresses : self.externalBIP44Addresses addObject:addr];
-            [a addObject:addr];
-            n++;
+            [(internal) ? self.internalBIP44Addresses : self.externalBIP44Addresses addObjectsFromArray:addrs];
+            [a addObjectsFromArray:addrs];
         }
         
         return a;
@@ -243,35 +405,24 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
         unsigned n = (unsigned)i;
         
         // keep only the trailing contiguous block of addresses with no transactions
-        while (i > 0 && ! [self.usedAddresses containsObject:a[i - 1]]) {
+        while (i > 0 && ! [self addressIsUsed:a[i - 1]]) {
             i--;
         }
         
         if (i > 0) [a removeObjectsInRange:NSMakeRange(0, i)];
         if (a.count >= gapLimit) return [a subarrayWithRange:NSMakeRange(0, gapLimit)];
         
-        while (a.count < gapLimit) { // generate new addresses up to gapLimit
-            NSData *pubKey = [self.sequence publicKey:n internal:internal masterPublicKey:self.masterBIP32PublicKey];
-            NSString *addr = [BRKey keyWithPublicKey:pubKey].address;
+        if (a.count < gapLimit) { // generate new addresses up to gapLimit
+            NSArray *addrs = [self generateAddresses:gapLimit - a.count from:n purpose:0 internal:internal
+                                     masterPublicKey:self.masterBIP32PublicKey];
             
-            if (! addr) {
+            if (! addrs) {
                 NSLog(@"error generating keys");
                 return nil;
             }
             
-            [self.moc performBlock:^{ // store new address in core data
-                BRAddressEntity *e = [BRAddressEntity managedObject];
-                e.purpose = 0;
-                e.account = 0;
-                e.address = addr;
-                e.index = n;
-                e.internal = internal;
-            }];
-            
-            [self.allAddresses addObject:addr];
-            [(internal) ? self.internalBIP32Addresses : self.externalBIP32Addresses addObject:addr];
-            [a addObject:addr];
-            n++;
+            [(internal) ? self.internalBIP32Addresses : self.externalBIP32Addresses addObjectsFromArray:addrs];
+            [a addObjectsFromArray:addrs];
         }
         
         return a;
@@ -282,137 +433,138 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
 // each block, however correct transaction ordering cannot be relied upon for determining wallet balance or UTXO set
 - (void)sortTransactions
 {
-    BOOL (^isAscending)(id, id);
-    __block __weak BOOL (^_isAscending)(id, id) = isAscending = ^BOOL(BRTransaction *tx1, BRTransaction *tx2) {
-        if (! tx1 || ! tx2) return NO;
-        if (tx1.blockHeight > tx2.blockHeight) return YES;
-        if (tx1.blockHeight < tx2.blockHeight) return NO;
+    size_t count = br_txstore_list_count(_txStore), inCount = 0, p = 0;
+    NSMutableArray *inputs = [NSMutableArray arrayWithCapacity:count];
+    NSMutableData *txs, *inHashes, *order;
+    
+    for (size_t k = 0; k < count; k++) {
+        NSArray *inputHashes = ((__bridge BRTransaction *)br_txstore_list_get(_txStore, k)).inputHashes;
         
-        NSValue *hash1 = uint256_obj(tx1.txHash), *hash2 = uint256_obj(tx2.txHash);
+        [inputs addObject:(inputHashes) ? inputHashes : @[]];
+        inCount += [inputs[k] count];
+    }
+    
+    txs = [NSMutableData dataWithLength:count*sizeof(br_txorder_tx)];
+    inHashes = [NSMutableData dataWithLength:inCount*sizeof(UInt256)];
+    order = [NSMutableData dataWithLength:count*sizeof(size_t)];
+    if (! txs || ! inHashes || ! order) return;
+    
+    // within a block, spenders go ahead of what they spend, then invalid and pending transactions and what spends
+    // them, then the ones whose first output address in the internal chain, or else the external one, comes later
+    for (size_t k = 0, j = 0; k < count; k++) {
+        BRTransaction *tx = (__bridge BRTransaction *)br_txstore_list_get(_txStore, k);
+        br_txorder_tx *t = (br_txorder_tx *)txs.mutableBytes + k;
+        uint8_t *h = inHashes.mutableBytes;
+        int state = br_balance_state(_journal, br_txstore_list_hash(_txStore, k));
+        NSUInteger i = txAddressIndex(tx, _allAddresses);
         
-        if ([tx1.inputHashes containsObject:hash2]) return YES;
-        if ([tx2.inputHashes containsObject:hash1]) return NO;
-        if ([self.invalidTx containsObject:hash1] && ! [self.invalidTx containsObject:hash2]) return YES;
-        if ([self.pendingTx containsObject:hash1] && ! [self.pendingTx containsObject:hash2]) return YES;
+        t->hash = br_txstore_list_hash(_txStore, k);
+        t->height = tx.blockHeight;
+        t->rank = (state == BR_BALANCE_INVALID) ? 2 : (state == BR_BALANCE_PENDING) ? 1 : 0;
+        t->tie = (i == NSNotFound) ? 0 : 1 + i;
+        t->in_count = [inputs[k] count];
+        t->in_hash = h + j*sizeof(UInt256);
+        for (NSValue *hash in inputs[k]) [hash getValue:h + j++*sizeof(UInt256)];
+    }
+    
+    if (! br_txorder_sort(txs.bytes, count, order.mutableBytes)) return;
+    if (! br_txstore_list_reorder(_txStore, order.bytes)) return;
+    self.transactions = nil;
+    
+    // the journal still holds the oldest transactions up to the first one that moved
+    while (p < _journalSynced && p < br_balance_count(_journal) && p < count &&
+           memcmp(br_balance_hash(_journal, p), br_txstore_list_hash(_txStore, count - 1 - p), sizeof(UInt256)) == 0) {
+        p++;
+    }
+    
+    _journalSynced = p;
+}
+
+// applies the transaction to the journal as the most recent one, returns NO if out of memory
+- (BOOL)applyTransaction:(BRTransaction *)tx now:(uint32_t)now
+{
+    NSArray *inputHashes = tx.inputHashes, *inputIndexes = tx.inputIndexes, *outputAmounts = tx.outputAmounts;
+    NSUInteger inCount = inputHashes.count, outCount = outputAmounts.count, i = 0, n = 0;
+    NSMutableData *d = [NSMutableData dataWithLength:outCount*(sizeof(uint64_t) + 1) +
+                        inCount*(sizeof(uint32_t) + sizeof(UInt256))];
+    uint64_t *outAmount = d.mutableBytes;
+    uint32_t *inIndex = (uint32_t *)(outAmount + outCount);
+    uint8_t *inHash = (uint8_t *)(inIndex + inCount), *outMine = inHash + inCount*sizeof(UInt256);
+    UInt256 txHash = tx.txHash;
+    BOOL pending = NO;
+    
+    if (! d) return NO;
+    
+    for (NSValue *hash in inputHashes) {
+        [hash getValue:inHash + i*sizeof(UInt256)];
+        inIndex[i] = [inputIndexes[i] unsignedIntValue];
+        i++;
+    }
+    
+    //TODO: don't add outputs below TX_MIN_OUTPUT_AMOUNT
+    //TODO: don't add coin generation outputs < 100 blocks deep
+    //NOTE: balance/UTXOs will then need to be recalculated when last block changes
+    for (NSData *script in tx.outputScripts) {
+        if (n >= outCount) break;
+        outAmount[n] = [outputAmounts[n] unsignedLongLongValue];
+        outMine[n] = (scriptValue(_allAddresses, script) != UINT32_MAX);
+        n++;
+    }
+    
+    // check if any inputs are pending
+    if (tx.blockHeight == TX_UNCONFIRMED) {
+        if (tx.size > TX_MAX_SIZE) pending = YES; // check transaction size is under TX_MAX_SIZE
         
-        for (NSValue *hash in tx1.inputHashes) {
-            if (_isAscending(self.allTx[hash], tx2)) return YES;
+        for (NSNumber *sequence in tx.inputSequences) {
+            if (sequence.unsignedIntValue < UINT32_MAX - 1) pending = YES; // check for replace-by-fee
+            if (sequence.unsignedIntValue < UINT32_MAX && tx.lockTime < TX_MAX_LOCK_HEIGHT &&
+                tx.lockTime > self.bestBlockHeight + 1) pending = YES; // future lockTime
+            if (sequence.unsignedIntValue < UINT32_MAX && tx.lockTime >= TX_MAX_LOCK_HEIGHT &&
+                tx.lockTime > now) pending = YES; // future locktime
         }
         
-        return NO;
-    };
+        for (NSNumber *amount in outputAmounts) { // check that no outputs are dust
+            if (amount.unsignedLongLongValue < TX_MIN_OUTPUT_AMOUNT) pending = YES;
+        }
+    }
     
-    [self.transactions sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(id tx1, id tx2) {
-        if (isAscending(tx1, tx2)) return NSOrderedAscending;
-        if (isAscending(tx2, tx1)) return NSOrderedDescending;
-        
-        NSUInteger i = txAddressIndex(tx1, self.internalAddresses),
-        j = txAddressIndex(tx2, (i == NSNotFound) ? self.externalAddresses : self.internalAddresses);
-        
-        if (i == NSNotFound && j != NSNotFound) i = txAddressIndex(tx1, self.externalAddresses);
-        if (i == NSNotFound || j == NSNotFound || i == j) return NSOrderedSame;
-        return (i > j) ? NSOrderedAscending : NSOrderedDescending;
-    }];
+    br_balance_tx btx = { txHash.u8, tx.blockHeight, (tx.blockHeight == TX_UNCONFIRMED), pending, inCount, inHash,
+                          inIndex, n, outAmount, outMine };
+    
+    return (br_balance_apply(_journal, &btx) != 0) ? YES : NO;
 }
 
+// brings the journal up to date with the list: the transactions that no longer match, and every unconfirmed one since
+// its pending checks depend on the time and the best block, are reverted and applied again, oldest first
 - (void)updateBalance
 {
-    uint64_t balance = 0, prevBalance = 0, totalSent = 0, totalReceived = 0;
-    NSMutableOrderedSet *utxos = [NSMutableOrderedSet orderedSet];
-    NSMutableSet *spentOutputs = [NSMutableSet set], *invalidTx = [NSMutableSet set], *pendingTx = [NSMutableSet set];
-    NSMutableArray *balanceHistory = [NSMutableArray array];
+    size_t count = br_txstore_list_count(_txStore), p = br_balance_count(_journal), c;
     uint32_t now = [NSDate timeIntervalSinceReferenceDate] + NSTimeIntervalSince1970;
+    uint64_t balance;
     
-    for (BRTransaction *tx in [self.transactions reverseObjectEnumerator]) {
+    if (_journalSynced < p) p = _journalSynced;
+    if (br_balance_unconfirmed(_journal) < p) p = br_balance_unconfirmed(_journal);
+    
+    if (p == 0 || p < br_balance_checkpoint(_journal)) br_balance_clear(_journal); // reorg below the checkpoint
+    else while (br_balance_count(_journal) > p && br_balance_revert(_journal));
+    
+    for (p = br_balance_count(_journal); p < count; p++) {
         @autoreleasepool {
-            NSMutableSet *spent = [NSMutableSet set];
-            NSSet *inputs;
-            uint32_t i = 0, n = 0;
-            BOOL pending = NO;
-            UInt256 h;
-            
-            for (NSValue *hash in tx.inputHashes) {
-                n = [tx.inputIndexes[i++] unsignedIntValue];
-                [hash getValue:&h];
-                [spent addObject:brutxo_obj(((BRUTXO) { h, n }))];
-            }
-            
-            inputs = [NSSet setWithArray:tx.inputHashes];
-            
-            // check if any inputs are invalid or already spent
-            if (tx.blockHeight == TX_UNCONFIRMED &&
-                ([spent intersectsSet:spentOutputs] || [inputs intersectsSet:invalidTx])) {
-                [invalidTx addObject:uint256_obj(tx.txHash)];
-                [balanceHistory insertObject:@(balance) atIndex:0];
-                continue;
-            }
-            
-            [spentOutputs unionSet:spent]; // add inputs to spent output set
-            n = 0;
-            
-            // check if any inputs are pending
-            if (tx.blockHeight == TX_UNCONFIRMED) {
-                if (tx.size > TX_MAX_SIZE) pending = YES; // check transaction size is under TX_MAX_SIZE
-                
-                for (NSNumber *sequence in tx.inputSequences) {
-                    if (sequence.unsignedIntValue < UINT32_MAX - 1) pending = YES; // check for replace-by-fee
-                    if (sequence.unsignedIntValue < UINT32_MAX && tx.lockTime < TX_MAX_LOCK_HEIGHT &&
-                        tx.lockTime > self.bestBlockHeight + 1) pending = YES; // future lockTime
-                    if (sequence.unsignedIntValue < UINT32_MAX && tx.lockTime >= TX_MAX_LOCK_HEIGHT &&
-                        tx.lockTime > now) pending = YES; // future locktime
-                }
-                
-                for (NSNumber *amount in tx.outputAmounts) { // check that no outputs are dust
-                    if (amount.unsignedLongLongValue < TX_MIN_OUTPUT_AMOUNT) pending = YES;
-                }
-                
-                if (pending || [inputs intersectsSet:pendingTx]) {
-                    [pendingTx addObject:uint256_obj(tx.txHash)];
-                    [balanceHistory insertObject:@(balance) atIndex:0];
-                    continue;
-                }
-            }
-            
-            //TODO: don't add outputs below TX_MIN_OUTPUT_AMOUNT
-            //TODO: don't add coin generation outputs < 100 blocks deep
-            //NOTE: balance/UTXOs will then need to be recalculated when last block changes
-            for (NSString *address in tx.outputAddresses) { // add outputs to UTXO set
-                if ([self containsAddress:address]) {
-                    [utxos addObject:brutxo_obj(((BRUTXO) { tx.txHash, n }))];
-                    balance += [tx.outputAmounts[n] unsignedLongLongValue];
-                }
-                
-                n++;
-            }
-            
-            // transaction ordering is not guaranteed, so check the entire UTXO set against the entire spent output set
-            [spent setSet:utxos.set];
-            [spent intersectSet:spentOutputs];
-            
-            for (NSValue *output in spent) { // remove any spent outputs from UTXO set
-                BRTransaction *transaction;
-                BRUTXO o;
-                
-                [output getValue:&o];
-                transaction = self.allTx[uint256_obj(o.hash)];
-                [utxos removeObject:output];
-                balance -= [transaction.outputAmounts[o.n] unsignedLongLongValue];
-            }
-            
-            if (prevBalance < balance) totalReceived += balance - prevBalance;
-            if (balance < prevBalance) totalSent += prevBalance - balance;
-            [balanceHistory insertObject:@(balance) atIndex:0];
-            prevBalance = balance;
+            if (! [self applyTransaction:(__bridge BRTransaction *)br_txstore_list_get(_txStore, count - 1 - p)
+                   now:now]) break;
         }
     }
     
-    self.invalidTx = invalidTx;
-    self.pendingTx = pendingTx;
-    self.spentOutputs = spentOutputs;
-    self.utxos = utxos;
-    self.balanceHistory = balanceHistory;
-    _totalSent = totalSent;
-    _totalReceived = totalReceived;
+    _journalSynced = br_balance_count(_journal);
+    
+    // drop the undo records of transactions buried too deep for a reorg to reach
+    for (c = br_balance_checkpoint(_journal); c < br_balance_unconfirmed(_journal) &&
+         br_balance_height(_journal, c) + BALANCE_UNDO_DEPTH <= self.bestBlockHeight; c++);
+    br_balance_set_checkpoint(_journal, c);
+    
+    balance = br_balance_total(_journal);
+    _totalSent = br_balance_sent(_journal);
+    _totalReceived = br_balance_received(_journal);
     
     if (balance != _balance) {
         _balance = balance;
@@ -470,41 +622,78 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
 // NSData objects containing serialized UTXOs
 - (NSArray *)unspentOutputs
 {
-    return self.utxos.array;
+    size_t count = br_balance_utxo_count(_journal);
+    NSMutableArray *utxos = [NSMutableArray arrayWithCapacity:count];
+    NSMutableData *d = [NSMutableData dataWithLength:count*BR_OUTPOINT_SIZE];
+    
+    if (! d || ! br_balance_utxos(_journal, d.mutableBytes)) return utxos;
+    
+    for (size_t i = 0; i < count; i++) {
+        BRUTXO o = utxoForOutpoint((const uint8_t *)d.bytes + i*BR_OUTPOINT_SIZE);
+        
+        [utxos addObject:brutxo_obj(o)];
+    }
+    
+    return utxos;
 }
 
 // last 100 transactions sorted by date, most recent first
 - (NSArray *)recentTransactions
 {
     //TODO: don't include receive transactions that don't have at least one wallet output >= TX_MIN_OUTPUT_AMOUNT
-    return [self.transactions.array subarrayWithRange:NSMakeRange(0, (self.transactions.count > 100) ? 100 :
-                                                                  self.transactions.count)];
+    return [self.transactions subarrayWithRange:NSMakeRange(0, (self.transactions.count > 100) ? 100 :
+                                                            self.transactions.count)];
 }
 
 // all wallet transactions sorted by date, most recent first
 - (NSArray *)allTransactions
 {
-    return self.transactions.array;
+    return self.transactions;
+}
+
+- (NSArray *)transactions
+{
+    if (! _transactions) {
+        size_t count = br_txstore_list_count(_txStore);
+        NSMutableArray *transactions = [NSMutableArray arrayWithCapacity:count];
+        
+        for (size_t i = 0; i < count; i++) {
+            [transactions addObject:(__bridge BRTransaction *)br_txstore_list_get(_txStore, i)];
+        }
+        
+        _transactions = transactions;
+    }
+    
+    return _transactions;
 }
 
 // true if the address is controlled by the wallet
 - (BOOL)containsAddress:(NSString *)address
 {
-    return (address && [self.allAddresses containsObject:address]) ? YES : NO;
+    uint8_t h160[sizeof(UInt160)];
+    br_tx_script_type type = addressHash160(address, h160);
+    
+    return (type != BR_TX_SCRIPT_OTHER && br_addrset_contains(_allAddresses, type, h160)) ? YES : NO;
 }
 
 // gives the purpose of the address (either 0 or 44 for now)
 -(NSUInteger)addressPurpose:(NSString *)address
 {
-    if ([self.internalBIP44Addresses containsObject:address] || [self.externalBIP44Addresses containsObject:address]) return BIP44_PURPOSE;
-    if ([self.internalBIP32Addresses containsObject:address] || [self.externalBIP32Addresses containsObject:address]) return BIP32_PURPOSE;
-    return NSIntegerMax;
+    uint8_t h160[sizeof(UInt160)];
+    br_tx_script_type type = addressHash160(address, h160);
+    uint32_t value = (type != BR_TX_SCRIPT_OTHER) ? br_addrset_get(_allAddresses, type, h160) : UINT32_MAX;
+    
+    if (value == UINT32_MAX) return NSIntegerMax;
+    return (value & ADDRESS_BIP44) ? BIP44_PURPOSE : BIP32_PURPOSE;
 }
 
 // true if the address was previously used as an input or output in any wallet transaction
 - (BOOL)addressIsUsed:(NSString *)address
 {
-    return (address && [self.usedAddresses containsObject:address]) ? YES : NO;
+    uint8_t h160[sizeof(UInt160)];
+    br_tx_script_type type = addressHash160(address, h160);
+    
+    return (type != BR_TX_SCRIPT_OTHER && br_addrset_contains(_usedAddresses, type, h160)) ? YES : NO;
 }
 
 // MARK: - transactions
@@ -550,16 +739,16 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     //TODO: avoid combining addresses in a single transaction when possible to reduce information leakage
     //TODO: use up UTXOs received from any of the output scripts that this transaction sends funds to, to mitigate an
     //      attacker double spending and requesting a refund
-    for (NSValue *output in self.utxos) {
+    for (NSValue *output in self.unspentOutputs) {
         [output getValue:&o];
-        tx = self.allTx[uint256_obj(o.hash)];
+        tx = (__bridge BRTransaction *)br_txstore_get(_txStore, o.hash.u8);
         if (! tx) continue;
         //for example the tx block height is 25, can only send after the chain block height is 31 for previous confirmations needed of 6
         if (isInstant && (tx.blockHeight >= (self.blockHeight - IX_PREVIOUS_CONFIRMATIONS_NEEDED))) continue;
         [transaction addInputHash:tx.txHash index:o.n script:tx.outputScripts[o.n]];
         
         if (transaction.size + 34 > TX_MAX_SIZE) { // transaction size-in-bytes too large
-            NSUInteger txSize = 10 + self.utxos.count*148 + (scripts.count + 1)*34;
+            NSUInteger txSize = 10 + br_balance_utxo_count(_journal)*148 + (scripts.count + 1)*34;
             
             // check for sufficient total funds before building a smaller transaction
             if (self.balance < amount + [self feeForTxSize:txSize + cpfpSize isInstant:isInstant inputCount:transaction.inputHashes.count]) {
@@ -700,42 +889,71 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
 // true if the given transaction is associated with the wallet (even if it hasn't been registered), false otherwise
 - (BOOL)containsTransaction:(BRTransaction *)transaction
 {
-    if ([[NSSet setWithArray:transaction.outputAddresses] intersectsSet:self.allAddresses]) return YES;
+    for (NSData *script in transaction.outputScripts) {
+        if (scriptValue(_allAddresses, script) != UINT32_MAX) return YES;
+    }
     
     NSInteger i = 0;
     
     for (NSValue *txHash in transaction.inputHashes) {
-        BRTransaction *tx = self.allTx[txHash];
+        BRTransaction *tx = txForHash(_txStore, txHash);
         uint32_t n = [transaction.inputIndexes[i++] unsignedIntValue];
         
-        if (n < tx.outputAddresses.count && [self containsAddress:tx.outputAddresses[n]]) return YES;
+        if (n < tx.outputScripts.count && scriptValue(_allAddresses, tx.outputScripts[n]) != UINT32_MAX) return YES;
     }
     
     return NO;
 }
 
+// false if the transaction spends a wallet output and its signatures don't verify against the scripts of the outputs
+// it spends; true without checking unless all of those are in the tx store and pay to a pubkey or pubkey hash
+- (BOOL)transactionSpendsVerify:(BRTransaction *)transaction
+{
+    NSMutableArray *scripts = [NSMutableArray arrayWithCapacity:transaction.inputHashes.count];
+    uint8_t h160[sizeof(UInt160)];
+    BOOL spendsWallet = NO;
+    NSInteger i = 0;
+    
+    for (NSValue *txHash in transaction.inputHashes) {
+        BRTransaction *tx = txForHash(_txStore, txHash);
+        uint32_t n = [transaction.inputIndexes[i++] unsignedIntValue];
+        NSData *script = (n < tx.outputScripts.count) ? tx.outputScripts[n] : nil;
+    
+        if (scriptHash160(script, h160) != BR_TX_SCRIPT_PUBKEY_HASH) return YES;
+        if (scriptValue(_allAddresses, script) != UINT32_MAX) spendsWallet = YES;
+        [scripts addObject:script];
+    }
+    
+    return (! spendsWallet || [transaction verifySignaturesWithScripts:scripts]) ? YES : NO;
+}
+
 // records the transaction in the wallet, or returns false if it isn't associated with the wallet
 - (BOOL)registerTransaction:(BRTransaction *)transaction
 {
     UInt256 txHash = transaction.txHash;
-    NSValue *hash = uint256_obj(txHash);
     
     if (uint256_is_zero(txHash)) return NO;
     
     if (! [self containsTransaction:transaction]) {
-        if (transaction.blockHeight == TX_UNCONFIRMED) self.allTx[hash] = transaction;
+        if (transaction.blockHeight == TX_UNCONFIRMED) [self storeTransaction:transaction];
         return NO;
     }
     
-    if (self.allTx[hash] != nil) return YES;
+    if (br_txstore_get(_txStore, txHash.u8)) return YES;
+    
+    // an unconfirmed spend of a wallet output with a bad signature would otherwise show the output as spent
+    if (transaction.blockHeight == TX_UNCONFIRMED && ! [self transactionSpendsVerify:transaction]) {
+        NSLog(@"[BRWallet] signatures don't verify for transaction %@", transaction);
+        return NO;
+    }
     
     //TODO: handle tx replacement with input sequence numbers (now replacements appear invalid until confirmation)
     NSLog(@"[BRWallet] received unseen transaction %@", transaction);
     
-    self.allTx[hash] = transaction;
-    [self.transactions insertObject:transaction atIndex:0];
-    [self.usedAddresses addObjectsFromArray:transaction.inputAddresses];
-    [self.usedAddresses addObjectsFromArray:transaction.outputAddresses];
+    if (! [self storeTransaction:transaction]) return NO;
+    br_txstore_list_insert(_txStore, txHash.u8, 0);
+    self.transactions = nil;
+    addTxAddresses(_usedAddresses, transaction);
     [self updateBalance];
     
     // when a wallet address is used in a transaction, generate a new address to replace it
@@ -760,7 +978,7 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
 // removes a transaction from the wallet along with any transactions that depend on its outputs
 - (void)removeTransaction:(UInt256)txHash
 {
-    BRTransaction *transaction = self.allTx[uint256_obj(txHash)];
+    BRTransaction *transaction = (__bridge BRTransaction *)br_txstore_get(_txStore, txHash.u8);
     NSMutableSet *hashes = [NSMutableSet set];
     
     for (BRTransaction *tx in self.transactions) { // remove dependent transactions
@@ -778,8 +996,9 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
         [self removeTransaction:h];
     }
     
-    [self.allTx removeObjectForKey:uint256_obj(txHash)];
-    if (transaction) [self.transactions removeObject:transaction];
+    [self invalidateJournalFrom:txHash.u8];
+    br_txstore_remove(_txStore, txHash.u8); // takes it off the list as well
+    self.transactions = nil;
     [self updateBalance];
     
     [self.moc performBlock:^{ // remove transaction from core data
@@ -793,30 +1012,30 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
 // returns the transaction with the given hash if it's been registered in the wallet (might also return non-registered)
 - (BRTransaction *)transactionForHash:(UInt256)txHash
 {
-    return self.allTx[uint256_obj(txHash)];
+    return (__bridge BRTransaction *)br_txstore_get(_txStore, txHash.u8);
 }
 
 // true if no previous wallet transactions spend any of the given transaction's inputs, and no input tx is invalid
 - (BOOL)transactionIsValid:(BRTransaction *)transaction
 {
     //TODO: XXX attempted double spends should cause conflicted tx to remain unverified until they're confirmed
-    //TODO: XXX verify signatures for spends
     if (transaction.blockHeight != TX_UNCONFIRMED) return YES;
     
-    if (self.allTx[uint256_obj(transaction.txHash)] != nil) {
-        return ([self.invalidTx containsObject:uint256_obj(transaction.txHash)]) ? NO : YES;
+    if (br_txstore_get(_txStore, transaction.txHash.u8)) {
+        return (br_balance_state(_journal, transaction.txHash.u8) == BR_BALANCE_INVALID) ? NO : YES;
     }
     
+    if (! [self transactionSpendsVerify:transaction]) return NO;
+    
     uint32_t i = 0;
     
     for (NSValue *hash in transaction.inputHashes) {
-        BRTransaction *tx = self.allTx[hash];
+        BRTransaction *tx = txForHash(_txStore, hash);
         uint32_t n = [transaction.inputIndexes[i++] unsignedIntValue];
         UInt256 h;
         
         [hash getValue:&h];
-        if ((tx && ! [self transactionIsValid:tx]) ||
-            [self.spentOutputs containsObject:brutxo_obj(((BRUTXO) { h, n }))]) return NO;
+        if ((tx && ! [self transactionIsValid:tx]) || br_balance_spent(_journal, h.u8, n)) return NO;
     }
     
     return YES;
@@ -842,7 +1061,7 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     }
     
     for (NSValue *txHash in transaction.inputHashes) { // check if any inputs are known to be pending
-        if ([self transactionIsPending:self.allTx[txHash]]) return YES;
+        if ([self transactionIsPending:txForHash(_txStore, txHash)]) return YES;
     }
     
     return NO;
@@ -856,8 +1075,10 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     if (! [self transactionIsValid:transaction] || [self transactionIsPending:transaction]) return NO;
     
     for (NSValue *txHash in transaction.inputHashes) { // check if any inputs are known to be unverfied
-        if (! self.allTx[txHash]) continue;
-        if (! [self transactionIsVerified:self.allTx[txHash]]) return NO;
+        BRTransaction *tx = txForHash(_txStore, txHash);
+        
+        if (! tx) continue;
+        if (! [self transactionIsVerified:tx]) return NO;
     }
     
     return YES;
@@ -873,20 +1094,24 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     if (height != TX_UNCONFIRMED && height > self.bestBlockHeight) self.bestBlockHeight = height;
     
     for (NSValue *hash in txHashes) {
-        BRTransaction *tx = self.allTx[hash];
+        BRTransaction *tx = txForHash(_txStore, hash);
         UInt256 h;
         
         if (! tx || (tx.blockHeight == height && tx.timestamp == timestamp)) continue;
+        [hash getValue:&h];
+        if (tx.blockHeight != height) [self invalidateJournalFrom:h.u8];
         tx.blockHeight = height;
         tx.timestamp = timestamp;
+        br_txstore_set_height(_txStore, h.u8, height);
         
         if ([self containsTransaction:tx]) {
-            [hash getValue:&h];
+            int state = br_balance_state(_journal, h.u8);
+            
             [hashes addObject:[NSData dataWithBytes:&h length:sizeof(h)]];
             [updated addObject:hash];
-            if ([self.pendingTx containsObject:hash] || [self.invalidTx containsObject:hash]) needsUpdate = YES;
+            if (state == BR_BALANCE_PENDING || state == BR_BALANCE_INVALID) needsUpdate = YES;
         }
-        else if (height != TX_UNCONFIRMED) [self.allTx removeObjectForKey:hash]; // remove confirmed non-wallet tx
+        else if (height != TX_UNCONFIRMED) br_txstore_remove(_txStore, h.u8); // remove confirmed non-wallet tx
     }
     
     if (hashes.count > 0) {
@@ -941,8 +1166,11 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     NSUInteger n = 0;
     
     //TODO: don't include outputs below TX_MIN_OUTPUT_AMOUNT
-    for (NSString *address in transaction.outputAddresses) {
-        if ([self containsAddress:address]) amount += [transaction.outputAmounts[n] unsignedLongLongValue];
+    for (NSData *script in transaction.outputScripts) {
+        if (scriptValue(_allAddresses, script) != UINT32_MAX) {
+            amount += [transaction.outputAmounts[n] unsignedLongLongValue];
+        }
+        
         n++;
     }
     
@@ -956,10 +1184,10 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     NSUInteger i = 0;
     
     for (NSValue *hash in transaction.inputHashes) {
-        BRTransaction *tx = self.allTx[hash];
+        BRTransaction *tx = txForHash(_txStore, hash);
         uint32_t n = [transaction.inputIndexes[i++] unsignedIntValue];
         
-        if (n < tx.outputAddresses.count && [self containsAddress:tx.outputAddresses[n]]) {
+        if (n < tx.outputScripts.count && scriptValue(_allAddresses, tx.outputScripts[n]) != UINT32_MAX) {
             amount += [tx.outputAmounts[n] unsignedLongLongValue];
         }
     }
@@ -974,7 +1202,7 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     NSUInteger i = 0;
     
     for (NSValue *hash in transaction.inputHashes) {
-        BRTransaction *tx = self.allTx[hash];
+        BRTransaction *tx = txForHash(_txStore, hash);
         uint32_t n = [transaction.inputIndexes[i++] unsignedIntValue];
         
         if (n >= tx.outputAmounts.count) return UINT64_MAX;
@@ -991,9 +1219,11 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
 // historical wallet balance after the given transaction, or current balance if transaction is not registered in wallet
 - (uint64_t)balanceAfterTransaction:(BRTransaction *)transaction
 {
-    NSUInteger i = [self.transactions indexOfObject:transaction];
+    size_t i = (transaction) ? br_txstore_list_index(_txStore, transaction.txHash.u8) : SIZE_MAX,
+           count = br_txstore_list_count(_txStore);
     
-    return (i < self.balanceHistory.count) ? [self.balanceHistory[i] unsignedLongLongValue] : self.balance;
+    // the list is most recent first, the journal oldest first
+    return (i < count && count == br_balance_count(_journal)) ? br_balance_after(_journal, count - 1 - i) : self.balance;
 }
 
 // Returns the block height after which the transaction is likely to be processed without including a fee. This is based
@@ -1006,7 +1236,7 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     NSUInteger i = 0;
     
     for (NSValue *hash in transaction.inputHashes) { // get the amounts and block heights of all the transaction inputs
-        BRTransaction *tx = self.allTx[hash];
+        BRTransaction *tx = txForHash(_txStore, hash);
         uint32_t n = [transaction.inputIndexes[i++] unsignedIntValue];
         
         if (n >= tx.outputAmounts.count) break;
@@ -1064,9 +1294,9 @@ static NSUInteger txAddressIndex(BRTransaction *tx, NSArray *chain) {
     uint64_t amount = 0, fee;
     size_t cpfpSize = 0, txSize;
     
-    for (NSValue *output in self.utxos) {
+    for (NSValue *output in self.unspentOutputs) {
         [output getValue:&o];
-        tx = self.allTx[uint256_obj(o.hash)];
+        tx = (__bridge BRTransaction *)br_txstore_get(_txStore, o.hash.u8);
         if (o.n >= tx.outputAmounts.count) continue;
         if (confirmationCount && (tx.blockHeight >= (self.blockHeight - confirmationCount))) continue;
         inputCount++;
@@ -32,19 +32,8 @@
 
 - (UInt256)XEVAN
 {
-    NSData * copy = [self copy];
-    char *output = (char *)calloc(256, sizeof(char));
-   // NSData *data4 = [copy subdataWithRange:NSMakeRange(0, 4)];
-   // int value = CFSwapInt32BigToHost(*(int*)([data4 bytes]));
-    
-    
-    int version;
-    [copy getBytes:&version length:sizeof(version)];
-    
-    
-    xevan_hash(copy.bytes, output, version);
-    // Check if i have to dealloc something here.
-    return *(const UInt256 *)output;
+    if (self.length < sizeof(uint32_t)) return UINT256_ZERO;
+    return xevan_header(self.bytes, self.length);
 }
 
 + (NSData *)dataFromHexString:(NSString *)string
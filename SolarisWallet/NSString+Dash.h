@@ -25,6 +25,7 @@
 
 #import <Foundation/Foundation.h>
 #import <UIKit/UIKit.h>
+#import "IntTypes.h"
 
 #define DASH_PUBKEY_ADDRESS      63
 #define DASH_SCRIPT_ADDRESS      13
@@ -45,6 +46,7 @@
 
 + (NSString *)addressWithScriptPubKey:(NSData *)script;
 + (NSString *)addressWithScriptSig:(NSData *)script;
++ (NSString *)addressWithHash160:(UInt160)hash160;
 
 - (NSAttributedString*)attributedStringForDashSymbol;
 - (NSAttributedString*)attributedStringForDashSymbolWithTintColor:(UIColor*)color;
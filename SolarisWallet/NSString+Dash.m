@@ -112,6 +112,21 @@
     return [self base58checkWithData:d];
 }
 
+// pay-to-pubkey-hash address
++ (NSString *)addressWithHash160:(UInt160)hash160
+{
+    NSMutableData *d = [NSMutableData secureDataWithCapacity:sizeof(UInt160) + 1];
+    uint8_t v = DASH_PUBKEY_ADDRESS;
+
+#if DASH_TESTNET
+    v = DASH_PUBKEY_ADDRESS_TEST;
+#endif
+
+    [d appendBytes:&v length:1];
+    [d appendBytes:&hash160 length:sizeof(hash160)];
+    return [self base58checkWithData:d];
+}
+
 - (BOOL)isValidDashAddress
 {
     if (self.length > 35) return NO;
@@ -0,0 +1,71 @@
+//
+//  bench.h
+//  SolarisWallet
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#ifndef bench_h
+#define bench_h
+
+// the timer, random numbers and failure report shared by the bench_*.c programs, in the manner of secp256k1/src/bench.h
+// define before including it: BENCH_NAME, the program name failures are reported under, and optionally BENCH_DETAIL,
+// an expression for what is being checked at the time, and BENCH_SEED, the first state of bench_rand()
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#ifndef BENCH_SEED
+#define BENCH_SEED 0x2545f491u
+#endif
+
+static inline double gettimedouble(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return tv.tv_usec*0.000001 + tv.tv_sec;
+}
+
+// xorshift32, the same sequence on every run
+static inline uint32_t bench_rand(void)
+{
+    static uint32_t bench_x = BENCH_SEED;
+
+    bench_x ^= bench_x << 13;
+    bench_x ^= bench_x >> 17;
+    bench_x ^= bench_x << 5;
+    return bench_x;
+}
+
+// reports check what failing at i, returns 0 for the check to return
+static inline int bench_fail(const char *what, size_t i)
+{
+#ifdef BENCH_DETAIL
+    fprintf(stderr, "%s: %s: %s at %zu\n", BENCH_NAME, BENCH_DETAIL, what, i);
+#else
+    fprintf(stderr, "%s: %s at %zu\n", BENCH_NAME, what, i);
+#endif
+    return 0;
+}
+
+#endif /* bench_h */
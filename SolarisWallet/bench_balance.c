@@ -0,0 +1,379 @@
+//
+//  bench_balance.c
+//  SolarisWallet
+//
+//  Checks BRBalance.c against walking every transaction the way -[BRWallet updateBalance] did, and
+//  times the two with -b.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRBalance.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_NAME "bench_balance"
+#include "bench.h"
+
+#define CHECK_TXS     120
+#define CHECK_ROUNDS  3000
+#define BENCH_TXS     20000
+#define MAX_INPUTS    3
+#define MAX_OUTPUTS   4
+
+typedef struct {
+    uint8_t hash[32];
+    int unconfirmed, pending;
+    size_t in_count, out_count;
+    uint8_t in_hash[MAX_INPUTS*32];
+    uint32_t in_index[MAX_INPUTS];
+    uint64_t out_amount[MAX_OUTPUTS];
+    uint8_t out_mine[MAX_OUTPUTS];
+} bench_tx;
+
+typedef struct {
+    size_t tx;
+    int unconfirmed, pending;
+} bench_applied;
+
+// transactions spending outputs of the ones before them, close enough that some spend the same output
+static void bench_make(bench_tx *txs, size_t count, int spread)
+{
+    for (size_t i = 0; i < count; i++) {
+        bench_tx *tx = &txs[i];
+
+        memset(tx, 0, sizeof(*tx));
+        for (size_t j = 0; j < 32; j++) tx->hash[j] = (uint8_t)bench_rand();
+        tx->in_count = 1 + bench_rand() % MAX_INPUTS;
+        tx->out_count = 1 + bench_rand() % MAX_OUTPUTS;
+
+        for (size_t j = 0; j < tx->in_count; j++) {
+            size_t k = (i > 0) ? i - 1 - bench_rand() % ((i < (size_t)spread) ? i : (size_t)spread) : 0;
+
+            if (i == 0 || bench_rand() % 8 == 0) { // from outside the wallet
+                for (size_t b = 0; b < 32; b++) tx->in_hash[j*32 + b] = (uint8_t)bench_rand();
+            }
+            else memcpy(tx->in_hash + j*32, txs[k].hash, 32);
+
+            tx->in_index[j] = bench_rand() % MAX_OUTPUTS;
+        }
+
+        for (size_t n = 0; n < tx->out_count; n++) {
+            tx->out_amount[n] = 1000 + bench_rand() % 100000;
+            tx->out_mine[n] = (bench_rand() % 3 != 0);
+        }
+    }
+}
+
+static void bench_input(br_balance_tx *in, const bench_tx *tx, int unconfirmed, int pending)
+{
+    in->hash = tx->hash;
+    in->height = (unconfirmed) ? UINT32_MAX : 1;
+    in->unconfirmed = unconfirmed;
+    in->pending = pending;
+    in->in_count = tx->in_count;
+    in->in_hash = tx->in_hash;
+    in->in_index = tx->in_index;
+    in->out_count = tx->out_count;
+    in->out_amount = tx->out_amount;
+    in->out_mine = tx->out_mine;
+}
+
+typedef struct {
+    uint8_t (*spent)[BR_OUTPOINT_SIZE], (*utxos)[BR_OUTPOINT_SIZE];
+    size_t spent_count, utxo_count;
+    int *state; // per position
+    uint64_t *history, balance, sent, received;
+} bench_ref;
+
+static size_t bench_find(uint8_t (*set)[BR_OUTPOINT_SIZE], size_t count, const uint8_t *hash, uint32_t n)
+{
+    uint8_t key[BR_OUTPOINT_SIZE];
+
+    memcpy(key, hash, 32);
+    key[32] = (uint8_t)n, key[33] = (uint8_t)(n >> 8), key[34] = (uint8_t)(n >> 16), key[35] = (uint8_t)(n >> 24);
+    for (size_t i = 0; i < count; i++) if (memcmp(set[i], key, BR_OUTPOINT_SIZE) == 0) return i;
+    return SIZE_MAX;
+}
+
+static void bench_insert(uint8_t (*set)[BR_OUTPOINT_SIZE], size_t *count, const uint8_t *hash, uint32_t n)
+{
+    if (bench_find(set, *count, hash, n) != SIZE_MAX) return;
+    memcpy(set[*count], hash, 32);
+    set[*count][32] = (uint8_t)n, set[*count][33] = (uint8_t)(n >> 8);
+    set[*count][34] = (uint8_t)(n >> 16), set[*count][35] = (uint8_t)(n >> 24);
+    (*count)++;
+}
+
+// the state of the applied transaction with the given hash among the first count of the list, 0 if there is none
+static int bench_ref_state(const bench_ref *r, const bench_tx *txs, const bench_applied *list, size_t count,
+                           const uint8_t *hash)
+{
+    for (size_t i = 0; i < count; i++) if (memcmp(txs[list[i].tx].hash, hash, 32) == 0) return r->state[i];
+    return 0;
+}
+
+// -[BRWallet updateBalance] as it was, with the list oldest first
+static void bench_reference(bench_ref *r, const bench_tx *txs, const bench_applied *list, size_t count)
+{
+    uint64_t balance = 0, prevBalance = 0;
+
+    r->spent_count = r->utxo_count = 0;
+    r->sent = r->received = 0;
+
+    for (size_t t = 0; t < count; t++) {
+        const bench_tx *tx = &txs[list[t].tx];
+        int invalid = 0, pending = 0;
+
+        if (list[t].unconfirmed) { // check if any inputs are invalid or already spent
+            for (size_t i = 0; i < tx->in_count; i++) {
+                if (bench_find(r->spent, r->spent_count, tx->in_hash + i*32, tx->in_index[i]) != SIZE_MAX ||
+                    bench_ref_state(r, txs, list, t, tx->in_hash + i*32) == BR_BALANCE_INVALID) invalid = 1;
+            }
+        }
+
+        if (invalid) {
+            r->state[t] = BR_BALANCE_INVALID;
+            r->history[t] = balance;
+            continue;
+        }
+
+        for (size_t i = 0; i < tx->in_count; i++) {
+            bench_insert(r->spent, &r->spent_count, tx->in_hash + i*32, tx->in_index[i]);
+        }
+
+        if (list[t].unconfirmed) {
+            pending = list[t].pending;
+
+            for (size_t i = 0; i < tx->in_count; i++) {
+                if (bench_ref_state(r, txs, list, t, tx->in_hash + i*32) == BR_BALANCE_PENDING) pending = 1;
+            }
+
+            if (pending) {
+                r->state[t] = BR_BALANCE_PENDING;
+                r->history[t] = balance;
+                continue;
+            }
+        }
+
+        r->state[t] = BR_BALANCE_APPLIED;
+
+        for (size_t n = 0; n < tx->out_count; n++) {
+            if (! tx->out_mine[n]) continue;
+            bench_insert(r->utxos, &r->utxo_count, tx->hash, (uint32_t)n);
+            balance += tx->out_amount[n];
+        }
+
+        // check the entire UTXO set against the entire spent output set
+        for (size_t i = 0; i < r->utxo_count;) {
+            uint32_t n = r->utxos[i][32] | ((uint32_t)r->utxos[i][33] << 8);
+
+            if (bench_find(r->spent, r->spent_count, r->utxos[i], n) == SIZE_MAX) {
+                i++;
+                continue;
+            }
+
+            for (size_t k = 0; k < count; k++) {
+                if (memcmp(txs[list[k].tx].hash, r->utxos[i], 32) == 0) balance -= txs[list[k].tx].out_amount[n];
+            }
+
+            memmove(r->utxos + i, r->utxos + i + 1, (--r->utxo_count - i)*BR_OUTPOINT_SIZE);
+        }
+
+        if (prevBalance < balance) r->received += balance - prevBalance;
+        if (balance < prevBalance) r->sent += prevBalance - balance;
+        r->history[t] = balance;
+        prevBalance = balance;
+    }
+
+    r->balance = balance;
+}
+
+// brings the journal up to date with the list the way BRWallet does, returns 0 if out of memory; the changes to
+// pending checks are all in the list here, so going back to the oldest unconfirmed transaction is up to floor
+static int bench_sync(br_balance *b, bench_applied *applied, const bench_tx *txs, const bench_applied *list,
+                      size_t count, int floor)
+{
+    size_t p = 0;
+    br_balance_tx in;
+
+    while (p < count && p < br_balance_count(b) && applied[p].tx == list[p].tx &&
+           applied[p].unconfirmed == list[p].unconfirmed && applied[p].pending == list[p].pending) p++;
+    if (floor && br_balance_unconfirmed(b) < p) p = br_balance_unconfirmed(b);
+    if (p < br_balance_checkpoint(b)) br_balance_clear(b);
+    while (br_balance_count(b) > p && br_balance_revert(b));
+
+    for (p = br_balance_count(b); p < count; p++) {
+        bench_input(&in, &txs[list[p].tx], list[p].unconfirmed, list[p].pending);
+        if (! br_balance_apply(b, &in)) return 0;
+        applied[p] = list[p];
+    }
+
+    return 1;
+}
+
+static int bench_compare(const br_balance *b, bench_ref *r, const bench_tx *txs, const bench_applied *list,
+                         size_t count, size_t universe, size_t round)
+{
+    uint8_t *utxos;
+
+    bench_reference(r, txs, list, count);
+    if (br_balance_count(b) != count) return bench_fail("count", round);
+
+    for (size_t t = 0; t < count; t++) {
+        if (br_balance_state(b, txs[list[t].tx].hash) != r->state[t]) return bench_fail("state", round);
+        if (memcmp(br_balance_hash(b, t), txs[list[t].tx].hash, 32) != 0) return bench_fail("hash", round);
+        if (br_balance_after(b, t) != r->history[t]) return bench_fail("balance history", round);
+    }
+
+    if (br_balance_total(b) != r->balance) return bench_fail("balance", round);
+    if (br_balance_sent(b) != r->sent || br_balance_received(b) != r->received) return bench_fail("totals", round);
+
+    for (size_t i = 0; i < universe; i++) {
+        for (uint32_t n = 0; n < MAX_OUTPUTS; n++) {
+            if (br_balance_spent(b, txs[i].hash, n) !=
+                (bench_find(r->spent, r->spent_count, txs[i].hash, n) != SIZE_MAX)) return bench_fail("spent", round);
+        }
+
+        if (br_balance_state(b, txs[i].hash) != 0) {
+            size_t t;
+
+            for (t = 0; t < count && list[t].tx != i; t++);
+            if (t == count) return bench_fail("state of unlisted", round);
+        }
+    }
+
+    if (br_balance_utxo_count(b) != r->utxo_count) return bench_fail("utxo count", round);
+    utxos = malloc(r->utxo_count*BR_OUTPOINT_SIZE + 1);
+    if (! utxos || ! br_balance_utxos(b, utxos)) return bench_fail("utxos out of memory", round);
+
+    if (memcmp(utxos, r->utxos, r->utxo_count*BR_OUTPOINT_SIZE) != 0) {
+        free(utxos);
+        return bench_fail("utxo order", round);
+    }
+
+    free(utxos);
+    return 1;
+}
+
+static int bench_check(void)
+{
+    static bench_tx txs[CHECK_TXS];
+    static bench_applied list[CHECK_TXS], applied[CHECK_TXS];
+    static uint8_t spent[CHECK_TXS*MAX_INPUTS][BR_OUTPOINT_SIZE], utxos[CHECK_TXS*MAX_OUTPUTS][BR_OUTPOINT_SIZE];
+    static int state[CHECK_TXS];
+    static uint64_t history[CHECK_TXS];
+    bench_ref r = { spent, utxos, 0, 0, state, history, 0, 0, 0 };
+    br_balance *b = br_balance_new();
+    size_t count = 0, next = 0;
+
+    if (! b) return 0;
+    bench_make(txs, CHECK_TXS, 6);
+
+    for (size_t round = 0; round < CHECK_ROUNDS; round++) {
+        size_t op = bench_rand() % 10, i = (count > 0) ? bench_rand() % count : 0, j, k;
+
+        if (op < 3 && next < CHECK_TXS) { // a new transaction, the most recent
+            list[count].tx = next++;
+            list[count].unconfirmed = (bench_rand() % 2 == 0);
+            list[count++].pending = (bench_rand() % 4 == 0);
+        }
+        else if (op == 3 && count > 0) { // removed, with what depends on it left to its checks
+            memmove(list + i, list + i + 1, (--count - i)*sizeof(*list));
+        }
+        else if (op == 4 && count > 1) { // sorted into another place
+            bench_applied x = list[i];
+
+            j = bench_rand() % count;
+            memmove(list + i, list + i + 1, (count - 1 - i)*sizeof(*list));
+            memmove(list + j + 1, list + j, (count - 1 - j)*sizeof(*list));
+            list[j] = x;
+        }
+        else if (op < 7 && count > 0) { // confirmed, unconfirmed by a reorg, or time passing for its pending checks
+            j = (bench_rand() % 4 == 0) ? i : count - 1 - bench_rand() % ((count < 4) ? count : 4);
+            if (op == 5) list[j].unconfirmed = ! list[j].unconfirmed;
+            else list[j].pending = ! list[j].pending;
+        }
+        else if (op == 7) { // the checkpoint moves up over confirmed transactions
+            k = br_balance_checkpoint(b) + bench_rand() % 8;
+            if (k > br_balance_unconfirmed(b)) k = br_balance_unconfirmed(b);
+            br_balance_set_checkpoint(b, k);
+        }
+        else if (op == 8) { // back to any transaction above the checkpoint, then forward again
+            k = bench_rand() % 8;
+            while (k-- > 0 && br_balance_revert(b));
+        }
+        else if (op == 9 && bench_rand() % 16 == 0) { // a wallet that starts over
+            br_balance_clear(b);
+            count = next = 0;
+            bench_make(txs, CHECK_TXS, 2 + bench_rand() % 8);
+        }
+
+        if (! bench_sync(b, applied, txs, list, count, bench_rand() % 2)) return bench_fail("out of memory", round);
+        if (! bench_compare(b, &r, txs, list, count, CHECK_TXS, round)) return 0;
+    }
+
+    br_balance_free(b);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (! bench_check()) return 1;
+    printf("br_balance: matches the full walk over %d rounds of changes\n", CHECK_ROUNDS);
+
+    if (argc > 1 && strcmp(argv[1], "-b") == 0) {
+        bench_tx *txs = malloc(BENCH_TXS*sizeof(*txs));
+        br_balance *b = br_balance_new();
+        br_balance_tx in;
+        double begin, t_all, t_top = 0;
+        int rounds = 1000;
+
+        if (! txs || ! b) return 1;
+        bench_make(txs, BENCH_TXS, 200);
+        begin = gettimedouble();
+
+        for (size_t i = 0; i < BENCH_TXS; i++) {
+            bench_input(&in, &txs[i], 0, 0);
+            br_balance_apply(b, &in);
+        }
+
+        t_all = gettimedouble() - begin;
+
+        // a new unconfirmed transaction and then its confirmation: revert it, apply it again, confirmed
+        for (int r = 0; r < rounds; r++) {
+            begin = gettimedouble();
+            br_balance_revert(b);
+            bench_input(&in, &txs[BENCH_TXS - 1], r & 1, 0);
+            br_balance_apply(b, &in);
+            t_top += gettimedouble() - begin;
+        }
+
+        printf("%d txs: %.2f ms to walk them all, %.0f ns to revert and apply the most recent, balance %llu, "
+               "%zu utxos\n", BENCH_TXS, t_all*1e3, t_top*1e9/rounds, (unsigned long long)br_balance_total(b),
+               br_balance_utxo_count(b));
+        br_balance_free(b);
+        free(txs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+//
+//  bench_bip32.c
+//  SolarisWallet
+//
+//  Checks BRBIP32Chain.c against the BIP32 test vectors and against CKDpub one child at a time, and
+//  times the two with -b.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRBIP32Chain.h"
+#include "sph/sph_sha2.h"
+#include "sph/sph_ripemd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_NAME "bench_bip32"
+#define BENCH_SEED 0x3c6ef372u
+#include "bench.h"
+
+#define CHECK_ROUNDS  20
+#define CHECK_MAX     600 // more than two runs of BR_BIP32_RUN
+#define BENCH_KEYS    1000
+
+static void bench_unhex(uint8_t *out, const char *hex)
+{
+    for (size_t i = 0; hex[2*i]; i++) sscanf(hex + 2*i, "%2hhx", &out[i]);
+}
+
+static void bench_hmac_sha512(uint8_t *md, const uint8_t *key, size_t key_len, const uint8_t *data, size_t len)
+{
+    sph_sha512_context sha;
+    uint8_t pad[128], inner[64];
+
+    memset(pad, 0x36, sizeof(pad));
+    for (size_t i = 0; i < key_len; i++) pad[i] ^= key[i];
+    sph_sha512_init(&sha);
+    sph_sha512(&sha, pad, sizeof(pad));
+    sph_sha512(&sha, data, len);
+    sph_sha512_close(&sha, inner);
+    memset(pad, 0x5c, sizeof(pad));
+    for (size_t i = 0; i < key_len; i++) pad[i] ^= key[i];
+    sph_sha512(&sha, pad, sizeof(pad));
+    sph_sha512(&sha, inner, sizeof(inner));
+    sph_sha512_close(&sha, md);
+}
+
+static void bench_hash160(uint8_t *hash160, const uint8_t *pubkey)
+{
+    sph_sha256_context sha;
+    sph_ripemd160_context rmd;
+    uint8_t md[32];
+
+    sph_sha256_init(&sha);
+    sph_sha256(&sha, pubkey, 33);
+    sph_sha256_close(&sha, md);
+    sph_ripemd160_init(&rmd);
+    sph_ripemd160(&rmd, md, sizeof(md));
+    sph_ripemd160_close(&rmd, hash160);
+}
+
+// CKDpub as BRBIP32Sequence does it: parse, tweak and serialise through the public api, one child at a time
+static void bench_ckd_pub(const secp256k1_context *ctx, uint8_t *pubkey, uint8_t *chain, uint32_t i)
+{
+    uint8_t buf[37], I[64];
+    secp256k1_pubkey pk;
+    size_t len = 33;
+
+    memcpy(buf, pubkey, 33);
+    buf[33] = (uint8_t)(i >> 24), buf[34] = (uint8_t)(i >> 16), buf[35] = (uint8_t)(i >> 8), buf[36] = (uint8_t)i;
+    bench_hmac_sha512(I, chain, 32, buf, sizeof(buf));
+    memcpy(chain, I + 32, 32);
+
+    if (! secp256k1_ec_pubkey_parse(ctx, &pk, pubkey, 33) || ! secp256k1_ec_pubkey_tweak_add(ctx, &pk, I) ||
+        ! secp256k1_ec_pubkey_serialize(ctx, pubkey, &len, &pk, SECP256K1_EC_COMPRESSED)) memset(pubkey, 0, 33);
+}
+
+// BIP32 test vector 1: m/0H/1/2H, and its children 2 and then 1000000000
+static int bench_check_vectors(const secp256k1_context *ctx)
+{
+    uint8_t pubkey[33], chain[32], child[33], expected[33];
+    br_bip32_chain *c;
+
+    bench_unhex(pubkey, "0357bfe1e341d01c69fe5654309956cbea516822fba8a601743a012a7896ee8dc2");
+    bench_unhex(chain, "04466b9cc8e161e966409ca52986c584f07e9dc81f735db683c3ff6ec7b1503f");
+    if (! (c = br_bip32_chain_new(pubkey, chain))) return 0;
+    if (br_bip32_chain_derive(c, ctx, 2, 1, child, NULL) != 1) return bench_fail("vector derive", 2);
+    br_bip32_chain_free(c);
+    bench_unhex(expected, "02e8445082a72f29b75ca48748a914df60622a609cacfce8ed0e35804560741d29");
+    if (memcmp(child, expected, 33) != 0) return bench_fail("vector m/0H/1/2H/2", 0);
+
+    bench_unhex(chain, "cfb71883f01676f587d023cc53a35bc7f88f724b1f8c2892ac1275ac822a3edd");
+    if (! (c = br_bip32_chain_new(child, chain))) return 0;
+    if (br_bip32_chain_derive(c, ctx, 1000000000, 1, pubkey, NULL) != 1) return bench_fail("vector derive", 1);
+    br_bip32_chain_free(c);
+    bench_unhex(expected, "022a471424da5e657499d1ff51cb43c47481a03b1e77f951fe64cec9f5a48f7011");
+    if (memcmp(pubkey, expected, 33) != 0) return bench_fail("vector m/0H/1/2H/2/1000000000", 0);
+    return 1;
+}
+
+static int bench_check_runs(const secp256k1_context *ctx)
+{
+    static uint8_t pubkeys[CHECK_MAX*33], hash160s[CHECK_MAX*20];
+
+    for (size_t round = 0; round < CHECK_ROUNDS; round++) {
+        uint8_t seckey[32], pubkey[33], chain[32], key[33], c[32], hash160[20];
+        uint32_t first = (round % 4 == 0) ? 0 : bench_rand() % 100000;
+        size_t n = 1 + bench_rand() % CHECK_MAX, len = 33;
+        secp256k1_pubkey pk;
+        br_bip32_chain *bc;
+
+        for (size_t i = 0; i < 32; i++) seckey[i] = (uint8_t)bench_rand(), chain[i] = (uint8_t)bench_rand();
+        if (! secp256k1_ec_pubkey_create(ctx, &pk, seckey)) continue;
+        secp256k1_ec_pubkey_serialize(ctx, pubkey, &len, &pk, SECP256K1_EC_COMPRESSED);
+        if (! (bc = br_bip32_chain_new(pubkey, chain))) return 0;
+        if (br_bip32_chain_derive(bc, ctx, first, n, pubkeys, hash160s) != n) return bench_fail("derive", round);
+        br_bip32_chain_free(bc);
+
+        for (size_t i = 0; i < n; i++) {
+            memcpy(key, pubkey, 33);
+            memcpy(c, chain, 32);
+            bench_ckd_pub(ctx, key, c, first + (uint32_t)i);
+            bench_hash160(hash160, key);
+            if (memcmp(pubkeys + i*33, key, 33) != 0) return bench_fail("pubkey", round*CHECK_MAX + i);
+            if (memcmp(hash160s + i*20, hash160, 20) != 0) return bench_fail("hash160", round*CHECK_MAX + i);
+        }
+    }
+
+    return 1;
+}
+
+// tweaks of zero, of the group order and above it, and of the negated secret key, which sums to infinity
+static int bench_check_edges(const secp256k1_context *ctx)
+{
+    static const char *order = "fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141";
+    uint8_t seckey[32] = { 0 }, pubkey[33], tweaks[4*32], out[4*33];
+    secp256k1_pubkey pk;
+    size_t len = 33;
+
+    seckey[31] = 7;
+    if (! secp256k1_ec_pubkey_create(ctx, &pk, seckey)) return 0;
+    secp256k1_ec_pubkey_serialize(ctx, pubkey, &len, &pk, SECP256K1_EC_COMPRESSED);
+    memset(tweaks, 0, 32);
+    bench_unhex(tweaks + 32, order);
+    memset(tweaks + 64, 0xff, 32);
+    bench_unhex(tweaks + 96, order);
+    tweaks[127] -= 7; // the order minus 7, so 7G + (n - 7)G is the point at infinity
+
+    if (br_secp_pubkey_tweak_add_all(ctx, out, pubkey, tweaks, 4) != 1) return bench_fail("edge count", 0);
+    if (memcmp(out, pubkey, 33) != 0) return bench_fail("zero tweak", 0);
+
+    for (size_t i = 1; i < 4; i++) {
+        for (size_t j = 0; j < 33; j++) if (out[i*33 + j]) return bench_fail("not zeroed", i);
+    }
+
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    secp256k1_context *ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+
+    if (! ctx || ! bench_check_vectors(ctx) || ! bench_check_runs(ctx) || ! bench_check_edges(ctx)) return 1;
+    printf("br_bip32_chain: matches the test vectors and CKDpub over %d runs\n", CHECK_ROUNDS);
+
+    if (argc > 1 && strcmp(argv[1], "-b") == 0) {
+        static uint8_t pubkeys[BENCH_KEYS*33], hash160s[BENCH_KEYS*20];
+        uint8_t master[33], master_chain[32], pubkey[33], chain[32];
+        secp256k1_pubkey pk;
+        size_t len = 33;
+        br_bip32_chain *bc;
+        double begin, t_one, t_batch;
+
+        memset(pubkey, 0x11, 32);
+        if (! secp256k1_ec_pubkey_create(ctx, &pk, pubkey)) return 1;
+        secp256k1_ec_pubkey_serialize(ctx, master, &len, &pk, SECP256K1_EC_COMPRESSED);
+        memset(master_chain, 0x22, sizeof(master_chain));
+
+        // before: the chain key from the master key and then the child, for every address
+        begin = gettimedouble();
+
+        for (uint32_t i = 0; i < BENCH_KEYS; i++) {
+            memcpy(pubkey, master, 33);
+            memcpy(chain, master_chain, 32);
+            bench_ckd_pub(ctx, pubkey, chain, 0);
+            bench_ckd_pub(ctx, pubkey, chain, i);
+            bench_hash160(hash160s + i*20, pubkey);
+        }
+
+        t_one = gettimedouble() - begin;
+        begin = gettimedouble();
+        memcpy(pubkey, master, 33);
+        memcpy(chain, master_chain, 32);
+        bench_ckd_pub(ctx, pubkey, chain, 0);
+        if (! (bc = br_bip32_chain_new(pubkey, chain))) return 1;
+        br_bip32_chain_derive(bc, ctx, 0, BENCH_KEYS, pubkeys, hash160s);
+        t_batch = gettimedouble() - begin;
+        br_bip32_chain_free(bc);
+        printf("%d addresses: %.1f us each one at a time, %.1f us each batched\n", BENCH_KEYS, t_one*1e6/BENCH_KEYS,
+               t_batch*1e6/BENCH_KEYS);
+    }
+
+    secp256k1_context_destroy(ctx);
+    return 0;
+}
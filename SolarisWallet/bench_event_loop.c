@@ -0,0 +1,225 @@
+//
+//  bench_event_loop.c
+//  SolarisWallet
+//
+//  Drives the bw_event_loop of BRSocketHelpers.c over socketpairs, and times it with -b.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRSocketHelpers.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#if defined(__linux__) && ! defined(BW_EVENT_POLL)
+#define BENCH_EDGE 1 // epoll, a readiness is reported once
+#define BENCH_BACKEND "epoll"
+#else
+#define BENCH_EDGE 0 // poll(), reported for as long as it lasts
+#define BENCH_BACKEND "poll"
+#endif
+
+#define BENCH_NAME "bench_event_loop"
+#define BENCH_DETAIL BENCH_BACKEND
+#include "bench.h"
+
+#define BENCH_PAIRS   200 // more than the fd table starts with
+#define BENCH_EVENTS  512
+#define BENCH_ROUNDS  100000
+#define BENCH_FDS     1000
+
+static int bench_pair(int fds[2])
+{
+    return (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0 && bw_nbioify(fds[0]) == 0 && bw_nbioify(fds[1]) == 0);
+}
+
+// reads fd until EAGAIN, returns the bytes read, or -1 on end of stream
+static ssize_t bench_drain(int fd)
+{
+    char buf[256];
+    ssize_t n = 0, l;
+
+    while ((l = read(fd, buf, sizeof(buf))) > 0) n += l;
+    if (l == 0) return -1;
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? n : -2;
+}
+
+// waits timeout_ms and checks that exactly one event, for fd with info and the given flags among its events, came in
+static int bench_expect(struct bw_event_loop *loop, int timeout_ms, int fd, int events, void *info, const char *what)
+{
+    struct bw_event ev[4];
+    int n = bw_event_loop_wait(loop, ev, 4, timeout_ms);
+
+    if (fd < 0) return (n == 0) ? 1 : bench_fail(what, (size_t)n);
+    if (n != 1) return bench_fail(what, (size_t)n);
+    if (ev[0].fd != fd || ev[0].info != info || (ev[0].events & events) != events) return bench_fail(what, 1);
+    return 1;
+}
+
+static int bench_check_pair(struct bw_event_loop *loop)
+{
+    int fds[2], dup_fd, tag = 0, other = 0;
+
+    if (! bench_pair(fds)) return bench_fail("socketpair", 0);
+    if (bw_event_loop_add(loop, fds[0], BW_EVENT_READ, &tag) != 0) return bench_fail("add", 0);
+    if (! bench_expect(loop, 0, -1, 0, NULL, "idle")) return 0;
+    if (! bench_expect(loop, 20, -1, 0, NULL, "timeout")) return 0;
+    if (write(fds[1], "ping", 4) != 4) return bench_fail("write", 0);
+    if (! bench_expect(loop, 100, fds[0], BW_EVENT_READ, &tag, "readable")) return 0;
+
+    // not drained: the edge-triggered loop stays quiet, the level-triggered one reports it again
+    if (! bench_expect(loop, 0, BENCH_EDGE ? -1 : fds[0], BW_EVENT_READ, &tag, "undrained")) return 0;
+    if (bench_drain(fds[0]) != 4) return bench_fail("drain", 0);
+    if (! bench_expect(loop, 0, -1, 0, NULL, "drained")) return 0;
+
+    if (bw_event_loop_mod(loop, fds[0], BW_EVENT_READ | BW_EVENT_WRITE, &other) != 0) return bench_fail("mod", 0);
+    if (! bench_expect(loop, 0, fds[0], BW_EVENT_WRITE, &other, "writable")) return 0;
+    if (bw_event_loop_mod(loop, fds[0], BW_EVENT_READ, &tag) != 0) return bench_fail("mod", 1);
+    if (! bench_expect(loop, 0, -1, 0, NULL, "read only")) return 0;
+
+    if (bw_event_loop_del(loop, fds[0]) != 0) return bench_fail("del", 0);
+    if (write(fds[1], "ping", 4) != 4) return bench_fail("write", 1);
+    if (! bench_expect(loop, 0, -1, 0, NULL, "deleted")) return 0;
+    if (bench_drain(fds[0]) != 4) return bench_fail("drain", 1);
+
+    if (bw_event_loop_add(loop, fds[0], BW_EVENT_READ, &tag) != 0) return bench_fail("add", 1);
+    close(fds[1]);
+    if (! bench_expect(loop, 100, fds[0], BW_EVENT_READ, &tag, "hang-up")) return 0;
+    if (bench_drain(fds[0]) != -1) return bench_fail("end of stream", 0);
+    if (bw_event_loop_del(loop, fds[0]) != 0) return bench_fail("del", 1);
+    close(fds[0]);
+
+    // closed before its del, while a dup keeps the socket open, so epoll still holds it under the old number
+    if (! bench_pair(fds) || (dup_fd = dup(fds[0])) < 0) return bench_fail("socketpair", 1);
+    if (bw_event_loop_add(loop, fds[0], BW_EVENT_READ, &tag) != 0) return bench_fail("add", 2);
+    close(fds[0]);
+    if (bw_event_loop_del(loop, fds[0]) != 0) return bench_fail("del after close", 0);
+    if (write(fds[1], "ping", 4) != 4) return bench_fail("write", 2);
+    if (! bench_expect(loop, 20, -1, 0, NULL, "closed behind a dup")) return 0;
+    close(dup_fd);
+    close(fds[1]);
+    return 1;
+}
+
+static int bench_check_errors(struct bw_event_loop *loop)
+{
+    int fds[2];
+    struct bw_event ev;
+
+    if (! bench_pair(fds)) return bench_fail("socketpair", 2);
+    if (bw_event_loop_add(loop, -1, BW_EVENT_READ, NULL) != -1 || errno != EBADF) return bench_fail("add -1", 0);
+    if (bw_event_loop_add(loop, fds[0], 0, NULL) != -1 || errno != EINVAL) return bench_fail("add no events", 0);
+    if (bw_event_loop_mod(loop, fds[0], BW_EVENT_READ, NULL) != -1 || errno != ENOENT) return bench_fail("mod", 2);
+    if (bw_event_loop_del(loop, fds[0]) != -1 || errno != ENOENT) return bench_fail("del", 2);
+    if (bw_event_loop_add(loop, fds[0], BW_EVENT_READ, NULL) != 0) return bench_fail("add", 3);
+    if (bw_event_loop_add(loop, fds[0], BW_EVENT_READ, NULL) != -1 || errno != EEXIST) return bench_fail("add twice", 0);
+    if (bw_event_loop_mod(loop, fds[0], 0, NULL) != -1 || errno != EINVAL) return bench_fail("mod no events", 0);
+    if (bw_event_loop_wait(loop, &ev, 0, 0) != -1 || errno != EINVAL) return bench_fail("wait for none", 0);
+    if (bw_event_loop_del(loop, fds[0]) != 0) return bench_fail("del", 3);
+    close(fds[0]);
+    close(fds[1]);
+    return 1;
+}
+
+static int bench_check_many(struct bw_event_loop *loop)
+{
+    static int fds[BENCH_PAIRS][2];
+    static uint8_t seen[BENCH_PAIRS];
+    struct bw_event ev[BENCH_EVENTS];
+    int n = 0, ok = 1;
+
+    memset(seen, 0, sizeof(seen));
+
+    for (size_t i = 0; i < BENCH_PAIRS; i++) {
+        if (! bench_pair(fds[i])) return bench_fail("socketpair", i);
+        if (bw_event_loop_add(loop, fds[i][0], BW_EVENT_READ, &fds[i]) != 0) return bench_fail("add many", i);
+    }
+
+    for (size_t i = 0; i < BENCH_PAIRS; i += 2) if (write(fds[i][1], "x", 1) != 1) return bench_fail("write", i);
+
+    // one wait hands out at most a batch of events, the rest stay ready for the next one
+    for (int timeout = 100; ok && (n = bw_event_loop_wait(loop, ev, BENCH_EVENTS, timeout)) > 0; timeout = 0) {
+        for (int j = 0; ok && j < n; j++) {
+            size_t i = (size_t)((int (*)[2])ev[j].info - fds);
+
+            if (i >= BENCH_PAIRS || i % 2 || ev[j].fd != fds[i][0]) ok = bench_fail("many", i);
+            else if (BENCH_EDGE && seen[i]) ok = bench_fail("many reported twice", i);
+            else seen[i] = 1;
+            if (! BENCH_EDGE && ok && bench_drain(fds[i][0]) < 0) ok = bench_fail("many drain", i);
+        }
+    }
+
+    for (size_t i = 0; ok && i < BENCH_PAIRS; i++) if (seen[i] != ! (i % 2)) ok = bench_fail("many missed", i);
+
+    for (size_t i = 0; i < BENCH_PAIRS; i++) {
+        if (bw_event_loop_del(loop, fds[i][0]) != 0) ok = bench_fail("del many", i);
+        close(fds[i][0]);
+        close(fds[i][1]);
+    }
+
+    return ok;
+}
+
+static int bench_round_trips(void)
+{
+    static int fds[BENCH_FDS][2];
+    struct bw_event_loop *loop = bw_event_loop_new();
+    struct bw_event ev[4];
+    double begin, t;
+    int ok = (loop != NULL);
+
+    for (size_t i = 0; ok && i < BENCH_FDS; i++) {
+        ok = bench_pair(fds[i]) && bw_event_loop_add(loop, fds[i][0], BW_EVENT_READ, &fds[i]) == 0;
+    }
+
+    begin = gettimedouble();
+
+    for (size_t r = 0; ok && r < BENCH_ROUNDS; r++) {
+        size_t i = bench_rand() % BENCH_FDS;
+
+        ok = (write(fds[i][1], "x", 1) == 1 && bw_event_loop_wait(loop, ev, 4, 100) == 1 && bench_drain(ev[0].fd) == 1);
+    }
+
+    t = gettimedouble() - begin;
+    if (ok) printf("  %d sockets: %.0f ns per write, wait and read\n", BENCH_FDS, t*1e9/BENCH_ROUNDS);
+    bw_event_loop_free(loop);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    int bench = (argc > 1 && strcmp(argv[1], "-b") == 0), ok;
+    struct bw_event_loop *loop = bw_event_loop_new();
+
+    if (! loop) return bench_fail("new", 0), 1;
+    ok = bench_check_pair(loop) && bench_check_errors(loop) && bench_check_many(loop);
+    bw_event_loop_free(loop);
+    if (! ok) return 1;
+    printf("bw_event_loop %s: readiness, mod, del, hang-up, errors and %d socketpairs check out\n", BENCH_BACKEND,
+           BENCH_PAIRS);
+    if (bench && ! bench_round_trips()) return bench_fail("round trips", 0), 1;
+    return 0;
+}
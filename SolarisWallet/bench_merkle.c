@@ -0,0 +1,288 @@
+//
+//  bench_merkle.c
+//  SolarisWallet
+//
+//  Checks BRMerkleTree.c against the recursive walk BRMerkleBlock used, and times the two with -b.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRMerkleTree.h"
+#include "sph/sph_sha2.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_NAME "bench_merkle"
+#define BENCH_SEED 0x9b05688cu
+#include "bench.h"
+
+#define CHECK_ROUNDS  300
+#define CHECK_TXS     3000
+#define CHECK_MUTATE  3000
+#define BENCH_TXS     2000
+#define BENCH_ROUNDS  2000
+
+typedef struct {
+    uint32_t total;
+    size_t n, bits;
+    uint8_t hashes[2*CHECK_TXS*32], flags[2*CHECK_TXS/8 + 8];
+} bench_tree;
+
+// the recursive walk's state: where it is in the hashes and flags, and the matches it collected
+typedef struct {
+    const bench_tree *t;
+    size_t hash_idx, flag_idx, matched;
+    uint8_t matches[CHECK_TXS*32];
+} bench_walk;
+
+static void bench_sha256_2(uint8_t *md, const uint8_t *l, const uint8_t *r)
+{
+    sph_sha256_context sha;
+
+    sph_sha256_init(&sha);
+    sph_sha256(&sha, l, 32);
+    sph_sha256(&sha, r, 32);
+    sph_sha256_close(&sha, md);
+    sph_sha256(&sha, md, 32);
+    sph_sha256_close(&sha, md);
+}
+
+static uint64_t bench_width(uint32_t total, int level)
+{
+    return ((uint64_t)total + ((uint64_t)1 << level) - 1) >> level;
+}
+
+static int bench_height(uint32_t total)
+{
+    int height = 0;
+
+    while (bench_width(total, height) > 1) height++;
+    return height;
+}
+
+// the hash of the node at the level and position in the whole tree of txids
+static void bench_node(uint8_t *md, const uint8_t *txids, uint32_t total, int level, uint32_t pos)
+{
+    uint8_t l[32], r[32];
+
+    if (level == 0) {
+        memcpy(md, txids + pos*32, 32);
+        return;
+    }
+
+    bench_node(l, txids, total, level - 1, pos*2);
+    if (pos*2 + 1 < bench_width(total, level - 1)) bench_node(r, txids, total, level - 1, pos*2 + 1);
+    else memcpy(r, l, 32);
+    bench_sha256_2(md, l, r);
+}
+
+// bitcoind's CPartialMerkleTree::TraverseAndBuild
+static void bench_build(bench_tree *t, const uint8_t *txids, const uint8_t *match, int level, uint32_t pos)
+{
+    int parent = 0;
+
+    for (uint64_t p = (uint64_t)pos << level; p < ((uint64_t)pos + 1) << level && p < t->total; p++) parent |= match[p];
+    if (parent) t->flags[t->bits/8] |= (uint8_t)(1 << (t->bits % 8));
+    t->bits++;
+
+    if (level == 0 || ! parent) {
+        bench_node(t->hashes + (t->n++)*32, txids, t->total, level, pos);
+        return;
+    }
+
+    bench_build(t, txids, match, level - 1, pos*2);
+    if (pos*2 + 1 < bench_width(t->total, level - 1)) bench_build(t, txids, match, level - 1, pos*2 + 1);
+}
+
+static void bench_make(bench_tree *t, const uint8_t *txids, const uint8_t *match, uint32_t total)
+{
+    memset(t->flags, 0, sizeof(t->flags));
+    t->total = total, t->n = t->bits = 0;
+    bench_build(t, txids, match, bench_height(total), 0);
+}
+
+// BRMerkleBlock's -_walk:::::, its leaf and branch blocks for -isValid and -txHashes folded in; returns 0 for nil
+static int bench_recurse(bench_walk *w, uint8_t *md, int depth)
+{
+    const bench_tree *t = w->t;
+    uint8_t l[32], r[32];
+    int flag, height = bench_height(t->total);
+
+    if (w->flag_idx/8 >= (t->bits + 7)/8 || (w->hash_idx + 1)*32 > t->n*32) return 0;
+    flag = (t->flags[w->flag_idx/8] >> (w->flag_idx % 8)) & 1;
+    w->flag_idx++;
+
+    if (! flag || depth == height) {
+        memcpy(md, t->hashes + (w->hash_idx++)*32, 32);
+        if (flag) memcpy(w->matches + (w->matched++)*32, md, 32);
+        return 1;
+    }
+
+    if (! bench_recurse(w, l, depth + 1)) return 0; // nil from the left, an unusable root
+    if (! bench_recurse(w, r, depth + 1)) memcpy(r, l, 32);
+    bench_sha256_2(md, l, r);
+    return 1;
+}
+
+static int bench_check_walk(const bench_tree *t, const uint8_t *block_root, const uint8_t *match_txids,
+                            size_t match_count, size_t i)
+{
+    static bench_walk w;
+    static uint8_t matches[CHECK_TXS*32];
+    uint8_t root[32], old_root[32];
+    size_t matched = 0;
+
+    if (! br_merkle_tree_walk(root, matches, &matched, t->total, t->hashes, t->n, t->flags, (t->bits + 7)/8)) {
+        return bench_fail("rejected", i);
+    }
+
+    if (memcmp(root, block_root, 32) != 0) return bench_fail("root", i);
+    if (matched != match_count || memcmp(matches, match_txids, matched*32) != 0) return bench_fail("matches", i);
+    memset(&w, 0, sizeof(w));
+    w.t = t;
+    if (! bench_recurse(&w, old_root, 0) || memcmp(old_root, root, 32) != 0) return bench_fail("recursive root", i);
+    if (w.matched != matched || memcmp(w.matches, matches, matched*32) != 0) return bench_fail("recursive matches", i);
+    return 1;
+}
+
+// a mutated tree is either rejected or walks to what the recursive walk gets from it; returns 1 if it was rejected
+static int bench_check_mutated(bench_tree *t, size_t i)
+{
+    static bench_walk w;
+    static uint8_t matches[CHECK_TXS*32];
+    uint8_t root[32], old_root[32];
+    size_t matched = 0, flags_len = (t->bits + 7)/8;
+
+    if (! br_merkle_tree_walk(root, matches, &matched, t->total, t->hashes, t->n, t->flags, flags_len)) return 1;
+    memset(&w, 0, sizeof(w));
+    w.t = t;
+    if (! bench_recurse(&w, old_root, 0) || memcmp(old_root, root, 32) != 0) return bench_fail("mutated root", i);
+    if (w.matched != matched || memcmp(w.matches, matches, matched*32) != 0) return bench_fail("mutated matches", i);
+    return 2;
+}
+
+static int bench_check_trees(void)
+{
+    static bench_tree t, m;
+    static uint8_t txids[CHECK_TXS*32], match[CHECK_TXS], match_txids[CHECK_TXS*32];
+    size_t rejected = 0;
+
+    for (size_t i = 0; i < sizeof(txids); i++) txids[i] = (uint8_t)bench_rand();
+
+    for (size_t round = 0; round < CHECK_ROUNDS; round++) {
+        uint32_t total = (round < 40) ? (uint32_t)round + 1 : 1 + bench_rand() % CHECK_TXS, odds = bench_rand() % 5;
+        size_t match_count = 0;
+        uint8_t block_root[32];
+
+        for (uint32_t i = 0; i < total; i++) {
+            match[i] = (odds == 0) ? 0 : (odds == 1) ? 1 : (bench_rand() % (odds*odds*odds) == 0);
+            if (match[i]) memcpy(match_txids + (match_count++)*32, txids + i*32, 32);
+        }
+
+        bench_node(block_root, txids, total, bench_height(total), 0);
+        bench_make(&t, txids, match, total);
+        if (! bench_check_walk(&t, block_root, match_txids, match_count, round)) return 0;
+
+        for (size_t k = 0; k < CHECK_MUTATE/CHECK_ROUNDS; k++) {
+            int r;
+
+            m = t;
+
+            switch (bench_rand() % 6) {
+            case 0: m.flags[bench_rand() % ((m.bits + 7)/8)] ^= (uint8_t)(1 << bench_rand() % 8); break;
+            case 1: m.hashes[bench_rand() % (m.n*32)] ^= (uint8_t)(1 << bench_rand() % 8); break;
+            case 2: if (m.n > 1) m.n -= 1 + bench_rand() % (m.n - 1); break;
+            case 3: m.n += 1 + bench_rand() % 4; break;
+            case 4: m.bits += 8*(1 + bench_rand() % 4); break; // a whole byte or more of flags left over
+            case 5: m.total = 1 + bench_rand() % (2*total); break;
+            }
+
+            if (! (r = bench_check_mutated(&m, round*CHECK_MUTATE + k))) return 0;
+            if (r == 1) rejected++;
+        }
+    }
+
+    printf("br_merkle_tree_walk: %zu of %d mutated trees rejected\n", rejected, CHECK_MUTATE);
+    return 1;
+}
+
+// txids a, b, c and a, b, c, c have the same root, only the tree with c twice has identical siblings
+static int bench_check_duplicates(void)
+{
+    static bench_tree t;
+    uint8_t txids[4*32], match[4] = { 0, 0, 1, 1 }, root3[32], root4[32], root[32];
+
+    for (size_t i = 0; i < 3*32; i++) txids[i] = (uint8_t)bench_rand();
+    memcpy(txids + 3*32, txids + 2*32, 32);
+    bench_node(root3, txids, 3, 2, 0);
+    bench_node(root4, txids, 4, 2, 0);
+    if (memcmp(root3, root4, 32) != 0) return bench_fail("duplicate roots", 0);
+    bench_make(&t, txids, match, 3);
+    if (! br_merkle_tree_walk(root, NULL, NULL, 3, t.hashes, t.n, t.flags, (t.bits + 7)/8)) return bench_fail("3", 0);
+    bench_make(&t, txids, match, 4);
+    if (br_merkle_tree_walk(root, NULL, NULL, 4, t.hashes, t.n, t.flags, (t.bits + 7)/8)) return bench_fail("4", 0);
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (! bench_check_trees() || ! bench_check_duplicates()) return 1;
+    printf("br_merkle_tree_walk: matches whole block roots and the recursive walk over %d trees\n", CHECK_ROUNDS);
+
+    if (argc > 1 && strcmp(argv[1], "-b") == 0) {
+        static bench_tree t;
+        static bench_walk w;
+        static uint8_t txids[BENCH_TXS*32], match[BENCH_TXS], matches[BENCH_TXS*32];
+        static const uint32_t every[] = { 0, 200, 20, 1 }; // none, 10, 100, all matched
+        uint8_t root[32];
+        size_t matched;
+        double begin, t_recurse, t_walk;
+
+        for (size_t i = 0; i < sizeof(txids); i++) txids[i] = (uint8_t)bench_rand();
+
+        for (size_t k = 0; k < sizeof(every)/sizeof(*every); k++) {
+            size_t rounds = (every[k] == 1) ? BENCH_ROUNDS/10 : BENCH_ROUNDS; // every hash of the block given
+
+            for (uint32_t i = 0; i < BENCH_TXS; i++) match[i] = (every[k] && i % every[k] == 0);
+            bench_make(&t, txids, match, BENCH_TXS);
+            begin = gettimedouble();
+
+            for (size_t r = 0; r < rounds; r++) {
+                w.t = &t, w.hash_idx = w.flag_idx = w.matched = 0;
+                bench_recurse(&w, root, 0);
+            }
+
+            t_recurse = gettimedouble() - begin;
+            begin = gettimedouble();
+
+            for (size_t r = 0; r < rounds; r++) {
+                br_merkle_tree_walk(root, matches, &matched, t.total, t.hashes, t.n, t.flags, (t.bits + 7)/8);
+            }
+
+            t_walk = gettimedouble() - begin;
+            printf("%d txs, %zu hashes: %.1f us recursive, %.1f us walked\n", BENCH_TXS, t.n, t_recurse*1e6/rounds,
+                   t_walk*1e6/rounds);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,271 @@
+//
+//  bench_secp_pool.c
+//  SolarisWallet
+//
+//  Checks the pooled contexts of BRSecp256k1.c against a single context, and times batch signing
+//  with -b.
+//
+//  usage: bench_secp_pool [-b] [threads]
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRSecp256k1.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BENCH_NAME "bench_secp_pool"
+#include "bench.h"
+
+#define CHECK_ITEMS   203 // not a multiple of any chunk size, so the last thread gets a short one
+#define CHECK_THREADS 6
+#define BENCH_ITEMS   1000
+
+typedef struct {
+    uint8_t md[CHECK_ITEMS*32], seckeys[CHECK_ITEMS*32], tweaks[CHECK_ITEMS*32];
+    uint8_t sigs[CHECK_ITEMS*BR_SECP_DER_SIG_MAX];
+    size_t siglens[CHECK_ITEMS];
+    uint8_t pubkeys[CHECK_ITEMS*65];
+    size_t ok;
+} check_set;
+
+// fills a set with deterministic digests, keys and tweaks, every 17th key is zero and so invalid
+static void check_fill(check_set *set)
+{
+    uint32_t x = 0x12345678;
+
+    memset(set, 0, sizeof(*set));
+
+    for (size_t i = 0; i < CHECK_ITEMS*32; i++) {
+        x = x*1664525 + 1013904223;
+        set->md[i] = (uint8_t)(x >> 24);
+        x = x*1664525 + 1013904223;
+        set->seckeys[i] = (uint8_t)(x >> 24);
+        x = x*1664525 + 1013904223;
+        set->tweaks[i] = (uint8_t)(x >> 24);
+    }
+
+    for (size_t i = 0; i < CHECK_ITEMS; i += 17) memset(set->seckeys + i*32, 0, 32);
+}
+
+// what the batch calls have to produce, from one context doing the items in turn
+static void check_expect(const secp256k1_context *ctx, const check_set *in, check_set *sign, check_set *pub,
+                         check_set *priv, check_set *tweaked)
+{
+    *sign = *pub = *priv = *in;
+
+    for (size_t i = 0; i < CHECK_ITEMS; i++) {
+        secp256k1_ecdsa_signature s;
+        secp256k1_pubkey pk;
+        size_t len = BR_SECP_DER_SIG_MAX;
+
+        if (secp256k1_ecdsa_sign(ctx, &s, in->md + i*32, in->seckeys + i*32, secp256k1_nonce_function_rfc6979, NULL) &&
+            secp256k1_ecdsa_signature_serialize_der(ctx, sign->sigs + i*BR_SECP_DER_SIG_MAX, &len, &s)) {
+            sign->siglens[i] = len;
+            sign->ok++;
+        }
+
+        len = 33;
+
+        if (secp256k1_ec_pubkey_create(ctx, &pk, in->seckeys + i*32) &&
+            secp256k1_ec_pubkey_serialize(ctx, pub->pubkeys + i*33, &len, &pk, SECP256K1_EC_COMPRESSED)) pub->ok++;
+
+        if (secp256k1_ec_seckey_verify(ctx, in->seckeys + i*32) &&
+            secp256k1_ec_privkey_tweak_add(ctx, priv->seckeys + i*32, in->tweaks + i*32)) priv->ok++;
+        else memset(priv->seckeys + i*32, 0, 32);
+    }
+
+    // tweaking the public keys has to match the public keys of the tweaked secret keys
+    *tweaked = *pub;
+    tweaked->ok = 0;
+
+    for (size_t i = 0; i < CHECK_ITEMS; i++) {
+        secp256k1_pubkey pk;
+        size_t len = 33;
+
+        if (secp256k1_ec_pubkey_create(ctx, &pk, priv->seckeys + i*32) &&
+            secp256k1_ec_pubkey_serialize(ctx, tweaked->pubkeys + i*33, &len, &pk, SECP256K1_EC_COMPRESSED)) {
+            tweaked->ok++;
+        }
+        else memset(tweaked->pubkeys + i*33, 0, 33);
+    }
+}
+
+static int check_same(const char *name, const check_set *got, const check_set *want)
+{
+    if (got->ok == want->ok && memcmp(got->sigs, want->sigs, sizeof(got->sigs)) == 0 &&
+        memcmp(got->siglens, want->siglens, sizeof(got->siglens)) == 0 &&
+        memcmp(got->pubkeys, want->pubkeys, sizeof(got->pubkeys)) == 0 &&
+        memcmp(got->seckeys, want->seckeys, sizeof(got->seckeys)) == 0) return 1;
+    fprintf(stderr, "bench_secp_pool: %s differs from a single context\n", name);
+    return 0;
+}
+
+static int check_batches(br_secp_pool *pool, const check_set *in, const check_set *sign, const check_set *pub,
+                         const check_set *priv, const check_set *tweaked)
+{
+    static check_set got;
+    int ok;
+
+    got = *in;
+    got.ok = br_secp_pool_sign(pool, got.sigs, got.siglens, got.md, got.seckeys, CHECK_ITEMS);
+    ok = check_same("br_secp_pool_sign", &got, sign);
+
+    got = *in;
+    got.ok = br_secp_pool_pubkey_create(pool, got.pubkeys, 1, got.seckeys, CHECK_ITEMS);
+    ok = ok && check_same("br_secp_pool_pubkey_create", &got, pub);
+
+    got = *in;
+    got.ok = br_secp_pool_privkey_tweak_add(pool, got.seckeys, got.tweaks, CHECK_ITEMS);
+    ok = ok && check_same("br_secp_pool_privkey_tweak_add", &got, priv);
+
+    got = *pub;
+    got.ok = br_secp_pool_pubkey_tweak_add(pool, got.pubkeys, got.tweaks, CHECK_ITEMS);
+    ok = ok && check_same("br_secp_pool_pubkey_tweak_add", &got, tweaked);
+
+    return ok;
+}
+
+typedef struct {
+    br_secp_pool *pool;
+    const check_set *in, *sign;
+    int ok;
+} check_thread;
+
+// signs one item at a time on acquired contexts, while the other threads do the same
+static void *check_acquire_worker(void *arg)
+{
+    check_thread *t = arg;
+
+    t->ok = 1;
+
+    for (int r = 0; r < 40; r++) {
+        for (size_t i = (size_t)r; i < CHECK_ITEMS; i += 7) {
+            secp256k1_context *ctx = br_secp_pool_acquire(t->pool);
+            secp256k1_ecdsa_signature s;
+            uint8_t sig[BR_SECP_DER_SIG_MAX];
+            size_t len = sizeof(sig);
+            int signed_ok = (ctx && secp256k1_ecdsa_sign(ctx, &s, t->in->md + i*32, t->in->seckeys + i*32,
+                                                         secp256k1_nonce_function_rfc6979, NULL) &&
+                             secp256k1_ecdsa_signature_serialize_der(ctx, sig, &len, &s));
+
+            if (ctx) br_secp_pool_release(t->pool, ctx);
+            if (signed_ok != (t->sign->siglens[i] != 0)) t->ok = 0;
+            if (signed_ok && (len != t->sign->siglens[i] ||
+                              memcmp(sig, t->sign->sigs + i*BR_SECP_DER_SIG_MAX, len) != 0)) t->ok = 0;
+        }
+    }
+
+    return NULL;
+}
+
+// more threads than contexts, half of them acquiring single contexts and half running batches, reseeding every 3 uses
+static int check_contention(const secp256k1_context *tmpl, const check_set *in, const check_set *sign,
+                            const check_set *pub, const check_set *priv, const check_set *tweaked)
+{
+    br_secp_pool *pool = br_secp_pool_new(tmpl, 3, 3);
+    pthread_t tid[CHECK_THREADS];
+    check_thread t[CHECK_THREADS];
+    int ok = (pool != NULL), started = 0;
+
+    for (; ok && started < CHECK_THREADS; started++) {
+        t[started].pool = pool;
+        t[started].in = in;
+        t[started].sign = sign;
+        if (pthread_create(&tid[started], NULL, check_acquire_worker, &t[started]) != 0) break;
+    }
+
+    for (int r = 0; ok && r < 4; r++) ok = check_batches(pool, in, sign, pub, priv, tweaked);
+
+    for (int i = 0; i < started; i++) {
+        pthread_join(tid[i], NULL);
+        if (! t[i].ok) {
+            fprintf(stderr, "bench_secp_pool: acquired context %d signed differently\n", i);
+            ok = 0;
+        }
+    }
+
+    br_secp_pool_free(pool);
+    return ok;
+}
+
+static void bench_sign(const secp256k1_context *tmpl, const check_set *in, unsigned threads)
+{
+    static uint8_t md[BENCH_ITEMS*32], seckeys[BENCH_ITEMS*32], sigs[BENCH_ITEMS*BR_SECP_DER_SIG_MAX];
+    static size_t siglens[BENCH_ITEMS];
+    static const size_t counts[] = { 1, 10, 100, BENCH_ITEMS };
+    br_secp_pool *pool = br_secp_pool_new(tmpl, threads, 0);
+
+    if (! pool) return;
+
+    for (size_t i = 0; i < BENCH_ITEMS; i++) {
+        memcpy(md + i*32, in->md + (i % CHECK_ITEMS)*32, 32);
+        memcpy(seckeys + i*32, in->tweaks + (i % CHECK_ITEMS)*32, 32); // the tweaks are all valid keys
+    }
+
+    br_secp_pool_sign(pool, sigs, siglens, md, seckeys, BENCH_ITEMS); // clone the contexts before timing
+
+    for (size_t c = 0; c < sizeof(counts)/sizeof(*counts); c++) {
+        double begin = gettimedouble(), t;
+        size_t rounds = BENCH_ITEMS*4/counts[c];
+
+        for (size_t r = 0; r < rounds; r++) br_secp_pool_sign(pool, sigs, siglens, md, seckeys, counts[c]);
+        t = gettimedouble() - begin;
+        printf("br_secp_pool_sign: %4zu items, %u contexts: %.1f us per signature\n", counts[c],
+               br_secp_pool_size(pool), t*1e6/(double)(rounds*counts[c]));
+    }
+
+    br_secp_pool_free(pool);
+}
+
+int main(int argc, char **argv)
+{
+    static check_set in, sign, pub, priv, tweaked;
+    secp256k1_context *ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    br_secp_pool *pool = br_secp_pool_new(ctx, 4, 5);
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned threads = (cpus > 0) ? (unsigned)cpus : 1;
+    int bench = 0, ok;
+
+    if (argc > 1 && strcmp(argv[1], "-b") == 0) {
+        bench = 1;
+        argc--;
+        argv++;
+    }
+
+    if (argc > 1) threads = (unsigned)atoi(argv[1]);
+
+    check_fill(&in);
+    check_expect(ctx, &in, &sign, &pub, &priv, &tweaked);
+    ok = (pool && check_batches(pool, &in, &sign, &pub, &priv, &tweaked) &&
+          check_contention(ctx, &in, &sign, &pub, &priv, &tweaked));
+    br_secp_pool_free(pool);
+    if (! ok) return 1;
+    printf("br_secp_pool: %zu of %d items valid, batches and %d contending threads match a single context\n",
+           sign.ok, CHECK_ITEMS, CHECK_THREADS);
+
+    if (bench) bench_sign(ctx, &in, threads);
+    secp256k1_context_destroy(ctx);
+    return 0;
+}
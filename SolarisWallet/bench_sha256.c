@@ -0,0 +1,180 @@
+//
+//  bench_sha256.c
+//  SolarisWallet
+//
+//  Checks each implementation of BRSha256.c this cpu can run against the FIPS 180-2 vectors and sph,
+//  and times them with -b.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRSha256.h"
+#include "sph/sph_sha2.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_NAME "bench_sha256"
+#define BENCH_DETAIL br_sha256_impl()
+#define BENCH_SEED 0x510e527fu
+#include "bench.h"
+
+#define CHECK_LEN     300
+#define CHECK_D64     37 // four runs of eight lanes and a remainder
+#define BENCH_BYTES   (64*1024*1024)
+#define BENCH_INPUTS  4096
+
+static const char *bench_impls[] = { "generic", "shani", "avx2", "shani+avx2", "armv8" };
+
+static void bench_unhex(uint8_t *out, const char *hex)
+{
+    for (size_t i = 0; hex[2*i]; i++) sscanf(hex + 2*i, "%2hhx", &out[i]);
+}
+
+static void bench_sph_sha256(uint8_t *md, const void *data, size_t len)
+{
+    sph_sha256_context sha;
+
+    sph_sha256_init(&sha);
+    sph_sha256(&sha, data, len);
+    sph_sha256_close(&sha, md);
+}
+
+static int bench_check_vectors(void)
+{
+    static const char *vectors[][2] = {
+        { "", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" },
+        { "abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad" },
+        { "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+          "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1" }
+    };
+    uint8_t md[32], expected[32], *a;
+
+    for (size_t i = 0; i < sizeof(vectors)/sizeof(*vectors); i++) {
+        br_sha256(md, vectors[i][0], strlen(vectors[i][0]));
+        bench_unhex(expected, vectors[i][1]);
+        if (memcmp(md, expected, 32) != 0) return bench_fail("vector", i);
+    }
+
+    if (! (a = malloc(1000000))) return 0;
+    memset(a, 'a', 1000000);
+    br_sha256(md, a, 1000000);
+    free(a);
+    bench_unhex(expected, "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    if (memcmp(md, expected, 32) != 0) return bench_fail("vector", 3);
+    return 1;
+}
+
+static int bench_check_lengths(void)
+{
+    uint8_t data[CHECK_LEN], md[32], expected[32];
+
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)bench_rand();
+
+    for (size_t len = 0; len <= sizeof(data); len++) {
+        size_t off = bench_rand() % (sizeof(data) - len + 1); // unaligned too
+
+        br_sha256(md, data + off, len);
+        bench_sph_sha256(expected, data + off, len);
+        if (memcmp(md, expected, 32) != 0) return bench_fail("length", len);
+    }
+
+    return 1;
+}
+
+static int bench_check_d64(void)
+{
+    uint8_t in[CHECK_D64*64], out[CHECK_D64*32], md[32];
+
+    for (size_t n = 0; n <= CHECK_D64; n++) {
+        for (size_t i = 0; i < n*64; i++) in[i] = (uint8_t)bench_rand();
+        memset(out, 0xee, sizeof(out));
+        br_sha256d64(out, in, n);
+
+        for (size_t i = 0; i < n; i++) {
+            bench_sph_sha256(md, in + i*64, 64);
+            bench_sph_sha256(md, md, 32);
+            if (memcmp(out + i*32, md, 32) != 0) return bench_fail("d64", n*CHECK_D64 + i);
+        }
+
+        for (size_t i = n*32; i < sizeof(out); i++) if (out[i] != 0xee) return bench_fail("d64 overrun", n);
+        br_sha256d64(in, in, n); // in place, the way a merkle level folds into itself
+
+        for (size_t i = 0; i < n; i++) {
+            if (memcmp(in + i*32, out + i*32, 32) != 0) return bench_fail("d64 in place", n*CHECK_D64 + i);
+        }
+    }
+
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    int bench = (argc > 1 && strcmp(argv[1], "-b") == 0);
+
+    for (size_t k = 0; k < sizeof(bench_impls)/sizeof(*bench_impls); k++) {
+        if (! br_sha256_select(bench_impls[k])) {
+            printf("br_sha256 %s: not available\n", bench_impls[k]);
+            continue;
+        }
+
+        if (! bench_check_vectors() || ! bench_check_lengths() || ! bench_check_d64()) return 1;
+        printf("br_sha256 %s: matches the test vectors and sph up to %d bytes and %d inputs\n", bench_impls[k],
+               CHECK_LEN, CHECK_D64);
+
+        if (bench) {
+            static uint8_t in[BENCH_INPUTS*64];
+            uint8_t *data = calloc(1, BENCH_BYTES), md[32];
+            size_t rounds = BENCH_BYTES/sizeof(in);
+            double begin, t;
+
+            if (! data) return 1;
+            begin = gettimedouble();
+            br_sha256(md, data, BENCH_BYTES);
+            t = gettimedouble() - begin;
+            printf("  %d MB: %.0f MB/s\n", BENCH_BYTES >> 20, BENCH_BYTES/t/1e6);
+            begin = gettimedouble();
+            for (size_t i = 0; i < BENCH_BYTES/64; i++) br_sha256(md, data + i*64, 64);
+            t = gettimedouble() - begin;
+            printf("  64 byte messages: %.0f ns each\n", t*1e9/(BENCH_BYTES/64));
+            free(data);
+            begin = gettimedouble();
+            for (size_t r = 0; r < rounds; r++) br_sha256d64(in, in, BENCH_INPUTS);
+            t = gettimedouble() - begin;
+            printf("  br_sha256d64: %.0f ns per 64 byte input\n", t*1e9/(rounds*BENCH_INPUTS));
+        }
+    }
+
+    br_sha256_select(NULL);
+    printf("br_sha256: using %s\n", br_sha256_impl());
+    if (bench) {
+        uint8_t in[64] = { 0 }, md[32];
+        size_t n = 1000000;
+        double begin = gettimedouble(), t;
+
+        // the portable baseline, a plain C sha256 like the one NSData+Bitcoin had, run twice per input
+        for (size_t i = 0; i < n; i++) bench_sph_sha256(md, in, 64), bench_sph_sha256(md, md, 32), in[0] = md[0];
+        t = gettimedouble() - begin;
+        printf("sph sha256 twice: %.0f ns per 64 byte input\n", t*1e9/n);
+    }
+
+    return 0;
+}
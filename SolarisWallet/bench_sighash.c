@@ -0,0 +1,486 @@
+//
+//  bench_sighash.c
+//  SolarisWallet
+//
+//  Checks BRSighash.c against serialising the transaction once per input, and times the two with -b.
+//
+//  usage: bench_sighash [-b] [threads]
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRSighash.h"
+#include "BRSecp256k1.h"
+#include "BRTxCodec.h"
+#include "sph/sph_ripemd.h"
+#include "sph/sph_sha2.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define BENCH_NAME "bench_sighash"
+#include "bench.h"
+
+#define BENCH_MAX_INPUTS 1000
+#define BENCH_OUTPUTS    2
+#define BENCH_SCRIPT_LEN 25 // pay-to-pubkey-hash
+
+typedef struct {
+    uint8_t hash[BENCH_MAX_INPUTS][32];
+    uint32_t index[BENCH_MAX_INPUTS], sequence[BENCH_MAX_INPUTS];
+    uint8_t script[BENCH_MAX_INPUTS][BENCH_SCRIPT_LEN];
+    int has_script[BENCH_MAX_INPUTS];
+    uint64_t amount[BENCH_OUTPUTS];
+    uint8_t out_script[BENCH_OUTPUTS][BENCH_SCRIPT_LEN];
+    uint8_t seckeys[BENCH_MAX_INPUTS*32];
+    size_t inputs;
+} bench_tx;
+
+static void bench_fill(bench_tx *tx, size_t inputs, int all_scripts)
+{
+    uint32_t x = 0x9e3779b9u + (uint32_t)inputs;
+
+    memset(tx, 0, sizeof(*tx));
+    tx->inputs = inputs;
+
+    for (size_t i = 0; i < inputs; i++) {
+        for (size_t j = 0; j < 32; j++) tx->hash[i][j] = (uint8_t)((x = x*1664525 + 1013904223) >> 24);
+        for (size_t j = 0; j < 32; j++) tx->seckeys[i*32 + j] = (uint8_t)((x = x*1664525 + 1013904223) >> 24);
+        tx->index[i] = (x >> 8) % 4;
+        tx->sequence[i] = (i % 3) ? UINT32_MAX : (uint32_t)i;
+        tx->has_script[i] = all_scripts || (i % 5 != 1);
+        memcpy(tx->script[i], "\x76\xa9\x14", 3);
+        for (size_t j = 3; j < 23; j++) tx->script[i][j] = (uint8_t)(i*31 + j);
+        memcpy(tx->script[i] + 23, "\x88\xac", 2);
+    }
+
+    for (size_t i = 0; i < BENCH_OUTPUTS; i++) {
+        tx->amount[i] = 100000000ull*(i + 1) + 12345;
+        memcpy(tx->out_script[i], tx->script[0], BENCH_SCRIPT_LEN);
+        tx->out_script[i][5] ^= (uint8_t)(i + 1);
+    }
+}
+
+static size_t bench_put32(uint8_t *p, uint32_t u)
+{
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(u >> 8*i);
+    return 4;
+}
+
+static size_t bench_put_varint(uint8_t *p, size_t u)
+{
+    if (u < 0xfd) {
+        p[0] = (uint8_t)u;
+        return 1;
+    }
+
+    p[0] = 0xfd;
+    p[1] = (uint8_t)u;
+    p[2] = (uint8_t)(u >> 8);
+    return 3;
+}
+
+// the whole transaction with only the script of input sub, like toDataWithSubscriptIndex:, returns its length
+static size_t bench_serialize(const bench_tx *tx, size_t sub, uint8_t *d)
+{
+    size_t len = bench_put32(d, 1);
+
+    len += bench_put_varint(d + len, tx->inputs);
+
+    for (size_t i = 0; i < tx->inputs; i++) {
+        memcpy(d + len, tx->hash[i], 32);
+        len += 32 + bench_put32(d + len + 32, tx->index[i]);
+
+        if (i == sub && tx->has_script[i]) {
+            len += bench_put_varint(d + len, BENCH_SCRIPT_LEN);
+            memcpy(d + len, tx->script[i], BENCH_SCRIPT_LEN);
+            len += BENCH_SCRIPT_LEN;
+        }
+        else d[len++] = 0;
+
+        len += bench_put32(d + len, tx->sequence[i]);
+    }
+
+    len += bench_put_varint(d + len, BENCH_OUTPUTS);
+
+    for (size_t i = 0; i < BENCH_OUTPUTS; i++) {
+        len += bench_put32(d + len, (uint32_t)tx->amount[i]);
+        len += bench_put32(d + len, (uint32_t)(tx->amount[i] >> 32));
+        len += bench_put_varint(d + len, BENCH_SCRIPT_LEN);
+        memcpy(d + len, tx->out_script[i], BENCH_SCRIPT_LEN);
+        len += BENCH_SCRIPT_LEN;
+    }
+
+    len += bench_put32(d + len, 0);
+    return len + bench_put32(d + len, BR_SIGHASH_ALL);
+}
+
+static void bench_sha256_2(const uint8_t *d, size_t len, uint8_t *md)
+{
+    sph_sha256_context sha;
+
+    sph_sha256_init(&sha);
+    sph_sha256(&sha, d, len);
+    sph_sha256_close(&sha, md);
+    sph_sha256(&sha, md, 32);
+    sph_sha256_close(&sha, md);
+}
+
+static int bench_layout(br_sighash *sh, const bench_tx *tx)
+{
+    int ok = br_sighash_begin(sh, 1, tx->inputs, BENCH_OUTPUTS);
+
+    for (size_t i = 0; ok && i < tx->inputs; i++) {
+        ok = br_sighash_add_input(sh, tx->hash[i], tx->index[i], (tx->has_script[i]) ? tx->script[i] : NULL,
+                                  BENCH_SCRIPT_LEN, tx->sequence[i]);
+    }
+
+    for (size_t i = 0; ok && i < BENCH_OUTPUTS; i++) {
+        ok = br_sighash_add_output(sh, tx->amount[i], tx->out_script[i], BENCH_SCRIPT_LEN);
+    }
+
+    return ok && br_sighash_end(sh, 0);
+}
+
+static int bench_check(br_sighash *sh, bench_tx *tx, uint8_t *buf, uint8_t *md32s, unsigned threads)
+{
+    static const size_t counts[] = { 0, 1, 2, 252, 253, 300 }; // around the varint boundary
+    uint8_t md[32];
+
+    for (size_t c = 0; c < sizeof(counts)/sizeof(*counts); c++) {
+        bench_fill(tx, counts[c], 0);
+        if (! bench_layout(sh, tx)) return 0;
+        br_sighash_digests(sh, NULL, tx->inputs, BR_SIGHASH_ALL, md32s, threads);
+
+        for (size_t i = 0; i < tx->inputs; i++) {
+            bench_sha256_2(buf, bench_serialize(tx, i, buf), md);
+
+            if (memcmp(md, md32s + i*32, 32) != 0) {
+                fprintf(stderr, "bench_sighash: input %zu of %zu hashes differently\n", i, tx->inputs);
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+#define BENCH_ROUND_TRIP_INPUTS 5
+
+typedef struct {
+    uint8_t *p;
+    size_t len;
+} bench_buf;
+
+static void bench_write(void *info, const uint8_t *bytes, size_t len)
+{
+    bench_buf *b = info;
+
+    memcpy(b->p + b->len, bytes, len);
+    b->len += len;
+}
+
+// lays out tx with scripts[i], or nothing if it is NULL, as the output script input i spends
+static int bench_layout_tx(br_sighash *sh, const br_tx *tx, const br_span *scripts)
+{
+    int ok = br_sighash_begin(sh, tx->version, tx->in_count, tx->out_count);
+
+    for (size_t i = 0; ok && i < tx->in_count; i++) {
+        ok = br_sighash_add_input(sh, tx->in_hash[i], tx->in_index[i], (scripts) ? scripts[i].p : NULL,
+                                  (scripts) ? scripts[i].len : 0, tx->in_sequence[i]);
+    }
+
+    for (size_t i = 0; ok && i < tx->out_count; i++) {
+        ok = br_sighash_add_output(sh, tx->out_amount[i], tx->out_script[i].p, tx->out_script[i].len);
+    }
+
+    return ok && br_sighash_end(sh, tx->lock_time);
+}
+
+// checks each signature script, a push of a DER signature with SIGHASH_ALL and a push of the pubkey, against the
+// pay-to-pubkey-hash script it spends, scripts[i], or against nothing if scripts is NULL; returns how many verify
+static size_t bench_verify(const secp256k1_context *ctx, br_sighash *sh, const br_tx *tx, const br_span *scripts)
+{
+    uint8_t md32s[BENCH_ROUND_TRIP_INPUTS*32], h160[20], sig_h160[20];
+    size_t valid = 0;
+
+    if (tx->in_count > BENCH_ROUND_TRIP_INPUTS || ! bench_layout_tx(sh, tx, scripts)) return 0;
+    br_sighash_digests(sh, NULL, tx->in_count, BR_SIGHASH_ALL, md32s, 1);
+
+    for (size_t i = 0; i < tx->in_count; i++) {
+        const uint8_t *p = tx->in_script[i].p;
+        size_t len = tx->in_script[i].len, sig_len = (len > 0) ? p[0] : 0;
+        secp256k1_ecdsa_signature sig;
+        secp256k1_pubkey pubkey;
+
+        if (sig_len < 2 || len != 1 + sig_len + 1 + 33 || p[sig_len] != BR_SIGHASH_ALL || p[1 + sig_len] != 33) continue;
+
+        // without the scripts only the signature over the digest is checked, which is what they go into
+        if (scripts && (br_tx_script_hash160(scripts[i].p, scripts[i].len, h160) != BR_TX_SCRIPT_PUBKEY_HASH ||
+                        br_tx_sig_hash160(p, len, sig_h160) != BR_TX_SCRIPT_PUBKEY_HASH ||
+                        memcmp(h160, sig_h160, sizeof(h160)) != 0)) continue;
+
+        if (secp256k1_ecdsa_signature_parse_der(ctx, &sig, p + 1, sig_len - 1) &&
+            secp256k1_ec_pubkey_parse(ctx, &pubkey, p + 2 + sig_len, 33)) {
+            secp256k1_ecdsa_signature_normalize(ctx, &sig, &sig); // as -[BRKey verify:signature:] does
+            if (secp256k1_ecdsa_verify(ctx, &sig, md32s + i*32, &pubkey)) valid++;
+        }
+    }
+
+    return valid;
+}
+
+static void bench_hash160(uint8_t *h160, const uint8_t *data, size_t len)
+{
+    sph_sha256_context sha;
+    sph_ripemd160_context rmd;
+    uint8_t md[32];
+
+    sph_sha256_init(&sha);
+    sph_sha256(&sha, data, len);
+    sph_sha256_close(&sha, md);
+    sph_ripemd160_init(&rmd);
+    sph_ripemd160(&rmd, md, sizeof(md));
+    sph_ripemd160_close(&rmd, h160);
+}
+
+// rewrites the DER signature sig of *len bytes with n - s in place of s, the high s form a peer may relay
+static int bench_high_s(const secp256k1_context *ctx, uint8_t *sig, size_t *len)
+{
+    static const uint8_t order[32] = {
+        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfe,
+        0xba, 0xae, 0xdc, 0xe6, 0xaf, 0x48, 0xa0, 0x3b, 0xbf, 0xd2, 0x5e, 0x8c, 0xd0, 0x36, 0x41, 0x41
+    };
+    secp256k1_ecdsa_signature s;
+    uint8_t rs[64];
+    int borrow = 0;
+
+    if (! secp256k1_ecdsa_signature_parse_der(ctx, &s, sig, *len)) return 0;
+    secp256k1_ecdsa_signature_serialize_compact(ctx, rs, &s);
+
+    for (int j = 31; j >= 0; j--) {
+        int d = order[j] - rs[32 + j] - borrow;
+
+        borrow = (d < 0);
+        rs[32 + j] = (uint8_t)d;
+    }
+
+    *len = BR_SECP_DER_SIG_MAX;
+    return secp256k1_ecdsa_signature_parse_compact(ctx, &s, rs) &&
+           secp256k1_ecdsa_signature_serialize_der(ctx, sig, len, &s);
+}
+
+static int bench_round_trip(br_sighash *sh)
+{
+    enum { n = BENCH_ROUND_TRIP_INPUTS };
+    static uint8_t hashes[n][32], seckeys[n*32], pubkeys[n][33], spent[n][BENCH_SCRIPT_LEN],
+                   sig_scripts[n][2 + BR_SECP_DER_SIG_MAX + 1 + 33], out_scripts[2][BENCH_SCRIPT_LEN], md32s[n*32],
+                   sigs[n*BR_SECP_DER_SIG_MAX], msg[1024];
+    br_span scripts[n];
+    size_t lens[n], pubkey_len = 33;
+    secp256k1_context *ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    br_secp_pool *pool = (ctx) ? br_secp_pool_new(ctx, 2, 0) : NULL;
+    br_tx *tx = br_tx_new(), *parsed = br_tx_new();
+    bench_buf b = { msg, 0 };
+    uint32_t x = 0x6a09e667u;
+    int ok = (pool && tx && parsed && br_tx_resize(tx, n, 2));
+
+    for (size_t i = 0; ok && i < n; i++) {
+        secp256k1_pubkey pubkey;
+
+        for (size_t j = 0; j < 32; j++) hashes[i][j] = (uint8_t)((x = x*1664525 + 1013904223) >> 24);
+        for (size_t j = 0; j < 32; j++) seckeys[i*32 + j] = (uint8_t)((x = x*1664525 + 1013904223) >> 24);
+        ok = secp256k1_ec_pubkey_create(ctx, &pubkey, seckeys + i*32) &&
+             secp256k1_ec_pubkey_serialize(ctx, pubkeys[i], &pubkey_len, &pubkey, SECP256K1_EC_COMPRESSED);
+        memcpy(spent[i], "\x76\xa9\x14", 3);
+        bench_hash160(spent[i] + 3, pubkeys[i], 33);
+        memcpy(spent[i] + 23, "\x88\xac", 2);
+        scripts[i].p = spent[i], scripts[i].len = BENCH_SCRIPT_LEN;
+        tx->in_hash[i] = hashes[i], tx->in_index[i] = (uint32_t)i, tx->in_sequence[i] = UINT32_MAX;
+        tx->in_script[i].p = NULL, tx->in_script[i].len = 0;
+    }
+
+    for (size_t i = 0; ok && i < 2; i++) {
+        memcpy(out_scripts[i], spent[i], BENCH_SCRIPT_LEN);
+        out_scripts[i][3] ^= 0x5a;
+        tx->out_amount[i] = 50000000ull*(i + 1);
+        tx->out_script[i].p = out_scripts[i], tx->out_script[i].len = BENCH_SCRIPT_LEN;
+    }
+
+    tx->version = 1, tx->lock_time = 0, tx->raw = NULL;
+
+    // sign like -signWithPrivateKeys:, every input laid out with the script it spends
+    if (ok) ok = bench_layout_tx(sh, tx, scripts);
+    if (ok) br_sighash_digests(sh, NULL, n, BR_SIGHASH_ALL, md32s, 2);
+    if (ok) ok = (br_secp_pool_sign(pool, sigs, lens, md32s, seckeys, n) == n);
+    if (ok) ok = bench_high_s(ctx, sigs, &lens[0]); // valid by consensus, so it has to verify like the others
+
+    for (size_t i = 0; ok && i < n; i++) {
+        uint8_t *p = sig_scripts[i];
+
+        p[0] = (uint8_t)(lens[i] + 1);
+        memcpy(p + 1, sigs + i*BR_SECP_DER_SIG_MAX, lens[i]);
+        p[1 + lens[i]] = BR_SIGHASH_ALL;
+        p[2 + lens[i]] = 33;
+        memcpy(p + 3 + lens[i], pubkeys[i], 33);
+        tx->in_script[i].p = p, tx->in_script[i].len = 3 + lens[i] + 33;
+    }
+
+    // the message a peer would send, read back the way initWithMessage: does, which keeps no spent scripts
+    if (ok) br_tx_serialize(tx, 1, bench_write, &b);
+    if (ok) ok = (br_tx_parse(parsed, msg, b.len) == b.len);
+
+    if (ok && bench_verify(ctx, sh, parsed, scripts) != n) {
+        fprintf(stderr, "bench_sighash: a parsed transaction does not verify against the scripts it spends\n");
+        ok = 0;
+    }
+
+    if (ok && bench_verify(ctx, sh, parsed, NULL) != 0) {
+        fprintf(stderr, "bench_sighash: a parsed transaction verifies without the scripts it spends\n");
+        ok = 0;
+    }
+
+    if (ok) {
+        parsed->out_amount[1]++;
+
+        if (bench_verify(ctx, sh, parsed, scripts) != 0) {
+            fprintf(stderr, "bench_sighash: a transaction with a changed output still verifies\n");
+            ok = 0;
+        }
+    }
+
+    br_tx_free(parsed);
+    br_tx_free(tx);
+    if (pool) br_secp_pool_free(pool);
+    if (ctx) secp256k1_context_destroy(ctx);
+    return ok;
+}
+
+// the old way: serialise the whole transaction for each input, hash it and sign it with one context
+static void bench_old(const secp256k1_context *ctx, const bench_tx *tx, uint8_t *buf, uint8_t *sigs, size_t *lens)
+{
+    for (size_t i = 0; i < tx->inputs; i++) {
+        secp256k1_ecdsa_signature s;
+        uint8_t md[32];
+
+        bench_sha256_2(buf, bench_serialize(tx, i, buf), md);
+        lens[i] = BR_SECP_DER_SIG_MAX;
+        if (! secp256k1_ecdsa_sign(ctx, &s, md, tx->seckeys + i*32, secp256k1_nonce_function_rfc6979, NULL) ||
+            ! secp256k1_ecdsa_signature_serialize_der(ctx, sigs + i*BR_SECP_DER_SIG_MAX, &lens[i], &s)) lens[i] = 0;
+    }
+}
+
+static void bench_new(br_secp_pool *pool, br_sighash *sh, const bench_tx *tx, uint8_t *md32s, uint8_t *sigs,
+                      size_t *lens, unsigned threads)
+{
+    bench_layout(sh, tx);
+    br_sighash_digests(sh, NULL, tx->inputs, BR_SIGHASH_ALL, md32s, threads);
+    br_secp_pool_sign(pool, sigs, lens, md32s, tx->seckeys, tx->inputs);
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t counts[] = { 1, 10, 100, 300, BENCH_MAX_INPUTS };
+    static bench_tx tx;
+    static uint8_t buf[10 + BENCH_MAX_INPUTS*(41 + 1 + BENCH_SCRIPT_LEN) + BENCH_OUTPUTS*64 + 8];
+    static uint8_t md32s[BENCH_MAX_INPUTS*32], sigs[BENCH_MAX_INPUTS*BR_SECP_DER_SIG_MAX],
+                   sigs2[BENCH_MAX_INPUTS*BR_SECP_DER_SIG_MAX];
+    static size_t lens[BENCH_MAX_INPUTS], lens2[BENCH_MAX_INPUTS];
+    br_sighash *sh = br_sighash_new();
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned threads = (cpus > 0) ? (unsigned)cpus : 1;
+    secp256k1_context *ctx;
+    br_secp_pool *pool;
+    int bench = 0;
+
+    if (argc > 1 && strcmp(argv[1], "-b") == 0) {
+        bench = 1;
+        argc--;
+        argv++;
+    }
+
+    if (argc > 1) threads = (unsigned)atoi(argv[1]);
+    if (! sh || ! bench_check(sh, &tx, buf, md32s, 4)) return 1;
+    printf("br_sighash: digests match a serialisation per input\n");
+    if (! bench_round_trip(sh)) return 1;
+    printf("br_sighash: a signed transaction verifies after a round trip through its message\n");
+
+    if (bench) {
+        ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+        pool = br_secp_pool_new(ctx, threads, 0);
+        if (! pool) return 1;
+
+        for (size_t c = 0; c < sizeof(counts)/sizeof(*counts); c++) {
+            size_t rounds = (counts[c] < 100) ? 200/counts[c] + 1 : 1;
+            double begin, t_old, t_new;
+
+            bench_fill(&tx, counts[c], 1);
+            begin = gettimedouble();
+            for (size_t r = 0; r < rounds; r++) bench_old(ctx, &tx, buf, sigs, lens);
+            t_old = (gettimedouble() - begin)/(double)rounds;
+            begin = gettimedouble();
+            for (size_t r = 0; r < rounds; r++) bench_new(pool, sh, &tx, md32s, sigs2, lens2, threads);
+            t_new = (gettimedouble() - begin)/(double)rounds;
+
+            // rfc6979 nonces make both ways sign identically
+            if (memcmp(lens, lens2, counts[c]*sizeof(*lens)) != 0 ||
+                memcmp(sigs, sigs2, counts[c]*BR_SECP_DER_SIG_MAX) != 0) {
+                fprintf(stderr, "bench_sighash: %zu inputs signed differently\n", counts[c]);
+                return 1;
+            }
+
+            printf("sign %4zu inputs: %9.3f ms serialising per input, %9.3f ms laid out once on %u threads\n",
+                   counts[c], t_old*1e3, t_new*1e3, br_secp_pool_size(pool));
+        }
+
+        // the hashing alone, on one thread: a serialisation per input against the midstates of one layout
+        for (size_t c = 0; c < sizeof(counts)/sizeof(*counts); c++) {
+            size_t rounds = (counts[c] < 100) ? 2000/counts[c] + 1 : 10;
+            double begin, t_old, t_new;
+
+            bench_fill(&tx, counts[c], 1);
+            begin = gettimedouble();
+
+            for (size_t r = 0; r < rounds; r++) {
+                for (size_t i = 0; i < tx.inputs; i++) bench_sha256_2(buf, bench_serialize(&tx, i, buf), md32s + i*32);
+            }
+
+            t_old = (gettimedouble() - begin)/(double)rounds;
+            begin = gettimedouble();
+
+            for (size_t r = 0; r < rounds; r++) {
+                bench_layout(sh, &tx);
+                br_sighash_digests(sh, NULL, tx.inputs, BR_SIGHASH_ALL, md32s, 1);
+            }
+
+            t_new = (gettimedouble() - begin)/(double)rounds;
+            printf("hash %4zu inputs: %9.3f ms serialising per input, %9.3f ms from midstates\n", counts[c],
+                   t_old*1e3, t_new*1e3);
+        }
+
+        br_secp_pool_free(pool);
+        secp256k1_context_destroy(ctx);
+    }
+
+    br_sighash_free(sh);
+    return 0;
+}
@@ -0,0 +1,275 @@
+//
+//  bench_sph.c
+//  SolarisWallet
+//
+//  Checks the kernels of sph/sph_4way.h and sph/sph_aes_hw.h against the scalar sph functions, and
+//  times them with -b.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "sph/sph_4way.h"
+#include "sph/sph_aes_hw.h"
+#include "sph/sph_blake.h"
+#include "sph/sph_bmw.h"
+#include "sph/sph_cubehash.h"
+#include "sph/sph_echo.h"
+#include "sph/sph_groestl.h"
+#include "sph/sph_hamsi.h"
+#include "sph/sph_jh.h"
+#include "sph/sph_keccak.h"
+#include "sph/sph_luffa.h"
+#include "sph/sph_shavite.h"
+#include "sph/sph_shabal.h"
+#include "sph/sph_simd.h"
+#include "sph/sph_skein.h"
+#include "sph/sph_sha2.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *bench_checking; // name of the kernel being checked
+
+#define BENCH_NAME "bench_sph"
+#define BENCH_DETAIL bench_checking
+#define BENCH_SEED 0x3c6ef372u
+#include "bench.h"
+
+#define CHECK_ROUNDS  1000
+#define BENCH_ROUNDS  100000
+#define MSG_LEN       128
+
+typedef union {
+    sph_blake512_context blake;
+    sph_bmw512_context bmw;
+    sph_cubehash512_context cubehash;
+    sph_echo512_context echo;
+    sph_groestl512_context groestl;
+    sph_hamsi512_context hamsi;
+    sph_jh512_context jh;
+    sph_keccak512_context keccak;
+    sph_luffa512_context luffa;
+    sph_shavite512_context shavite;
+    sph_shabal512_context shabal;
+    sph_simd512_context simd;
+    sph_skein512_context skein;
+    sph_sha512_context sha512;
+} bench_ctx;
+
+typedef struct {
+    const char *name;
+    void (*init)(void *cc);
+    void (*update)(void *cc, const void *data, size_t len);
+    void (*close)(void *cc, void *dst);
+    void (*run4)(const void *const in[4], void *const out[4]);
+    void (*run8)(const void *const in[8], void *const out[8]);
+    void (*run1)(const void *in, void *out);
+} bench_kernel;
+
+#if SPH_4WAY
+
+#define BENCH_KERNEL(name) \
+    { #name, sph_##name##_init, sph_##name, sph_##name##_close, sph_##name##_4way_128, sph_##name##_8way_128, NULL }
+
+static const bench_kernel bench_kernels[] = {
+    BENCH_KERNEL(blake512),
+    BENCH_KERNEL(bmw512),
+    BENCH_KERNEL(skein512),
+    BENCH_KERNEL(jh512),
+    BENCH_KERNEL(keccak512),
+    BENCH_KERNEL(sha512),
+    BENCH_KERNEL(luffa512),
+    BENCH_KERNEL(cubehash512),
+    BENCH_KERNEL(shabal512),
+    BENCH_KERNEL(hamsi512),
+    BENCH_KERNEL(simd512),
+};
+
+#define BENCH_KERNEL_COUNT (sizeof(bench_kernels)/sizeof(*bench_kernels))
+
+#endif
+
+#if SPH_AES_HW
+
+#define BENCH_KERNEL_AES(name) \
+    { #name, sph_##name##_init, sph_##name, sph_##name##_close, NULL, NULL, sph_##name##_aes_128 }
+
+static const bench_kernel bench_aes_kernels[] = {
+    BENCH_KERNEL_AES(groestl512),
+    BENCH_KERNEL_AES(shavite512),
+    BENCH_KERNEL_AES(echo512),
+};
+
+#define BENCH_AES_KERNEL_COUNT (sizeof(bench_aes_kernels)/sizeof(*bench_aes_kernels))
+
+#endif
+
+static void bench_scalar(const bench_kernel *k, uint8_t md[64], const uint8_t *data, size_t len)
+{
+    bench_ctx cc;
+
+    k->init(&cc);
+    k->update(&cc, data, len);
+    k->close(&cc, md);
+}
+
+#if SPH_4WAY
+
+// runs the 4-way or 8-way kernel of k
+static void bench_run(const bench_kernel *k, size_t lanes, void *const msg[], void *const md[])
+{
+    if (lanes == 8) k->run8((const void *const *)msg, md);
+    else k->run4((const void *const *)msg, md);
+}
+
+static int bench_check_mb(const bench_kernel *k, size_t lanes)
+{
+    uint8_t msg[8][MSG_LEN], md[8][64], expected[8][64];
+    void *in[8], *out[8];
+
+    bench_checking = k->name;
+    for (size_t j = 0; j < 8; j++) in[j] = msg[j], out[j] = md[j];
+
+    for (size_t r = 0; r < CHECK_ROUNDS; r++) {
+        for (size_t i = 0; i < sizeof(msg); i++) ((uint8_t *)msg)[i] = (uint8_t)bench_rand();
+        if (r % 4 == 1) memcpy(msg[2], msg[0], MSG_LEN); // equal lanes must not disturb each other either
+        for (size_t j = 0; j < lanes; j++) bench_scalar(k, expected[j], msg[j], MSG_LEN);
+        memset(md, 0xee, sizeof(md));
+        bench_run(k, lanes, in, out);
+
+        for (size_t j = 0; j < lanes; j++) {
+            if (memcmp(md[j], expected[j], 64) != 0) return bench_fail("lane", r*lanes + j);
+        }
+
+        if (r % 4 == 3) { // in place, the way xevan feeds one stage's output to the next
+            for (size_t j = 0; j < lanes; j++) {
+                memset(msg[j] + 64, 0, 64);
+                bench_scalar(k, expected[j], msg[j], MSG_LEN);
+            }
+
+            bench_run(k, lanes, in, in);
+
+            for (size_t j = 0; j < lanes; j++) {
+                if (memcmp(msg[j], expected[j], 64) != 0) return bench_fail("lane in place", r*lanes + j);
+            }
+        }
+    }
+
+    return 1;
+}
+
+static void bench_time_mb(const bench_kernel *k)
+{
+    uint8_t msg[8][MSG_LEN];
+    void *io[8];
+    double begin, t1, t4, t8;
+
+    for (size_t j = 0; j < 8; j++) io[j] = msg[j];
+    memset(msg, 0x5a, sizeof(msg));
+    begin = gettimedouble();
+    for (size_t r = 0; r < BENCH_ROUNDS; r++) for (size_t j = 0; j < 8; j++) bench_scalar(k, msg[j], msg[j], MSG_LEN);
+    t1 = gettimedouble() - begin;
+    begin = gettimedouble();
+    for (size_t r = 0; r < BENCH_ROUNDS; r++) bench_run(k, 4, io, io), bench_run(k, 4, io + 4, io + 4);
+    t4 = gettimedouble() - begin;
+    begin = gettimedouble();
+    for (size_t r = 0; r < BENCH_ROUNDS; r++) bench_run(k, 8, io, io);
+    t8 = gettimedouble() - begin;
+    printf("  %-11s scalar %4.0f ns, 4-way %4.0f ns (%.2fx), 8-way %4.0f ns (%.2fx) per message\n", k->name,
+           t1*1e9/(8*BENCH_ROUNDS), t4*1e9/(8*BENCH_ROUNDS), t1/t4, t8*1e9/(8*BENCH_ROUNDS), t1/t8);
+}
+
+#endif
+
+#if SPH_AES_HW
+
+static int bench_check_aes(const bench_kernel *k)
+{
+    uint8_t msg[MSG_LEN], md[64], expected[64];
+
+    bench_checking = k->name;
+
+    for (size_t r = 0; r < CHECK_ROUNDS; r++) {
+        for (size_t i = 0; i < sizeof(msg); i++) msg[i] = (uint8_t)bench_rand();
+        bench_scalar(k, expected, msg, MSG_LEN);
+        memset(md, 0xee, sizeof(md));
+        k->run1(msg, md);
+        if (memcmp(md, expected, 64) != 0) return bench_fail("aes", r);
+
+        if (r % 4 == 3) { // in place, the way xevan feeds one stage's output to the next
+            memset(msg + 64, 0, 64);
+            bench_scalar(k, expected, msg, MSG_LEN);
+            k->run1(msg, msg);
+            if (memcmp(msg, expected, 64) != 0) return bench_fail("aes in place", r);
+        }
+    }
+
+    return 1;
+}
+
+static void bench_time_aes(const bench_kernel *k)
+{
+    uint8_t msg[MSG_LEN];
+    double begin, t1, ta;
+
+    memset(msg, 0x5a, sizeof(msg));
+    begin = gettimedouble();
+    for (size_t r = 0; r < BENCH_ROUNDS; r++) bench_scalar(k, msg, msg, MSG_LEN);
+    t1 = gettimedouble() - begin;
+    begin = gettimedouble();
+    for (size_t r = 0; r < BENCH_ROUNDS; r++) k->run1(msg, msg);
+    ta = gettimedouble() - begin;
+    printf("  %-11s scalar %4.0f ns, aes %4.0f ns per message (%.2fx)\n", k->name, t1*1e9/BENCH_ROUNDS,
+           ta*1e9/BENCH_ROUNDS, t1/ta);
+}
+
+#endif
+
+int main(int argc, char **argv)
+{
+    int bench = (argc > 1 && strcmp(argv[1], "-b") == 0);
+
+#if SPH_4WAY
+    for (size_t i = 0; i < BENCH_KERNEL_COUNT; i++) {
+        if (! bench_check_mb(&bench_kernels[i], 4) || ! bench_check_mb(&bench_kernels[i], 8)) return 1;
+    }
+
+    printf("sph multi-buffer: every lane of the %zu 4-way and 8-way kernels matches the scalar code over %d rounds, "
+           "%u lanes suit this cpu\n", BENCH_KERNEL_COUNT, CHECK_ROUNDS, sph_mb_lanes());
+    if (bench) for (size_t i = 0; i < BENCH_KERNEL_COUNT; i++) bench_time_mb(&bench_kernels[i]);
+#else
+    printf("sph multi-buffer: not available\n");
+#endif
+
+#if SPH_AES_HW
+    if (sph_aes_hw_available()) {
+        for (size_t i = 0; i < BENCH_AES_KERNEL_COUNT; i++) if (! bench_check_aes(&bench_aes_kernels[i])) return 1;
+        printf("sph aes: the %zu kernels match the scalar code over %d messages\n", BENCH_AES_KERNEL_COUNT,
+               CHECK_ROUNDS);
+        if (bench) for (size_t i = 0; i < BENCH_AES_KERNEL_COUNT; i++) bench_time_aes(&bench_aes_kernels[i]);
+    }
+    else printf("sph aes: not supported by this cpu\n");
+#else
+    printf("sph aes: not available\n");
+#endif
+
+    return 0;
+}
@@ -0,0 +1,436 @@
+//
+//  bench_txcodec.c
+//  SolarisWallet
+//
+//  Checks BRTxCodec.c against transactions serialised field by field, and times it with -b.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRTxCodec.h"
+#include "sph/sph_sha2.h"
+#include "sph/sph_ripemd.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static char bench_checking[48]; // size of the transaction being checked
+
+#define BENCH_NAME "bench_txcodec"
+#define BENCH_DETAIL bench_checking
+#define BENCH_SEED 0x9e3779b9u
+#include "bench.h"
+
+#define BENCH_MAX_IO     300
+#define BENCH_SCRIPT_MAX 70
+#define BENCH_BUF_SIZE   (16 + BENCH_MAX_IO*(41 + 3 + BENCH_SCRIPT_MAX) + BENCH_MAX_IO*(8 + 3 + BENCH_SCRIPT_MAX))
+#define BENCH_BLOCK_TXS  2000
+
+typedef struct {
+    uint32_t version, lock_time;
+    size_t inputs, outputs;
+    uint8_t hash[BENCH_MAX_IO][32];
+    uint32_t index[BENCH_MAX_IO], sequence[BENCH_MAX_IO];
+    uint8_t script[BENCH_MAX_IO][BENCH_SCRIPT_MAX];
+    size_t script_len[BENCH_MAX_IO];
+    uint64_t amount[BENCH_MAX_IO];
+    uint8_t out_script[BENCH_MAX_IO][BENCH_SCRIPT_MAX];
+    size_t out_script_len[BENCH_MAX_IO];
+} bench_tx;
+
+typedef struct {
+    uint8_t *p;
+    size_t len, cap;
+} bench_sink;
+
+static uint8_t bench_byte(void)
+{
+    return (uint8_t)(bench_rand() >> 24);
+}
+
+static void bench_fill(bench_tx *tx, size_t inputs, size_t outputs)
+{
+    tx->version = 1 + bench_byte() % 2;
+    tx->lock_time = (bench_byte() & 1) ? 0 : bench_byte()*0x10101u;
+    tx->inputs = inputs;
+    tx->outputs = outputs;
+
+    for (size_t i = 0; i < inputs; i++) {
+        for (size_t j = 0; j < 32; j++) tx->hash[i][j] = bench_byte();
+        tx->index[i] = bench_byte() % 4;
+        tx->sequence[i] = (i % 3) ? UINT32_MAX : (uint32_t)i*0x01000193u;
+        tx->script_len[i] = (i % 7 == 3) ? 0 : bench_byte() % BENCH_SCRIPT_MAX; // some inputs unsigned
+        for (size_t j = 0; j < tx->script_len[i]; j++) tx->script[i][j] = bench_byte();
+    }
+
+    for (size_t i = 0; i < outputs; i++) {
+        tx->amount[i] = ((uint64_t)bench_byte() << 40) | ((uint64_t)bench_byte() << 8) | i;
+        tx->out_script_len[i] = (i % 5 == 4) ? 0 : 25;
+        memcpy(tx->out_script[i], "\x76\xa9\x14", 3);
+        for (size_t j = 3; j < 23; j++) tx->out_script[i][j] = bench_byte();
+        memcpy(tx->out_script[i] + 23, "\x88\xac", 2);
+    }
+}
+
+static size_t bench_put32(uint8_t *p, uint32_t u)
+{
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(u >> 8*i);
+    return 4;
+}
+
+static size_t bench_put_varint(uint8_t *p, size_t u)
+{
+    if (u < 0xfd) {
+        p[0] = (uint8_t)u;
+        return 1;
+    }
+
+    p[0] = 0xfd;
+    p[1] = (uint8_t)u;
+    p[2] = (uint8_t)(u >> 8);
+    return 3;
+}
+
+static size_t bench_serialize(const bench_tx *tx, uint8_t *d)
+{
+    size_t len = bench_put32(d, tx->version);
+
+    len += bench_put_varint(d + len, tx->inputs);
+
+    for (size_t i = 0; i < tx->inputs; i++) {
+        memcpy(d + len, tx->hash[i], 32);
+        len += 32;
+        len += bench_put32(d + len, tx->index[i]);
+        len += bench_put_varint(d + len, tx->script_len[i]);
+        memcpy(d + len, tx->script[i], tx->script_len[i]);
+        len += tx->script_len[i];
+        len += bench_put32(d + len, tx->sequence[i]);
+    }
+
+    len += bench_put_varint(d + len, tx->outputs);
+
+    for (size_t i = 0; i < tx->outputs; i++) {
+        len += bench_put32(d + len, (uint32_t)tx->amount[i]);
+        len += bench_put32(d + len, (uint32_t)(tx->amount[i] >> 32));
+        len += bench_put_varint(d + len, tx->out_script_len[i]);
+        memcpy(d + len, tx->out_script[i], tx->out_script_len[i]);
+        len += tx->out_script_len[i];
+    }
+
+    return len + bench_put32(d + len, tx->lock_time);
+}
+
+static void bench_sha256_2(const uint8_t *d, size_t len, uint8_t *md)
+{
+    sph_sha256_context sha;
+
+    sph_sha256_init(&sha);
+    sph_sha256(&sha, d, len);
+    sph_sha256_close(&sha, md);
+    sph_sha256(&sha, md, 32);
+    sph_sha256_close(&sha, md);
+}
+
+static void bench_sink_write(void *info, const uint8_t *bytes, size_t len)
+{
+    bench_sink *s = info;
+
+    if (s->len + len <= s->cap) memcpy(s->p + s->len, bytes, len);
+    s->len += len;
+}
+
+static int bench_check_tx(br_tx *tx, const bench_tx *t, uint8_t *buf, uint8_t *out)
+{
+    size_t len = bench_serialize(t, buf);
+    bench_sink sink = { out, 0, BENCH_BUF_SIZE };
+    uint8_t md[32], md2[32];
+
+    snprintf(bench_checking, sizeof(bench_checking), "%zu inputs %zu outputs", t->inputs, t->outputs);
+    if (br_tx_parse(tx, buf, len + 7) != len) return bench_fail("parse length", 0);
+
+    if (tx->version != t->version || tx->lock_time != t->lock_time || tx->in_count != t->inputs ||
+        tx->out_count != t->outputs) return bench_fail("parse header", 0);
+
+    for (size_t i = 0; i < t->inputs; i++) {
+        if (memcmp(tx->in_hash[i], t->hash[i], 32) != 0 || tx->in_index[i] != t->index[i] ||
+            tx->in_sequence[i] != t->sequence[i] || tx->in_script[i].len != t->script_len[i] ||
+            memcmp(tx->in_script[i].p, t->script[i], t->script_len[i]) != 0 ||
+            tx->in_script[i].p < buf || tx->in_script[i].p >= buf + len) {
+            return bench_fail("parse input", i);
+        }
+    }
+
+    for (size_t i = 0; i < t->outputs; i++) {
+        if (tx->out_amount[i] != t->amount[i] || tx->out_script[i].len != t->out_script_len[i] ||
+            memcmp(tx->out_script[i].p, t->out_script[i], t->out_script_len[i]) != 0) {
+            return bench_fail("parse output", i);
+        }
+    }
+
+    bench_sha256_2(buf, len, md);
+    br_tx_hash(tx, md2);
+    if (memcmp(md, md2, 32) != 0) return bench_fail("hash of the message", 0);
+    br_tx_serialize(tx, 1, bench_sink_write, &sink);
+    if (sink.len != len || memcmp(out, buf, len) != 0) return bench_fail("message", 0);
+
+    // as it would be once its fields may have changed, streamed from the arrays
+    tx->raw = NULL;
+    sink.len = 0;
+    br_tx_serialize(tx, 1, bench_sink_write, &sink);
+    if (br_tx_size(tx) != len || sink.len != len || memcmp(out, buf, len) != 0) {
+        return bench_fail("serialisation", 0);
+    }
+
+    br_tx_hash(tx, md2);
+    if (memcmp(md, md2, 32) != 0) return bench_fail("hash of the serialisation", 0);
+
+    for (size_t l = 0; l < len; l += (l < 200 || len - l < 200) ? 1 : 97) {
+        if (br_tx_parse(tx, buf, l) != 0) return bench_fail("truncation accepted", l);
+    }
+
+    return 1;
+}
+
+static int bench_check_script(const char *name, const uint8_t *script, size_t len, br_tx_script_type type,
+                              const uint8_t *h160)
+{
+    uint8_t md[20];
+
+    memset(md, 0, sizeof(md));
+    if (br_tx_script_hash160(script, len, md) == type && (! h160 || memcmp(md, h160, 20) == 0)) return 1;
+    fprintf(stderr, "bench_txcodec: %s script misclassified\n", name);
+    return 0;
+}
+
+static int bench_check_scripts(void)
+{
+    uint8_t s[80], pk[65], md[32], h160[20];
+    sph_sha256_context sha;
+    sph_ripemd160_context rmd;
+    int ok = 1;
+
+    for (size_t i = 0; i < sizeof(pk); i++) pk[i] = bench_byte();
+    memcpy(s, "\x76\xa9\x14", 3);
+    memcpy(s + 3, pk, 20);
+    memcpy(s + 23, "\x88\xac", 2);
+    ok &= bench_check_script("pay-to-pubkey-hash", s, 25, BR_TX_SCRIPT_PUBKEY_HASH, pk);
+    ok &= bench_check_script("pay-to-pubkey-hash with an extra op", s, 26, BR_TX_SCRIPT_OTHER, NULL);
+    ok &= bench_check_script("truncated pay-to-pubkey-hash", s, 24, BR_TX_SCRIPT_OTHER, NULL);
+    s[2] = 0x15; // a 21 byte push runs into the ops after it
+    ok &= bench_check_script("pay-to-pubkey-hash of 21 bytes", s, 25, BR_TX_SCRIPT_OTHER, NULL);
+
+    // the push opcode is not part of the pattern, OP_PUSHDATA1 of 20 bytes counts as a 20 byte push
+    memcpy(s, "\x76\xa9\x4c\x14", 4);
+    memcpy(s + 4, pk, 20);
+    memcpy(s + 24, "\x88\xac", 2);
+    ok &= bench_check_script("pay-to-pubkey-hash via OP_PUSHDATA1", s, 26, BR_TX_SCRIPT_PUBKEY_HASH, pk);
+
+    memcpy(s, "\xa9\x14", 2);
+    memcpy(s + 2, pk + 1, 20);
+    s[22] = 0x87;
+    ok &= bench_check_script("pay-to-script-hash", s, 23, BR_TX_SCRIPT_HASH, pk + 1);
+    s[22] = 0x88;
+    ok &= bench_check_script("pay-to-script-hash with OP_EQUALVERIFY", s, 23, BR_TX_SCRIPT_OTHER, NULL);
+
+    for (size_t l = 33; l <= 65; l += 32) {
+        s[0] = (uint8_t)l;
+        memcpy(s + 1, pk, l);
+        s[l + 1] = 0xac;
+        sph_sha256_init(&sha);
+        sph_sha256(&sha, pk, l);
+        sph_sha256_close(&sha, md);
+        sph_ripemd160_init(&rmd);
+        sph_ripemd160(&rmd, md, sizeof(md));
+        sph_ripemd160_close(&rmd, h160);
+        ok &= bench_check_script("pay-to-pubkey", s, l + 2, BR_TX_SCRIPT_PUBKEY_HASH, h160);
+    }
+
+    s[0] = 34;
+    ok &= bench_check_script("pay-to-pubkey of 34 bytes", s, 36, BR_TX_SCRIPT_OTHER, NULL);
+    memcpy(s, "\x6a\x14", 2);
+    ok &= bench_check_script("OP_RETURN", s, 22, BR_TX_SCRIPT_OTHER, NULL);
+    ok &= bench_check_script("empty", s, 0, BR_TX_SCRIPT_OTHER, NULL);
+    memcpy(s, "\x76\xa9\x4e\xff\xff\xff\xff", 7);
+    ok &= bench_check_script("oversized OP_PUSHDATA4", s, 7, BR_TX_SCRIPT_OTHER, NULL);
+    return ok;
+}
+
+static void bench_hash160(uint8_t *h160, const uint8_t *data, size_t len)
+{
+    sph_sha256_context sha;
+    sph_ripemd160_context rmd;
+    uint8_t md[32];
+
+    sph_sha256_init(&sha);
+    sph_sha256(&sha, data, len);
+    sph_sha256_close(&sha, md);
+    sph_ripemd160_init(&rmd);
+    sph_ripemd160(&rmd, md, sizeof(md));
+    sph_ripemd160_close(&rmd, h160);
+}
+
+static int bench_check_sig(const char *name, const uint8_t *script, size_t len, br_tx_script_type type,
+                           const uint8_t *h160)
+{
+    uint8_t md[20];
+
+    memset(md, 0, sizeof(md));
+    if (br_tx_sig_hash160(script, len, md) == type && (! h160 || memcmp(md, h160, 20) == 0)) return 1;
+    fprintf(stderr, "bench_txcodec: %s signature script misclassified\n", name);
+    return 0;
+}
+
+static int bench_check_sigs(void)
+{
+    uint8_t s[400], sig[72], pk[65], redeem[105], h160[20];
+    int ok = 1;
+
+    for (size_t i = 0; i < sizeof(sig); i++) sig[i] = bench_byte();
+    for (size_t i = 0; i < sizeof(pk); i++) pk[i] = bench_byte();
+    for (size_t i = 0; i < sizeof(redeem); i++) redeem[i] = bench_byte();
+
+    for (size_t l = 33; l <= 65; l += 32) { // a signature, then the pubkey
+        s[0] = 72;
+        memcpy(s + 1, sig, 72);
+        s[73] = (uint8_t)l;
+        memcpy(s + 74, pk, l);
+        bench_hash160(h160, pk, l);
+        ok &= bench_check_sig("pay-to-pubkey-hash", s, 74 + l, BR_TX_SCRIPT_PUBKEY_HASH, h160);
+    }
+
+    s[73] = 34;
+    ok &= bench_check_sig("a 34 byte push after a signature", s, 74 + 34, BR_TX_SCRIPT_HASH, NULL);
+    ok &= bench_check_sig("a lone signature", s, 73, BR_TX_SCRIPT_OTHER, NULL);
+
+    // OP_0, two signatures and a redeem script pushed with OP_PUSHDATA1
+    s[0] = 0;
+    s[1] = 72;
+    memcpy(s + 2, sig, 72);
+    s[74] = 72;
+    memcpy(s + 75, sig, 72);
+    s[147] = 0x4c;
+    s[148] = sizeof(redeem);
+    memcpy(s + 149, redeem, sizeof(redeem));
+    bench_hash160(h160, redeem, sizeof(redeem));
+    ok &= bench_check_sig("pay-to-script-hash", s, 149 + sizeof(redeem), BR_TX_SCRIPT_HASH, h160);
+    bench_hash160(h160, sig, sizeof(sig)); // scriptElements stops before the cut off push, the last signature is left
+    ok &= bench_check_sig("truncated pay-to-script-hash", s, 148 + sizeof(redeem), BR_TX_SCRIPT_HASH, h160);
+    s[149 + sizeof(redeem)] = 0xac; // an op after the pushes
+    ok &= bench_check_sig("pushes then an op", s, 150 + sizeof(redeem), BR_TX_SCRIPT_OTHER, NULL);
+    s[0] = 0;
+    s[1] = 0;
+    ok &= bench_check_sig("empty pushes", s, 2, BR_TX_SCRIPT_OTHER, NULL);
+    ok &= bench_check_sig("empty", s, 0, BR_TX_SCRIPT_OTHER, NULL);
+    return ok;
+}
+
+static int bench_check(br_tx *tx, bench_tx *t, uint8_t *buf, uint8_t *out)
+{
+    static const size_t counts[][2] = { { 1, 0 }, { 1, 1 }, { 2, 3 }, { 252, 2 }, { 253, 253 }, { 5, 300 },
+                                        { 300, 1 }, { 3, 2 } }; // around the varint boundary, then shrinking
+    static const uint8_t bad[][8] = {
+        { 1, 0, 0, 0, 0, 0, 0, 0 }, // no inputs
+        { 1, 0, 0, 0, 0xfd, 0xff, 0xff, 0 }, // more inputs than bytes
+        { 1, 0, 0, 0, 0xff, 0xff, 0xff, 0xff }, // truncated varint
+    };
+
+    for (size_t c = 0; c < sizeof(counts)/sizeof(*counts); c++) {
+        bench_fill(t, counts[c][0], counts[c][1]);
+        if (! bench_check_tx(tx, t, buf, out)) return 0;
+    }
+
+    for (size_t i = 0; i < sizeof(bad)/sizeof(*bad); i++) {
+        if (br_tx_parse(tx, bad[i], sizeof(*bad)) == 0) continue;
+        fprintf(stderr, "bench_txcodec: malformed header %zu accepted\n", i);
+        return 0;
+    }
+
+    return bench_check_scripts() && bench_check_sigs();
+}
+
+int main(int argc, char **argv)
+{
+    static bench_tx t;
+    static uint8_t buf[BENCH_BUF_SIZE], out[BENCH_BUF_SIZE];
+    br_tx *tx = br_tx_new();
+    int bench = (argc > 1 && strcmp(argv[1], "-b") == 0);
+
+    if (! tx || ! bench_check(tx, &t, buf, out)) return 1;
+    printf("br_tx: parses, serialises, hashes and classifies like the fields it was made of\n");
+
+    if (bench) {
+        uint8_t *block = malloc(BENCH_BLOCK_TXS*1000), md[32];
+        size_t len = 0, off, parsed, grown = 0, ios[] = { 1, 2, 2, 3, 1, 2, 5, 2 };
+        void *mem = NULL;
+        double begin, t_reuse, t_new, t_hash, t_ser;
+        bench_sink sink = { out, 0, BENCH_BUF_SIZE };
+
+        if (! block) return 1;
+
+        // a block's worth of small transactions back to back, like a stream of relayed ones
+        for (size_t i = 0; i < BENCH_BLOCK_TXS; i++) {
+            bench_fill(&t, ios[i % 8], ios[(i + 3) % 8]);
+            len += bench_serialize(&t, block + len);
+        }
+
+        begin = gettimedouble();
+
+        for (off = 0, parsed = 0; off < len; off += br_tx_parse(tx, block + off, len - off), parsed++) {
+            if (tx->mem != mem) grown++, mem = tx->mem;
+        }
+
+        t_reuse = gettimedouble() - begin;
+        begin = gettimedouble();
+
+        for (off = 0; off < len;) {
+            br_tx *tx2 = br_tx_new();
+
+            off += br_tx_parse(tx2, block + off, len - off);
+            br_tx_free(tx2);
+        }
+
+        t_new = gettimedouble() - begin;
+        begin = gettimedouble();
+
+        for (off = 0; off < len; off += br_tx_parse(tx, block + off, len - off)) {
+            br_tx_hash(tx, md);
+        }
+
+        t_hash = gettimedouble() - begin;
+        begin = gettimedouble();
+
+        for (off = 0; off < len; off += br_tx_parse(tx, block + off, len - off)) {
+            tx->raw = NULL;
+            sink.len = 0;
+            br_tx_serialize(tx, 1, bench_sink_write, &sink);
+        }
+
+        t_ser = gettimedouble() - begin;
+        printf("%zu txs, %zu bytes: parse %.0f ns/tx reusing one br_tx (%zu allocations), %.0f ns/tx with a new one "
+               "each\n", parsed, len, t_reuse*1e9/parsed, grown, t_new*1e9/parsed);
+        printf("parse and txid %.0f ns/tx, parse and serialise from the arrays %.0f ns/tx\n", t_hash*1e9/parsed,
+               t_ser*1e9/parsed);
+        free(block);
+    }
+
+    br_tx_free(tx);
+    return 0;
+}
@@ -0,0 +1,345 @@
+//
+//  bench_txorder.c
+//  SolarisWallet
+//
+//  Checks BRTxOrder.c against a quadratic selection of the same order, and times it against the
+//  sort -[BRWallet sortTransactions] did with -b.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRTxOrder.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_NAME "bench_txorder"
+#define BENCH_SEED 0x6b43a9b5u
+#include "bench.h"
+
+#define CHECK_TXS     300
+#define CHECK_ROUNDS  200
+#define OLD_MAX_TXS   10000 // the previous sort takes tens of seconds beyond this
+#define MAX_INPUTS    3
+#define UNCONFIRMED   INT32_MAX
+#define NONE          SIZE_MAX
+
+typedef struct {
+    size_t n;
+    br_txorder_tx *txs;
+    uint8_t *hashes, *in_hashes;
+    size_t *parent; // MAX_INPUTS per transaction, the position of the one spent if the wallet has it, or NONE
+    uint32_t *addr; // 2 output addresses per transaction, below n on the internal chain, below 2n on the external one
+    uint32_t *internal, *external, *chain_pos; // the chains, and each address's position in its chain
+} bench_set;
+
+static void bench_hash(uint8_t *hash, size_t i)
+{
+    uint64_t x = i*0x2545f4914f6cdd1dull + 1;
+
+    for (size_t j = 0; j < 32; j++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        hash[j] = (uint8_t)(x >> 24);
+    }
+}
+
+static void bench_shuffle(uint32_t *a, size_t n)
+{
+    for (size_t i = n; i > 1; i--) {
+        size_t j = bench_rand() % i;
+        uint32_t t = a[i - 1];
+
+        a[i - 1] = a[j];
+        a[j] = t;
+    }
+}
+
+static void bench_free(bench_set *s)
+{
+    free(s->txs);
+    free(s->hashes);
+    free(s->in_hashes);
+    free(s->parent);
+    free(s->addr);
+    free(s->internal);
+    free(s->external);
+    free(s->chain_pos);
+    memset(s, 0, sizeof(*s));
+}
+
+// n transactions made oldest first, each spending some of the 16 before it, and given in a shuffled order; with
+// circles, some also spend later ones in their block
+static int bench_make(bench_set *s, size_t n, int circles)
+{
+    uint32_t *pos = malloc((n + 1)*sizeof(*pos));
+    size_t blocks = n/6 + 1;
+
+    s->n = n;
+    s->txs = calloc(n + 1, sizeof(*s->txs));
+    s->hashes = malloc((n + 1)*32);
+    s->in_hashes = malloc((n + 1)*MAX_INPUTS*32);
+    s->parent = malloc((n + 1)*MAX_INPUTS*sizeof(*s->parent));
+    s->addr = malloc((n + 1)*2*sizeof(*s->addr));
+    s->internal = malloc((n + 1)*sizeof(*s->internal));
+    s->external = malloc((n + 1)*sizeof(*s->external));
+    s->chain_pos = malloc((2*n + 1)*sizeof(*s->chain_pos));
+
+    if (! pos || ! s->txs || ! s->hashes || ! s->in_hashes || ! s->parent || ! s->addr || ! s->internal ||
+        ! s->external || ! s->chain_pos) {
+        free(pos);
+        bench_free(s);
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < n; i++) pos[i] = i, s->internal[i] = i, s->external[i] = (uint32_t)n + i;
+    bench_shuffle(pos, n);
+    bench_shuffle(s->internal, n);
+    bench_shuffle(s->external, n);
+    for (uint32_t i = 0; i < n; i++) s->chain_pos[s->internal[i]] = s->chain_pos[s->external[i]] = i;
+
+    for (size_t g = 0; g < n; g++) {
+        size_t p = pos[g];
+        br_txorder_tx *tx = &s->txs[p];
+        uint8_t *in_hash = s->in_hashes + p*MAX_INPUTS*32;
+
+        bench_hash(s->hashes + p*32, g);
+        tx->hash = s->hashes + p*32;
+        tx->height = (g >= n - n/20) ? UNCONFIRMED : (uint32_t)(1 + g*blocks/n);
+        tx->rank = (bench_rand() % 20 == 0) ? 2 : (bench_rand() % 20 == 0) ? 1 : 0;
+        tx->in_count = 1 + bench_rand() % MAX_INPUTS;
+        tx->in_hash = in_hash;
+
+        for (size_t j = 0; j < tx->in_count; j++) {
+            size_t k = NONE;
+
+            if (g > 0 && bench_rand() % 3 > 0) k = g - 1 - bench_rand() % ((g < 16) ? g : 16);
+            if (circles && bench_rand() % 8 == 0 && g + 4 < n) k = g + 1 + bench_rand() % 3;
+            bench_hash(in_hash + j*32, (k == NONE) ? n + g*MAX_INPUTS + j : k);
+            s->parent[p*MAX_INPUTS + j] = (k == NONE) ? NONE : pos[k];
+        }
+
+        for (size_t o = 0; o < 2; o++) s->addr[p*2 + o] = bench_rand() % (3*n);
+
+        // the position of the first output address found in the internal chain, or else in the external one
+        for (size_t o = 0; o < 4 && ! tx->tie; o++) {
+            uint32_t a = s->addr[p*2 + o % 2];
+
+            if (a < ((o < 2) ? n : 2*n)) tx->tie = 1 + s->chain_pos[a];
+        }
+    }
+
+    free(pos);
+    return 1;
+}
+
+// 1 if transaction a spends transaction b in the same block
+static int bench_spends(const bench_set *s, size_t a, size_t b)
+{
+    if (a == b || s->txs[a].height != s->txs[b].height) return 0;
+
+    for (size_t j = 0; j < s->txs[a].in_count; j++) {
+        if (s->parent[a*MAX_INPUTS + j] == b) return 1;
+    }
+
+    return 0;
+}
+
+// picks, as many times as there are transactions, the best one of the highest block left that nothing left spends
+static void bench_reference(const bench_set *s, size_t *order, int *rank, uint8_t *done)
+{
+    size_t n = s->n, changed = 1;
+
+    for (size_t i = 0; i < n; i++) rank[i] = s->txs[i].rank, done[i] = 0;
+
+    while (changed) { // ranks raised to those of everything they spend in their block, until none changes
+        changed = 0;
+
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < s->txs[i].in_count; j++) {
+                size_t p = s->parent[i*MAX_INPUTS + j];
+
+                if (p != NONE && bench_spends(s, i, p) && rank[p] > rank[i]) rank[i] = rank[p], changed = 1;
+            }
+        }
+    }
+
+    for (size_t k = 0; k < n; k++) {
+        size_t best = NONE;
+        uint32_t height = 0;
+
+        for (size_t i = 0; i < n; i++) if (! done[i] && s->txs[i].height > height) height = s->txs[i].height;
+
+        for (size_t i = 0; i < n; i++) {
+            int ready = (! done[i] && s->txs[i].height == height);
+
+            for (size_t c = 0; ready && c < n; c++) if (! done[c] && bench_spends(s, c, i)) ready = 0;
+            if (! ready) continue;
+
+            if (best == NONE || rank[i] > rank[best] || (rank[i] == rank[best] && (s->txs[i].tie > s->txs[best].tie ||
+                (s->txs[i].tie == s->txs[best].tie && i < best)))) best = i;
+        }
+
+        order[k] = best;
+        done[best] = 1;
+    }
+}
+
+static int bench_check(void)
+{
+    static size_t order[CHECK_TXS], expected[CHECK_TXS];
+    static int rank[CHECK_TXS];
+    static uint8_t seen[CHECK_TXS];
+    bench_set s;
+
+    for (size_t round = 0; round < CHECK_ROUNDS; round++) {
+        int circles = (round % 4 == 3);
+        size_t n = (round == 0) ? 0 : 1 + bench_rand() % CHECK_TXS;
+
+        if (! bench_make(&s, n, circles)) return bench_fail("make", round);
+        if (! br_txorder_sort(s.txs, n, order)) return bench_fail("sort", round);
+        memset(seen, 0, sizeof(seen));
+
+        for (size_t k = 0; k < n; k++) {
+            if (order[k] >= n || seen[order[k]]++) return bench_fail("permutation", round);
+            if (k > 0 && s.txs[order[k]].height > s.txs[order[k - 1]].height) return bench_fail("height", round);
+        }
+
+        if (! circles) {
+            bench_reference(&s, expected, rank, seen);
+
+            for (size_t k = 0; k < n; k++) {
+                if (order[k] != expected[k]) return bench_fail("order", round);
+
+                for (size_t j = 0; j < s.txs[order[k]].in_count; j++) { // what it spends in its block comes later
+                    size_t p = s.parent[order[k]*MAX_INPUTS + j];
+
+                    for (size_t l = 0; p != NONE && bench_spends(&s, order[k], p) && l < k; l++) {
+                        if (order[l] == p) return bench_fail("spend order", round);
+                    }
+                }
+            }
+        }
+
+        bench_free(&s);
+    }
+
+    return 1;
+}
+
+// the position in the chain of the first output address found in it, by scanning the chain like indexOfObject:
+static size_t old_address_index(const bench_set *s, size_t tx, const uint32_t *chain)
+{
+    for (size_t o = 0; o < 2; o++) {
+        for (size_t i = 0; i < s->n; i++) if (chain[i] == s->addr[tx*2 + o]) return i;
+    }
+
+    return NONE;
+}
+
+// isAscending: tx1 spends tx2, or is invalid or pending when tx2 is not, or something it spends is ascending to tx2
+static int old_ascending(const bench_set *s, size_t tx1, size_t tx2)
+{
+    if (tx1 == NONE || tx2 == NONE) return 0;
+    if (s->txs[tx1].height > s->txs[tx2].height) return 1;
+    if (s->txs[tx1].height < s->txs[tx2].height) return 0;
+
+    for (size_t j = 0; j < s->txs[tx1].in_count; j++) { // containsObject: on the input hashes
+        if (memcmp(s->txs[tx1].in_hash + j*32, s->txs[tx2].hash, 32) == 0) return 1;
+    }
+
+    for (size_t j = 0; j < s->txs[tx2].in_count; j++) {
+        if (memcmp(s->txs[tx2].in_hash + j*32, s->txs[tx1].hash, 32) == 0) return 0;
+    }
+
+    if (s->txs[tx1].rank == 2 && s->txs[tx2].rank != 2) return 1;
+    if (s->txs[tx1].rank == 1 && s->txs[tx2].rank != 1) return 1;
+
+    for (size_t j = 0; j < s->txs[tx1].in_count; j++) {
+        if (old_ascending(s, s->parent[tx1*MAX_INPUTS + j], tx2)) return 1;
+    }
+
+    return 0;
+}
+
+static int old_cmp(const bench_set *s, size_t tx1, size_t tx2)
+{
+    size_t i, j;
+
+    if (old_ascending(s, tx1, tx2)) return -1;
+    if (old_ascending(s, tx2, tx1)) return 1;
+    i = old_address_index(s, tx1, s->internal);
+    j = old_address_index(s, tx2, (i == NONE) ? s->external : s->internal);
+    if (i == NONE && j != NONE) i = old_address_index(s, tx1, s->external);
+    if (i == NONE || j == NONE || i == j) return 0;
+    return (i > j) ? -1 : 1;
+}
+
+// the previous sortTransactions: a merge sort of all of them with old_cmp
+static void old_sort(const bench_set *s, size_t *a, size_t *b, size_t n)
+{
+    size_t mid = n/2, i = 0, j = mid, k = 0;
+
+    if (n < 2) return;
+    old_sort(s, a, b, mid);
+    old_sort(s, a + mid, b, n - mid);
+    while (i < mid && j < n) b[k++] = (old_cmp(s, a[j], a[i]) < 0) ? a[j++] : a[i++];
+    while (i < mid) b[k++] = a[i++];
+    while (j < n) b[k++] = a[j++];
+    memcpy(a, b, n*sizeof(*a));
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t counts[] = { 1000, 10000, 100000 };
+
+    if (! bench_check()) return 1;
+    printf("br_txorder: matches the quadratic selection over %d random wallets\n", CHECK_ROUNDS);
+
+    if (argc > 1 && strcmp(argv[1], "-b") == 0) {
+        for (size_t c = 0; c < sizeof(counts)/sizeof(*counts); c++) {
+            size_t n = counts[c], *order = malloc(n*sizeof(*order)), *tmp = malloc(n*sizeof(*tmp));
+            bench_set s;
+            double begin, t_new, t_old = 0;
+
+            if (! order || ! tmp || ! bench_make(&s, n, 0)) return 1;
+            begin = gettimedouble();
+            if (! br_txorder_sort(s.txs, n, order)) return 1;
+            t_new = gettimedouble() - begin;
+
+            if (n <= OLD_MAX_TXS) {
+                for (size_t i = 0; i < n; i++) order[i] = i;
+                begin = gettimedouble();
+                old_sort(&s, order, tmp, n);
+                t_old = gettimedouble() - begin;
+                printf("%6zu txs: %8.2f ms, previous sort %9.2f ms\n", n, t_new*1e3, t_old*1e3);
+            }
+            else printf("%6zu txs: %8.2f ms\n", n, t_new*1e3);
+
+            bench_free(&s);
+            free(order);
+            free(tmp);
+        }
+    }
+
+    return 0;
+}
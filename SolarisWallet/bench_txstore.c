@@ -0,0 +1,327 @@
+//
+//  bench_txstore.c
+//  SolarisWallet
+//
+//  Checks BRTxStore.c against plain arrays, and measures its memory and lookup times with -b.
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRTxStore.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_NAME "bench_txstore"
+#define BENCH_SEED 0x9e3779b9u
+#include "bench.h"
+
+#define CHECK_TXS      3000
+#define CHECK_OUTPUTS  4
+#define BENCH_LOOKUPS  1000000
+
+// hashes of transaction i; below CHECK_TXS every 16th shares its first and last 8 bytes with all the others like it,
+// which puts them in the same probe sequence
+static void bench_hash(uint8_t *hash, size_t i)
+{
+    uint64_t x = i*0x2545f4914f6cdd1dull + 1;
+
+    for (size_t j = 0; j < 32; j++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        hash[j] = (uint8_t)(x >> 24);
+    }
+
+    if (i < CHECK_TXS && i % 16 == 5) memset(hash, 0xab, 8), memset(hash + 24, 0xcd, 8);
+}
+
+static int _released[CHECK_TXS*2], _expected[CHECK_TXS*2];
+
+static void bench_release(void *tx)
+{
+    _released[(size_t)tx - 1]++;
+}
+
+static int bench_check_store(void)
+{
+    static uint8_t hashes[CHECK_TXS][32];
+    static size_t stored[CHECK_TXS], list[CHECK_TXS]; // 0 or tx pointer, and the listed indexes
+    static size_t moved[CHECK_TXS], order[CHECK_TXS];
+    static uint32_t heights[CHECK_TXS];
+    br_txstore *s = br_txstore_new(bench_release);
+    size_t count = 0, listed = 0, tx = 0;
+
+    if (! s) return 0;
+    for (size_t i = 0; i < CHECK_TXS; i++) bench_hash(hashes[i], i);
+
+    for (size_t round = 0; round < 40000; round++) {
+        size_t i = bench_rand() % CHECK_TXS, op = bench_rand() % 8, k;
+
+        if (op < 3) { // put, replacing and releasing what was there
+            if (! br_txstore_put(s, hashes[i], (void *)(++tx % (CHECK_TXS*2) + 1), heights[i] = bench_rand() % 8)) {
+                return bench_fail("put", round);
+            }
+
+            if (stored[i]) _expected[stored[i] - 1]++;
+            else count++;
+            stored[i] = tx % (CHECK_TXS*2) + 1;
+        }
+        else if (op == 3) {
+            if (br_txstore_remove(s, hashes[i]) != (stored[i] != 0)) return bench_fail("remove", round);
+            if (stored[i]) _expected[stored[i] - 1]++, count--;
+            stored[i] = 0;
+
+            for (k = 0; k < listed && list[k] != i; k++);
+            if (k < listed) memmove(list + k, list + k + 1, (--listed - k)*sizeof(*list));
+        }
+        else if (op < 6) {
+            for (k = 0; k < listed && list[k] != i; k++);
+            size_t at = (op == 4) ? 0 : bench_rand() % (listed + 1);
+
+            if (br_txstore_list_insert(s, hashes[i], at) != (stored[i] && k == listed)) {
+                return bench_fail("list insert", round);
+            }
+
+            if (stored[i] && k == listed) {
+                memmove(list + at + 1, list + at, (listed++ - at)*sizeof(*list));
+                list[at] = i;
+            }
+        }
+        else if (op == 6) {
+            for (k = 0; k < listed && list[k] != i; k++);
+            if (br_txstore_list_remove(s, hashes[i]) != (k < listed)) return bench_fail("list remove", round);
+            if (k < listed) memmove(list + k, list + k + 1, (--listed - k)*sizeof(*list));
+        }
+        else if (bench_rand() % 64 == 0) { // reorder by a random permutation
+            for (k = 0; k < listed; k++) order[k] = k;
+
+            for (k = listed; k > 1; k--) {
+                size_t j = bench_rand() % k, t = order[k - 1];
+
+                order[k - 1] = order[j];
+                order[j] = t;
+            }
+
+            for (k = 0; k < listed; k++) moved[k] = list[order[k]];
+            memcpy(list, moved, listed*sizeof(*list));
+            if (! br_txstore_list_reorder(s, order)) return bench_fail("reorder", round);
+        }
+        else if (br_txstore_set_height(s, hashes[i], bench_rand() % 8 + 1) != (stored[i] != 0)) {
+            return bench_fail("set height", round);
+        }
+        else if (stored[i]) heights[i] = br_txstore_height(s, hashes[i]);
+
+        if (br_txstore_count(s) != count || br_txstore_list_count(s) != listed) return bench_fail("count", round);
+    }
+
+    for (size_t i = 0; i < CHECK_TXS; i++) {
+        if ((size_t)br_txstore_get(s, hashes[i]) != stored[i]) return bench_fail("get", i);
+        if (stored[i] && br_txstore_height(s, hashes[i]) != heights[i]) return bench_fail("height", i);
+        if (stored[i]) _expected[stored[i] - 1]++;
+    }
+
+    for (size_t k = 0; k < listed; k++) {
+        if ((size_t)br_txstore_list_get(s, k) != stored[list[k]]) return bench_fail("list order", k);
+        if (memcmp(br_txstore_list_hash(s, k), hashes[list[k]], 32) != 0) return bench_fail("list hash", k);
+        if (br_txstore_list_index(s, hashes[list[k]]) != k) return bench_fail("list index", k);
+    }
+
+    br_txstore_free(s);
+
+    for (size_t i = 0; i < CHECK_TXS*2; i++) { // every pointer released once each time the store let go of it
+        if (_released[i] != _expected[i]) return bench_fail("release", i);
+    }
+
+    return 1;
+}
+
+static int bench_check_outset(void)
+{
+    static uint8_t hashes[CHECK_TXS][32];
+    static uint32_t order[CHECK_TXS*CHECK_OUTPUTS]; // the live outpoints, oldest first, as i*CHECK_OUTPUTS + n
+    static int in[CHECK_TXS*CHECK_OUTPUTS];
+    br_outset *o = br_outset_new();
+    size_t live = 0;
+
+    if (! o) return 0;
+    for (size_t i = 0; i < CHECK_TXS; i++) bench_hash(hashes[i], i);
+
+    for (size_t round = 0; round < 100000; round++) {
+        size_t i = bench_rand() % CHECK_TXS, n = bench_rand() % CHECK_OUTPUTS, p = i*CHECK_OUTPUTS + n, k;
+
+        if (round % 30011 == 30010) { // empty it now and then
+            br_outset_clear(o);
+            memset(in, 0, sizeof(in));
+            live = 0;
+        }
+        else if (bench_rand() % 3) {
+            if (! br_outset_add(o, hashes[i], (uint32_t)n)) return bench_fail("add", round);
+            if (! in[p]) order[live++] = (uint32_t)p;
+            in[p] = 1;
+        }
+        else {
+            if (br_outset_remove(o, hashes[i], (uint32_t)n) != in[p]) return bench_fail("remove", round);
+            for (k = 0; in[p] && order[k] != p; k++);
+            if (in[p]) memmove(order + k, order + k + 1, (--live - k)*sizeof(*order));
+            in[p] = 0;
+        }
+
+        if (br_outset_count(o) != live) return bench_fail("count", round);
+
+        if (round % 5000 == 0) { // iterate, removing every third outpoint on the way
+            const uint8_t *key;
+            size_t it = 0, k2 = 0, j = 0;
+
+            while ((key = br_outset_next(o, &it))) {
+                uint32_t q = order[k2];
+                uint32_t idx = key[32] | ((uint32_t)key[33] << 8) | ((uint32_t)key[34] << 16) |
+                               ((uint32_t)key[35] << 24);
+
+                if (memcmp(key, hashes[q/CHECK_OUTPUTS], 32) != 0 || idx != q % CHECK_OUTPUTS) {
+                    return bench_fail("iteration order", round);
+                }
+
+                if (k2++ % 3 == 0) {
+                    if (! br_outset_remove(o, key, idx)) return bench_fail("remove while iterating", round);
+                    in[q] = 0;
+                }
+                else order[j++] = q;
+            }
+
+            if (k2 != live) return bench_fail("iteration count", round);
+            live = j;
+        }
+    }
+
+    for (size_t p = 0; p < CHECK_TXS*CHECK_OUTPUTS; p++) {
+        if (br_outset_contains(o, hashes[p/CHECK_OUTPUTS], (uint32_t)(p % CHECK_OUTPUTS)) != in[p]) {
+            return bench_fail("contains", p);
+        }
+    }
+
+    br_outset_free(o);
+    return 1;
+}
+
+static int bench_check_addrset(void)
+{
+    static uint8_t h160s[CHECK_TXS][32];
+    static uint32_t values[CHECK_TXS*2]; // by i*2 + type - 1, UINT32_MAX while not in the set
+    br_addrset *a = br_addrset_new();
+    size_t count = 0;
+
+    if (! a) return 0;
+
+    for (size_t i = 0; i < CHECK_TXS; i++) { // the first 20 bytes of a hash, those bench_hash() makes alike as well
+        bench_hash(h160s[i], i);
+        if (i % 16 == 5) memset(h160s[i], 0xab, 8), memset(h160s[i] + 12, 0xcd, 8);
+    }
+
+    for (size_t p = 0; p < CHECK_TXS*2; p++) values[p] = UINT32_MAX;
+
+    for (size_t round = 0; round < 20000; round++) {
+        size_t p = (bench_rand() % CHECK_TXS)*2 + bench_rand() % 2;
+        uint32_t v = bench_rand() % 0x40000000u;
+
+        if (! br_addrset_add(a, (uint8_t)(p % 2 + 1), h160s[p/2], v)) return bench_fail("add", round);
+        if (values[p] == UINT32_MAX) values[p] = v, count++;
+        if (br_addrset_count(a) != count) return bench_fail("address count", round);
+        p = (bench_rand() % CHECK_TXS)*2 + bench_rand() % 2;
+        if (br_addrset_get(a, (uint8_t)(p % 2 + 1), h160s[p/2]) != values[p]) return bench_fail("get", round);
+    }
+
+    for (size_t p = 0; p < CHECK_TXS*2; p++) {
+        if (br_addrset_contains(a, (uint8_t)(p % 2 + 1), h160s[p/2]) != (values[p] != UINT32_MAX)) {
+            return bench_fail("address contains", p);
+        }
+
+        if (br_addrset_contains(a, 3, h160s[p/2])) return bench_fail("address of another type", p);
+    }
+
+    br_addrset_free(a);
+    return 1;
+}
+
+static void bench_nop(void *tx)
+{
+    (void)tx;
+}
+
+int main(int argc, char **argv)
+{
+    static const size_t counts[] = { 10000, 50000, 200000 };
+
+    if (! bench_check_store() || ! bench_check_outset() || ! bench_check_addrset()) return 1;
+    printf("br_txstore, br_outset, br_addrset: agree with plain arrays under random operations\n");
+
+    if (argc > 1 && strcmp(argv[1], "-b") == 0) {
+        for (size_t c = 0; c < sizeof(counts)/sizeof(*counts); c++) {
+            size_t n = counts[c], found = 0;
+            uint8_t (*hashes)[32] = malloc(2*n*32);
+            br_txstore *s = br_txstore_new(bench_nop);
+            br_outset *utxos = br_outset_new();
+            br_addrset *addrs = br_addrset_new();
+            double begin, t_hit, t_miss, t_out, t_addr;
+
+            if (! hashes || ! s || ! utxos || ! addrs) return 1;
+            for (size_t i = 0; i < 2*n; i++) bench_hash(hashes[i], i + CHECK_TXS);
+
+            for (size_t i = 0; i < n; i++) {
+                if (! br_txstore_put(s, hashes[i], (void *)(i + 1), (uint32_t)(i/4)) ||
+                    ! br_txstore_list_insert(s, hashes[i], 0) || ! br_outset_add(utxos, hashes[i], 0) ||
+                    ! br_outset_add(utxos, hashes[i], 1) || ! br_addrset_add(addrs, 1, hashes[i] + 4, 0)) return 1;
+            }
+
+            begin = gettimedouble();
+            for (size_t k = 0; k < BENCH_LOOKUPS; k++) found += (br_txstore_get(s, hashes[bench_rand() % n]) != NULL);
+            t_hit = gettimedouble() - begin;
+            begin = gettimedouble();
+            for (size_t k = 0; k < BENCH_LOOKUPS; k++) found += (br_txstore_get(s, hashes[n + bench_rand() % n]) != 0);
+            t_miss = gettimedouble() - begin;
+            begin = gettimedouble();
+
+            for (size_t k = 0; k < BENCH_LOOKUPS; k++) {
+                found += br_outset_contains(utxos, hashes[bench_rand() % (2*n)], bench_rand() % 2);
+            }
+
+            t_out = gettimedouble() - begin;
+            begin = gettimedouble();
+
+            for (size_t k = 0; k < BENCH_LOOKUPS; k++) {
+                found += br_addrset_contains(addrs, 1, hashes[bench_rand() % (2*n)] + 4);
+            }
+
+            t_addr = gettimedouble() - begin;
+            printf("%6zu txs: %5.1f bytes/tx in the store, %5.1f bytes/outpoint and %5.1f bytes/address in a set; "
+                   "lookups %5.1f ns hit, %5.1f ns miss, %5.1f ns outpoint, %5.1f ns address (%zu found)\n", n,
+                   (double)br_txstore_memory(s)/n, (double)br_outset_memory(utxos)/(2*n),
+                   (double)br_addrset_memory(addrs)/n, t_hit*1e9/BENCH_LOOKUPS, t_miss*1e9/BENCH_LOOKUPS,
+                   t_out*1e9/BENCH_LOOKUPS, t_addr*1e9/BENCH_LOOKUPS, found);
+            br_addrset_free(addrs);
+            br_outset_free(utxos);
+            br_txstore_free(s);
+            free(hashes);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,394 @@
+//
+//  bench_xevan.c
+//  SolarisWallet
+//
+//  Checks the xevan chain against xevan_kat.txt, and times it.
+//
+//  usage: bench_xevan [-k] [kat file] [threads]
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "xevan.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#define BENCH_NAME "bench_xevan"
+#include "bench.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAVE_CYCLES 1
+#endif
+
+#define BENCH_ITERS 2000
+#define BENCH_BATCH 2000 // headers in a full headers message
+#define BENCH_STAGE_ITERS 20000
+#define BENCH_KAT_MAX 1024
+
+typedef struct {
+    unsigned char header[XEVAN_HEADER_LEN_V4];
+    size_t len;
+    unsigned threads;
+    xevan_ctx scratch;
+    unsigned char out[32];
+    unsigned char batch[BENCH_BATCH*XEVAN_HEADER_LEN_V4];
+    size_t stride;
+    unsigned char batch_out[BENCH_BATCH*32];
+} bench_xevan_t;
+
+typedef struct {
+    unsigned char header[XEVAN_HEADER_LEN_V4];
+    size_t len;
+    unsigned char hash[32];
+} bench_kat_t;
+
+static void run_benchmark(const char *name, void (*benchmark)(bench_xevan_t *), bench_xevan_t *data, int count)
+{
+    double min = HUGE_VAL, sum = 0.0, max = 0.0;
+
+    for (int i = 0; i < count; i++) {
+        double begin = gettimedouble(), total;
+
+        benchmark(data);
+        total = gettimedouble() - begin;
+        if (total < min) min = total;
+        if (total > max) max = total;
+        sum += total;
+    }
+
+    printf("%s (%zu bytes): min %.2fus / avg %.2fus / max %.2fus / %.0f hashes/s\n", name, data->len,
+           min*1000000.0/BENCH_ITERS, (sum/count)*1000000.0/BENCH_ITERS, max*1000000.0/BENCH_ITERS,
+           BENCH_ITERS/(sum/count));
+}
+
+static int hex_decode(unsigned char *out, size_t max, const char *hex, size_t *len)
+{
+    size_t n = strlen(hex);
+
+    if (n % 2 != 0 || n/2 > max) return 0;
+
+    for (size_t i = 0; i < n/2; i++) {
+        unsigned int b;
+
+        if (sscanf(hex + i*2, "%2x", &b) != 1) return 0;
+        out[i] = (unsigned char)b;
+    }
+
+    *len = n/2;
+    return 1;
+}
+
+// reads "<header hex> <hash hex>" lines, skipping blank lines and # comments, returns the vector count or -1
+static int kat_load(const char *path, bench_kat_t *kat, int max)
+{
+    FILE *f = fopen(path, "r");
+    char line[1024], header[512], hash[128];
+    int n = 0;
+
+    if (! f) {
+        fprintf(stderr, "bench_xevan: cannot open %s\n", path);
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), f)) {
+        size_t hash_len;
+
+        if (line[0] == '#' || line[0] == '\n') continue;
+
+        if (n == max || sscanf(line, "%511s %127s", header, hash) != 2 ||
+            ! hex_decode(kat[n].header, sizeof(kat[n].header), header, &kat[n].len) ||
+            (kat[n].len != XEVAN_HEADER_LEN && kat[n].len != XEVAN_HEADER_LEN_V4) ||
+            ! hex_decode(kat[n].hash, sizeof(kat[n].hash), hash, &hash_len) || hash_len != 32) {
+            fprintf(stderr, "bench_xevan: bad vector at %s entry %d\n", path, n);
+            fclose(f);
+            return -1;
+        }
+
+        n++;
+    }
+
+    fclose(f);
+    return n;
+}
+
+static int kat_compare(const char *name, int i, const unsigned char *got, const unsigned char *want)
+{
+    if (memcmp(got, want, 32) == 0) return 1;
+    fprintf(stderr, "bench_xevan: %s mismatch on vector %d\n", name, i);
+    return 0;
+}
+
+// the vector hash, read as a little-endian 256 bit number, has to be at or below the compact nBits target at offset 72
+// of its header, decoded as in BRMerkleBlock -isValid
+static int kat_target(int i, const bench_kat_t *kat)
+{
+    const unsigned char *b = &kat->header[72];
+    uint32_t bits = b[0] | (uint32_t)b[1] << 8 | (uint32_t)b[2] << 16 | (uint32_t)b[3] << 24;
+    uint32_t size = bits >> 24, target = bits & 0x00ffffffu;
+    unsigned char t[32] = { 0 };
+
+    if (target == 0 || (target & 0x00800000u) || size > 32) {
+        fprintf(stderr, "bench_xevan: vector %d has an invalid nBits %08x\n", i, bits);
+        return 0;
+    }
+
+    for (uint32_t j = 0; j < 3; j++) {
+        if (size + j >= 3) t[size + j - 3] = (unsigned char)(target >> j*8);
+    }
+
+    for (int j = 31; j >= 0; j--) {
+        if (kat->hash[j] < t[j]) return 1;
+        if (kat->hash[j] > t[j]) break;
+        if (j == 0) return 1;
+    }
+
+    fprintf(stderr, "bench_xevan: vector %d does not meet its nBits target %08x\n", i, bits);
+    return 0;
+}
+
+// every vector has to meet its target and every entry point has to reproduce it, the batch paths with the vectors in a
+// headers message layout
+static int kat_check(const bench_kat_t *kat, int n, unsigned threads)
+{
+    static unsigned char batch[BENCH_KAT_MAX*XEVAN_HEADER_LEN_V4], out[BENCH_KAT_MAX*32];
+    unsigned char hash[32];
+    xevan_ctx scratch;
+    int ok = 1;
+
+    for (int i = 0; i < n; i++) {
+        ok &= kat_target(i, &kat[i]);
+        xevan_hash((const char *)kat[i].header, (char *)hash, (kat[i].len == XEVAN_HEADER_LEN_V4) ? 4 : 3);
+        ok &= kat_compare("xevan_hash", i, hash, kat[i].hash);
+        xevan_hash_ctx(&scratch, kat[i].header, kat[i].len, hash);
+        ok &= kat_compare("xevan_hash_ctx", i, hash, kat[i].hash);
+        ok &= kat_compare("xevan_header", i, xevan_header(kat[i].header, kat[i].len).u8, kat[i].hash);
+        memcpy(&batch[i*XEVAN_HEADER_LEN_V4], kat[i].header, XEVAN_HEADER_LEN_V4);
+    }
+
+    xevan_hash_many(batch, XEVAN_HEADER_LEN_V4, (size_t)n, out);
+    for (int i = 0; i < n; i++) ok &= kat_compare("xevan_hash_many", i, &out[i*32], kat[i].hash);
+
+    memset(out, 0, sizeof(out));
+    xevan_hash_many_mt(batch, XEVAN_HEADER_LEN_V4, (size_t)n, out, threads);
+    for (int i = 0; i < n; i++) ok &= kat_compare("xevan_hash_many_mt", i, &out[i*32], kat[i].hash);
+
+    // first pass fills the cache, the second one (and xevan_header_cached) must answer from it
+    for (int pass = 0; pass < 2; pass++) {
+        memset(out, 0, sizeof(out));
+        xevan_hash_many_cached(batch, XEVAN_HEADER_LEN_V4, (size_t)n, out, threads);
+        for (int i = 0; i < n; i++) ok &= kat_compare("xevan_hash_many_cached", i, &out[i*32], kat[i].hash);
+    }
+
+    for (int i = 0; i < n; i++) {
+        ok &= kat_compare("xevan_header_cached", i, xevan_header_cached(kat[i].header, kat[i].len).u8, kat[i].hash);
+    }
+
+    return ok;
+}
+
+typedef struct {
+    const char *name;
+    size_t offset;
+    void (*update)(void *cc, const void *data, size_t len);
+    void (*close)(void *cc, void *dst);
+} bench_stage;
+
+#define BENCH_STAGE(ctx, name) { #name, offsetof(xevan_ctx, ctx), sph_##name, sph_##name##_close }
+
+// the 17 primitives of the chain, each timed alone over the 128 byte input every stage but the first one sees
+static const bench_stage bench_stages[] = {
+    BENCH_STAGE(blake1, blake512),
+    BENCH_STAGE(bmw1, bmw512),
+    BENCH_STAGE(groestl1, groestl512),
+    BENCH_STAGE(skein1, skein512),
+    BENCH_STAGE(jh1, jh512),
+    BENCH_STAGE(keccak1, keccak512),
+    BENCH_STAGE(luffa1, luffa512),
+    BENCH_STAGE(cubehash1, cubehash512),
+    BENCH_STAGE(shavite1, shavite512),
+    BENCH_STAGE(simd1, simd512),
+    BENCH_STAGE(echo1, echo512),
+    BENCH_STAGE(hamsi1, hamsi512),
+    BENCH_STAGE(fugue1, fugue512),
+    BENCH_STAGE(shabal1, shabal512),
+    BENCH_STAGE(whirlpool1, whirlpool),
+    BENCH_STAGE(sha512, sha512),
+    BENCH_STAGE(haval1, haval256_5),
+};
+
+static void bench_stages_run(bench_xevan_t *data)
+{
+    unsigned char hash[128];
+
+    memcpy(&data->scratch, xevan_ctx_base(), sizeof(data->scratch));
+    for (size_t i = 0; i < sizeof(hash); i++) hash[i] = (unsigned char)(i*11 + 3);
+
+    for (size_t s = 0; s < sizeof(bench_stages)/sizeof(*bench_stages); s++) {
+        const bench_stage *stage = &bench_stages[s];
+        void *cc = (char *)&data->scratch + stage->offset;
+        double begin = gettimedouble(), total;
+#if BENCH_HAVE_CYCLES
+        unsigned long long cycles = __rdtsc();
+#endif
+
+        for (int i = 0; i < BENCH_STAGE_ITERS; i++) {
+            stage->update(cc, hash, sizeof(hash));
+            stage->close(cc, hash);
+        }
+
+        total = gettimedouble() - begin;
+#if BENCH_HAVE_CYCLES
+        cycles = __rdtsc() - cycles;
+        printf("stage %-11s: %6.2f cycles/byte / %6.2f ns/byte\n", stage->name,
+               (double)cycles/BENCH_STAGE_ITERS/sizeof(hash), total*1e9/BENCH_STAGE_ITERS/sizeof(hash));
+#else
+        printf("stage %-11s: %6.2f ns/byte\n", stage->name, total*1e9/BENCH_STAGE_ITERS/sizeof(hash));
+#endif
+    }
+}
+
+// the pre-xevan_ctx behaviour: every hash re-ran all 17 sph inits before starting the chain
+static void bench_reinit(bench_xevan_t *data)
+{
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        xevan_ctx *c = &data->scratch;
+
+        sph_blake512_init(&c->blake1);
+        sph_bmw512_init(&c->bmw1);
+        sph_groestl512_init(&c->groestl1);
+        sph_skein512_init(&c->skein1);
+        sph_jh512_init(&c->jh1);
+        sph_keccak512_init(&c->keccak1);
+        sph_luffa512_init(&c->luffa1);
+        sph_cubehash512_init(&c->cubehash1);
+        sph_shavite512_init(&c->shavite1);
+        sph_simd512_init(&c->simd1);
+        sph_echo512_init(&c->echo1);
+        sph_hamsi512_init(&c->hamsi1);
+        sph_fugue512_init(&c->fugue1);
+        sph_shabal512_init(&c->shabal1);
+        sph_whirlpool_init(&c->whirlpool1);
+        sph_sha512_init(&c->sha512);
+        sph_haval256_5_init(&c->haval1);
+        xevan_hash_ctx(&data->scratch, data->header, data->len, data->out);
+        data->header[i % data->len] ^= data->out[0];
+    }
+}
+
+static void bench_hash(bench_xevan_t *data)
+{
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        xevan_hash((const char *)data->header, (char *)data->out,
+                   (data->len == XEVAN_HEADER_LEN_V4) ? 4 : 3);
+        data->header[i % data->len] ^= data->out[0];
+    }
+}
+
+static void bench_hash_ctx(bench_xevan_t *data)
+{
+    for (int i = 0; i < BENCH_ITERS; i++) {
+        xevan_hash_ctx(&data->scratch, data->header, data->len, data->out);
+        data->header[i % data->len] ^= data->out[0];
+    }
+}
+
+static void bench_batch_single(bench_xevan_t *data)
+{
+    for (int i = 0; i < BENCH_BATCH; i++) {
+        xevan_hash((const char *)&data->batch[i*data->stride], (char *)&data->batch_out[i*32],
+                   (data->len == XEVAN_HEADER_LEN_V4) ? 4 : 3);
+    }
+}
+
+static void bench_batch_many(bench_xevan_t *data)
+{
+    xevan_hash_many(data->batch, data->stride, BENCH_BATCH, data->batch_out);
+}
+
+static void bench_batch_many_mt(bench_xevan_t *data)
+{
+    xevan_hash_many_mt(data->batch, data->stride, BENCH_BATCH, data->batch_out, data->threads);
+}
+
+int main(int argc, char **argv)
+{
+    static bench_xevan_t data;
+    static bench_kat_t kat[BENCH_KAT_MAX];
+    size_t lens[] = { XEVAN_HEADER_LEN, XEVAN_HEADER_LEN_V4 };
+    const char *kat_path = "xevan_kat.txt";
+    int kat_only = 0, n;
+    uint64_t hits, misses;
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    char name[64];
+
+    data.threads = (cpus > 0) ? (unsigned)cpus : 1;
+    if (argc > 1 && strcmp(argv[1], "-k") == 0) {
+        kat_only = 1;
+        argc--;
+        argv++;
+    }
+
+    if (argc > 1) kat_path = argv[1];
+    if (argc > 2) data.threads = (unsigned)atoi(argv[2]);
+
+    n = kat_load(kat_path, kat, BENCH_KAT_MAX);
+    if (n < 0) return 1;
+    if (! kat_check(kat, n, data.threads)) return 1;
+    xevan_cache_stats(&hits, &misses);
+    printf("kat: %d vectors ok, header hash cache %llu hits / %llu misses\n", n, (unsigned long long)hits,
+           (unsigned long long)misses);
+    if (kat_only) return 0;
+
+    data.len = 128;
+    bench_stages_run(&data);
+
+    for (size_t i = 0; i < sizeof(data.header); i++) data.header[i] = (unsigned char)(i*7 + 1);
+
+    for (size_t i = 0; i < sizeof(lens)/sizeof(*lens); i++) {
+        data.len = lens[i];
+        run_benchmark("xevan_reinit", bench_reinit, &data, 10);
+        run_benchmark("xevan_hash", bench_hash, &data, 10);
+        run_benchmark("xevan_hash_ctx", bench_hash_ctx, &data, 10);
+    }
+
+    // per-header figures for a 2000 header message, run_benchmark divides by BENCH_ITERS == BENCH_BATCH
+    for (size_t i = 0; i < sizeof(lens)/sizeof(*lens); i++) {
+        data.len = lens[i];
+        data.stride = (data.len == XEVAN_HEADER_LEN) ? XEVAN_HEADER_LEN + 1 : XEVAN_HEADER_LEN_V4; // header and tx count, as in a headers message
+
+        for (size_t j = 0; j < sizeof(data.batch); j++) data.batch[j] = (unsigned char)(j*13 + 5);
+        for (size_t j = 0; j < BENCH_BATCH; j++) {
+            memset(&data.batch[j*data.stride], 0, 4);
+            data.batch[j*data.stride] = (data.len == XEVAN_HEADER_LEN_V4) ? 4 : 3;
+        }
+
+        run_benchmark("batch_xevan_hash", bench_batch_single, &data, 5);
+        run_benchmark("batch_xevan_hash_many", bench_batch_many, &data, 5);
+        snprintf(name, sizeof(name), "batch_xevan_hash_many_mt%u", data.threads);
+        run_benchmark(name, bench_batch_many_mt, &data, 5);
+    }
+
+    return 0;
+}
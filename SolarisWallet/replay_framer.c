@@ -0,0 +1,315 @@
+//
+//  replay_framer.c
+//  SolarisWallet
+//
+//  Replays captured peer byte streams through BRMessageFramer in chunks of several sizes, or a
+//  generated stream with bad headers when given none.
+//
+//  usage: replay_framer [capture file...]
+//
+//  Copyright (c) 2018 Aaron Voisine <voisine@gmail.com>
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+
+#include "BRMessageFramer.h"
+#include "sph/sph_sha2.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REPLAY_MAGIC 0xa1012102 // DASH_MAGIC_NUMBER
+#define REPLAY_MAX_EVENTS 4096
+
+typedef struct {
+    int status;
+    char type[BR_FRAMER_TYPE_LENGTH + 1];
+    uint32_t length;
+    uint8_t digest[4]; // first bytes of sha256 over the payload the framer handed out
+} replay_event;
+
+typedef struct {
+    replay_event event[REPLAY_MAX_EVENTS];
+    size_t count;
+    uint64_t skipped;
+    size_t copied; // payloads br_framer_detach() did not hand over as the block they were read into, or lost
+} replay_log;
+
+// read is where the last input bytes were written to
+static void replay_drain(br_framer *framer, replay_log *log, const uint8_t *read)
+{
+    br_message msg;
+    br_framer_status status;
+
+    while ((status = br_framer_next(framer, &msg)) != BR_FRAMER_NEED_MORE) {
+        replay_event *e = &log->event[log->count < REPLAY_MAX_EVENTS ? log->count : REPLAY_MAX_EVENTS - 1];
+        sph_sha256_context sha;
+        uint8_t hash[32];
+
+        memset(e, 0, sizeof(*e));
+        e->status = status;
+        memcpy(e->type, msg.type, sizeof(e->type));
+        e->length = msg.length;
+
+        if (status == BR_FRAMER_MESSAGE) {
+            uint8_t *payload = br_framer_detach(framer);
+
+            sph_sha256_init(&sha);
+            sph_sha256(&sha, msg.payload, msg.length);
+            sph_sha256_close(&sha, hash);
+            memcpy(e->digest, hash, sizeof(e->digest));
+
+            if (msg.length >= BR_FRAMER_DETACH_LENGTH) {
+                if (payload != msg.payload || read < payload || read >= payload + msg.length) log->copied++;
+            }
+            else if (msg.length > 0 && (! payload || memcmp(payload, msg.payload, msg.length) != 0)) log->copied++;
+
+            free(payload);
+        }
+
+        if (log->count < REPLAY_MAX_EVENTS) log->count++;
+    }
+}
+
+// frames len bytes handed to the framer chunk bytes at a time, read straight into its buffer like BRPeer does
+static int replay(const uint8_t *data, size_t len, size_t chunk, replay_log *log)
+{
+    br_framer *framer = br_framer_new(REPLAY_MAGIC);
+    size_t off = 0;
+
+    if (! framer) return 0;
+    memset(log, 0, sizeof(*log));
+
+    while (off < len) {
+        size_t space = 0, l;
+        uint8_t *buf = br_framer_buffer(framer, &space);
+
+        if (! buf) {
+            br_framer_free(framer);
+            return 0;
+        }
+
+        l = len - off;
+        if (l > chunk) l = chunk;
+        if (l > space) l = space;
+        memcpy(buf, data + off, l);
+        br_framer_commit(framer, l);
+        off += l;
+        replay_drain(framer, log, buf);
+    }
+
+    log->skipped = br_framer_skipped(framer);
+    br_framer_free(framer);
+    return 1;
+}
+
+static int replay_compare(const char *name, size_t chunk, const replay_log *got, const replay_log *want)
+{
+    if (got->copied > 0) {
+        fprintf(stderr, "replay_framer: %s: %zu payloads copied in %zu byte chunks\n", name, got->copied, chunk);
+        return 0;
+    }
+
+    if (got->count == want->count && got->skipped == want->skipped &&
+        memcmp(got->event, want->event, got->count*sizeof(*got->event)) == 0) return 1;
+    fprintf(stderr, "replay_framer: %s framed differently in %zu byte chunks\n", name, chunk);
+    return 0;
+}
+
+static void replay_print(const char *name, const replay_log *log)
+{
+    size_t messages = 0, errors = 0;
+
+    for (size_t i = 0; i < log->count; i++) {
+        if (log->event[i].status == BR_FRAMER_MESSAGE) messages++;
+        else errors++;
+    }
+
+    printf("%s: %zu messages, %zu bad headers or checksums, %llu bytes skipped\n", name, messages, errors,
+           (unsigned long long)log->skipped);
+}
+
+static int replay_check(const char *name, const uint8_t *data, size_t len, replay_log *whole)
+{
+    static const size_t chunks[] = { 1, 7, 1460, 65536 };
+    static replay_log log;
+    int ok = replay(data, len, len ? len : 1, whole) && replay_compare(name, len, whole, whole);
+
+    for (size_t i = 0; ok && i < sizeof(chunks)/sizeof(*chunks); i++) {
+        ok = replay(data, len, chunks[i], &log) && replay_compare(name, chunks[i], &log, whole);
+    }
+
+    return ok;
+}
+
+static size_t append_message(uint8_t *out, const char *type, const uint8_t *payload, uint32_t length, int corrupt)
+{
+    sph_sha256_context sha;
+    uint8_t hash[32];
+
+    sph_sha256_init(&sha);
+    sph_sha256(&sha, payload, length);
+    sph_sha256_close(&sha, hash);
+    sph_sha256(&sha, hash, sizeof(hash));
+    sph_sha256_close(&sha, hash);
+
+    sph_enc32le(out, REPLAY_MAGIC);
+    memset(out + 4, 0, BR_FRAMER_TYPE_LENGTH);
+    memcpy(out + 4, type, strlen(type));
+    sph_enc32le(out + 16, length);
+    memcpy(out + 20, hash, 4);
+    if (corrupt) out[20] ^= 1;
+    memcpy(out + BR_FRAMER_HEADER_LENGTH, payload, length);
+    return BR_FRAMER_HEADER_LENGTH + length;
+}
+
+// version, junk with a split magic number, a 2 MiB headers message, a bad checksum, an oversized length, an
+// unterminated type, verack
+static int replay_synthetic(void)
+{
+    static const int expect[] = { BR_FRAMER_MESSAGE, BR_FRAMER_MESSAGE, BR_FRAMER_ERROR_CHECKSUM,
+                                  BR_FRAMER_ERROR_LENGTH, BR_FRAMER_ERROR_HEADER, BR_FRAMER_MESSAGE };
+    static const char *types[] = { "version", "headers", "inv", "block", "", "verack" };
+    size_t big = 2*1024*1024, len = 0, junk = 0;
+    uint8_t *payload = malloc(big), *stream = malloc(big + 4096);
+    replay_log *log = malloc(sizeof(*log));
+    int ok = (payload && stream && log);
+
+    if (ok) {
+        for (size_t i = 0; i < big; i++) payload[i] = (uint8_t)(i*2654435761u >> 13);
+        len += append_message(stream + len, "version", payload, 105, 0);
+        memcpy(stream + len, "\x02\x21\x01junk\x02\x21", 9); // partial magic numbers, then junk
+        len += 9;
+        junk += 9;
+        len += append_message(stream + len, "headers", payload, (uint32_t)big, 0);
+        len += append_message(stream + len, "inv", payload, 37, 1);
+        sph_enc32le(stream + len, REPLAY_MAGIC);
+        memset(stream + len + 4, 0, 20);
+        memcpy(stream + len + 4, "block", 5);
+        sph_enc32le(stream + len + 16, BR_FRAMER_MAX_MSG_LENGTH + 1);
+        len += BR_FRAMER_HEADER_LENGTH;
+        sph_enc32le(stream + len, REPLAY_MAGIC);
+        memset(stream + len + 4, 'x', 12);
+        memset(stream + len + 16, 0, 8);
+        len += BR_FRAMER_HEADER_LENGTH;
+        len += append_message(stream + len, "verack", payload, 0, 0);
+        ok = replay_check("synthetic", stream, len, log);
+    }
+
+    if (ok && (log->count != sizeof(expect)/sizeof(*expect) || log->skipped != junk)) ok = 0;
+
+    for (size_t i = 0; ok && i < log->count; i++) {
+        if (log->event[i].status != expect[i]) ok = 0;
+        if (expect[i] != BR_FRAMER_ERROR_HEADER && strcmp(log->event[i].type, types[i]) != 0) ok = 0;
+    }
+
+    if (ok) replay_print("synthetic", log);
+    else fprintf(stderr, "replay_framer: synthetic stream framed wrong\n");
+    free(payload);
+    free(stream);
+    free(log);
+    return ok;
+}
+
+static int replay_deliver(void *info, const br_message *msg)
+{
+    replay_log *log = info;
+
+    if (log->count < REPLAY_MAX_EVENTS) memcpy(log->event[log->count++].type, msg->type, sizeof(msg->type));
+    return 1;
+}
+
+// version, inv with a bad checksum, verack: drained the way BRPeer reads, in one piece and in chunks, only version may
+// be delivered, the framer has to stop at the bad checksum with verack already buffered behind it
+static int replay_stop(void)
+{
+    static const size_t chunks[] = { 1, 7, 1460, 65536 };
+    static replay_log log;
+    uint8_t payload[200], stream[3*BR_FRAMER_HEADER_LENGTH + sizeof(payload)];
+    size_t len = 0;
+    int ok = 1;
+
+    for (size_t i = 0; i < sizeof(payload); i++) payload[i] = (uint8_t)(i*2654435761u >> 13);
+    len += append_message(stream + len, "version", payload, 105, 0);
+    len += append_message(stream + len, "inv", payload, 37, 1);
+    len += append_message(stream + len, "verack", payload, 0, 0);
+
+    for (size_t i = 0; ok && i < sizeof(chunks)/sizeof(*chunks); i++) {
+        br_framer *framer = br_framer_new(REPLAY_MAGIC);
+        br_framer_status status = BR_FRAMER_NEED_MORE;
+        br_message msg;
+        size_t off = 0;
+
+        if (! framer) return 0;
+        memset(&log, 0, sizeof(log));
+
+        while (off < len && status == BR_FRAMER_NEED_MORE) {
+            size_t space = 0, l = (len - off < chunks[i]) ? len - off : chunks[i];
+            uint8_t *buf = br_framer_buffer(framer, &space);
+
+            if (! buf) break;
+            if (l > space) l = space;
+            memcpy(buf, stream + off, l);
+            br_framer_commit(framer, l);
+            off += l;
+            status = br_framer_drain(framer, &msg, replay_deliver, &log);
+        }
+
+        if (status != BR_FRAMER_ERROR_CHECKSUM || strcmp(msg.type, "inv") != 0 || log.count != 1 ||
+            strcmp(log.event[0].type, "version") != 0) {
+            fprintf(stderr, "replay_framer: delivered %zu messages around a bad checksum in %zu byte chunks\n",
+                    log.count, chunks[i]);
+            ok = 0;
+        }
+
+        br_framer_free(framer);
+    }
+
+    if (ok) printf("bad checksum: framing stops before the message behind it\n");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    static replay_log log;
+    int ok = 1;
+
+    if (argc < 2) return (replay_synthetic() && replay_stop()) ? 0 : 1;
+
+    for (int i = 1; i < argc; i++) {
+        FILE *f = fopen(argv[i], "rb");
+        uint8_t *data = NULL;
+        long len = -1;
+
+        if (f && fseek(f, 0, SEEK_END) == 0) len = ftell(f);
+        if (len >= 0 && fseek(f, 0, SEEK_SET) == 0) data = malloc(len ? (size_t)len : 1);
+
+        if (! data || fread(data, 1, (size_t)len, f) != (size_t)len) {
+            fprintf(stderr, "replay_framer: cannot read %s\n", argv[i]);
+            ok = 0;
+        }
+        else if (replay_check(argv[i], data, (size_t)len, &log)) replay_print(argv[i], &log);
+        else ok = 0;
+
+        free(data);
+        if (f) fclose(f);
+    }
+
+    return ok ? 0 : 1;
+}
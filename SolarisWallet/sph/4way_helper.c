@@ -0,0 +1,226 @@
+/*
+ * Shared definitions for the multi-buffer kernels (sph_4way.h).
+ *
+ * This file is included by the *_4way.c files, and through them by the
+ * *_8way.c files, which define SPH_MB_LANES to 8 first. Each kernel is
+ * written once as an always-inline body over mb_u64 (or mb_u32) vectors
+ * of SPH_MB_LANES lanes; SPH_MB_DISPATCH then instantiates it for the
+ * baseline target and, on x86, for AVX2 and AVX-512, and defines the
+ * public entry point that picks one on its first call and keeps calling
+ * it through a cached pointer.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_types.h"
+
+#if defined __GNUC__ && !defined __clang__
+/* the vector helpers are always inlined, their by-value ABI never shows */
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+#ifndef SPH_MB_LANES
+#define SPH_MB_LANES   4
+#endif
+
+typedef sph_u64 mb_u64 __attribute__((vector_size(8 * SPH_MB_LANES)));
+typedef sph_u32 mb_u32 __attribute__((vector_size(4 * SPH_MB_LANES)));
+
+#define MB_INLINE   static inline __attribute__((always_inline))
+
+MB_INLINE mb_u64
+mb_set1(sph_u64 x)
+{
+	mb_u64 v;
+	int j;
+
+	for (j = 0; j < SPH_MB_LANES; j ++)
+		v[j] = x;
+	return v;
+}
+
+MB_INLINE mb_u32
+mb_set1_32(sph_u32 x)
+{
+	mb_u32 v;
+	int j;
+
+	for (j = 0; j < SPH_MB_LANES; j ++)
+		v[j] = x;
+	return v;
+}
+
+#define MB_ROTL(x, n)     (((x) << (n)) | ((x) >> (64 - (n))))
+#define MB_ROTR(x, n)     (((x) >> (n)) | ((x) << (64 - (n))))
+#define MB_ROTL32(x, n)   (((x) << (n)) | ((x) >> (32 - (n))))
+
+/*
+ * Gather word w of each message into one vector.
+ */
+MB_INLINE mb_u64
+mb_load_le(const unsigned char *const in[SPH_MB_LANES], int w)
+{
+	mb_u64 v;
+	int j;
+
+	for (j = 0; j < SPH_MB_LANES; j ++)
+		v[j] = sph_dec64le(in[j] + 8 * w);
+	return v;
+}
+
+MB_INLINE mb_u64
+mb_load_be(const unsigned char *const in[SPH_MB_LANES], int w)
+{
+	mb_u64 v;
+	int j;
+
+	for (j = 0; j < SPH_MB_LANES; j ++)
+		v[j] = sph_dec64be(in[j] + 8 * w);
+	return v;
+}
+
+MB_INLINE mb_u32
+mb_load32_le(const unsigned char *const in[SPH_MB_LANES], int w)
+{
+	mb_u32 v;
+	int j;
+
+	for (j = 0; j < SPH_MB_LANES; j ++)
+		v[j] = sph_dec32le(in[j] + 4 * w);
+	return v;
+}
+
+MB_INLINE mb_u32
+mb_load32_be(const unsigned char *const in[SPH_MB_LANES], int w)
+{
+	mb_u32 v;
+	int j;
+
+	for (j = 0; j < SPH_MB_LANES; j ++)
+		v[j] = sph_dec32be(in[j] + 4 * w);
+	return v;
+}
+
+/*
+ * Scatter a vector back as word w of each output.
+ */
+MB_INLINE void
+mb_store_le(unsigned char *const out[SPH_MB_LANES], int w, const mb_u64 *x)
+{
+	int j;
+
+	for (j = 0; j < SPH_MB_LANES; j ++)
+		sph_enc64le(out[j] + 8 * w, (*x)[j]);
+}
+
+MB_INLINE void
+mb_store_be(unsigned char *const out[SPH_MB_LANES], int w, const mb_u64 *x)
+{
+	int j;
+
+	for (j = 0; j < SPH_MB_LANES; j ++)
+		sph_enc64be(out[j] + 8 * w, (*x)[j]);
+}
+
+MB_INLINE void
+mb_store32_le(unsigned char *const out[SPH_MB_LANES], int w, const mb_u32 *x)
+{
+	int j;
+
+	for (j = 0; j < SPH_MB_LANES; j ++)
+		sph_enc32le(out[j] + 4 * w, (*x)[j]);
+}
+
+MB_INLINE void
+mb_store32_be(unsigned char *const out[SPH_MB_LANES], int w, const mb_u32 *x)
+{
+	int j;
+
+	for (j = 0; j < SPH_MB_LANES; j ++)
+		sph_enc32be(out[j] + 4 * w, (*x)[j]);
+}
+
+/*
+ * MB_NAME(sph_blake512) is sph_blake512_4way_128 or sph_blake512_8way_128.
+ */
+#define MB_NAME(prefix)          MB_NAME_(prefix, SPH_MB_LANES)
+#define MB_NAME_(prefix, n)      MB_NAME__(prefix, n)
+#define MB_NAME__(prefix, n)     prefix ## _ ## n ## way_128
+
+#define SPH_MB_DISPATCH(prefix, body)   SPH_MB_DISPATCH_(MB_NAME(prefix), body)
+#define SPH_MB_DISPATCH_(name, body)    SPH_MB_DISPATCH__(name, body)
+
+#define SPH_MB_ENTRY(name, body, attr) \
+static void \
+name(const void *const in[SPH_MB_LANES], void *const out[SPH_MB_LANES]) \
+	attr; \
+static void \
+name(const void *const in[SPH_MB_LANES], void *const out[SPH_MB_LANES]) \
+{ \
+	body((const unsigned char *const *)in, (unsigned char *const *)out); \
+}
+
+#if (defined __x86_64__ || defined __i386__) && !defined __AVX512VL__
+
+#include <pthread.h>
+
+#define SPH_MB_DISPATCH__(name, body) \
+SPH_MB_ENTRY(name ## _avx512, body, \
+	__attribute__((target("avx512f,avx512vl")))) \
+SPH_MB_ENTRY(name ## _avx2, body, __attribute__((target("avx2")))) \
+SPH_MB_ENTRY(name ## _base, body, ) \
+static void (*name ## _impl)(const void *const in[SPH_MB_LANES], \
+	void *const out[SPH_MB_LANES]); \
+static pthread_once_t name ## _once = PTHREAD_ONCE_INIT; \
+static void \
+name ## _select(void) \
+{ \
+	__builtin_cpu_init(); \
+	if (__builtin_cpu_supports("avx512f") \
+		&& __builtin_cpu_supports("avx512vl")) \
+		name ## _impl = name ## _avx512; \
+	else if (__builtin_cpu_supports("avx2")) \
+		name ## _impl = name ## _avx2; \
+	else \
+		name ## _impl = name ## _base; \
+} \
+void \
+name(const void *const in[SPH_MB_LANES], void *const out[SPH_MB_LANES]) \
+{ \
+	pthread_once(&name ## _once, name ## _select); \
+	name ## _impl(in, out); \
+}
+
+#else
+
+#define SPH_MB_DISPATCH__(name, body) \
+void \
+name(const void *const in[SPH_MB_LANES], void *const out[SPH_MB_LANES]) \
+{ \
+	body((const unsigned char *const *)in, (unsigned char *const *)out); \
+}
+
+#endif
@@ -0,0 +1,99 @@
+/*
+ * Shared definitions for the hardware-AES code paths (sph_aes_hw.h).
+ *
+ * This file is included by the *_aes.c files. It maps a small set of
+ * 128-bit operations onto AES-NI/SSSE3 or onto the ARMv8 crypto and
+ * NEON instructions, so that each primitive is written only once.
+ *
+ *   AES_HW_ROUND(x, k)   one full AES encryption round (SubBytes,
+ *                        ShiftRows, MixColumns) followed by x ^= k
+ *   AES_HW_ROT32(x)      32-bit words (w0, w1, w2, w3) -> (w1, w2, w3, w0)
+ *   AES_HW_XTIME(x)      per-byte multiplication by 2 in GF(2^8)
+ *   AES_HW_LAST(x)       SubBytes and ShiftRows only, as in the last
+ *                        AES round with a zero key
+ *   AES_HW_SHUFFLE(x, m) byte k of the result is byte m[k] of x
+ *
+ * AES_HW_FUNC marks the functions which use the instructions; on x86
+ * they are compiled for the "aes" and "ssse3" targets and must only be
+ * reached after a successful sph_aes_hw_available() check.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include <string.h>
+
+#include "sph_aes_hw.h"
+
+#if defined __x86_64__ || defined __i386__
+
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <wmmintrin.h>
+
+typedef __m128i aes_hw_v128;
+
+#define AES_HW_FUNC   __attribute__((target("aes,ssse3")))
+
+#define AES_HW_LOAD(p)        _mm_loadu_si128((const __m128i *)(const void *)(p))
+#define AES_HW_STORE(p, x)    _mm_storeu_si128((__m128i *)(void *)(p), x)
+#define AES_HW_ZERO           _mm_setzero_si128()
+#define AES_HW_XOR(a, b)      _mm_xor_si128(a, b)
+#define AES_HW_SET32(w0, w1, w2, w3) \
+	_mm_set_epi32((int)(w3), (int)(w2), (int)(w1), (int)(w0))
+#define AES_HW_SET8(b)        _mm_set1_epi8((char)(b))
+#define AES_HW_ROUND(x, k)    _mm_aesenc_si128(x, k)
+#define AES_HW_LAST(x)        _mm_aesenclast_si128(x, _mm_setzero_si128())
+#define AES_HW_ROT32(x)       _mm_shuffle_epi32(x, 0x39)
+#define AES_HW_SHUFFLE(x, m)  _mm_shuffle_epi8(x, m)
+#define AES_HW_XTIME(x)       _mm_xor_si128(_mm_add_epi8(x, x), \
+	_mm_and_si128(_mm_cmplt_epi8(x, _mm_setzero_si128()), \
+	_mm_set1_epi8(0x1B)))
+
+#else
+
+#include <arm_neon.h>
+
+typedef uint8x16_t aes_hw_v128;
+
+#define AES_HW_FUNC
+
+#define AES_HW_LOAD(p)        vld1q_u8((const uint8_t *)(const void *)(p))
+#define AES_HW_STORE(p, x)    vst1q_u8((uint8_t *)(void *)(p), x)
+#define AES_HW_ZERO           vdupq_n_u8(0)
+#define AES_HW_XOR(a, b)      veorq_u8(a, b)
+#define AES_HW_SET32(w0, w1, w2, w3) \
+	vreinterpretq_u8_u32((uint32x4_t){ w0, w1, w2, w3 })
+#define AES_HW_SET8(b)        vdupq_n_u8(b)
+/* AESE xors the key before SubBytes, so it is given zero and the key goes last */
+#define AES_HW_ROUND(x, k)    veorq_u8(vaesmcq_u8(vaeseq_u8(x, vdupq_n_u8(0))), k)
+#define AES_HW_LAST(x)        vaeseq_u8(x, vdupq_n_u8(0))
+#define AES_HW_ROT32(x)       vextq_u8(x, x, 4)
+#define AES_HW_SHUFFLE(x, m)  vqtbl1q_u8(x, m)
+#define AES_HW_XTIME(x)       veorq_u8(vshlq_n_u8(x, 1), \
+	vandq_u8(vreinterpretq_u8_s8(vshrq_n_s8(vreinterpretq_s8_u8(x), 7)), \
+	vdupq_n_u8(0x1B)))
+
+#endif
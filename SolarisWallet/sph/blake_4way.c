@@ -0,0 +1,141 @@
+/*
+ * Multi-buffer BLAKE-512 over 128-byte messages, four lanes here and
+ * eight through blake_8way.c.
+ *
+ * A 128-byte message is exactly one block, compressed with a bit
+ * counter of 1024. The final block then carries only padding (0x80,
+ * the 0x01 marker and the 1024-bit length), so per the specification
+ * it is compressed with a counter of zero.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_4way.h"
+
+#if SPH_4WAY
+
+#include "4way_helper.c"
+
+static const sph_u64 IV512[8] = {
+	SPH_C64(0x6A09E667F3BCC908), SPH_C64(0xBB67AE8584CAA73B),
+	SPH_C64(0x3C6EF372FE94F82B), SPH_C64(0xA54FF53A5F1D36F1),
+	SPH_C64(0x510E527FADE682D1), SPH_C64(0x9B05688C2B3E6C1F),
+	SPH_C64(0x1F83D9ABFB41BD6B), SPH_C64(0x5BE0CD19137E2179)
+};
+
+static const sph_u64 CB[16] = {
+	SPH_C64(0x243F6A8885A308D3), SPH_C64(0x13198A2E03707344),
+	SPH_C64(0xA4093822299F31D0), SPH_C64(0x082EFA98EC4E6C89),
+	SPH_C64(0x452821E638D01377), SPH_C64(0xBE5466CF34E90C6C),
+	SPH_C64(0xC0AC29B7C97C50DD), SPH_C64(0x3F84D5B5B5470917),
+	SPH_C64(0x9216D5D98979FB1B), SPH_C64(0xD1310BA698DFB5AC),
+	SPH_C64(0x2FFD72DBD01ADFB7), SPH_C64(0xB8E1AFED6A267E96),
+	SPH_C64(0xBA7C9045F12C7F99), SPH_C64(0x24A19947B3916CF7),
+	SPH_C64(0x0801F2E2858EFC16), SPH_C64(0x636920D871574E69)
+};
+
+static const unsigned char sigma[10][16] = {
+	{  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+	{ 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+	{  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+	{  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+	{  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+	{ 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+	{ 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+	{  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+	{ 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+};
+
+#define GB4(m, s, i, a, b, c, d)   do { \
+		a += b + (m[s[2 * (i)]] ^ mb_set1(CB[s[2 * (i) + 1]])); \
+		d = MB_ROTR(d ^ a, 32); \
+		c += d; \
+		b = MB_ROTR(b ^ c, 25); \
+		a += b + (m[s[2 * (i) + 1]] ^ mb_set1(CB[s[2 * (i)]])); \
+		d = MB_ROTR(d ^ a, 16); \
+		c += d; \
+		b = MB_ROTR(b ^ c, 11); \
+	} while (0)
+
+MB_INLINE void
+blake512_mb_compress(mb_u64 h[8], const mb_u64 m[16], sph_u64 t0)
+{
+	mb_u64 v[16];
+	int r, i;
+
+	for (i = 0; i < 8; i ++)
+		v[i] = h[i];
+	for (i = 0; i < 8; i ++)
+		v[8 + i] = mb_set1(CB[i]);
+	v[12] ^= mb_set1(t0);
+	v[13] ^= mb_set1(t0);
+
+	for (r = 0; r < 16; r ++) {
+		const unsigned char *s = sigma[r % 10];
+
+		GB4(m, s, 0, v[0], v[4], v[ 8], v[12]);
+		GB4(m, s, 1, v[1], v[5], v[ 9], v[13]);
+		GB4(m, s, 2, v[2], v[6], v[10], v[14]);
+		GB4(m, s, 3, v[3], v[7], v[11], v[15]);
+		GB4(m, s, 4, v[0], v[5], v[10], v[15]);
+		GB4(m, s, 5, v[1], v[6], v[11], v[12]);
+		GB4(m, s, 6, v[2], v[7], v[ 8], v[13]);
+		GB4(m, s, 7, v[3], v[4], v[ 9], v[14]);
+	}
+
+	for (i = 0; i < 8; i ++)
+		h[i] ^= v[i] ^ v[i + 8];
+}
+
+MB_INLINE void
+blake512_mb_body(const unsigned char *const in[SPH_MB_LANES],
+	unsigned char *const out[SPH_MB_LANES])
+{
+	mb_u64 h[8], m[16];
+	int i;
+
+	for (i = 0; i < 8; i ++)
+		h[i] = mb_set1(IV512[i]);
+
+	for (i = 0; i < 16; i ++)
+		m[i] = mb_load_be(in, i);
+	blake512_mb_compress(h, m, 1024);
+
+	for (i = 0; i < 16; i ++)
+		m[i] = mb_set1(0);
+	m[0] = mb_set1(SPH_C64(0x8000000000000000));
+	m[13] = mb_set1(1);
+	m[15] = mb_set1(1024);
+	blake512_mb_compress(h, m, 0);
+
+	for (i = 0; i < 8; i ++)
+		mb_store_be(out, i, &h[i]);
+}
+
+SPH_MB_DISPATCH(sph_blake512, blake512_mb_body)
+
+#endif
@@ -0,0 +1,203 @@
+/*
+ * Multi-buffer BMW-512 over 128-byte messages, four lanes here and
+ * eight through bmw_8way.c.
+ *
+ * A 128-byte message is exactly one block. The padding block (0x80,
+ * zeros and the 1024-bit length) is then compressed on its own, and
+ * the result goes through the final compression keyed by the constant
+ * chaining value; the digest is the upper half of that output.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_4way.h"
+
+#if SPH_4WAY
+
+#include "4way_helper.c"
+
+static const sph_u64 IV512[16] = {
+	SPH_C64(0x8081828384858687), SPH_C64(0x88898A8B8C8D8E8F),
+	SPH_C64(0x9091929394959697), SPH_C64(0x98999A9B9C9D9E9F),
+	SPH_C64(0xA0A1A2A3A4A5A6A7), SPH_C64(0xA8A9AAABACADAEAF),
+	SPH_C64(0xB0B1B2B3B4B5B6B7), SPH_C64(0xB8B9BABBBCBDBEBF),
+	SPH_C64(0xC0C1C2C3C4C5C6C7), SPH_C64(0xC8C9CACBCCCDCECF),
+	SPH_C64(0xD0D1D2D3D4D5D6D7), SPH_C64(0xD8D9DADBDCDDDEDF),
+	SPH_C64(0xE0E1E2E3E4E5E6E7), SPH_C64(0xE8E9EAEBECEDEEEF),
+	SPH_C64(0xF0F1F2F3F4F5F6F7), SPH_C64(0xF8F9FAFBFCFDFEFF)
+};
+
+static const sph_u64 final_b[16] = {
+	SPH_C64(0xaaaaaaaaaaaaaaa0), SPH_C64(0xaaaaaaaaaaaaaaa1),
+	SPH_C64(0xaaaaaaaaaaaaaaa2), SPH_C64(0xaaaaaaaaaaaaaaa3),
+	SPH_C64(0xaaaaaaaaaaaaaaa4), SPH_C64(0xaaaaaaaaaaaaaaa5),
+	SPH_C64(0xaaaaaaaaaaaaaaa6), SPH_C64(0xaaaaaaaaaaaaaaa7),
+	SPH_C64(0xaaaaaaaaaaaaaaa8), SPH_C64(0xaaaaaaaaaaaaaaa9),
+	SPH_C64(0xaaaaaaaaaaaaaaaa), SPH_C64(0xaaaaaaaaaaaaaaab),
+	SPH_C64(0xaaaaaaaaaaaaaaac), SPH_C64(0xaaaaaaaaaaaaaaad),
+	SPH_C64(0xaaaaaaaaaaaaaaae), SPH_C64(0xaaaaaaaaaaaaaaaf)
+};
+
+#define sb0(x)    (((x) >> 1) ^ ((x) << 3) ^ MB_ROTL(x,  4) ^ MB_ROTL(x, 37))
+#define sb1(x)    (((x) >> 1) ^ ((x) << 2) ^ MB_ROTL(x, 13) ^ MB_ROTL(x, 43))
+#define sb2(x)    (((x) >> 2) ^ ((x) << 1) ^ MB_ROTL(x, 19) ^ MB_ROTL(x, 53))
+#define sb3(x)    (((x) >> 2) ^ ((x) << 2) ^ MB_ROTL(x, 28) ^ MB_ROTL(x, 59))
+#define sb4(x)    (((x) >> 1) ^ (x))
+#define sb5(x)    (((x) >> 2) ^ (x))
+
+/*
+ * W_i = +-(M ^ H)[i0] +- (M ^ H)[i1] ... over five words; a set bit
+ * in the sign mask means the word at that position is subtracted.
+ */
+static const unsigned char Wi[16][5] = {
+	{  5,  7, 10, 13, 14 }, {  6,  8, 11, 14, 15 },
+	{  0,  7,  9, 12, 15 }, {  0,  1,  8, 10, 13 },
+	{  1,  2,  9, 11, 14 }, {  3,  2, 10, 12, 15 },
+	{  4,  0,  3, 11, 13 }, {  1,  4,  5, 12, 14 },
+	{  2,  5,  6, 13, 15 }, {  0,  3,  6,  7, 14 },
+	{  8,  1,  4,  7, 15 }, {  8,  0,  2,  5,  9 },
+	{  1,  3,  6,  9, 10 }, {  2,  4,  7, 10, 11 },
+	{  3,  5,  8, 11, 12 }, { 12,  4,  6,  9, 13 }
+};
+
+static const unsigned char Wsign[16] = {
+	0x02, 0x12, 0x08, 0x0A, 0x18, 0x0A, 0x0E, 0x1E,
+	0x16, 0x0A, 0x0E, 0x0E, 0x0C, 0x00, 0x1A, 0x0E
+};
+
+#define ROL_M(m, j)   MB_ROTL(m[(j) & 15], ((j) & 15) + 1)
+
+MB_INLINE void
+bmw512_mb_compress(const mb_u64 m[16], const mb_u64 h[16],
+	mb_u64 dh[16])
+{
+	mb_u64 mh[16], q[32], w, xl, xh;
+	int i, k;
+
+	for (i = 0; i < 16; i ++)
+		mh[i] = m[i] ^ h[i];
+
+	for (i = 0; i < 16; i ++) {
+		w = mh[Wi[i][0]];
+		for (k = 1; k < 5; k ++) {
+			if (Wsign[i] & (1 << k))
+				w -= mh[Wi[i][k]];
+			else
+				w += mh[Wi[i][k]];
+		}
+		switch (i % 5) {
+		case 0: w = sb0(w); break;
+		case 1: w = sb1(w); break;
+		case 2: w = sb2(w); break;
+		case 3: w = sb3(w); break;
+		default: w = sb4(w); break;
+		}
+		q[i] = w + h[(i + 1) & 15];
+	}
+
+	for (i = 16; i < 32; i ++) {
+		int j = i - 16;
+		mb_u64 e = (ROL_M(m, j) + ROL_M(m, j + 3) - ROL_M(m, j + 10)
+			+ mb_set1((sph_u64)i * SPH_C64(0x0555555555555555)))
+			^ h[(j + 7) & 15];
+
+		if (i < 18) {
+			for (k = 0; k < 16; k += 4)
+				e += sb1(q[j + k]) + sb2(q[j + k + 1])
+					+ sb3(q[j + k + 2]) + sb0(q[j + k + 3]);
+		} else {
+			e += q[j] + MB_ROTL(q[j + 1], 5)
+				+ q[j + 2] + MB_ROTL(q[j + 3], 11)
+				+ q[j + 4] + MB_ROTL(q[j + 5], 27)
+				+ q[j + 6] + MB_ROTL(q[j + 7], 32)
+				+ q[j + 8] + MB_ROTL(q[j + 9], 37)
+				+ q[j + 10] + MB_ROTL(q[j + 11], 43)
+				+ q[j + 12] + MB_ROTL(q[j + 13], 53)
+				+ sb4(q[j + 14]) + sb5(q[j + 15]);
+		}
+		q[i] = e;
+	}
+
+	xl = q[16] ^ q[17] ^ q[18] ^ q[19] ^ q[20] ^ q[21] ^ q[22] ^ q[23];
+	xh = xl ^ q[24] ^ q[25] ^ q[26] ^ q[27]
+		^ q[28] ^ q[29] ^ q[30] ^ q[31];
+
+	dh[ 0] = ((xh <<  5) ^ (q[16] >>  5) ^ m[ 0]) + (xl ^ q[24] ^ q[ 0]);
+	dh[ 1] = ((xh >>  7) ^ (q[17] <<  8) ^ m[ 1]) + (xl ^ q[25] ^ q[ 1]);
+	dh[ 2] = ((xh >>  5) ^ (q[18] <<  5) ^ m[ 2]) + (xl ^ q[26] ^ q[ 2]);
+	dh[ 3] = ((xh >>  1) ^ (q[19] <<  5) ^ m[ 3]) + (xl ^ q[27] ^ q[ 3]);
+	dh[ 4] = ((xh >>  3) ^  q[20]        ^ m[ 4]) + (xl ^ q[28] ^ q[ 4]);
+	dh[ 5] = ((xh <<  6) ^ (q[21] >>  6) ^ m[ 5]) + (xl ^ q[29] ^ q[ 5]);
+	dh[ 6] = ((xh >>  4) ^ (q[22] <<  6) ^ m[ 6]) + (xl ^ q[30] ^ q[ 6]);
+	dh[ 7] = ((xh >> 11) ^ (q[23] <<  2) ^ m[ 7]) + (xl ^ q[31] ^ q[ 7]);
+	dh[ 8] = MB_ROTL(dh[4],  9) + (xh ^ q[24] ^ m[ 8])
+		+ ((xl << 8) ^ q[23] ^ q[ 8]);
+	dh[ 9] = MB_ROTL(dh[5], 10) + (xh ^ q[25] ^ m[ 9])
+		+ ((xl >> 6) ^ q[16] ^ q[ 9]);
+	dh[10] = MB_ROTL(dh[6], 11) + (xh ^ q[26] ^ m[10])
+		+ ((xl << 6) ^ q[17] ^ q[10]);
+	dh[11] = MB_ROTL(dh[7], 12) + (xh ^ q[27] ^ m[11])
+		+ ((xl << 4) ^ q[18] ^ q[11]);
+	dh[12] = MB_ROTL(dh[0], 13) + (xh ^ q[28] ^ m[12])
+		+ ((xl >> 3) ^ q[19] ^ q[12]);
+	dh[13] = MB_ROTL(dh[1], 14) + (xh ^ q[29] ^ m[13])
+		+ ((xl >> 4) ^ q[20] ^ q[13]);
+	dh[14] = MB_ROTL(dh[2], 15) + (xh ^ q[30] ^ m[14])
+		+ ((xl >> 7) ^ q[21] ^ q[14]);
+	dh[15] = MB_ROTL(dh[3], 16) + (xh ^ q[31] ^ m[15])
+		+ ((xl >> 2) ^ q[22] ^ q[15]);
+}
+
+MB_INLINE void
+bmw512_mb_body(const unsigned char *const in[SPH_MB_LANES],
+	unsigned char *const out[SPH_MB_LANES])
+{
+	mb_u64 h[16], h2[16], m[16];
+	int i;
+
+	for (i = 0; i < 16; i ++) {
+		h[i] = mb_set1(IV512[i]);
+		m[i] = mb_load_le(in, i);
+	}
+	bmw512_mb_compress(m, h, h2);
+
+	for (i = 0; i < 16; i ++)
+		m[i] = mb_set1(0);
+	m[0] = mb_set1(0x80);
+	m[15] = mb_set1(1024);
+	bmw512_mb_compress(m, h2, h);
+
+	for (i = 0; i < 16; i ++)
+		m[i] = mb_set1(final_b[i]);
+	bmw512_mb_compress(h, m, h2);
+
+	for (i = 0; i < 8; i ++)
+		mb_store_le(out, i, &h2[8 + i]);
+}
+
+SPH_MB_DISPATCH(sph_bmw512, bmw512_mb_body)
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * Multi-buffer CubeHash-512 over 128-byte messages, four lanes here and
+ * eight through cubehash_8way.c.
+ *
+ * This is CubeHash16/32-512, as in sph_cubehash512(): the message is
+ * four 32-byte blocks, the padding block holds only the 0x80 byte, and
+ * the finalisation flips the last state word before ten more times
+ * sixteen rounds.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_4way.h"
+
+#if SPH_4WAY
+
+#include "4way_helper.c"
+
+static const sph_u32 IV512[32] = {
+	SPH_C32(0x2AEA2A61), SPH_C32(0x50F494D4), SPH_C32(0x2D538B8B),
+	SPH_C32(0x4167D83E), SPH_C32(0x3FEE2313), SPH_C32(0xC701CF8C),
+	SPH_C32(0xCC39968E), SPH_C32(0x50AC5695), SPH_C32(0x4D42C787),
+	SPH_C32(0xA647A8B3), SPH_C32(0x97CF0BEF), SPH_C32(0x825B4537),
+	SPH_C32(0xEEF864D2), SPH_C32(0xF22090C4), SPH_C32(0xD0E5CD33),
+	SPH_C32(0xA23911AE), SPH_C32(0xFCD398D9), SPH_C32(0x148FE485),
+	SPH_C32(0x1B017BEF), SPH_C32(0xB6444532), SPH_C32(0x6A536159),
+	SPH_C32(0x2FF5781C), SPH_C32(0x91FA7934), SPH_C32(0x0DBADEA9),
+	SPH_C32(0xD65C8A2B), SPH_C32(0xA5A70E75), SPH_C32(0xB1C62456),
+	SPH_C32(0xBC796576), SPH_C32(0x1921C8F7), SPH_C32(0xE7989AF1),
+	SPH_C32(0x7795D246), SPH_C32(0xD43E3B44)
+};
+
+#define REP16(S)   S(0) S(1) S(2) S(3) S(4) S(5) S(6) S(7) \
+	S(8) S(9) S(10) S(11) S(12) S(13) S(14) S(15)
+
+/*
+ * The ten steps of a round, as in the specification. Word i of the
+ * state is x[i]; each swap of the specification is folded into the
+ * step before it, through y.
+ */
+#define ADD_HI(i)     x[16 + (i)] += x[i];
+#define ROT7_SWAP(i)  y[(i) ^ 8] = MB_ROTL32(x[i], 7);
+#define XOR_LO(i)     x[i] = y[i] ^ x[16 + (i)];
+#define SWAP2_HI(i)   y[(i) ^ 2] = x[16 + (i)];
+#define ADD_HI_Y(i)   x[16 + (i)] = y[i] + x[i];
+#define ROT11_SWAP(i) y[(i) ^ 4] = MB_ROTL32(x[i], 11);
+#define SWAP1_HI(i)   y[(i) ^ 1] = x[16 + (i)];
+#define COPY_HI(i)    x[16 + (i)] = y[i];
+
+MB_INLINE void
+cubehash_mb_rounds(mb_u32 x[32])
+{
+	mb_u32 y[16];
+	int r;
+
+	for (r = 0; r < 16; r ++) {
+		REP16(ADD_HI)
+		REP16(ROT7_SWAP)
+		REP16(XOR_LO)
+		REP16(SWAP2_HI)
+		REP16(ADD_HI_Y)
+		REP16(ROT11_SWAP)
+		REP16(XOR_LO)
+		REP16(SWAP1_HI)
+		REP16(COPY_HI)
+	}
+}
+
+MB_INLINE void
+cubehash512_mb_body(const unsigned char *const in[SPH_MB_LANES],
+	unsigned char *const out[SPH_MB_LANES])
+{
+	mb_u32 x[32];
+	int i, b;
+
+	for (i = 0; i < 32; i ++)
+		x[i] = mb_set1_32(IV512[i]);
+
+	for (b = 0; b < 4; b ++) {
+		for (i = 0; i < 8; i ++)
+			x[i] ^= mb_load32_le(in, 8 * b + i);
+		cubehash_mb_rounds(x);
+	}
+
+	x[0] ^= mb_set1_32(0x80);
+	cubehash_mb_rounds(x);
+	x[31] ^= mb_set1_32(1);
+	for (i = 0; i < 10; i ++)
+		cubehash_mb_rounds(x);
+
+	for (i = 0; i < 16; i ++)
+		mb_store32_le(out, i, &x[i]);
+}
+
+SPH_MB_DISPATCH(sph_cubehash512, cubehash512_mb_body)
+
+#endif
@@ -0,0 +1,118 @@
+/*
+ * ECHO-512 over 128-byte messages with hardware AES.
+ *
+ * The 2048-bit state is sixteen 128-bit words; the first eight hold
+ * the chaining value, the last eight the message block. A 128-byte
+ * message is one block compressed with a counter of 1024; the final
+ * block holds only padding (0x80, the 16-bit output size and the
+ * 128-bit message length) and is compressed with a counter of zero.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_aes_hw.h"
+
+#if SPH_AES_HW
+
+#include "aes_hw_helper.c"
+
+static AES_HW_FUNC void
+echo_aes_compress(aes_hw_v128 V[8], const unsigned char *block,
+	sph_u64 counter)
+{
+	aes_hw_v128 W[16];
+	int r, n;
+
+	for (n = 0; n < 8; n ++) {
+		W[n] = V[n];
+		W[n + 8] = AES_HW_LOAD(block + 16 * n);
+	}
+
+	for (r = 0; r < 10; r ++) {
+		aes_hw_v128 t;
+
+		/* sub words: two AES rounds per word, keyed by the counter */
+		for (n = 0; n < 16; n ++) {
+			aes_hw_v128 k = AES_HW_SET32((sph_u32)counter,
+				(sph_u32)(counter >> 32), 0, 0);
+
+			W[n] = AES_HW_ROUND(AES_HW_ROUND(W[n], k), AES_HW_ZERO);
+			counter ++;
+		}
+
+		/* shift rows */
+		t = W[1]; W[1] = W[5]; W[5] = W[9]; W[9] = W[13]; W[13] = t;
+		t = W[2]; W[2] = W[10]; W[10] = t;
+		t = W[6]; W[6] = W[14]; W[14] = t;
+		t = W[15]; W[15] = W[11]; W[11] = W[7]; W[7] = W[3]; W[3] = t;
+
+		/* mix columns */
+		for (n = 0; n < 16; n += 4) {
+			aes_hw_v128 a = W[n], b = W[n + 1];
+			aes_hw_v128 c = W[n + 2], d = W[n + 3];
+			aes_hw_v128 ab = AES_HW_XOR(a, b);
+			aes_hw_v128 bc = AES_HW_XOR(b, c);
+			aes_hw_v128 cd = AES_HW_XOR(c, d);
+			aes_hw_v128 abx = AES_HW_XTIME(ab);
+			aes_hw_v128 bcx = AES_HW_XTIME(bc);
+			aes_hw_v128 cdx = AES_HW_XTIME(cd);
+
+			W[n] = AES_HW_XOR(AES_HW_XOR(abx, bc), d);
+			W[n + 1] = AES_HW_XOR(AES_HW_XOR(bcx, a), cd);
+			W[n + 2] = AES_HW_XOR(AES_HW_XOR(cdx, ab), d);
+			W[n + 3] = AES_HW_XOR(AES_HW_XOR(AES_HW_XOR(abx, bcx),
+				AES_HW_XOR(cdx, ab)), c);
+		}
+	}
+
+	for (n = 0; n < 8; n ++)
+		V[n] = AES_HW_XOR(AES_HW_XOR(V[n], AES_HW_LOAD(block + 16 * n)),
+			AES_HW_XOR(W[n], W[n + 8]));
+}
+
+/* see sph_aes_hw.h */
+AES_HW_FUNC void
+sph_echo512_aes_128(const void *in, void *out)
+{
+	aes_hw_v128 V[8];
+	unsigned char pad[128];
+	int n;
+
+	for (n = 0; n < 8; n ++)
+		V[n] = AES_HW_SET32(512, 0, 0, 0);
+	echo_aes_compress(V, (const unsigned char *)in, 1024);
+
+	memset(pad, 0, sizeof pad);
+	pad[0] = 0x80;
+	sph_enc16le(pad + 110, 512);
+	sph_enc64le(pad + 112, 1024);
+	echo_aes_compress(V, pad, 0);
+
+	for (n = 0; n < 4; n ++)
+		AES_HW_STORE((unsigned char *)out + 16 * n, V[n]);
+}
+
+#endif
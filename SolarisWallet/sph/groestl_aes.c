@@ -0,0 +1,208 @@
+/*
+ * Groestl-512 over 128-byte messages with hardware AES.
+ *
+ * The 1024-bit state is held as its eight rows, one 128-bit word each,
+ * byte j of row i being column j. Groestl's S-box is the AES one, so
+ * SubBytes is the last AES round with a zero key; its ShiftRows is
+ * undone, and ShiftBytes applied, by one byte shuffle ahead of it
+ * (both are byte permutations, so they commute with SubBytes).
+ * MixBytes works on whole rows with GF(2^8) doublings.
+ *
+ * A 128-byte message is one block; the final block holds only padding
+ * (0x80 and the 64-bit block count of 2).
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_aes_hw.h"
+
+#if SPH_AES_HW
+
+#include "aes_hw_helper.c"
+
+/*
+ * Shuffles which undo AES ShiftRows and rotate a row left by 0, 1, 2,
+ * 3, 4, 5, 6 and 11 columns, the ShiftBytes offsets of P and Q.
+ */
+static const unsigned char SHIFT[8][16] = {
+	{  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3 },
+	{  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4 },
+	{  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5 },
+	{  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6 },
+	{  4,  1, 14, 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7 },
+	{  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8 },
+	{  6,  3,  0, 13, 10,  7,  4,  1, 14, 11,  8,  5,  2, 15, 12,  9 },
+	{ 11,  8,  5,  2, 15, 12,  9,  6,  3,  0, 13, 10,  7,  4,  1, 14 }
+};
+
+/* the column numbers in the high nibbles, the round constant base */
+static const unsigned char COLUMNS[16] = {
+	0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70,
+	0x80, 0x90, 0xA0, 0xB0, 0xC0, 0xD0, 0xE0, 0xF0
+};
+
+/*
+ * Row i of MixBytes is 2, 2, 3, 4, 5, 3, 5, 7 times rows i to i + 7:
+ * the rows with an odd factor, plus twice those with bit 1 set, plus
+ * four times those with bit 2 set.
+ */
+#define MIX_ROW(b, a0, a1, a2, a3, a4, a5, a6, a7)   do { \
+		aes_hw_v128 x, y, z; \
+		x = AES_HW_XOR(AES_HW_XOR(a2, a4), \
+			AES_HW_XOR(AES_HW_XOR(a5, a6), a7)); \
+		y = AES_HW_XOR(AES_HW_XOR(a0, a1), \
+			AES_HW_XOR(AES_HW_XOR(a2, a5), a7)); \
+		z = AES_HW_XOR(AES_HW_XOR(a3, a4), AES_HW_XOR(a6, a7)); \
+		b = AES_HW_XOR(x, AES_HW_XTIME(AES_HW_XOR(y, \
+			AES_HW_XTIME(z)))); \
+	} while (0)
+
+#define MIX_BYTES(a, b)   do { \
+		MIX_ROW(b[0], a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]); \
+		MIX_ROW(b[1], a[1], a[2], a[3], a[4], a[5], a[6], a[7], a[0]); \
+		MIX_ROW(b[2], a[2], a[3], a[4], a[5], a[6], a[7], a[0], a[1]); \
+		MIX_ROW(b[3], a[3], a[4], a[5], a[6], a[7], a[0], a[1], a[2]); \
+		MIX_ROW(b[4], a[4], a[5], a[6], a[7], a[0], a[1], a[2], a[3]); \
+		MIX_ROW(b[5], a[5], a[6], a[7], a[0], a[1], a[2], a[3], a[4]); \
+		MIX_ROW(b[6], a[6], a[7], a[0], a[1], a[2], a[3], a[4], a[5]); \
+		MIX_ROW(b[7], a[7], a[0], a[1], a[2], a[3], a[4], a[5], a[6]); \
+	} while (0)
+
+/* SubBytes and ShiftBytes of row i, shuffled by SHIFT[s] */
+#define SUB_SHIFT(a, i, s) \
+	(a[i] = AES_HW_LAST(AES_HW_SHUFFLE(a[i], AES_HW_LOAD(SHIFT[s]))))
+
+static AES_HW_FUNC void
+groestl_aes_perm_p(aes_hw_v128 a[8])
+{
+	aes_hw_v128 columns = AES_HW_LOAD(COLUMNS);
+	aes_hw_v128 b[8];
+	int r;
+
+	for (r = 0; r < 14; r ++) {
+		a[0] = AES_HW_XOR(a[0], AES_HW_XOR(columns, AES_HW_SET8(r)));
+		SUB_SHIFT(a, 0, 0);
+		SUB_SHIFT(a, 1, 1);
+		SUB_SHIFT(a, 2, 2);
+		SUB_SHIFT(a, 3, 3);
+		SUB_SHIFT(a, 4, 4);
+		SUB_SHIFT(a, 5, 5);
+		SUB_SHIFT(a, 6, 6);
+		SUB_SHIFT(a, 7, 7);
+		MIX_BYTES(a, b);
+		memcpy(a, b, sizeof b);
+	}
+}
+
+/*
+ * Q complements every byte and adds the round constant to row 7; its
+ * ShiftBytes offsets are 1, 3, 5, 11, 0, 2, 4 and 6.
+ */
+static AES_HW_FUNC void
+groestl_aes_perm_q(aes_hw_v128 a[8])
+{
+	aes_hw_v128 columns = AES_HW_XOR(AES_HW_LOAD(COLUMNS), AES_HW_SET8(0xFF));
+	aes_hw_v128 ones = AES_HW_SET8(0xFF);
+	aes_hw_v128 b[8];
+	int r;
+
+	for (r = 0; r < 14; r ++) {
+		a[0] = AES_HW_XOR(a[0], ones);
+		a[1] = AES_HW_XOR(a[1], ones);
+		a[2] = AES_HW_XOR(a[2], ones);
+		a[3] = AES_HW_XOR(a[3], ones);
+		a[4] = AES_HW_XOR(a[4], ones);
+		a[5] = AES_HW_XOR(a[5], ones);
+		a[6] = AES_HW_XOR(a[6], ones);
+		a[7] = AES_HW_XOR(a[7], AES_HW_XOR(columns, AES_HW_SET8(r)));
+		SUB_SHIFT(a, 0, 1);
+		SUB_SHIFT(a, 1, 3);
+		SUB_SHIFT(a, 2, 5);
+		SUB_SHIFT(a, 3, 7);
+		SUB_SHIFT(a, 4, 0);
+		SUB_SHIFT(a, 5, 2);
+		SUB_SHIFT(a, 6, 4);
+		SUB_SHIFT(a, 7, 6);
+		MIX_BYTES(a, b);
+		memcpy(a, b, sizeof b);
+	}
+}
+
+/*
+ * h = P(h ^ m) ^ Q(m) ^ h, with the message block already in rows.
+ */
+static AES_HW_FUNC void
+groestl_aes_compress(aes_hw_v128 h[8], const unsigned char m[8][16])
+{
+	aes_hw_v128 p[8], q[8];
+	int i;
+
+	for (i = 0; i < 8; i ++) {
+		q[i] = AES_HW_LOAD(m[i]);
+		p[i] = AES_HW_XOR(h[i], q[i]);
+	}
+	groestl_aes_perm_p(p);
+	groestl_aes_perm_q(q);
+	for (i = 0; i < 8; i ++)
+		h[i] = AES_HW_XOR(h[i], AES_HW_XOR(p[i], q[i]));
+}
+
+/* see sph_aes_hw.h */
+AES_HW_FUNC void
+sph_groestl512_aes_128(const void *in, void *out)
+{
+	const unsigned char *msg = in;
+	unsigned char rows[8][16];
+	aes_hw_v128 h[8], p[8];
+	int i, j;
+
+	/* the state is filled column by column */
+	for (i = 0; i < 8; i ++)
+		for (j = 0; j < 16; j ++)
+			rows[i][j] = msg[8 * j + i];
+
+	for (i = 0; i < 8; i ++)
+		h[i] = AES_HW_ZERO;
+	h[6] = AES_HW_SET32(0, 0, 0, (sph_u32)0x02 << 24);
+	groestl_aes_compress(h, (const unsigned char (*)[16])rows);
+
+	memset(rows, 0, sizeof rows);
+	rows[0][0] = 0x80;
+	rows[7][15] = 0x02;
+	groestl_aes_compress(h, (const unsigned char (*)[16])rows);
+
+	/* output transformation P(h) ^ h, truncated to its last 8 columns */
+	for (i = 0; i < 8; i ++)
+		p[i] = h[i];
+	groestl_aes_perm_p(p);
+	for (i = 0; i < 8; i ++)
+		AES_HW_STORE(rows[i], AES_HW_XOR(p[i], h[i]));
+	for (i = 0; i < 8; i ++)
+		for (j = 8; j < 16; j ++)
+			((unsigned char *)out)[8 * (j - 8) + i] = rows[i][j];
+}
+
+#endif
@@ -0,0 +1,267 @@
+/*
+ * Multi-buffer Hamsi-512 over 128-byte messages, four lanes here and
+ * eight through hamsi_8way.c.
+ *
+ * The message is sixteen 8-byte blocks, then the padding block (0x80
+ * and zeros) and the 1024-bit length, which goes through the longer
+ * final permutation. The message expansion is a table lookup per lane
+ * (four bits at a time, the 16 KB tables of hamsi_helper.c instead of
+ * the 128 KB ones of hamsi.c); the concatenation and permutation run
+ * on all lanes at once.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_4way.h"
+
+#if SPH_4WAY
+
+#include "4way_helper.c"
+
+#define SPH_HAMSI_EXPAND_SMALL   0
+#define SPH_HAMSI_EXPAND_BIG     4
+
+#include "hamsi_helper.c"
+
+static const sph_u32 IV512[16] = {
+	SPH_C32(0x73746565), SPH_C32(0x6c706172), SPH_C32(0x6b204172),
+	SPH_C32(0x656e6265), SPH_C32(0x72672031), SPH_C32(0x302c2062),
+	SPH_C32(0x75732032), SPH_C32(0x3434362c), SPH_C32(0x20422d33),
+	SPH_C32(0x30303120), SPH_C32(0x4c657576), SPH_C32(0x656e2d48),
+	SPH_C32(0x65766572), SPH_C32(0x6c65652c), SPH_C32(0x2042656c),
+	SPH_C32(0x6769756d)
+};
+
+static const sph_u32 alpha_n[32] = {
+	SPH_C32(0xff00f0f0), SPH_C32(0xccccaaaa), SPH_C32(0xf0f0cccc),
+	SPH_C32(0xff00aaaa), SPH_C32(0xccccaaaa), SPH_C32(0xf0f0ff00),
+	SPH_C32(0xaaaacccc), SPH_C32(0xf0f0ff00), SPH_C32(0xf0f0cccc),
+	SPH_C32(0xaaaaff00), SPH_C32(0xccccff00), SPH_C32(0xaaaaf0f0),
+	SPH_C32(0xaaaaf0f0), SPH_C32(0xff00cccc), SPH_C32(0xccccf0f0),
+	SPH_C32(0xff00aaaa), SPH_C32(0xccccaaaa), SPH_C32(0xff00f0f0),
+	SPH_C32(0xff00aaaa), SPH_C32(0xf0f0cccc), SPH_C32(0xf0f0ff00),
+	SPH_C32(0xccccaaaa), SPH_C32(0xf0f0ff00), SPH_C32(0xaaaacccc),
+	SPH_C32(0xaaaaff00), SPH_C32(0xf0f0cccc), SPH_C32(0xaaaaf0f0),
+	SPH_C32(0xccccff00), SPH_C32(0xff00cccc), SPH_C32(0xaaaaf0f0),
+	SPH_C32(0xff00aaaa), SPH_C32(0xccccf0f0)
+};
+
+static const sph_u32 alpha_f[32] = {
+	SPH_C32(0xcaf9639c), SPH_C32(0x0ff0f9c0), SPH_C32(0x639c0ff0),
+	SPH_C32(0xcaf9f9c0), SPH_C32(0x0ff0f9c0), SPH_C32(0x639ccaf9),
+	SPH_C32(0xf9c00ff0), SPH_C32(0x639ccaf9), SPH_C32(0x639c0ff0),
+	SPH_C32(0xf9c0caf9), SPH_C32(0x0ff0caf9), SPH_C32(0xf9c0639c),
+	SPH_C32(0xf9c0639c), SPH_C32(0xcaf90ff0), SPH_C32(0x0ff0639c),
+	SPH_C32(0xcaf9f9c0), SPH_C32(0x0ff0f9c0), SPH_C32(0xcaf9639c),
+	SPH_C32(0xcaf9f9c0), SPH_C32(0x639c0ff0), SPH_C32(0x639ccaf9),
+	SPH_C32(0x0ff0f9c0), SPH_C32(0x639ccaf9), SPH_C32(0xf9c00ff0),
+	SPH_C32(0xf9c0caf9), SPH_C32(0x639c0ff0), SPH_C32(0xf9c0639c),
+	SPH_C32(0x0ff0caf9), SPH_C32(0xcaf90ff0), SPH_C32(0xf9c0639c),
+	SPH_C32(0xcaf9f9c0), SPH_C32(0x0ff0639c)
+};
+
+/*
+ * The expansion tables, one per nibble of the 8-byte block, high
+ * nibble of each byte first.
+ */
+static const sph_u32 (*const T512[16])[16] = {
+	T512_0, T512_4, T512_8, T512_12, T512_16, T512_20, T512_24, T512_28,
+	T512_32, T512_36, T512_40, T512_44, T512_48, T512_52, T512_56, T512_60
+};
+
+static const unsigned char pad_block[8] = { 0x80 };
+
+/* the bit length of a 128-byte message, big-endian */
+static const unsigned char len_block[8] = { 0, 0, 0, 0, 0, 0, 0x04, 0x00 };
+
+/*
+ * Expands the 8-byte block at in[j] + off of every lane into m.
+ */
+MB_INLINE void
+hamsi_mb_expand(mb_u32 m[16], const unsigned char *const in[SPH_MB_LANES],
+	size_t off)
+{
+	sph_u32 e[SPH_MB_LANES][16];
+	int i, j, t;
+
+	for (j = 0; j < SPH_MB_LANES; j ++) {
+		const unsigned char *buf = in[j] + off;
+
+		for (i = 0; i < 16; i ++)
+			e[j][i] = 0;
+		for (t = 0; t < 16; t ++) {
+			unsigned nib = (buf[t >> 1] >> ((~t & 1) << 2)) & 0x0f;
+			const sph_u32 *rp = T512[t][nib];
+
+			for (i = 0; i < 16; i ++)
+				e[j][i] ^= rp[i];
+		}
+	}
+
+	for (i = 0; i < 16; i ++)
+		for (j = 0; j < SPH_MB_LANES; j ++)
+			m[i][j] = e[j][i];
+}
+
+#define SBOX(a, b, c, d)   do { \
+		mb_u32 t; \
+		t = (a); \
+		(a) &= (c); \
+		(a) ^= (d); \
+		(c) ^= (b); \
+		(c) ^= (a); \
+		(d) |= t; \
+		(d) ^= (b); \
+		t ^= (c); \
+		(b) = (d); \
+		(d) |= t; \
+		(d) ^= (a); \
+		(a) &= (b); \
+		t ^= (a); \
+		(b) ^= (d); \
+		(b) ^= t; \
+		(a) = (c); \
+		(c) = (b); \
+		(b) = (d); \
+		(d) = ~t; \
+	} while (0)
+
+#define L(a, b, c, d)   do { \
+		(a) = MB_ROTL32(a, 13); \
+		(c) = MB_ROTL32(c, 3); \
+		(b) ^= (a) ^ (c); \
+		(d) ^= (c) ^ ((a) << 3); \
+		(b) = MB_ROTL32(b, 1); \
+		(d) = MB_ROTL32(d, 7); \
+		(a) ^= (b) ^ (d); \
+		(c) ^= (d) ^ ((b) << 7); \
+		(a) = MB_ROTL32(a, 5); \
+		(c) = MB_ROTL32(c, 22); \
+	} while (0)
+
+/*
+ * Rounds of the permutation over the 32-word state s, six with alpha_n
+ * for a message block or twelve with alpha_f for the last one.
+ */
+MB_INLINE void
+hamsi_mb_perm(mb_u32 s[32], const sph_u32 *alpha, int rounds)
+{
+	int r, i;
+
+	for (r = 0; r < rounds; r ++) {
+		for (i = 0; i < 32; i ++)
+			s[i] ^= mb_set1_32(alpha[i]);
+		s[1] ^= mb_set1_32((sph_u32)r);
+
+		for (i = 0; i < 8; i ++)
+			SBOX(s[i], s[i + 8], s[i + 16], s[i + 24]);
+
+		L(s[0x00], s[0x09], s[0x12], s[0x1B]);
+		L(s[0x01], s[0x0A], s[0x13], s[0x1C]);
+		L(s[0x02], s[0x0B], s[0x14], s[0x1D]);
+		L(s[0x03], s[0x0C], s[0x15], s[0x1E]);
+		L(s[0x04], s[0x0D], s[0x16], s[0x1F]);
+		L(s[0x05], s[0x0E], s[0x17], s[0x18]);
+		L(s[0x06], s[0x0F], s[0x10], s[0x19]);
+		L(s[0x07], s[0x08], s[0x11], s[0x1A]);
+		L(s[0x00], s[0x02], s[0x05], s[0x07]);
+		L(s[0x10], s[0x13], s[0x15], s[0x16]);
+		L(s[0x09], s[0x0B], s[0x0C], s[0x0E]);
+		L(s[0x19], s[0x1A], s[0x1C], s[0x1F]);
+	}
+}
+
+/*
+ * One block: the expanded message m and the chaining value h are
+ * concatenated into the state, permuted, and the state words that
+ * came from h are fed forward into it.
+ */
+MB_INLINE void
+hamsi_mb_block(mb_u32 h[16], const mb_u32 m[16], const sph_u32 *alpha,
+	int rounds)
+{
+	mb_u32 s[32];
+	int i;
+
+	for (i = 0; i < 2; i ++) {
+		s[16 * i + 0x0] = m[8 * i + 0];
+		s[16 * i + 0x1] = m[8 * i + 1];
+		s[16 * i + 0x2] = h[8 * i + 0];
+		s[16 * i + 0x3] = h[8 * i + 1];
+		s[16 * i + 0x4] = m[8 * i + 2];
+		s[16 * i + 0x5] = m[8 * i + 3];
+		s[16 * i + 0x6] = h[8 * i + 2];
+		s[16 * i + 0x7] = h[8 * i + 3];
+		s[16 * i + 0x8] = h[8 * i + 4];
+		s[16 * i + 0x9] = h[8 * i + 5];
+		s[16 * i + 0xA] = m[8 * i + 4];
+		s[16 * i + 0xB] = m[8 * i + 5];
+		s[16 * i + 0xC] = h[8 * i + 6];
+		s[16 * i + 0xD] = h[8 * i + 7];
+		s[16 * i + 0xE] = m[8 * i + 6];
+		s[16 * i + 0xF] = m[8 * i + 7];
+	}
+
+	hamsi_mb_perm(s, alpha, rounds);
+
+	for (i = 0; i < 8; i ++) {
+		h[i] ^= s[i];
+		h[8 + i] ^= s[16 + i];
+	}
+}
+
+MB_INLINE void
+hamsi512_mb_body(const unsigned char *const in[SPH_MB_LANES],
+	unsigned char *const out[SPH_MB_LANES])
+{
+	const unsigned char *pad[SPH_MB_LANES], *len[SPH_MB_LANES];
+	mb_u32 h[16], m[16];
+	int i, j;
+
+	for (i = 0; i < 16; i ++)
+		h[i] = mb_set1_32(IV512[i]);
+	for (j = 0; j < SPH_MB_LANES; j ++) {
+		pad[j] = pad_block;
+		len[j] = len_block;
+	}
+
+	for (i = 0; i < 16; i ++) {
+		hamsi_mb_expand(m, in, 8 * i);
+		hamsi_mb_block(h, m, alpha_n, 6);
+	}
+
+	hamsi_mb_expand(m, pad, 0);
+	hamsi_mb_block(h, m, alpha_n, 6);
+	hamsi_mb_expand(m, len, 0);
+	hamsi_mb_block(h, m, alpha_f, 12);
+
+	for (i = 0; i < 16; i ++)
+		mb_store32_be(out, i, &h[i]);
+}
+
+SPH_MB_DISPATCH(sph_hamsi512, hamsi512_mb_body)
+
+#endif
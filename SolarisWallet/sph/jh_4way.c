@@ -0,0 +1,264 @@
+/*
+ * Multi-buffer JH-512 over 128-byte messages, four lanes here and
+ * eight through jh_8way.c.
+ *
+ * A 128-byte message is two 64-byte blocks, followed by one padding
+ * block (0x80, zeros and the 1024-bit length). The bitslice state is
+ * kept big-endian here, as in the specification; the scalar code uses
+ * byte-swapped constants instead, which gives the same digest.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_4way.h"
+
+#if SPH_4WAY
+
+#include "4way_helper.c"
+
+static const sph_u64 IV512[16] = {
+	SPH_C64(0x6fd14b963e00aa17), SPH_C64(0x636a2e057a15d543),
+	SPH_C64(0x8a225e8d0c97ef0b), SPH_C64(0xe9341259f2b3c361),
+	SPH_C64(0x891da0c1536f801e), SPH_C64(0x2aa9056bea2b6d80),
+	SPH_C64(0x588eccdb2075baa6), SPH_C64(0xa90f3a76baf83bf7),
+	SPH_C64(0x0169e60541e34a69), SPH_C64(0x46b58a8e2e6fe65a),
+	SPH_C64(0x1047a7d0c1843c24), SPH_C64(0x3b6e71b12d5ac199),
+	SPH_C64(0xcf57f6ec9db1f856), SPH_C64(0xa706887c5716b156),
+	SPH_C64(0xe3c2fcdfe68517fb), SPH_C64(0x545a4678cc8cdd4b)
+};
+
+/*
+ * Round constants, four words per round: the high and low halves of
+ * the constant for the even words, then for the odd words.
+ */
+static const sph_u64 C[168] = {
+	SPH_C64(0x72d5dea2df15f867), SPH_C64(0x7b84150ab7231557),
+	SPH_C64(0x81abd6904d5a87f6), SPH_C64(0x4e9f4fc5c3d12b40),
+	SPH_C64(0xea983ae05c45fa9c), SPH_C64(0x03c5d29966b2999a),
+	SPH_C64(0x660296b4f2bb538a), SPH_C64(0xb556141a88dba231),
+	SPH_C64(0x03a35a5c9a190edb), SPH_C64(0x403fb20a87c14410),
+	SPH_C64(0x1c051980849e951d), SPH_C64(0x6f33ebad5ee7cddc),
+	SPH_C64(0x10ba139202bf6b41), SPH_C64(0xdc786515f7bb27d0),
+	SPH_C64(0x0a2c813937aa7850), SPH_C64(0x3f1abfd2410091d3),
+	SPH_C64(0x422d5a0df6cc7e90), SPH_C64(0xdd629f9c92c097ce),
+	SPH_C64(0x185ca70bc72b44ac), SPH_C64(0xd1df65d663c6fc23),
+	SPH_C64(0x976e6c039ee0b81a), SPH_C64(0x2105457e446ceca8),
+	SPH_C64(0xeef103bb5d8e61fa), SPH_C64(0xfd9697b294838197),
+	SPH_C64(0x4a8e8537db03302f), SPH_C64(0x2a678d2dfb9f6a95),
+	SPH_C64(0x8afe7381f8b8696c), SPH_C64(0x8ac77246c07f4214),
+	SPH_C64(0xc5f4158fbdc75ec4), SPH_C64(0x75446fa78f11bb80),
+	SPH_C64(0x52de75b7aee488bc), SPH_C64(0x82b8001e98a6a3f4),
+	SPH_C64(0x8ef48f33a9a36315), SPH_C64(0xaa5f5624d5b7f989),
+	SPH_C64(0xb6f1ed207c5ae0fd), SPH_C64(0x36cae95a06422c36),
+	SPH_C64(0xce2935434efe983d), SPH_C64(0x533af974739a4ba7),
+	SPH_C64(0xd0f51f596f4e8186), SPH_C64(0x0e9dad81afd85a9f),
+	SPH_C64(0xa7050667ee34626a), SPH_C64(0x8b0b28be6eb91727),
+	SPH_C64(0x47740726c680103f), SPH_C64(0xe0a07e6fc67e487b),
+	SPH_C64(0x0d550aa54af8a4c0), SPH_C64(0x91e3e79f978ef19e),
+	SPH_C64(0x8676728150608dd4), SPH_C64(0x7e9e5a41f3e5b062),
+	SPH_C64(0xfc9f1fec4054207a), SPH_C64(0xe3e41a00cef4c984),
+	SPH_C64(0x4fd794f59dfa95d8), SPH_C64(0x552e7e1124c354a5),
+	SPH_C64(0x5bdf7228bdfe6e28), SPH_C64(0x78f57fe20fa5c4b2),
+	SPH_C64(0x05897cefee49d32e), SPH_C64(0x447e9385eb28597f),
+	SPH_C64(0x705f6937b324314a), SPH_C64(0x5e8628f11dd6e465),
+	SPH_C64(0xc71b770451b920e7), SPH_C64(0x74fe43e823d4878a),
+	SPH_C64(0x7d29e8a3927694f2), SPH_C64(0xddcb7a099b30d9c1),
+	SPH_C64(0x1d1b30fb5bdc1be0), SPH_C64(0xda24494ff29c82bf),
+	SPH_C64(0xa4e7ba31b470bfff), SPH_C64(0x0d324405def8bc48),
+	SPH_C64(0x3baefc3253bbd339), SPH_C64(0x459fc3c1e0298ba0),
+	SPH_C64(0xe5c905fdf7ae090f), SPH_C64(0x947034124290f134),
+	SPH_C64(0xa271b701e344ed95), SPH_C64(0xe93b8e364f2f984a),
+	SPH_C64(0x88401d63a06cf615), SPH_C64(0x47c1444b8752afff),
+	SPH_C64(0x7ebb4af1e20ac630), SPH_C64(0x4670b6c5cc6e8ce6),
+	SPH_C64(0xa4d5a456bd4fca00), SPH_C64(0xda9d844bc83e18ae),
+	SPH_C64(0x7357ce453064d1ad), SPH_C64(0xe8a6ce68145c2567),
+	SPH_C64(0xa3da8cf2cb0ee116), SPH_C64(0x33e906589a94999a),
+	SPH_C64(0x1f60b220c26f847b), SPH_C64(0xd1ceac7fa0d18518),
+	SPH_C64(0x32595ba18ddd19d3), SPH_C64(0x509a1cc0aaa5b446),
+	SPH_C64(0x9f3d6367e4046bba), SPH_C64(0xf6ca19ab0b56ee7e),
+	SPH_C64(0x1fb179eaa9282174), SPH_C64(0xe9bdf7353b3651ee),
+	SPH_C64(0x1d57ac5a7550d376), SPH_C64(0x3a46c2fea37d7001),
+	SPH_C64(0xf735c1af98a4d842), SPH_C64(0x78edec209e6b6779),
+	SPH_C64(0x41836315ea3adba8), SPH_C64(0xfac33b4d32832c83),
+	SPH_C64(0xa7403b1f1c2747f3), SPH_C64(0x5940f034b72d769a),
+	SPH_C64(0xe73e4e6cd2214ffd), SPH_C64(0xb8fd8d39dc5759ef),
+	SPH_C64(0x8d9b0c492b49ebda), SPH_C64(0x5ba2d74968f3700d),
+	SPH_C64(0x7d3baed07a8d5584), SPH_C64(0xf5a5e9f0e4f88e65),
+	SPH_C64(0xa0b8a2f436103b53), SPH_C64(0x0ca8079e753eec5a),
+	SPH_C64(0x9168949256e8884f), SPH_C64(0x5bb05c55f8babc4c),
+	SPH_C64(0xe3bb3b99f387947b), SPH_C64(0x75daf4d6726b1c5d),
+	SPH_C64(0x64aeac28dc34b36d), SPH_C64(0x6c34a550b828db71),
+	SPH_C64(0xf861e2f2108d512a), SPH_C64(0xe3db643359dd75fc),
+	SPH_C64(0x1cacbcf143ce3fa2), SPH_C64(0x67bbd13c02e843b0),
+	SPH_C64(0x330a5bca8829a175), SPH_C64(0x7f34194db416535c),
+	SPH_C64(0x923b94c30e794d1e), SPH_C64(0x797475d7b6eeaf3f),
+	SPH_C64(0xeaa8d4f7be1a3921), SPH_C64(0x5cf47e094c232751),
+	SPH_C64(0x26a32453ba323cd2), SPH_C64(0x44a3174a6da6d5ad),
+	SPH_C64(0xb51d3ea6aff2c908), SPH_C64(0x83593d98916b3c56),
+	SPH_C64(0x4cf87ca17286604d), SPH_C64(0x46e23ecc086ec7f6),
+	SPH_C64(0x2f9833b3b1bc765e), SPH_C64(0x2bd666a5efc4e62a),
+	SPH_C64(0x06f4b6e8bec1d436), SPH_C64(0x74ee8215bcef2163),
+	SPH_C64(0xfdc14e0df453c969), SPH_C64(0xa77d5ac406585826),
+	SPH_C64(0x7ec1141606e0fa16), SPH_C64(0x7e90af3d28639d3f),
+	SPH_C64(0xd2c9f2e3009bd20c), SPH_C64(0x5faace30b7d40c30),
+	SPH_C64(0x742a5116f2e03298), SPH_C64(0x0deb30d8e3cef89a),
+	SPH_C64(0x4bc59e7bb5f17992), SPH_C64(0xff51e66e048668d3),
+	SPH_C64(0x9b234d57e6966731), SPH_C64(0xcce6a6f3170a7505),
+	SPH_C64(0xb17681d913326cce), SPH_C64(0x3c175284f805a262),
+	SPH_C64(0xf42bcbb378471547), SPH_C64(0xff46548223936a48),
+	SPH_C64(0x38df58074e5e6565), SPH_C64(0xf2fc7c89fc86508e),
+	SPH_C64(0x31702e44d00bca86), SPH_C64(0xf04009a23078474e),
+	SPH_C64(0x65a0ee39d1f73883), SPH_C64(0xf75ee937e42c3abd),
+	SPH_C64(0x2197b2260113f86f), SPH_C64(0xa344edd1ef9fdee7),
+	SPH_C64(0x8ba0df15762592d9), SPH_C64(0x3c85f7f612dc42be),
+	SPH_C64(0xd8a7ec7cab27b07e), SPH_C64(0x538d7ddaaa3ea8de),
+	SPH_C64(0xaa25ce93bd0269d8), SPH_C64(0x5af643fd1a7308f9),
+	SPH_C64(0xc05fefda174a19a5), SPH_C64(0x974d66334cfd216a),
+	SPH_C64(0x35b49831db411570), SPH_C64(0xea1e0fbbedcd549b),
+	SPH_C64(0x9ad063a151974072), SPH_C64(0xf6759dbf91476fe2)
+};
+
+#define Sb(x0, x1, x2, x3, c)   do { \
+		mb_u64 tmp; \
+		x3 = ~x3; \
+		x0 ^= (c) & ~x2; \
+		tmp = (c) ^ (x0 & x1); \
+		x0 ^= x2 & x3; \
+		x3 ^= ~x1 & x2; \
+		x1 ^= x0 & x2; \
+		x2 ^= x0 & ~x3; \
+		x0 ^= x1 | x3; \
+		x3 ^= x1 & x2; \
+		x1 ^= tmp & x0; \
+		x2 ^= tmp; \
+	} while (0)
+
+#define Lb(x0, x1, x2, x3, x4, x5, x6, x7)   do { \
+		x4 ^= x1; \
+		x5 ^= x2; \
+		x6 ^= x3 ^ x0; \
+		x7 ^= x0; \
+		x0 ^= x5; \
+		x1 ^= x6; \
+		x2 ^= x7 ^ x4; \
+		x3 ^= x4; \
+	} while (0)
+
+static const sph_u64 Wmask[6] = {
+	SPH_C64(0x5555555555555555), SPH_C64(0x3333333333333333),
+	SPH_C64(0x0F0F0F0F0F0F0F0F), SPH_C64(0x00FF00FF00FF00FF),
+	SPH_C64(0x0000FFFF0000FFFF), SPH_C64(0x00000000FFFFFFFF)
+};
+
+/*
+ * The swap of round r mod 7: adjacent groups of 1, 2, 4, ... 32 bits
+ * within each word, or the two halves of the 128-bit word for 6.
+ */
+MB_INLINE void
+jh_mb_swap(mb_u64 x[2], int ro)
+{
+	if (ro == 6) {
+		mb_u64 t = x[0];
+
+		x[0] = x[1];
+		x[1] = t;
+	} else {
+		mb_u64 c = mb_set1(Wmask[ro]);
+		int n = 1 << ro;
+
+		x[0] = ((x[0] >> n) & c) | ((x[0] & c) << n);
+		x[1] = ((x[1] >> n) & c) | ((x[1] & c) << n);
+	}
+}
+
+/*
+ * E8 over the state: h[2 * i] and h[2 * i + 1] are the high and low
+ * halves of the 128-bit word i.
+ */
+MB_INLINE void
+jh512_mb_e8(mb_u64 h[16])
+{
+	int r, i;
+
+	for (r = 0; r < 42; r ++) {
+		mb_u64 ce_hi = mb_set1(C[4 * r + 0]);
+		mb_u64 ce_lo = mb_set1(C[4 * r + 1]);
+		mb_u64 co_hi = mb_set1(C[4 * r + 2]);
+		mb_u64 co_lo = mb_set1(C[4 * r + 3]);
+
+		Sb(h[0], h[4], h[ 8], h[12], ce_hi);
+		Sb(h[1], h[5], h[ 9], h[13], ce_lo);
+		Sb(h[2], h[6], h[10], h[14], co_hi);
+		Sb(h[3], h[7], h[11], h[15], co_lo);
+		Lb(h[0], h[4], h[ 8], h[12], h[2], h[6], h[10], h[14]);
+		Lb(h[1], h[5], h[ 9], h[13], h[3], h[7], h[11], h[15]);
+		for (i = 1; i < 8; i += 2)
+			jh_mb_swap(&h[2 * i], r % 7);
+	}
+}
+
+MB_INLINE void
+jh512_mb_block(mb_u64 h[16], const mb_u64 m[8])
+{
+	int i;
+
+	for (i = 0; i < 8; i ++)
+		h[i] ^= m[i];
+	jh512_mb_e8(h);
+	for (i = 0; i < 8; i ++)
+		h[8 + i] ^= m[i];
+}
+
+MB_INLINE void
+jh512_mb_body(const unsigned char *const in[SPH_MB_LANES],
+	unsigned char *const out[SPH_MB_LANES])
+{
+	mb_u64 h[16], m[8];
+	int i;
+
+	for (i = 0; i < 16; i ++)
+		h[i] = mb_set1(IV512[i]);
+
+	for (i = 0; i < 8; i ++)
+		m[i] = mb_load_be(in, i);
+	jh512_mb_block(h, m);
+	for (i = 0; i < 8; i ++)
+		m[i] = mb_load_be(in, 8 + i);
+	jh512_mb_block(h, m);
+
+	for (i = 0; i < 8; i ++)
+		m[i] = mb_set1(0);
+	m[0] = mb_set1(SPH_C64(0x8000000000000000));
+	m[7] = mb_set1(1024);
+	jh512_mb_block(h, m);
+
+	for (i = 0; i < 8; i ++)
+		mb_store_be(out, i, &h[8 + i]);
+}
+
+SPH_MB_DISPATCH(sph_jh512, jh512_mb_body)
+
+#endif
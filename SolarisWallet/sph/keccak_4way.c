@@ -0,0 +1,166 @@
+/*
+ * Multi-buffer Keccak-512 over 128-byte messages, four lanes here and
+ * eight through keccak_8way.c.
+ *
+ * Same function as sph_keccak512() (original Keccak padding, not
+ * SHA-3): the 72-byte rate takes the message in two blocks, the second
+ * holding the last 56 message bytes followed by the 0x01 ... 0x80
+ * padding.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_4way.h"
+
+#if SPH_4WAY
+
+#include "4way_helper.c"
+
+static const sph_u64 RC[24] = {
+	SPH_C64(0x0000000000000001), SPH_C64(0x0000000000008082),
+	SPH_C64(0x800000000000808A), SPH_C64(0x8000000080008000),
+	SPH_C64(0x000000000000808B), SPH_C64(0x0000000080000001),
+	SPH_C64(0x8000000080008081), SPH_C64(0x8000000000008009),
+	SPH_C64(0x000000000000008A), SPH_C64(0x0000000000000088),
+	SPH_C64(0x0000000080008009), SPH_C64(0x000000008000000A),
+	SPH_C64(0x000000008000808B), SPH_C64(0x800000000000008B),
+	SPH_C64(0x8000000000008089), SPH_C64(0x8000000000008003),
+	SPH_C64(0x8000000000008002), SPH_C64(0x8000000000000080),
+	SPH_C64(0x000000000000800A), SPH_C64(0x800000008000000A),
+	SPH_C64(0x8000000080008081), SPH_C64(0x8000000000008080),
+	SPH_C64(0x0000000080000001), SPH_C64(0x8000000080008008)
+};
+
+/*
+ * One round, with theta applied on the way into rho and pi:
+ * b[y + 5 * ((2 * x + 3 * y) % 5)] = ROTL(a[x + 5 * y] ^ d[x], r[x][y]),
+ * then chi from b back into a, and iota.
+ */
+#define KECCAK_ROUND(r)   do { \
+		c[0] = a[0] ^ a[5] ^ a[10] ^ a[15] ^ a[20]; \
+		c[1] = a[1] ^ a[6] ^ a[11] ^ a[16] ^ a[21]; \
+		c[2] = a[2] ^ a[7] ^ a[12] ^ a[17] ^ a[22]; \
+		c[3] = a[3] ^ a[8] ^ a[13] ^ a[18] ^ a[23]; \
+		c[4] = a[4] ^ a[9] ^ a[14] ^ a[19] ^ a[24]; \
+		d[0] = c[4] ^ MB_ROTL(c[1], 1); \
+		d[1] = c[0] ^ MB_ROTL(c[2], 1); \
+		d[2] = c[1] ^ MB_ROTL(c[3], 1); \
+		d[3] = c[2] ^ MB_ROTL(c[4], 1); \
+		d[4] = c[3] ^ MB_ROTL(c[0], 1); \
+		b[ 0] = a[ 0] ^ d[0]; \
+		b[ 1] = MB_ROTL(a[ 6] ^ d[1], 44); \
+		b[ 2] = MB_ROTL(a[12] ^ d[2], 43); \
+		b[ 3] = MB_ROTL(a[18] ^ d[3], 21); \
+		b[ 4] = MB_ROTL(a[24] ^ d[4], 14); \
+		b[ 5] = MB_ROTL(a[ 3] ^ d[3], 28); \
+		b[ 6] = MB_ROTL(a[ 9] ^ d[4], 20); \
+		b[ 7] = MB_ROTL(a[10] ^ d[0],  3); \
+		b[ 8] = MB_ROTL(a[16] ^ d[1], 45); \
+		b[ 9] = MB_ROTL(a[22] ^ d[2], 61); \
+		b[10] = MB_ROTL(a[ 1] ^ d[1],  1); \
+		b[11] = MB_ROTL(a[ 7] ^ d[2],  6); \
+		b[12] = MB_ROTL(a[13] ^ d[3], 25); \
+		b[13] = MB_ROTL(a[19] ^ d[4],  8); \
+		b[14] = MB_ROTL(a[20] ^ d[0], 18); \
+		b[15] = MB_ROTL(a[ 4] ^ d[4], 27); \
+		b[16] = MB_ROTL(a[ 5] ^ d[0], 36); \
+		b[17] = MB_ROTL(a[11] ^ d[1], 10); \
+		b[18] = MB_ROTL(a[17] ^ d[2], 15); \
+		b[19] = MB_ROTL(a[23] ^ d[3], 56); \
+		b[20] = MB_ROTL(a[ 2] ^ d[2], 62); \
+		b[21] = MB_ROTL(a[ 8] ^ d[3], 55); \
+		b[22] = MB_ROTL(a[14] ^ d[4], 39); \
+		b[23] = MB_ROTL(a[15] ^ d[0], 41); \
+		b[24] = MB_ROTL(a[21] ^ d[1],  2); \
+		a[ 0] = b[ 0] ^ (~b[ 1] & b[ 2]); \
+		a[ 1] = b[ 1] ^ (~b[ 2] & b[ 3]); \
+		a[ 2] = b[ 2] ^ (~b[ 3] & b[ 4]); \
+		a[ 3] = b[ 3] ^ (~b[ 4] & b[ 0]); \
+		a[ 4] = b[ 4] ^ (~b[ 0] & b[ 1]); \
+		a[ 5] = b[ 5] ^ (~b[ 6] & b[ 7]); \
+		a[ 6] = b[ 6] ^ (~b[ 7] & b[ 8]); \
+		a[ 7] = b[ 7] ^ (~b[ 8] & b[ 9]); \
+		a[ 8] = b[ 8] ^ (~b[ 9] & b[ 5]); \
+		a[ 9] = b[ 9] ^ (~b[ 5] & b[ 6]); \
+		a[10] = b[10] ^ (~b[11] & b[12]); \
+		a[11] = b[11] ^ (~b[12] & b[13]); \
+		a[12] = b[12] ^ (~b[13] & b[14]); \
+		a[13] = b[13] ^ (~b[14] & b[10]); \
+		a[14] = b[14] ^ (~b[10] & b[11]); \
+		a[15] = b[15] ^ (~b[16] & b[17]); \
+		a[16] = b[16] ^ (~b[17] & b[18]); \
+		a[17] = b[17] ^ (~b[18] & b[19]); \
+		a[18] = b[18] ^ (~b[19] & b[15]); \
+		a[19] = b[19] ^ (~b[15] & b[16]); \
+		a[20] = b[20] ^ (~b[21] & b[22]); \
+		a[21] = b[21] ^ (~b[22] & b[23]); \
+		a[22] = b[22] ^ (~b[23] & b[24]); \
+		a[23] = b[23] ^ (~b[24] & b[20]); \
+		a[24] = b[24] ^ (~b[20] & b[21]); \
+		a[0] ^= mb_set1(RC[r]); \
+	} while (0)
+
+MB_INLINE void
+keccak_f1600_mb(mb_u64 a[25])
+{
+	mb_u64 b[25], c[5], d[5];
+	int r;
+
+	for (r = 0; r < 24; r += 4) {
+		KECCAK_ROUND(r);
+		KECCAK_ROUND(r + 1);
+		KECCAK_ROUND(r + 2);
+		KECCAK_ROUND(r + 3);
+	}
+}
+
+MB_INLINE void
+keccak512_mb_body(const unsigned char *const in[SPH_MB_LANES],
+	unsigned char *const out[SPH_MB_LANES])
+{
+	mb_u64 a[25];
+	int i;
+
+	for (i = 0; i < 25; i ++)
+		a[i] = mb_set1(0);
+
+	for (i = 0; i < 9; i ++)
+		a[i] ^= mb_load_le(in, i);
+	keccak_f1600_mb(a);
+
+	for (i = 0; i < 7; i ++)
+		a[i] ^= mb_load_le(in, 9 + i);
+	a[7] ^= mb_set1(SPH_C64(0x0000000000000001));
+	a[8] ^= mb_set1(SPH_C64(0x8000000000000000));
+	keccak_f1600_mb(a);
+
+	for (i = 0; i < 8; i ++)
+		mb_store_le(out, i, &a[i]);
+}
+
+SPH_MB_DISPATCH(sph_keccak512, keccak512_mb_body)
+
+#endif
@@ -0,0 +1,298 @@
+/*
+ * Multi-buffer Luffa-512 over 128-byte messages, four lanes here and
+ * eight through luffa_8way.c.
+ *
+ * The message is four 32-byte blocks, each injected into the five
+ * 256-bit sub-states by MI and followed by the permutation P. The
+ * padding block (0x80 and zeros) and two blank blocks follow; the
+ * digest is the xor of the sub-states after each blank block.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_4way.h"
+
+#if SPH_4WAY
+
+#include "4way_helper.c"
+
+static const sph_u32 V_INIT[5][8] = {
+	{
+		SPH_C32(0x6d251e69), SPH_C32(0x44b051e0),
+		SPH_C32(0x4eaa6fb4), SPH_C32(0xdbf78465),
+		SPH_C32(0x6e292011), SPH_C32(0x90152df4),
+		SPH_C32(0xee058139), SPH_C32(0xdef610bb)
+	}, {
+		SPH_C32(0xc3b44b95), SPH_C32(0xd9d2f256),
+		SPH_C32(0x70eee9a0), SPH_C32(0xde099fa3),
+		SPH_C32(0x5d9b0557), SPH_C32(0x8fc944b3),
+		SPH_C32(0xcf1ccf0e), SPH_C32(0x746cd581)
+	}, {
+		SPH_C32(0xf7efc89d), SPH_C32(0x5dba5781),
+		SPH_C32(0x04016ce5), SPH_C32(0xad659c05),
+		SPH_C32(0x0306194f), SPH_C32(0x666d1836),
+		SPH_C32(0x24aa230a), SPH_C32(0x8b264ae7)
+	}, {
+		SPH_C32(0x858075d5), SPH_C32(0x36d79cce),
+		SPH_C32(0xe571f7d7), SPH_C32(0x204b1f67),
+		SPH_C32(0x35870c6a), SPH_C32(0x57e9e923),
+		SPH_C32(0x14bcb808), SPH_C32(0x7cde72ce)
+	}, {
+		SPH_C32(0x6c68e9be), SPH_C32(0x5ec41e22),
+		SPH_C32(0xc825b7c7), SPH_C32(0xaffb4363),
+		SPH_C32(0xf5df3999), SPH_C32(0x0fc688f1),
+		SPH_C32(0xb07224cc), SPH_C32(0x03e86cea)
+	}
+};
+
+static const sph_u32 RC[5][2][8] = {
+	{ {
+		SPH_C32(0x303994a6), SPH_C32(0xc0e65299),
+		SPH_C32(0x6cc33a12), SPH_C32(0xdc56983e),
+		SPH_C32(0x1e00108f), SPH_C32(0x7800423d),
+		SPH_C32(0x8f5b7882), SPH_C32(0x96e1db12)
+	}, {
+		SPH_C32(0xe0337818), SPH_C32(0x441ba90d),
+		SPH_C32(0x7f34d442), SPH_C32(0x9389217f),
+		SPH_C32(0xe5a8bce6), SPH_C32(0x5274baf4),
+		SPH_C32(0x26889ba7), SPH_C32(0x9a226e9d)
+	} }, { {
+		SPH_C32(0xb6de10ed), SPH_C32(0x70f47aae),
+		SPH_C32(0x0707a3d4), SPH_C32(0x1c1e8f51),
+		SPH_C32(0x707a3d45), SPH_C32(0xaeb28562),
+		SPH_C32(0xbaca1589), SPH_C32(0x40a46f3e)
+	}, {
+		SPH_C32(0x01685f3d), SPH_C32(0x05a17cf4),
+		SPH_C32(0xbd09caca), SPH_C32(0xf4272b28),
+		SPH_C32(0x144ae5cc), SPH_C32(0xfaa7ae2b),
+		SPH_C32(0x2e48f1c1), SPH_C32(0xb923c704)
+	} }, { {
+		SPH_C32(0xfc20d9d2), SPH_C32(0x34552e25),
+		SPH_C32(0x7ad8818f), SPH_C32(0x8438764a),
+		SPH_C32(0xbb6de032), SPH_C32(0xedb780c8),
+		SPH_C32(0xd9847356), SPH_C32(0xa2c78434)
+	}, {
+		SPH_C32(0xe25e72c1), SPH_C32(0xe623bb72),
+		SPH_C32(0x5c58a4a4), SPH_C32(0x1e38e2e7),
+		SPH_C32(0x78e38b9d), SPH_C32(0x27586719),
+		SPH_C32(0x36eda57f), SPH_C32(0x703aace7)
+	} }, { {
+		SPH_C32(0xb213afa5), SPH_C32(0xc84ebe95),
+		SPH_C32(0x4e608a22), SPH_C32(0x56d858fe),
+		SPH_C32(0x343b138f), SPH_C32(0xd0ec4e3d),
+		SPH_C32(0x2ceb4882), SPH_C32(0xb3ad2208)
+	}, {
+		SPH_C32(0xe028c9bf), SPH_C32(0x44756f91),
+		SPH_C32(0x7e8fce32), SPH_C32(0x956548be),
+		SPH_C32(0xfe191be2), SPH_C32(0x3cb226e5),
+		SPH_C32(0x5944a28e), SPH_C32(0xa1c4c355)
+	} }, { {
+		SPH_C32(0xf0d2e9e3), SPH_C32(0xac11d7fa),
+		SPH_C32(0x1bcb66f2), SPH_C32(0x6f2d9bc9),
+		SPH_C32(0x78602649), SPH_C32(0x8edae952),
+		SPH_C32(0x3b6ba548), SPH_C32(0xedae9520)
+	}, {
+		SPH_C32(0x5090d577), SPH_C32(0x2d1925ab),
+		SPH_C32(0xb46496ac), SPH_C32(0xd1925ab0),
+		SPH_C32(0x29131ab6), SPH_C32(0x0fc053c3),
+		SPH_C32(0x3f014f0c), SPH_C32(0xfc053c31)
+	} }
+};
+
+/*
+ * Multiplication by 2 in the ring of MI, on the eight words of one
+ * sub-state; d and s may be the same.
+ */
+MB_INLINE void
+luffa_mb_m2(mb_u32 d[8], const mb_u32 s[8])
+{
+	mb_u32 tmp = s[7];
+
+	d[7] = s[6];
+	d[6] = s[5];
+	d[5] = s[4];
+	d[4] = s[3] ^ tmp;
+	d[3] = s[2] ^ tmp;
+	d[2] = s[1];
+	d[1] = s[0] ^ tmp;
+	d[0] = tmp;
+}
+
+MB_INLINE void
+luffa_mb_xor(mb_u32 d[8], const mb_u32 s[8])
+{
+	int i;
+
+	for (i = 0; i < 8; i ++)
+		d[i] ^= s[i];
+}
+
+/*
+ * Message injection of the 32-byte block m, the same sequence of
+ * doublings and xors as MI5 in luffa.c.
+ */
+MB_INLINE void
+luffa_mb_mi(mb_u32 v[5][8], mb_u32 m[8])
+{
+	mb_u32 a[8], b[8];
+	int i;
+
+	for (i = 0; i < 8; i ++)
+		a[i] = v[0][i] ^ v[1][i] ^ v[2][i] ^ v[3][i] ^ v[4][i];
+	luffa_mb_m2(a, a);
+	for (i = 0; i < 5; i ++)
+		luffa_mb_xor(v[i], a);
+
+	luffa_mb_m2(b, v[0]);
+	luffa_mb_xor(b, v[1]);
+	luffa_mb_m2(v[1], v[1]);
+	luffa_mb_xor(v[1], v[2]);
+	luffa_mb_m2(v[2], v[2]);
+	luffa_mb_xor(v[2], v[3]);
+	luffa_mb_m2(v[3], v[3]);
+	luffa_mb_xor(v[3], v[4]);
+	luffa_mb_m2(v[4], v[4]);
+	luffa_mb_xor(v[4], v[0]);
+	luffa_mb_m2(v[0], b);
+	luffa_mb_xor(v[0], v[4]);
+	luffa_mb_m2(v[4], v[4]);
+	luffa_mb_xor(v[4], v[3]);
+	luffa_mb_m2(v[3], v[3]);
+	luffa_mb_xor(v[3], v[2]);
+	luffa_mb_m2(v[2], v[2]);
+	luffa_mb_xor(v[2], v[1]);
+	luffa_mb_m2(v[1], v[1]);
+	luffa_mb_xor(v[1], b);
+
+	for (i = 0; i < 5; i ++) {
+		if (i > 0)
+			luffa_mb_m2(m, m);
+		luffa_mb_xor(v[i], m);
+	}
+}
+
+#define SUB_CRUMB(a0, a1, a2, a3)   do { \
+		mb_u32 tmp = (a0); \
+		(a0) |= (a1); \
+		(a2) ^= (a3); \
+		(a1) = ~(a1); \
+		(a0) ^= (a3); \
+		(a3) &= tmp; \
+		(a1) ^= (a3); \
+		(a3) ^= (a2); \
+		(a2) &= (a0); \
+		(a0) = ~(a0); \
+		(a2) ^= (a1); \
+		(a1) |= (a3); \
+		tmp ^= (a1); \
+		(a3) ^= (a2); \
+		(a2) &= (a1); \
+		(a1) ^= (a0); \
+		(a0) = tmp; \
+	} while (0)
+
+#define MIX_WORD(u, v)   do { \
+		(v) ^= (u); \
+		(u) = MB_ROTL32((u), 2) ^ (v); \
+		(v) = MB_ROTL32((v), 14) ^ (u); \
+		(u) = MB_ROTL32((u), 10) ^ (v); \
+		(v) = MB_ROTL32((v), 1); \
+	} while (0)
+
+/*
+ * The step function of sub-permutation j, eight rounds, after the
+ * tweak that rotates the upper half of sub-state j by j bits.
+ */
+MB_INLINE void
+luffa_mb_q(mb_u32 v[8], int j)
+{
+	int r;
+
+	if (j > 0) {
+		v[4] = MB_ROTL32(v[4], j);
+		v[5] = MB_ROTL32(v[5], j);
+		v[6] = MB_ROTL32(v[6], j);
+		v[7] = MB_ROTL32(v[7], j);
+	}
+
+	for (r = 0; r < 8; r ++) {
+		SUB_CRUMB(v[0], v[1], v[2], v[3]);
+		SUB_CRUMB(v[5], v[6], v[7], v[4]);
+		MIX_WORD(v[0], v[4]);
+		MIX_WORD(v[1], v[5]);
+		MIX_WORD(v[2], v[6]);
+		MIX_WORD(v[3], v[7]);
+		v[0] ^= mb_set1_32(RC[j][0][r]);
+		v[4] ^= mb_set1_32(RC[j][1][r]);
+	}
+}
+
+MB_INLINE void
+luffa_mb_block(mb_u32 v[5][8], mb_u32 m[8])
+{
+	luffa_mb_mi(v, m);
+	luffa_mb_q(v[0], 0);
+	luffa_mb_q(v[1], 1);
+	luffa_mb_q(v[2], 2);
+	luffa_mb_q(v[3], 3);
+	luffa_mb_q(v[4], 4);
+}
+
+MB_INLINE void
+luffa512_mb_body(const unsigned char *const in[SPH_MB_LANES],
+	unsigned char *const out[SPH_MB_LANES])
+{
+	mb_u32 v[5][8], m[8], h;
+	int i, j, b;
+
+	for (j = 0; j < 5; j ++)
+		for (i = 0; i < 8; i ++)
+			v[j][i] = mb_set1_32(V_INIT[j][i]);
+
+	for (b = 0; b < 4; b ++) {
+		for (i = 0; i < 8; i ++)
+			m[i] = mb_load32_be(in, 8 * b + i);
+		luffa_mb_block(v, m);
+	}
+
+	for (b = 0; b < 3; b ++) {
+		for (i = 0; i < 8; i ++)
+			m[i] = mb_set1_32(0);
+		if (b == 0)
+			m[0] = mb_set1_32(SPH_C32(0x80000000));
+		luffa_mb_block(v, m);
+		if (b == 0)
+			continue;
+		for (i = 0; i < 8; i ++) {
+			h = v[0][i] ^ v[1][i] ^ v[2][i] ^ v[3][i] ^ v[4][i];
+			mb_store32_be(out, 8 * (b - 1) + i, &h);
+		}
+	}
+}
+
+SPH_MB_DISPATCH(sph_luffa512, luffa512_mb_body)
+
+#endif
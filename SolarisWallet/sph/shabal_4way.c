@@ -0,0 +1,161 @@
+/*
+ * Multi-buffer Shabal-512 over 128-byte messages, four lanes here and
+ * eight through shabal_8way.c.
+ *
+ * A 128-byte message is two 64-byte blocks, with the block counter W
+ * at 1 and 2. The padding block (0x80 and zeros) is then processed
+ * with W at 3 and followed by three more permutations, the B and C
+ * words swapped before each. W is the same for all lanes, so it stays
+ * a scalar.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_4way.h"
+
+#if SPH_4WAY
+
+#include "4way_helper.c"
+
+static const sph_u32 A_init_512[12] = {
+	SPH_C32(0x20728DFD), SPH_C32(0x46C0BD53), SPH_C32(0xE782B699),
+	SPH_C32(0x55304632), SPH_C32(0x71B4EF90), SPH_C32(0x0EA9E82C),
+	SPH_C32(0xDBB930F1), SPH_C32(0xFAD06B8B), SPH_C32(0xBE0CAE40),
+	SPH_C32(0x8BD14410), SPH_C32(0x76D2ADAC), SPH_C32(0x28ACAB7F)
+};
+
+static const sph_u32 B_init_512[16] = {
+	SPH_C32(0xC1099CB7), SPH_C32(0x07B385F3), SPH_C32(0xE7442C26),
+	SPH_C32(0xCC8AD640), SPH_C32(0xEB6F56C7), SPH_C32(0x1EA81AA9),
+	SPH_C32(0x73B9D314), SPH_C32(0x1DE85D08), SPH_C32(0x48910A5A),
+	SPH_C32(0x893B22DB), SPH_C32(0xC5A0DF44), SPH_C32(0xBBC4324E),
+	SPH_C32(0x72D2F240), SPH_C32(0x75941D99), SPH_C32(0x6D8BDE82),
+	SPH_C32(0xA1A7502B)
+};
+
+static const sph_u32 C_init_512[16] = {
+	SPH_C32(0xD9BF68D1), SPH_C32(0x58BAD750), SPH_C32(0x56028CB2),
+	SPH_C32(0x8134F359), SPH_C32(0xB5D469D8), SPH_C32(0x941A8CC2),
+	SPH_C32(0x418B2A6E), SPH_C32(0x04052780), SPH_C32(0x7F07D787),
+	SPH_C32(0x5194358F), SPH_C32(0x3C60D665), SPH_C32(0xBE97D79A),
+	SPH_C32(0x950C3434), SPH_C32(0xAED9A06D), SPH_C32(0x2537DC8D),
+	SPH_C32(0x7CDB5969)
+};
+
+#define REP12(S)   S(0) S(1) S(2) S(3) S(4) S(5) S(6) S(7) \
+	S(8) S(9) S(10) S(11)
+#define REP16(S)   REP12(S) S(12) S(13) S(14) S(15)
+
+/*
+ * Step k = i + 16 * j of the permutation, for message word i. The
+ * multiplications by 5 and 3 are written as shifts and adds, which
+ * every vector unit has.
+ */
+#define PERM_ELT(k, i)   do { \
+		mb_u32 u = MB_ROTL32(a[((k) + 11) % 12], 15); \
+		u = a[(k) % 12] ^ ((u << 2) + u) ^ c[(24 - (i)) % 16]; \
+		a[(k) % 12] = ((u << 1) + u) ^ b[((i) + 13) % 16] \
+			^ (b[((i) + 9) % 16] & ~b[((i) + 6) % 16]) ^ m[i]; \
+		b[i] = ~(MB_ROTL32(b[i], 1) ^ a[(k) % 12]); \
+	} while (0);
+
+#define ROT_B(i)   b[i] = MB_ROTL32(b[i], 17);
+#define PERM_0(i)  PERM_ELT(i, i)
+#define PERM_1(i)  PERM_ELT((i) + 16, i)
+#define PERM_2(i)  PERM_ELT((i) + 32, i)
+#define ADD_C(k)   a[k] += c[((k) + 3) % 16] + c[((k) + 15) % 16] \
+	+ c[((k) + 27) % 16];
+
+MB_INLINE void
+shabal_mb_perm(mb_u32 a[12], mb_u32 b[16], const mb_u32 c[16],
+	const mb_u32 m[16])
+{
+	REP16(ROT_B)
+	REP16(PERM_0)
+	REP16(PERM_1)
+	REP16(PERM_2)
+	REP12(ADD_C)
+}
+
+MB_INLINE void
+shabal_mb_swap_bc(mb_u32 b[16], mb_u32 c[16])
+{
+	int i;
+
+	for (i = 0; i < 16; i ++) {
+		mb_u32 t = b[i];
+
+		b[i] = c[i];
+		c[i] = t;
+	}
+}
+
+MB_INLINE void
+shabal512_mb_body(const unsigned char *const in[SPH_MB_LANES],
+	unsigned char *const out[SPH_MB_LANES])
+{
+	mb_u32 a[12], b[16], c[16], m[16];
+	sph_u32 w;
+	int i;
+
+	for (i = 0; i < 12; i ++)
+		a[i] = mb_set1_32(A_init_512[i]);
+	for (i = 0; i < 16; i ++) {
+		b[i] = mb_set1_32(B_init_512[i]);
+		c[i] = mb_set1_32(C_init_512[i]);
+	}
+
+	for (w = 1; w <= 2; w ++) {
+		for (i = 0; i < 16; i ++) {
+			m[i] = mb_load32_le(in, 16 * (w - 1) + i);
+			b[i] += m[i];
+		}
+		a[0] ^= mb_set1_32(w);
+		shabal_mb_perm(a, b, c, m);
+		for (i = 0; i < 16; i ++)
+			c[i] -= m[i];
+		shabal_mb_swap_bc(b, c);
+	}
+
+	for (i = 0; i < 16; i ++)
+		m[i] = mb_set1_32(0);
+	m[0] = mb_set1_32(0x80);
+	b[0] += m[0];
+	a[0] ^= mb_set1_32(3);
+	shabal_mb_perm(a, b, c, m);
+	for (i = 0; i < 3; i ++) {
+		shabal_mb_swap_bc(b, c);
+		a[0] ^= mb_set1_32(3);
+		shabal_mb_perm(a, b, c, m);
+	}
+
+	for (i = 0; i < 16; i ++)
+		mb_store32_le(out, i, &b[i]);
+}
+
+SPH_MB_DISPATCH(sph_shabal512, shabal512_mb_body)
+
+#endif
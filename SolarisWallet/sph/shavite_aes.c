@@ -0,0 +1,155 @@
+/*
+ * SHAvite-3-512 over 128-byte messages with hardware AES.
+ *
+ * Follows the specification as the scalar shavite.c does. The 448-word
+ * round key schedule is kept as 112 128-bit words. A 128-byte message is
+ * one block compressed with a bit counter of 1024; the final block
+ * holds only padding (0x80, the 128-bit message length and the 16-bit
+ * output size) and is compressed with a counter of zero.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_aes_hw.h"
+
+#if SPH_AES_HW
+
+#include "aes_hw_helper.c"
+
+#define C32   SPH_C32
+
+static const sph_u32 IV512[] = {
+	C32(0x72FCCDD8), C32(0x79CA4727), C32(0x128A077B), C32(0x40D55AEC),
+	C32(0xD1901A06), C32(0x430AE307), C32(0xB29F5CD1), C32(0xDF07FBFC),
+	C32(0x8E45D73D), C32(0x681AB538), C32(0xBDE86578), C32(0xDD577E47),
+	C32(0xE275EADE), C32(0x502D9FCD), C32(0xB9357178), C32(0x022A4B9A)
+};
+
+/*
+ * Round key vector i from vectors i - 1 and i - 8, as the nonlinear
+ * step of the scalar schedule (a word rotation and a keyless AES round).
+ */
+#define KEY_NONLINEAR(rk, i) \
+	AES_HW_XOR(AES_HW_ROUND(AES_HW_ROT32(rk[(i) - 8]), AES_HW_ZERO), \
+		rk[(i) - 1])
+
+static AES_HW_FUNC void
+shavite_aes_compress(aes_hw_v128 h[4], const unsigned char *block,
+	sph_u32 c0, sph_u32 c1, sph_u32 c2, sph_u32 c3)
+{
+	aes_hw_v128 rk[112], p[4];
+	sph_u32 w[8];
+	int i, s, r;
+
+	for (i = 0; i < 8; i ++)
+		rk[i] = AES_HW_LOAD(block + 16 * i);
+
+	i = 8;
+	for (;;) {
+		for (s = 0; s < 4; s ++) {
+			rk[i] = KEY_NONLINEAR(rk, i);
+			if (i == 8)
+				rk[i] = AES_HW_XOR(rk[i],
+					AES_HW_SET32(c0, c1, c2, ~c3));
+			else if (i == 110)
+				rk[i] = AES_HW_XOR(rk[i],
+					AES_HW_SET32(c1, c0, c3, ~c2));
+			i ++;
+
+			rk[i] = KEY_NONLINEAR(rk, i);
+			if (i == 41)
+				rk[i] = AES_HW_XOR(rk[i],
+					AES_HW_SET32(c3, c2, c1, ~c0));
+			else if (i == 79)
+				rk[i] = AES_HW_XOR(rk[i],
+					AES_HW_SET32(c2, c3, c0, ~c1));
+			i ++;
+		}
+		if (i == 112)
+			break;
+		for (s = 0; s < 8; s ++) {
+			/* words u - 7 .. u - 4 straddle vectors i - 2 and i - 1 */
+			AES_HW_STORE(w, rk[i - 2]);
+			AES_HW_STORE(w + 4, rk[i - 1]);
+			rk[i] = AES_HW_XOR(rk[i - 8], AES_HW_LOAD(w + 1));
+			i ++;
+		}
+	}
+
+	p[0] = h[0];
+	p[1] = h[1];
+	p[2] = h[2];
+	p[3] = h[3];
+	for (r = 0, i = 0; r < 14; r ++, i += 8) {
+		aes_hw_v128 x, y, t;
+
+		x = AES_HW_XOR(p[1], rk[i]);
+		x = AES_HW_ROUND(x, rk[i + 1]);
+		x = AES_HW_ROUND(x, rk[i + 2]);
+		x = AES_HW_ROUND(x, rk[i + 3]);
+		x = AES_HW_ROUND(x, AES_HW_ZERO);
+		y = AES_HW_XOR(p[3], rk[i + 4]);
+		y = AES_HW_ROUND(y, rk[i + 5]);
+		y = AES_HW_ROUND(y, rk[i + 6]);
+		y = AES_HW_ROUND(y, rk[i + 7]);
+		y = AES_HW_ROUND(y, AES_HW_ZERO);
+		p[0] = AES_HW_XOR(p[0], x);
+		p[2] = AES_HW_XOR(p[2], y);
+
+		/* (p0, p1, p2, p3) <- (p3, p0, p1, p2) */
+		t = p[3];
+		p[3] = p[2];
+		p[2] = p[1];
+		p[1] = p[0];
+		p[0] = t;
+	}
+	for (i = 0; i < 4; i ++)
+		h[i] = AES_HW_XOR(h[i], p[i]);
+}
+
+/* see sph_aes_hw.h */
+AES_HW_FUNC void
+sph_shavite512_aes_128(const void *in, void *out)
+{
+	aes_hw_v128 h[4];
+	unsigned char pad[128];
+	int i;
+
+	for (i = 0; i < 4; i ++)
+		h[i] = AES_HW_LOAD(&IV512[4 * i]);
+	shavite_aes_compress(h, (const unsigned char *)in, 1024, 0, 0, 0);
+
+	memset(pad, 0, sizeof pad);
+	pad[0] = 0x80;
+	sph_enc32le(pad + 110, 1024);
+	pad[127] = 2;
+	shavite_aes_compress(h, pad, 0, 0, 0, 0);
+
+	for (i = 0; i < 4; i ++)
+		AES_HW_STORE((unsigned char *)out + 16 * i, h[i]);
+}
+
+#endif
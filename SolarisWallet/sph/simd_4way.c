@@ -0,0 +1,361 @@
+/*
+ * Multi-buffer SIMD-512 over 128-byte messages, four lanes here and
+ * eight through simd_8way.c.
+ *
+ * A 128-byte message is exactly one block, so the hash is that block
+ * and then a block holding only the 1024-bit length, compressed with
+ * the final tweak. The number-theoretic transform keeps the structure
+ * and the reductions of simd.c, so its values stay in the ranges worked
+ * out there.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_4way.h"
+
+#if SPH_4WAY
+
+#include "4way_helper.c"
+
+typedef sph_s32 mb_s32 __attribute__((vector_size(4 * SPH_MB_LANES)));
+
+static const sph_s32 alpha_tab[] = {
+	  1,  41, 139,  45,  46,  87, 226,  14,  60, 147, 116, 130,
+	190,  80, 196,  69,   2,  82,  21,  90,  92, 174, 195,  28,
+	120,  37, 232,   3, 123, 160, 135, 138,   4, 164,  42, 180,
+	184,  91, 133,  56, 240,  74, 207,   6, 246,  63,  13,  19,
+	  8,  71,  84, 103, 111, 182,   9, 112, 223, 148, 157,  12,
+	235, 126,  26,  38,  16, 142, 168, 206, 222, 107,  18, 224,
+	189,  39,  57,  24, 213, 252,  52,  76,  32,  27,  79, 155,
+	187, 214,  36, 191, 121,  78, 114,  48, 169, 247, 104, 152,
+	 64,  54, 158,  53, 117, 171,  72, 125, 242, 156, 228,  96,
+	 81, 237, 208,  47, 128, 108,  59, 106, 234,  85, 144, 250,
+	227,  55, 199, 192, 162, 217, 159,  94, 256, 216, 118, 212,
+	211, 170,  31, 243, 197, 110, 141, 127,  67, 177,  61, 188,
+	255, 175, 236, 167, 165,  83,  62, 229, 137, 220,  25, 254,
+	134,  97, 122, 119, 253,  93, 215,  77,  73, 166, 124, 201,
+	 17, 183,  50, 251,  11, 194, 244, 238, 249, 186, 173, 154,
+	146,  75, 248, 145,  34, 109, 100, 245,  22, 131, 231, 219,
+	241, 115,  89,  51,  35, 150, 239,  33,  68, 218, 200, 233,
+	 44,   5, 205, 181, 225, 230, 178, 102,  70,  43, 221,  66,
+	136, 179, 143, 209,  88,  10, 153, 105, 193, 203,  99, 204,
+	140,  86, 185, 132,  15, 101,  29, 161, 176,  20,  49, 210,
+	129, 149, 198, 151,  23, 172, 113,   7,  30, 202,  58,  65,
+	 95,  40,  98, 163
+};
+
+static const unsigned short yoff_b_n[] = {
+	  1, 163,  98,  40,  95,  65,  58, 202,  30,   7, 113, 172,
+	 23, 151, 198, 149, 129, 210,  49,  20, 176, 161,  29, 101,
+	 15, 132, 185,  86, 140, 204,  99, 203, 193, 105, 153,  10,
+	 88, 209, 143, 179, 136,  66, 221,  43,  70, 102, 178, 230,
+	225, 181, 205,   5,  44, 233, 200, 218,  68,  33, 239, 150,
+	 35,  51,  89, 115, 241, 219, 231, 131,  22, 245, 100, 109,
+	 34, 145, 248,  75, 146, 154, 173, 186, 249, 238, 244, 194,
+	 11, 251,  50, 183,  17, 201, 124, 166,  73,  77, 215,  93,
+	253, 119, 122,  97, 134, 254,  25, 220, 137, 229,  62,  83,
+	165, 167, 236, 175, 255, 188,  61, 177,  67, 127, 141, 110,
+	197, 243,  31, 170, 211, 212, 118, 216, 256,  94, 159, 217,
+	162, 192, 199,  55, 227, 250, 144,  85, 234, 106,  59, 108,
+	128,  47, 208, 237,  81,  96, 228, 156, 242, 125,  72, 171,
+	117,  53, 158,  54,  64, 152, 104, 247, 169,  48, 114,  78,
+	121, 191,  36, 214, 187, 155,  79,  27,  32,  76,  52, 252,
+	213,  24,  57,  39, 189, 224,  18, 107, 222, 206, 168, 142,
+	 16,  38,  26, 126, 235,  12, 157, 148, 223, 112,   9, 182,
+	111, 103,  84,  71,   8,  19,  13,  63, 246,   6, 207,  74,
+	240,  56, 133,  91, 184, 180,  42, 164,   4, 138, 135, 160,
+	123,   3, 232,  37, 120,  28, 195, 174,  92,  90,  21,  82,
+	  2,  69, 196,  80, 190, 130, 116, 147,  60,  14, 226,  87,
+	 46,  45, 139,  41
+};
+
+static const unsigned short yoff_b_f[] = {
+	  2, 203, 156,  47, 118, 214, 107, 106,  45,  93, 212,  20,
+	111,  73, 162, 251,  97, 215, 249,  53, 211,  19,   3,  89,
+	 49, 207, 101,  67, 151, 130, 223,  23, 189, 202, 178, 239,
+	253, 127, 204,  49,  76, 236,  82, 137, 232, 157,  65,  79,
+	 96, 161, 176, 130, 161,  30,  47,   9, 189, 247,  61, 226,
+	248,  90, 107,  64,   0,  88, 131, 243, 133,  59, 113, 115,
+	 17, 236,  33, 213,  12, 191, 111,  19, 251,  61, 103, 208,
+	 57,  35, 148, 248,  47, 116,  65, 119, 249, 178, 143,  40,
+	189, 129,   8, 163, 204, 227, 230, 196, 205, 122, 151,  45,
+	187,  19, 227,  72, 247, 125, 111, 121, 140, 220,   6, 107,
+	 77,  69,  10, 101,  21,  65, 149, 171, 255,  54, 101, 210,
+	139,  43, 150, 151, 212, 164,  45, 237, 146, 184,  95,   6,
+	160,  42,   8, 204,  46, 238, 254, 168, 208,  50, 156, 190,
+	106, 127,  34, 234,  68,  55,  79,  18,   4, 130,  53, 208,
+	181,  21, 175, 120,  25, 100, 192, 178, 161,  96,  81, 127,
+	 96, 227, 210, 248,  68,  10, 196,  31,   9, 167, 150, 193,
+	  0, 169, 126,  14, 124, 198, 144, 142, 240,  21, 224,  44,
+	245,  66, 146, 238,   6, 196, 154,  49, 200, 222, 109,   9,
+	210, 141, 192, 138,   8,  79, 114, 217,  68, 128, 249,  94,
+	 53,  30,  27,  61,  52, 135, 106, 212,  70, 238,  30, 185,
+	 10, 132, 146, 136, 117,  37, 251, 150, 180, 188, 247, 156,
+	236, 192, 108,  86
+};
+
+static const sph_u32 IV512[] = {
+	SPH_C32(0x0BA16B95), SPH_C32(0x72F999AD), SPH_C32(0x9FECC2AE), SPH_C32(0xBA3264FC),
+	SPH_C32(0x5E894929), SPH_C32(0x8E9F30E5), SPH_C32(0x2F1DAA37), SPH_C32(0xF0F2C558),
+	SPH_C32(0xAC506643), SPH_C32(0xA90635A5), SPH_C32(0xE25B878B), SPH_C32(0xAAB7878F),
+	SPH_C32(0x88817F7A), SPH_C32(0x0A02892B), SPH_C32(0x559A7550), SPH_C32(0x598F657E),
+	SPH_C32(0x7EEF60A1), SPH_C32(0x6B70E3E8), SPH_C32(0x9C1714D1), SPH_C32(0xB958E2A8),
+	SPH_C32(0xAB02675E), SPH_C32(0xED1C014F), SPH_C32(0xCD8D65BB), SPH_C32(0xFDB7A257),
+	SPH_C32(0x09254899), SPH_C32(0xD699C7BC), SPH_C32(0x9019B6DC), SPH_C32(0x2B9022E4),
+	SPH_C32(0x8FA14956), SPH_C32(0x21BF9BD3), SPH_C32(0xB94D0943), SPH_C32(0x6FFDDC22)
+};
+
+/* wbp[] of simd.c: where each group of eight expanded words starts */
+static const unsigned char wbp[32] = {
+	 4,  6,  0,  2,  7,  5,  3,  1, 15, 11, 12,  8,  9, 13, 10, 14,
+	17, 18, 23, 20, 22, 21, 16, 19, 30, 24, 25, 31, 27, 29, 28, 26
+};
+
+/* per round: the rotations p0..p3 and the W offsets and multiplier */
+static const struct {
+	int p[4];
+	int o1, o2, mm;
+} simd_round[4] = {
+	{ {  3, 23, 17, 27 },    0,    1, 185 },
+	{ { 28, 19, 22,  7 },    0,    1, 185 },
+	{ { 29,  9, 15,  5 }, -256, -128, 233 },
+	{ {  4, 13, 10, 25 }, -383, -255, 233 }
+};
+
+static const int pp8k[] = { 1, 6, 2, 3, 5, 7, 4, 1, 6, 2, 3 };
+
+#define REDS1(x)    (((x) & 0xFF) - ((x) >> 8))
+#define REDS2(x)    (((x) & 0xFFFF) + ((x) >> 16))
+
+#define IF(x, y, z)    ((((y) ^ (z)) & (x)) ^ (z))
+#define MAJ(x, y, z)   (((x) & (y)) | (((x) | (y)) & (z)))
+
+/*
+ * FFT8 of simd.c: only x[xb] to x[xb + 3 * xs] can be nonzero.
+ */
+MB_INLINE void
+simd_mb_fft8(const mb_s32 *x, int xb, int xs, mb_s32 d[8])
+{
+	mb_s32 x0 = x[xb];
+	mb_s32 x1 = x[xb + xs];
+	mb_s32 x2 = x[xb + 2 * xs];
+	mb_s32 x3 = x[xb + 3 * xs];
+	mb_s32 a0 = x0 + x2;
+	mb_s32 a1 = x0 + (x2 << 4);
+	mb_s32 a2 = x0 - x2;
+	mb_s32 a3 = x0 - (x2 << 4);
+	mb_s32 b0 = x1 + x3;
+	mb_s32 b1 = REDS1((x1 << 2) + (x3 << 6));
+	mb_s32 b2 = (x1 << 4) - (x3 << 4);
+	mb_s32 b3 = REDS1((x1 << 6) + (x3 << 2));
+
+	d[0] = a0 + b0;
+	d[1] = a1 + b1;
+	d[2] = a2 + b2;
+	d[3] = a3 + b3;
+	d[4] = a0 - b0;
+	d[5] = a1 - b1;
+	d[6] = a2 - b2;
+	d[7] = a3 - b3;
+}
+
+MB_INLINE void
+simd_mb_fft16(const mb_s32 *x, int xb, int xs, mb_s32 *q)
+{
+	mb_s32 d1[8], d2[8];
+	int i;
+
+	simd_mb_fft8(x, xb, xs << 1, d1);
+	simd_mb_fft8(x, xb + xs, xs << 1, d2);
+	for (i = 0; i < 8; i ++) {
+		q[i] = d1[i] + (d2[i] << i);
+		q[i + 8] = d1[i] - (d2[i] << i);
+	}
+}
+
+/*
+ * FFT_LOOP of simd.c: merges the two halves q[0..hk-1] and
+ * q[hk..2*hk-1], with alpha^(as * u) on the odd half.
+ */
+MB_INLINE void
+simd_mb_fft_loop(mb_s32 *q, int hk, int as)
+{
+	mb_s32 m, n, t;
+	int u;
+
+	m = q[0];
+	n = q[hk];
+	q[0] = m + n;
+	q[hk] = m - n;
+	for (u = 1; u < hk; u ++) {
+		m = q[u];
+		n = q[u + hk];
+		t = REDS2(n * alpha_tab[u * as]);
+		q[u] = m + t;
+		q[u + hk] = m - t;
+	}
+}
+
+MB_INLINE void
+simd_mb_fft32(const mb_s32 *x, int xb, int xs, mb_s32 *q)
+{
+	simd_mb_fft16(x, xb, xs << 1, q);
+	simd_mb_fft16(x, xb + xs, xs << 1, q + 16);
+	simd_mb_fft_loop(q, 16, 8);
+}
+
+MB_INLINE void
+simd_mb_fft64(const mb_s32 *x, int xb, int xs, mb_s32 *q)
+{
+	simd_mb_fft32(x, xb, xs << 1, q);
+	simd_mb_fft32(x, xb + xs, xs << 1, q + 32);
+	simd_mb_fft_loop(q, 32, 4);
+}
+
+MB_INLINE void
+simd_mb_fft256(const mb_s32 x[128], mb_s32 q[256])
+{
+	simd_mb_fft64(x, 0, 4, q);
+	simd_mb_fft64(x, 2, 4, q + 64);
+	simd_mb_fft_loop(q, 64, 2);
+	simd_mb_fft64(x, 1, 4, q + 128);
+	simd_mb_fft64(x, 3, 4, q + 192);
+	simd_mb_fft_loop(q + 128, 64, 2);
+	simd_mb_fft_loop(q, 128, 1);
+}
+
+/*
+ * One step over the eight columns of the state s (A, B, C and D at
+ * s[0], s[8], s[16] and s[24]).
+ */
+MB_INLINE void
+simd_mb_step(mb_u32 s[32], const mb_u32 w[8], int maj, int r, int sh,
+	int ppb)
+{
+	mb_u32 ta[8];
+	int n;
+
+	for (n = 0; n < 8; n ++)
+		ta[n] = MB_ROTL32(s[n], r);
+	for (n = 0; n < 8; n ++) {
+		mb_u32 a = s[n], b = s[8 + n], c = s[16 + n];
+		mb_u32 tt = s[24 + n] + w[n] + (maj ? MAJ(a, b, c) : IF(a, b, c));
+
+		s[n] = MB_ROTL32(tt, sh) + ta[ppb ^ n];
+		s[24 + n] = c;
+		s[16 + n] = b;
+		s[8 + n] = ta[n];
+	}
+}
+
+/*
+ * compress_big() of simd.c, with the message bytes in x (one per
+ * vector word) and the same bytes as little-endian words in m.
+ */
+MB_INLINE void
+simd_mb_compress(mb_u32 h[32], const mb_s32 x[128], const mb_u32 m[32],
+	const unsigned short *yoff)
+{
+	mb_s32 q[256];
+	mb_u32 s[32], w[64];
+	int i, r, u, k;
+
+	simd_mb_fft256(x, q);
+	for (i = 0; i < 256; i ++) {
+		mb_s32 tq = q[i] + (sph_s32)yoff[i];
+
+		tq = REDS2(tq);
+		tq = REDS1(tq);
+		tq = REDS1(tq);
+		q[i] = tq - (257 & (tq > 128));
+	}
+
+	for (i = 0; i < 32; i ++)
+		s[i] = h[i] ^ m[i];
+
+	for (r = 0; r < 4; r ++) {
+		const int *p = simd_round[r].p;
+		int mm = simd_round[r].mm;
+
+		for (u = 0; u < 8; u ++) {
+			const mb_s32 *qv = q + (wbp[8 * r + u] << 4);
+
+			for (k = 0; k < 8; k ++) {
+				mb_s32 lo = qv[2 * k + simd_round[r].o1] * mm;
+				mb_s32 hi = qv[2 * k + simd_round[r].o2] * mm;
+
+				w[8 * u + k] = ((mb_u32)lo & 0xFFFF)
+					+ ((mb_u32)hi << 16);
+			}
+		}
+		for (u = 0; u < 8; u ++)
+			simd_mb_step(s, w + 8 * u, u >= 4, p[u & 3],
+				p[(u + 1) & 3], pp8k[r + u]);
+	}
+
+	simd_mb_step(s, h +  0, 0,  4, 13, 5);
+	simd_mb_step(s, h +  8, 0, 13, 10, 7);
+	simd_mb_step(s, h + 16, 0, 10, 25, 4);
+	simd_mb_step(s, h + 24, 0, 25,  4, 1);
+
+	for (i = 0; i < 32; i ++)
+		h[i] = s[i];
+}
+
+MB_INLINE void
+simd512_mb_body(const unsigned char *const in[SPH_MB_LANES],
+	unsigned char *const out[SPH_MB_LANES])
+{
+	mb_s32 x[128];
+	mb_u32 h[32], m[32];
+	int i, j;
+
+	for (i = 0; i < 32; i ++)
+		h[i] = mb_set1_32(IV512[i]);
+
+	for (i = 0; i < 128; i ++)
+		for (j = 0; j < SPH_MB_LANES; j ++)
+			x[i][j] = in[j][i];
+	for (i = 0; i < 32; i ++)
+		m[i] = mb_load32_le(in, i);
+	simd_mb_compress(h, x, m, yoff_b_n);
+
+	/* the length block: 1024 bits, little-endian */
+	for (i = 0; i < 128; i ++)
+		x[i] = (mb_s32)mb_set1_32(0);
+	x[1] = (mb_s32)mb_set1_32(0x04);
+	for (i = 0; i < 32; i ++)
+		m[i] = mb_set1_32(0);
+	m[0] = mb_set1_32(0x400);
+	simd_mb_compress(h, x, m, yoff_b_f);
+
+	for (i = 0; i < 16; i ++)
+		mb_store32_le(out, i, &h[i]);
+}
+
+SPH_MB_DISPATCH(sph_simd512, simd512_mb_body)
+
+#endif
@@ -0,0 +1,163 @@
+/*
+ * Multi-buffer Skein-512-512 over 128-byte messages, four lanes here
+ * and eight through skein_8way.c.
+ *
+ * A 128-byte message takes two UBI calls of type "message", the
+ * second one flagged final, followed by the output UBI call over a
+ * zero block. The tweak of each call is the same for all lanes,
+ * so only the chaining values and the message words are vectors.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#include "sph_4way.h"
+
+#if SPH_4WAY
+
+#include "4way_helper.c"
+
+static const sph_u64 IV512[8] = {
+	SPH_C64(0x4903ADFF749C51CE), SPH_C64(0x0D95DE399746DF03),
+	SPH_C64(0x8FD1934127C79BCE), SPH_C64(0x9A255629FF352CB1),
+	SPH_C64(0x5DB62599DF6CA7B0), SPH_C64(0xEABE394CA9D5C3F4),
+	SPH_C64(0x991112C71A75B523), SPH_C64(0xAE18A40B660FCC33)
+};
+
+#define MIX4(x0, x1, rc)   do { \
+		x0 += x1; \
+		x1 = MB_ROTL(x1, rc) ^ x0; \
+	} while (0)
+
+#define MIX8(w0, w1, w2, w3, w4, w5, w6, w7, rc0, rc1, rc2, rc3)   do { \
+		MIX4(p[w0], p[w1], rc0); \
+		MIX4(p[w2], p[w3], rc1); \
+		MIX4(p[w4], p[w5], rc2); \
+		MIX4(p[w6], p[w7], rc3); \
+	} while (0)
+
+#define ADDKEY(s)   do { \
+		p[0] += k[((s) + 0) % 9]; \
+		p[1] += k[((s) + 1) % 9]; \
+		p[2] += k[((s) + 2) % 9]; \
+		p[3] += k[((s) + 3) % 9]; \
+		p[4] += k[((s) + 4) % 9]; \
+		p[5] += k[((s) + 5) % 9] + t[(s) % 3]; \
+		p[6] += k[((s) + 6) % 9] + t[((s) + 1) % 3]; \
+		p[7] += k[((s) + 7) % 9] + mb_set1(s); \
+	} while (0)
+
+/*
+ * Even and odd rounds: the key injection of subkey s, then four MIX
+ * layers over the Threefish-512 word permutation.
+ */
+#define ROUND4E(s)   do { \
+		ADDKEY(s); \
+		MIX8(0, 1, 2, 3, 4, 5, 6, 7, 46, 36, 19, 37); \
+		MIX8(2, 1, 4, 7, 6, 5, 0, 3, 33, 27, 14, 42); \
+		MIX8(4, 1, 6, 3, 0, 5, 2, 7, 17, 49, 36, 39); \
+		MIX8(6, 1, 0, 7, 2, 5, 4, 3, 44,  9, 54, 56); \
+	} while (0)
+
+#define ROUND4O(s)   do { \
+		ADDKEY(s); \
+		MIX8(0, 1, 2, 3, 4, 5, 6, 7, 39, 30, 34, 24); \
+		MIX8(2, 1, 4, 7, 6, 5, 0, 3, 13, 50, 10, 17); \
+		MIX8(4, 1, 6, 3, 0, 5, 2, 7, 25, 29, 39, 43); \
+		MIX8(6, 1, 0, 7, 2, 5, 4, 3,  8, 35, 56, 22); \
+	} while (0)
+
+MB_INLINE void
+skein512_mb_ubi(mb_u64 h[8], const mb_u64 m[8],
+	sph_u64 bcount, unsigned etype, sph_u64 extra)
+{
+	mb_u64 k[9], p[8], t[3];
+	int i;
+
+	t[0] = mb_set1((bcount << 6) + extra);
+	t[1] = mb_set1((bcount >> 58) + ((sph_u64)etype << 55));
+	t[2] = t[0] ^ t[1];
+
+	k[8] = mb_set1(SPH_C64(0x1BD11BDAA9FC1A22));
+	for (i = 0; i < 8; i ++) {
+		k[i] = h[i];
+		k[8] ^= h[i];
+		p[i] = m[i];
+	}
+
+	ROUND4E( 0);
+	ROUND4O( 1);
+	ROUND4E( 2);
+	ROUND4O( 3);
+	ROUND4E( 4);
+	ROUND4O( 5);
+	ROUND4E( 6);
+	ROUND4O( 7);
+	ROUND4E( 8);
+	ROUND4O( 9);
+	ROUND4E(10);
+	ROUND4O(11);
+	ROUND4E(12);
+	ROUND4O(13);
+	ROUND4E(14);
+	ROUND4O(15);
+	ROUND4E(16);
+	ROUND4O(17);
+	ADDKEY(18);
+
+	for (i = 0; i < 8; i ++)
+		h[i] = m[i] ^ p[i];
+}
+
+MB_INLINE void
+skein512_mb_body(const unsigned char *const in[SPH_MB_LANES],
+	unsigned char *const out[SPH_MB_LANES])
+{
+	mb_u64 h[8], m[8];
+	int i;
+
+	for (i = 0; i < 8; i ++)
+		h[i] = mb_set1(IV512[i]);
+
+	/* type 48 (message) with the "first" flag, then with "final" */
+	for (i = 0; i < 8; i ++)
+		m[i] = mb_load_le(in, i);
+	skein512_mb_ubi(h, m, 1, 224, 0);
+	for (i = 0; i < 8; i ++)
+		m[i] = mb_load_le(in, 8 + i);
+	skein512_mb_ubi(h, m, 1, 352, 64);
+
+	/* type 63 (output), first and final, over the 8-byte counter 0 */
+	for (i = 0; i < 8; i ++)
+		m[i] = mb_set1(0);
+	skein512_mb_ubi(h, m, 0, 510, 8);
+
+	for (i = 0; i < 8; i ++)
+		mb_store_le(out, i, &h[i]);
+}
+
+SPH_MB_DISPATCH(sph_skein512, skein512_mb_body)
+
+#endif
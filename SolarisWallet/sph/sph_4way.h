@@ -0,0 +1,252 @@
+/*
+ * Multi-buffer interface for the 512-bit primitives of the X chains.
+ *
+ * Each function hashes four (or eight) independent 128-byte messages in
+ * lockstep and writes as many 64-byte digests. The result is
+ * byte-identical to running the matching scalar sph_*512() /
+ * sph_*512_close() pair over each message on a freshly initialised
+ * context; the scalar code stays the reference implementation. Input and
+ * output pointers may alias (all input is consumed before any output is
+ * written).
+ *
+ * On x86 an AVX-512 or AVX2 build of each kernel is selected at runtime
+ * when the CPU supports it, with the baseline (SSE2 on x86-64) build as
+ * fallback; other architectures use their native vector unit (NEON on
+ * ARMv8) through the same code. sph_mb_lanes() tells which of the two
+ * lane counts suits the CPU.
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#ifndef SPH_4WAY_H__
+#define SPH_4WAY_H__
+
+#include "sph_types.h"
+
+#if SPH_64 && (defined __GNUC__ || defined __clang__)
+
+/**
+ * Defined to 1 when the 4-way and 8-way kernels are available. They need
+ * 64-bit arithmetic and GCC-style vector extensions.
+ */
+#define SPH_4WAY   1
+
+/**
+ * Message length, in bytes, accepted by the multi-buffer kernels.
+ */
+#define SPH_4WAY_MSG_LEN   128
+
+/**
+ * Number of lanes the kernels are best run with on this CPU: 8 when the
+ * AVX-512 builds were selected, 4 otherwise. Both sets work everywhere.
+ *
+ * @return  4 or 8
+ */
+unsigned sph_mb_lanes(void);
+
+/**
+ * BLAKE-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_blake512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * BLAKE-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_blake512_8way_128(const void *const in[8], void *const out[8]);
+
+/**
+ * BMW-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_bmw512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * BMW-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_bmw512_8way_128(const void *const in[8], void *const out[8]);
+
+/**
+ * Skein-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_skein512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * Skein-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_skein512_8way_128(const void *const in[8], void *const out[8]);
+
+/**
+ * JH-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_jh512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * JH-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_jh512_8way_128(const void *const in[8], void *const out[8]);
+
+/**
+ * Keccak-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_keccak512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * Keccak-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_keccak512_8way_128(const void *const in[8], void *const out[8]);
+
+/**
+ * SHA-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_sha512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * SHA-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_sha512_8way_128(const void *const in[8], void *const out[8]);
+
+/**
+ * CubeHash-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_cubehash512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * CubeHash-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_cubehash512_8way_128(const void *const in[8], void *const out[8]);
+
+/**
+ * Shabal-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_shabal512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * Shabal-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_shabal512_8way_128(const void *const in[8], void *const out[8]);
+
+/**
+ * Luffa-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_luffa512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * Luffa-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_luffa512_8way_128(const void *const in[8], void *const out[8]);
+
+/**
+ * Hamsi-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_hamsi512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * Hamsi-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_hamsi512_8way_128(const void *const in[8], void *const out[8]);
+
+/**
+ * SIMD-512 over four 128-byte messages.
+ *
+ * @param in    the four input messages
+ * @param out   the four 64-byte output buffers
+ */
+void sph_simd512_4way_128(const void *const in[4], void *const out[4]);
+
+/**
+ * SIMD-512 over eight 128-byte messages.
+ *
+ * @param in    the eight input messages
+ * @param out   the eight 64-byte output buffers
+ */
+void sph_simd512_8way_128(const void *const in[8], void *const out[8]);
+
+#else
+
+#define SPH_4WAY   0
+
+#endif
+
+#endif
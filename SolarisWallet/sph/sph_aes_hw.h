@@ -0,0 +1,103 @@
+/*
+ * Hardware-AES implementations of the AES-round based 512-bit
+ * primitives of the X chains.
+ *
+ * Each function hashes one 128-byte message into a 64-byte digest and
+ * is byte-identical to running the matching scalar sph_*512() /
+ * sph_*512_close() pair on a freshly initialised context; the scalar
+ * code stays the reference implementation. Input and output may alias.
+ *
+ * On x86 the AES-NI code path is compiled for the "aes" and "ssse3"
+ * targets and may only be called when sph_aes_hw_available() returns
+ * non-zero. On ARMv8 it uses the crypto extensions and is available
+ * whenever the compiler targets them (all arm64 iOS devices).
+ *
+ * ==========================(LICENSE BEGIN)============================
+ *
+ * Copyright (c) 2007-2010  Projet RNRT SAPHIR
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * ===========================(LICENSE END)=============================
+ */
+
+#ifndef SPH_AES_HW_H__
+#define SPH_AES_HW_H__
+
+#include "sph_types.h"
+
+#if (defined __x86_64__ || defined __i386__) && (defined __GNUC__ || defined __clang__)
+#define SPH_AES_HW   1
+#elif (defined __aarch64__ || defined __arm64__) \
+	&& (defined __ARM_FEATURE_CRYPTO || defined __ARM_FEATURE_AES)
+#define SPH_AES_HW   1
+#else
+#define SPH_AES_HW   0
+#endif
+
+#if SPH_AES_HW
+
+/**
+ * Message length, in bytes, accepted by the hardware-AES functions.
+ */
+#define SPH_AES_HW_MSG_LEN   128
+
+/**
+ * Returns non-zero when the running CPU supports the hardware-AES code
+ * paths below.
+ */
+static inline int
+sph_aes_hw_available(void)
+{
+#if defined __x86_64__ || defined __i386__
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("aes") && __builtin_cpu_supports("ssse3");
+#else
+	return 1;
+#endif
+}
+
+/**
+ * ECHO-512 over one 128-byte message.
+ *
+ * @param in    the input message
+ * @param out   the 64-byte output buffer
+ */
+void sph_echo512_aes_128(const void *in, void *out);
+
+/**
+ * Groestl-512 over one 128-byte message.
+ *
+ * @param in    the input message
+ * @param out   the 64-byte output buffer
+ */
+void sph_groestl512_aes_128(const void *in, void *out);
+
+/**
+ * SHAvite-3-512 over one 128-byte message.
+ *
+ * @param in    the input message
+ * @param out   the 64-byte output buffer
+ */
+void sph_shavite512_aes_128(const void *in, void *out);
+
+#endif
+
+#endif
@@ -955,6 +955,17 @@ typedef long long sph_s64;
 #endif
 #endif
 
+/*
+ * SPH_SMALL_FOOTPRINT selects the compact implementation (rolled loops,
+ * smaller tables) of every function in the library at once, for builds
+ * where code size matters more than speed. It defaults to zero, i.e. the
+ * unrolled table-driven code. A single function can still be switched on
+ * its own with the matching SPH_SMALL_FOOTPRINT_<NAME> macro.
+ */
+#ifndef SPH_SMALL_FOOTPRINT
+#define SPH_SMALL_FOOTPRINT   0
+#endif
+
 /*
  * We define some macros which qualify the architecture. These macros
  * may be explicit set externally (e.g. as compiler parameters). The
@@ -7,53 +7,22 @@
 //
 
 #include "xevan.h"
+#include "BRParallel.h"
+#include "sph/sph_4way.h"
+#include "sph/sph_aes_hw.h"
 
-
-
-#include <stdlib.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
-#include <stdio.h>
-#include "sph/sph_blake.h"
-#include "sph/sph_bmw.h"
-#include "sph/sph_groestl.h"
-#include "sph/sph_jh.h"
-#include "sph/sph_keccak.h"
-#include "sph/sph_skein.h"
-#include "sph/sph_luffa.h"
-#include "sph/sph_cubehash.h"
-#include "sph/sph_shavite.h"
-#include "sph/sph_simd.h"
-#include "sph/sph_echo.h"
-#include "sph/sph_hamsi.h"
-#include "sph/sph_fugue.h"
-#include "sph/sph_shabal.h"
-#include "sph/sph_whirlpool.h"
-#include "sph/sph_sha2.h"
-#include "sph/sph_haval.h"
+#include <pthread.h>
 
-typedef struct {
-    sph_blake512_context    blake1;
-    sph_bmw512_context      bmw1;
-    sph_groestl512_context  groestl1;
-    sph_skein512_context    skein1;
-    sph_jh512_context       jh1;
-    sph_keccak512_context   keccak1;
-    sph_luffa512_context    luffa1;
-    sph_cubehash512_context cubehash1;
-    sph_shavite512_context  shavite1;
-    sph_simd512_context     simd1;
-    sph_echo512_context     echo1;
-    sph_hamsi512_context    hamsi1;
-    sph_fugue512_context    fugue1;
-    sph_shabal512_context   shabal1;
-    sph_whirlpool_context   whirlpool1;
-    sph_sha512_context      sha512;
-    sph_haval256_5_context  haval1;
-} Xhash_context_holder;
-
-static Xhash_context_holder base_contexts;
-void init_xevanhash_contexts()
+static xevan_ctx base_contexts;
+static pthread_once_t base_contexts_once = PTHREAD_ONCE_INIT;
+static int aes_hw; // cpu has the aes instructions the run1 kernels need, probed once with the contexts
+static size_t lanes_max = 4; // headers per lane group, the lane count the multi-buffer kernels suit on this cpu
+
+static void init_xevanhash_contexts(void)
 {
     sph_blake512_init(&base_contexts.blake1);
     sph_bmw512_init(&base_contexts.bmw1);
@@ -72,124 +41,347 @@ void init_xevanhash_contexts()
     sph_whirlpool_init (&base_contexts.whirlpool1);
     sph_sha512_init(&base_contexts.sha512);
     sph_haval256_5_init(&base_contexts.haval1);
+#if SPH_AES_HW
+    aes_hw = sph_aes_hw_available();
+#endif
+#if SPH_4WAY
+    lanes_max = sph_mb_lanes();
+#endif
 }
-void xevan_hash(const char* input, char* state, int version)
+
+const xevan_ctx *xevan_ctx_base(void)
+{
+    pthread_once(&base_contexts_once, init_xevanhash_contexts);
+    return &base_contexts;
+}
+
+typedef struct {
+    size_t offset; // offset of the stage context inside xevan_ctx
+    void (*update)(void *cc, const void *data, size_t len);
+    void (*close)(void *cc, void *dst);
+    void (*run4)(const void *const in[4], void *const out[4]); // 4-way kernel for 128 byte inputs, or NULL
+    void (*run8)(const void *const in[8], void *const out[8]); // 8-way kernel for 128 byte inputs, or NULL
+    void (*run1)(const void *in, void *out); // hardware aes kernel for 128 byte inputs, or NULL
+} xevan_stage;
+
+#define XEVAN_STAGE(ctx, name) { offsetof(xevan_ctx, ctx), sph_##name, sph_##name##_close, NULL, NULL, NULL }
+
+#if SPH_4WAY
+#define XEVAN_STAGE_4WAY(ctx, name) \
+    { offsetof(xevan_ctx, ctx), sph_##name, sph_##name##_close, sph_##name##_4way_128, sph_##name##_8way_128, NULL }
+#else
+#define XEVAN_STAGE_4WAY(ctx, name) XEVAN_STAGE(ctx, name)
+#endif
+
+#if SPH_AES_HW
+#define XEVAN_STAGE_AES(ctx, name) \
+    { offsetof(xevan_ctx, ctx), sph_##name, sph_##name##_close, NULL, NULL, sph_##name##_aes_128 }
+#else
+#define XEVAN_STAGE_AES(ctx, name) XEVAN_STAGE(ctx, name)
+#endif
+
+// the 17 stages of one xevan round, in chain order
+// every sph close re-initialises its context, so a context comes back ready for the next round
+static const xevan_stage xevan_stages[] = {
+    XEVAN_STAGE_4WAY(blake1, blake512),
+    XEVAN_STAGE_4WAY(bmw1, bmw512),
+    XEVAN_STAGE_AES(groestl1, groestl512),
+    XEVAN_STAGE_4WAY(skein1, skein512),
+    XEVAN_STAGE_4WAY(jh1, jh512),
+    XEVAN_STAGE_4WAY(keccak1, keccak512),
+    XEVAN_STAGE_4WAY(luffa1, luffa512),
+    XEVAN_STAGE_4WAY(cubehash1, cubehash512),
+    XEVAN_STAGE_AES(shavite1, shavite512),
+    XEVAN_STAGE_4WAY(simd1, simd512),
+    XEVAN_STAGE_AES(echo1, echo512),
+    XEVAN_STAGE_4WAY(hamsi1, hamsi512),
+    XEVAN_STAGE(fugue1, fugue512),
+    XEVAN_STAGE_4WAY(shabal1, shabal512),
+    XEVAN_STAGE(whirlpool1, whirlpool),
+    XEVAN_STAGE_4WAY(sha512, sha512),
+    XEVAN_STAGE(haval1, haval256_5),
+};
+
+#define XEVAN_STAGE_COUNT (sizeof(xevan_stages)/sizeof(*xevan_stages))
+
+static void xevan_stage_run(const xevan_stage *stage, xevan_ctx *ctx, const void *data, size_t len, uint32_t hash[32])
+{
+    void *cc = (char *)ctx + stage->offset;
+
+    if (stage->run1 && aes_hw && len == 128) {
+        stage->run1(data, hash); // one-shot kernel, leaves the context untouched and still initialised
+        return;
+    }
+
+    stage->update(cc, data, len);
+    stage->close(cc, hash);
+}
+
+// runs one stage over the 128 byte hashes of every active lane, eight or four lanes at a time through the multi-buffer
+// kernels where the stage has them, the rest one by one
+static void xevan_stage_run_lanes(const xevan_stage *stage, xevan_ctx ctx[XEVAN_MAX_LANES],
+                                  uint32_t hash[XEVAN_MAX_LANES][32], size_t lanes)
+{
+    size_t j = 0;
+
+    if (stage->run8 && lanes == 8) {
+        void *const io[8] = { hash[0], hash[1], hash[2], hash[3], hash[4], hash[5], hash[6], hash[7] };
+
+        stage->run8((const void *const *)io, io);
+        return;
+    }
+
+    for (; stage->run4 && j + 4 <= lanes; j += 4) {
+        void *const io[4] = { hash[j], hash[j + 1], hash[j + 2], hash[j + 3] };
+
+        stage->run4((const void *const *)io, io);
+    }
+
+    for (; j < lanes; j++) xevan_stage_run(stage, &ctx[j], hash[j], 128, hash[j]);
+}
+
+// header length implied by the version field, capped at the space the caller says is available
+static size_t xevan_header_len(const uint8_t *header, size_t max)
+{
+    uint32_t version = (uint32_t)header[0] | ((uint32_t)header[1] << 8) | ((uint32_t)header[2] << 16) |
+                       ((uint32_t)header[3] << 24);
+    size_t len = (version == 4) ? XEVAN_HEADER_LEN_V4 : XEVAN_HEADER_LEN;
+
+    return (len < max) ? len : max;
+}
+
+void xevan_hash_ctx(xevan_ctx *scratch, const void *input, size_t len, void *output)
 {
-    init_xevanhash_contexts();
-    
-    Xhash_context_holder ctx;
-    
     uint32_t hash[32];
-    
+
     memset(hash, 0, 128);
-    memcpy(&ctx, &base_contexts, sizeof(base_contexts));
-    if(version == 4){
-        sph_blake512 (&ctx.blake1, input, 112);
-    } else
-        sph_blake512 (&ctx.blake1, input, 80);
-    sph_blake512_close (&ctx.blake1, hash);
-    
-    sph_bmw512 (&ctx.bmw1, hash, 128);
-    sph_bmw512_close(&ctx.bmw1, hash);
-    
-    sph_groestl512 (&ctx.groestl1, hash, 128);
-    sph_groestl512_close(&ctx.groestl1, hash);
-    
-    sph_skein512 (&ctx.skein1, hash, 128);
-    sph_skein512_close(&ctx.skein1, hash);
-    
-    sph_jh512 (&ctx.jh1, hash, 128);
-    sph_jh512_close(&ctx.jh1, hash);
-    
-    sph_keccak512 (&ctx.keccak1, hash, 128);
-    sph_keccak512_close(&ctx.keccak1, hash);
-    
-    sph_luffa512 (&ctx.luffa1, hash, 128);
-    sph_luffa512_close (&ctx.luffa1, hash);
-    
-    sph_cubehash512 (&ctx.cubehash1, hash, 128);
-    sph_cubehash512_close(&ctx.cubehash1, hash);
-    
-    sph_shavite512 (&ctx.shavite1, hash, 128);
-    sph_shavite512_close(&ctx.shavite1, hash);
-    
-    sph_simd512 (&ctx.simd1, hash, 128);
-    sph_simd512_close(&ctx.simd1, hash);
-    
-    sph_echo512 (&ctx.echo1, hash, 128);
-    sph_echo512_close(&ctx.echo1, hash);
-    
-    sph_hamsi512 (&ctx.hamsi1, hash, 128);
-    sph_hamsi512_close(&ctx.hamsi1, hash);
-    
-    sph_fugue512 (&ctx.fugue1, hash, 128);
-    sph_fugue512_close(&ctx.fugue1, hash);
-    
-    sph_shabal512 (&ctx.shabal1, hash, 128);
-    sph_shabal512_close(&ctx.shabal1, hash);
-    
-    sph_whirlpool (&ctx.whirlpool1, hash, 128);
-    sph_whirlpool_close(&ctx.whirlpool1, hash);
-    
-    sph_sha512 (&ctx.sha512, hash, 128);
-    sph_sha512_close(&ctx.sha512, hash);
-    
-    sph_haval256_5 (&ctx.haval1, hash, 128);
-    sph_haval256_5_close(&ctx.haval1, hash);
-    
+    memcpy(scratch, xevan_ctx_base(), sizeof(*scratch));
+
+    xevan_stage_run(&xevan_stages[0], scratch, input, len, hash);
+    for (size_t s = 1; s < XEVAN_STAGE_COUNT; s++) xevan_stage_run(&xevan_stages[s], scratch, hash, 128, hash);
+
     memset(&hash[8], 0, 128 - 32);
-    sph_blake512 (&ctx.blake1, hash, 128);
-    sph_blake512_close (&ctx.blake1, hash);
-    
-    sph_bmw512 (&ctx.bmw1, hash, 128);
-    sph_bmw512_close(&ctx.bmw1, hash);
-    
-    sph_groestl512 (&ctx.groestl1, hash, 128);
-    sph_groestl512_close(&ctx.groestl1, hash);
-    
-    sph_skein512 (&ctx.skein1, hash, 128);
-    sph_skein512_close(&ctx.skein1, hash);
-    
-    sph_jh512 (&ctx.jh1, hash, 128);
-    sph_jh512_close(&ctx.jh1, hash);
-    
-    sph_keccak512 (&ctx.keccak1, hash, 128);
-    sph_keccak512_close(&ctx.keccak1, hash);
-    
-    sph_luffa512 (&ctx.luffa1, hash, 128);
-    sph_luffa512_close (&ctx.luffa1, hash);
-    
-    sph_cubehash512 (&ctx.cubehash1, hash, 128);
-    sph_cubehash512_close(&ctx.cubehash1, hash);
-    
-    sph_shavite512 (&ctx.shavite1, hash, 128);
-    sph_shavite512_close(&ctx.shavite1, hash);
-    
-    sph_simd512 (&ctx.simd1, hash, 128);
-    sph_simd512_close(&ctx.simd1, hash);
-    
-    sph_echo512 (&ctx.echo1, hash, 128);
-    sph_echo512_close(&ctx.echo1, hash);
-    
-    sph_hamsi512 (&ctx.hamsi1, hash, 128);
-    sph_hamsi512_close(&ctx.hamsi1, hash);
-    
-    sph_fugue512 (&ctx.fugue1, hash, 128);
-    sph_fugue512_close(&ctx.fugue1, hash);
-    
-    sph_shabal512 (&ctx.shabal1, hash, 128);
-    sph_shabal512_close(&ctx.shabal1, hash);
-    
-    sph_whirlpool (&ctx.whirlpool1, hash, 128);
-    sph_whirlpool_close(&ctx.whirlpool1, hash);
-    
-    sph_sha512 (&ctx.sha512, hash, 128);
-    sph_sha512_close(&ctx.sha512, hash);
-    
-    sph_haval256_5 (&ctx.haval1, hash, 128);
-    sph_haval256_5_close(&ctx.haval1, hash);
-    
-    memcpy(state, hash, 32);
-    
+    for (size_t s = 0; s < XEVAN_STAGE_COUNT; s++) xevan_stage_run(&xevan_stages[s], scratch, hash, 128, hash);
+
+    memcpy(output, hash, 32);
+}
+
+UInt256 xevan_header(const uint8_t *hdr, size_t len)
+{
+    xevan_ctx scratch;
+    UInt256 hash;
+
+    xevan_hash_ctx(&scratch, hdr, xevan_header_len(hdr, len), hash.u8);
+    return hash;
+}
+
+void xevan_hash_many(const uint8_t *headers, size_t stride, size_t n, uint8_t *out)
+{
+    xevan_ctx ctx[XEVAN_MAX_LANES];
+    uint32_t hash[XEVAN_MAX_LANES][32];
+    const xevan_ctx *base = xevan_ctx_base();
+    size_t i, j, s, lanes;
+
+    // contexts are left re-initialised by each close, so one copy per lane covers the whole batch
+    for (j = 0; j < lanes_max && j < n; j++) memcpy(&ctx[j], base, sizeof(*base));
+
+    for (i = 0; i < n; i += lanes) {
+        lanes = (n - i < lanes_max) ? n - i : lanes_max;
+
+        // stage-major order: each stage runs over every lane before the next one starts, so its code and tables
+        // stay hot and the independent lanes give the cpu work to overlap
+        for (j = 0; j < lanes; j++) {
+            const uint8_t *header = headers + (i + j)*stride;
+
+            memset(hash[j], 0, 128);
+            xevan_stage_run(&xevan_stages[0], &ctx[j], header, xevan_header_len(header, stride), hash[j]);
+        }
+
+        for (s = 1; s < XEVAN_STAGE_COUNT; s++) xevan_stage_run_lanes(&xevan_stages[s], ctx, hash, lanes);
+
+        for (j = 0; j < lanes; j++) memset(&hash[j][8], 0, 128 - 32);
+
+        for (s = 0; s < XEVAN_STAGE_COUNT; s++) xevan_stage_run_lanes(&xevan_stages[s], ctx, hash, lanes);
+
+        for (j = 0; j < lanes; j++) memcpy(out + (i + j)*32, hash[j], 32);
+    }
+}
+
+typedef struct {
+    const uint8_t *headers;
+    size_t stride;
+    uint8_t *out;
+} xevan_hash_many_job;
+
+static void xevan_hash_many_chunk(void *info, unsigned chunk, size_t first, size_t count)
+{
+    const xevan_hash_many_job *job = info;
+
+    xevan_hash_many(job->headers + first*job->stride, job->stride, count, job->out + first*32);
+}
+
+void xevan_hash_many_mt(const uint8_t *headers, size_t stride, size_t n, uint8_t *out, unsigned threads)
+{
+    xevan_hash_many_job job = { headers, stride, out };
+
+    xevan_ctx_base(); // initialise the shared contexts before any worker races for them
+    if (threads > XEVAN_MAX_THREADS) threads = XEVAN_MAX_THREADS;
+    br_parallel_for(n, lanes_max, threads, xevan_hash_many_chunk, &job); // whole lane groups per thread
+}
+
+typedef struct {
+    uint8_t header[XEVAN_HEADER_LEN_V4];
+    uint8_t len; // hashed length of header, 0 for an empty slot
+    uint8_t referenced; // clock bit, set on every hit and cleared as the hand passes
+    UInt256 hash;
+} xevan_cache_entry;
+
+// set-associative cache from header bytes to hash, each set evicts with its own clock hand
+static struct {
+    pthread_mutex_t lock;
+    xevan_cache_entry entry[XEVAN_CACHE_SETS][XEVAN_CACHE_WAYS];
+    uint8_t hand[XEVAN_CACHE_SETS];
+    uint64_t hits, misses;
+} xevan_cache = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+static size_t xevan_cache_set(const uint8_t *header)
+{
+    uint32_t merkle, nonce;
+
+    // the merkle root is already uniformly distributed, the nonce tells apart headers that share one
+    memcpy(&merkle, header + 36, sizeof(merkle));
+    memcpy(&nonce, header + 76, sizeof(nonce));
+    return (merkle ^ nonce) % XEVAN_CACHE_SETS;
+}
+
+static xevan_cache_entry *xevan_cache_find(size_t set, const uint8_t *header, size_t len)
+{
+    for (size_t w = 0; w < XEVAN_CACHE_WAYS; w++) {
+        xevan_cache_entry *e = &xevan_cache.entry[set][w];
+
+        if (e->len == len && memcmp(e->header, header, len) == 0) return e;
+    }
+
+    return NULL;
+}
+
+// returns 1 and the cached hash if header was hashed before, otherwise 0; updates the hit/miss counters
+static int xevan_cache_lookup(const uint8_t *header, size_t len, UInt256 *hash)
+{
+    size_t set = xevan_cache_set(header);
+    xevan_cache_entry *e;
+
+    pthread_mutex_lock(&xevan_cache.lock);
+    e = xevan_cache_find(set, header, len);
+
+    if (e) {
+        e->referenced = 1;
+        *hash = e->hash;
+        xevan_cache.hits++;
+    }
+    else xevan_cache.misses++;
+
+    pthread_mutex_unlock(&xevan_cache.lock);
+    return (e != NULL);
+}
+
+static void xevan_cache_insert(const uint8_t *header, size_t len, UInt256 hash)
+{
+    size_t set = xevan_cache_set(header);
+    xevan_cache_entry *e;
+
+    pthread_mutex_lock(&xevan_cache.lock);
+
+    if (! xevan_cache_find(set, header, len)) { // another thread may have added it since our lookup
+        for (;;) { // second chance: skip over and clear referenced entries until one comes around unreferenced
+            e = &xevan_cache.entry[set][xevan_cache.hand[set]];
+            xevan_cache.hand[set] = (xevan_cache.hand[set] + 1) % XEVAN_CACHE_WAYS;
+            if (e->len == 0 || ! e->referenced) break;
+            e->referenced = 0;
+        }
+
+        memcpy(e->header, header, len);
+        e->len = (uint8_t)len;
+        e->referenced = 0;
+        e->hash = hash;
+    }
+
+    pthread_mutex_unlock(&xevan_cache.lock);
+}
+
+UInt256 xevan_header_cached(const uint8_t *hdr, size_t len)
+{
+    size_t hlen = xevan_header_len(hdr, len);
+    UInt256 hash;
+
+    if (hlen < XEVAN_HEADER_LEN) return xevan_header(hdr, len); // not a full header, not worth remembering
+    if (xevan_cache_lookup(hdr, hlen, &hash)) return hash;
+    hash = xevan_header(hdr, len);
+    xevan_cache_insert(hdr, hlen, hash);
+    return hash;
+}
+
+void xevan_hash_many_cached(const uint8_t *headers, size_t stride, size_t n, uint8_t *out, unsigned threads)
+{
+    size_t i, j, misses = 0, *miss = malloc(n*sizeof(*miss));
+    uint8_t *batch = NULL, *batch_out = NULL;
+
+    if (! miss || stride < XEVAN_HEADER_LEN) { // fall back to hashing everything
+        free(miss);
+        xevan_hash_many_mt(headers, stride, n, out, threads);
+        return;
+    }
+
+    for (i = 0; i < n; i++) {
+        UInt256 hash;
+
+        if (xevan_cache_lookup(headers + i*stride, xevan_header_len(headers + i*stride, stride), &hash)) {
+            memcpy(out + i*32, &hash, sizeof(hash));
+        }
+        else miss[misses++] = i;
+    }
+
+    if (misses == n) xevan_hash_many_mt(headers, stride, n, out, threads); // the common case during a sync
+    else if (misses > 0) {
+        batch = malloc(misses*stride + misses*32);
+        batch_out = (batch) ? batch + misses*stride : NULL;
+
+        if (batch) {
+            for (j = 0; j < misses; j++) memcpy(batch + j*stride, headers + miss[j]*stride, stride);
+            xevan_hash_many_mt(batch, stride, misses, batch_out, threads);
+            for (j = 0; j < misses; j++) memcpy(out + miss[j]*32, batch_out + j*32, 32);
+            free(batch);
+        }
+        else {
+            for (j = 0; j < misses; j++) {
+                UInt256 hash = xevan_header(headers + miss[j]*stride, stride);
+
+                memcpy(out + miss[j]*32, &hash, 32);
+            }
+        }
+    }
+
+    for (j = 0; j < misses; j++) {
+        UInt256 hash;
+
+        memcpy(&hash, out + miss[j]*32, sizeof(hash));
+        xevan_cache_insert(headers + miss[j]*stride, xevan_header_len(headers + miss[j]*stride, stride), hash);
+    }
+
+    free(miss);
 }
 
+void xevan_cache_stats(uint64_t *hits, uint64_t *misses)
+{
+    pthread_mutex_lock(&xevan_cache.lock);
+    if (hits) *hits = xevan_cache.hits;
+    if (misses) *misses = xevan_cache.misses;
+    pthread_mutex_unlock(&xevan_cache.lock);
+}
+
+void xevan_hash(const char* input, char* state, int version)
+{
+    xevan_ctx ctx;
+
+    xevan_hash_ctx(&ctx, input, (version == 4) ? XEVAN_HEADER_LEN_V4 : XEVAN_HEADER_LEN, state);
+}
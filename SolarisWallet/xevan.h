@@ -1,6 +1,6 @@
 //
 //  xevan.h
-//  
+//
 //
 //  Created by Bin on 2018/7/6.
 //  Copyright © 2018 Aaron Voisine. All rights reserved.
@@ -9,10 +9,92 @@
 #ifndef xevan_h
 #define xevan_h
 
-#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "IntTypes.h"
+#include "sph/sph_blake.h"
+#include "sph/sph_bmw.h"
+#include "sph/sph_groestl.h"
+#include "sph/sph_jh.h"
+#include "sph/sph_keccak.h"
+#include "sph/sph_skein.h"
+#include "sph/sph_luffa.h"
+#include "sph/sph_cubehash.h"
+#include "sph/sph_shavite.h"
+#include "sph/sph_simd.h"
+#include "sph/sph_echo.h"
+#include "sph/sph_hamsi.h"
+#include "sph/sph_fugue.h"
+#include "sph/sph_shabal.h"
+#include "sph/sph_whirlpool.h"
+#include "sph/sph_sha2.h"
+#include "sph/sph_haval.h"
+
+#define XEVAN_HEADER_LEN    80  // block header length for version < 4
+#define XEVAN_HEADER_LEN_V4 112 // block header length for version == 4
+#define XEVAN_MAX_LANES     8   // most headers interleaved through the chain by xevan_hash_many()
+#define XEVAN_MAX_THREADS   16  // upper bound on workers used by xevan_hash_many_mt()
+#define XEVAN_CACHE_SETS    512 // sets in the header hash cache, XEVAN_CACHE_WAYS headers each
+#define XEVAN_CACHE_WAYS    4
+
+// one set of sph contexts for every stage of the chain
+typedef struct {
+    sph_blake512_context    blake1;
+    sph_bmw512_context      bmw1;
+    sph_groestl512_context  groestl1;
+    sph_skein512_context    skein1;
+    sph_jh512_context       jh1;
+    sph_keccak512_context   keccak1;
+    sph_luffa512_context    luffa1;
+    sph_cubehash512_context cubehash1;
+    sph_shavite512_context  shavite1;
+    sph_simd512_context     simd1;
+    sph_echo512_context     echo1;
+    sph_hamsi512_context    hamsi1;
+    sph_fugue512_context    fugue1;
+    sph_shabal512_context   shabal1;
+    sph_whirlpool_context   whirlpool1;
+    sph_sha512_context      sha512;
+    sph_haval256_5_context  haval1;
+} xevan_ctx;
+
+// returns the freshly initialised contexts every hash starts from; they are set up exactly once per process and are
+// never written to afterwards, so the pointer can be shared freely between threads
+const xevan_ctx *xevan_ctx_base(void);
+
+// hashes len bytes of input into the 32 byte output using the caller owned scratch contexts
+// the only shared state touched is the read-only xevan_ctx_base(), so concurrent callers are safe as long as each one
+// passes its own scratch
+void xevan_hash_ctx(xevan_ctx *scratch, const void *input, size_t len, void *output);
+
+// hashes n headers laid out stride bytes apart into n consecutive 32 byte hashes at out
+// each header is hashed over the length implied by its version field, capped at stride: a headers message of version
+// < 4 headers can be passed as-is with stride 81, but version 4 headers need a stride of at least 112, a shorter one
+// gives a hash of the truncated header that is neither block hash; as many independent headers as the multi-buffer
+// kernels take on this cpu (4 or 8, up to XEVAN_MAX_LANES) are stepped through each stage together
+void xevan_hash_many(const uint8_t *headers, size_t stride, size_t n, uint8_t *out);
 
+// same as xevan_hash_many(), with the batch split into contiguous chunks over up to threads threads (the calling
+// thread included), output is identical regardless of the thread count
+void xevan_hash_many_mt(const uint8_t *headers, size_t stride, size_t n, uint8_t *out, unsigned threads);
 
+// hashes a serialized block header straight from its buffer, over the length implied by its version field (112 bytes
+// when version == 4, otherwise 80) capped at len; len must be at least 4, no heap memory is touched
+UInt256 xevan_header(const uint8_t *hdr, size_t len);
+
+// same as xevan_header(), answered from a process-wide cache of recently hashed headers when the same header bytes
+// were hashed before; thread safe
+UInt256 xevan_header_cached(const uint8_t *hdr, size_t len);
+
+// same as xevan_hash_many_mt(), except that headers found in the cache are not hashed again and the ones that were
+// hashed are added to it
+void xevan_hash_many_cached(const uint8_t *headers, size_t stride, size_t n, uint8_t *out, unsigned threads);
+
+// cache lookups answered without hashing, and lookups that had to hash, since the process started
+void xevan_cache_stats(uint64_t *hits, uint64_t *misses);
+
+// hashes a block header of the length implied by version (112 bytes when version == 4, otherwise 80)
+// reentrant, scratch contexts live on the caller's stack
 void xevan_hash(const char* input, char* output, int version);
 
 #endif /* xevan_h */
-
@@ -42,6 +42,19 @@ extern "C" {
  */
 typedef struct secp256k1_context_struct secp256k1_context;
 
+/** Opaque data structure that holds rewriteable "scratch space"
+ *
+ *  The purpose of this structure is to replace dynamic memory allocations
+ *  inside functions that need large temporaries, such as multi-point
+ *  multiplication. It is a block of bytes allocated once when it is created;
+ *  the functions given it carve their temporaries out of it and never call
+ *  malloc themselves. Its size bounds how much work they do per batch.
+ *
+ *  Unlike the context object, this cannot safely be shared between threads
+ *  without additional synchronization logic.
+ */
+typedef struct secp256k1_scratch_space_struct secp256k1_scratch_space;
+
 /** Opaque data structure that holds a parsed and valid public key.
  *
  *  The exact representation of data inside is implementation defined and not
@@ -236,6 +249,26 @@ SECP256K1_API void secp256k1_context_set_error_callback(
     const void* data
 ) SECP256K1_ARG_NONNULL(1);
 
+/** Create a secp256k1 scratch space object.
+ *
+ *  Returns: a newly created scratch space.
+ *  Args: ctx:  an existing context object (cannot be NULL)
+ *  In:   max_size: maximum amount of memory to allocate
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT secp256k1_scratch_space* secp256k1_scratch_space_create(
+    const secp256k1_context* ctx,
+    size_t max_size
+) SECP256K1_ARG_NONNULL(1);
+
+/** Destroy a secp256k1 scratch space.
+ *
+ *  The pointer may not be used afterwards.
+ *  Args:   scratch: space to destroy
+ */
+SECP256K1_API void secp256k1_scratch_space_destroy(
+    secp256k1_scratch_space* scratch
+);
+
 /** Parse a variable-length public key into the pubkey object.
  *
  *  Returns: 1 if the public key was fully valid.
@@ -381,6 +414,36 @@ SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify(
     const secp256k1_pubkey *pubkey
 ) SECP256K1_ARG_NONNULL(1) SECP256K1_ARG_NONNULL(2) SECP256K1_ARG_NONNULL(3) SECP256K1_ARG_NONNULL(4);
 
+/** Verify a batch of ECDSA signatures.
+ *
+ *  Returns: 1: all n signatures are correct (also when n is 0)
+ *           0: at least one signature is incorrect or unparseable
+ *  Args:    ctx:       a secp256k1 context object, initialized for verification.
+ *  Out:     failed:    if not NULL, set to the index of the first incorrect
+ *                      signature when 0 is returned, untouched otherwise
+ *  In:      sigs:      array of n signatures (cannot be NULL unless n is 0)
+ *           msg32s:    n 32-byte message hashes stored back to back, the i-th
+ *                      one at msg32s + 32 * i (cannot be NULL unless n is 0)
+ *           pubkeys:   array of n initialized public keys, the i-th signature
+ *                      is checked against the i-th key (cannot be NULL unless
+ *                      n is 0)
+ *           n:         number of signatures
+ *
+ * The result for each signature is the same as secp256k1_ecdsa_verify would
+ * give, lower-S form included. The signatures share a single scalar inversion,
+ * the remaining work is still one multiplication per signature: a signature
+ * only carries the x coordinate of R, so the checks cannot be folded into one
+ * random linear combination without each R's sign.
+ */
+SECP256K1_API SECP256K1_WARN_UNUSED_RESULT int secp256k1_ecdsa_verify_batch(
+    const secp256k1_context* ctx,
+    size_t *failed,
+    const secp256k1_ecdsa_signature *sigs,
+    const unsigned char *msg32s,
+    const secp256k1_pubkey *pubkeys,
+    size_t n
+) SECP256K1_ARG_NONNULL(1);
+
 /** Convert a signature to a normalized lower-S form.
  *
  *  Returns: 1 if sigin was not normalized, 0 if it already was.
@@ -22,11 +22,20 @@
 #undef USE_SCALAR_INV_BUILTIN
 #undef USE_SCALAR_INV_NUM
 
+#define USE_ENDOMORPHISM 1
 #define USE_NUM_NONE 1
 #define USE_FIELD_INV_BUILTIN 1
 #define USE_SCALAR_INV_BUILTIN 1
 #define USE_FIELD_10X26 1
 #define USE_SCALAR_8X32 1
 
+/* table sizes can be overridden from the compiler command line, see ecmult_gen.h and ecmult_impl.h */
+#ifndef ECMULT_WINDOW_SIZE
+#define ECMULT_WINDOW_SIZE 15
+#endif
+#ifndef ECMULT_GEN_PREC_BITS
+#define ECMULT_GEN_PREC_BITS 4
+#endif
+
 #endif // USE_BASIC_CONFIG
 #endif // _SECP256K1_BASIC_CONFIG_
@@ -0,0 +1,138 @@
+/**********************************************************************
+ * Copyright (c) 2017 Pieter Wuille                                   *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+#include <stdio.h>
+
+#include "include/secp256k1.h"
+
+#include "util.h"
+#include "hash_impl.h"
+#include "num_impl.h"
+#include "field_impl.h"
+#include "group_impl.h"
+#include "scalar_impl.h"
+#include "ecmult_impl.h"
+#include "bench.h"
+#include "secp256k1.c"
+
+#define POINTS 8192
+#define ITERS 4096
+
+typedef int (*ecmult_multi_func)(const secp256k1_ecmult_context*, secp256k1_scratch*, secp256k1_gej*, const secp256k1_scalar*, secp256k1_ecmult_multi_callback cb, void*, size_t);
+
+typedef struct {
+    /* Setup once in advance */
+    secp256k1_context* ctx;
+    secp256k1_scratch_space* scratch;
+    secp256k1_scalar* scalars;
+    secp256k1_ge* pubkeys;
+    ecmult_multi_func ecmult_multi;
+
+    /* Changes per test */
+    size_t count;
+
+    /* Changes per test iteration */
+    size_t offset;
+
+    /* Test output. */
+    secp256k1_gej output;
+} bench_data;
+
+static int bench_callback(secp256k1_scalar* sc, secp256k1_ge* ge, size_t idx, void* arg) {
+    bench_data* data = (bench_data*)arg;
+    *sc = data->scalars[(data->offset + idx) % POINTS];
+    *ge = data->pubkeys[(data->offset + idx) % POINTS];
+    return 1;
+}
+
+static int ecmult_multi_strauss(const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n) {
+    return secp256k1_ecmult_strauss_batch(ctx, scratch, r, inp_g_sc, cb, cbdata, n, 0);
+}
+
+static int ecmult_multi_pippenger(const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n) {
+    return secp256k1_ecmult_pippenger_batch(ctx, scratch, r, inp_g_sc, cb, cbdata, n, 0);
+}
+
+/* Multiplies ITERS points in total, count points per call. */
+static void bench_ecmult(void* arg) {
+    bench_data* data = (bench_data*)arg;
+    size_t iters = 1 + (ITERS - 1) / data->count;
+    size_t iter;
+
+    for (iter = 0; iter < iters; ++iter) {
+        CHECK(data->ecmult_multi(&data->ctx->ecmult_ctx, data->scratch, &data->output, NULL, bench_callback, arg, data->count));
+        data->offset = (data->offset + data->count) % POINTS;
+    }
+}
+
+static void run_test(bench_data* data, const char *name, ecmult_multi_func ecmult_multi, size_t count) {
+    char str[64];
+    data->ecmult_multi = ecmult_multi;
+    data->count = count;
+    data->offset = 0;
+    sprintf(str, "ecmult_multi_%s_%i", name, (int)count);
+    run_benchmark(str, bench_ecmult, NULL, NULL, data, 3, (1 + (ITERS - 1) / count) * count);
+}
+
+int have_flag(int argc, char** argv, char *flag) {
+    char** argm = argv + argc;
+    argv++;
+    if (argv == argm) {
+        return 1;
+    }
+    while (argv != NULL && argv != argm) {
+        if (strcmp(*argv, flag) == 0) {
+            return 1;
+        }
+        argv++;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    bench_data data;
+    secp256k1_sha256_t sha;
+    secp256k1_scratch_space *strauss_scratch;
+    size_t i, p;
+
+    data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    data.scalars = (secp256k1_scalar*)checked_malloc(&data.ctx->error_callback, sizeof(secp256k1_scalar) * POINTS);
+    data.pubkeys = (secp256k1_ge*)checked_malloc(&data.ctx->error_callback, sizeof(secp256k1_ge) * POINTS);
+
+    /* Pseudorandom scalars, and the points they generate. */
+    for (i = 0; i < POINTS; i++) {
+        unsigned char c[32];
+        unsigned char idx[4];
+        secp256k1_gej pubkeyj;
+        int overflow;
+        idx[0] = i; idx[1] = i >> 8; idx[2] = i >> 16; idx[3] = i >> 24;
+        secp256k1_sha256_initialize(&sha);
+        secp256k1_sha256_write(&sha, (const unsigned char*)"ecmult_multi", 12);
+        secp256k1_sha256_write(&sha, idx, sizeof(idx));
+        secp256k1_sha256_finalize(&sha, c);
+        secp256k1_scalar_set_b32(&data.scalars[i], c, &overflow);
+        secp256k1_ecmult_gen(&data.ctx->ecmult_gen_ctx, &pubkeyj, &data.scalars[(i + 1) % POINTS]);
+        secp256k1_ge_set_gej(&data.pubkeys[i], &pubkeyj);
+    }
+
+    /* A single multiplication per point, the way separate secp256k1_ecmult calls would do it. */
+    data.scratch = NULL;
+    if (have_flag(argc, argv, "simple")) run_test(&data, "simple", secp256k1_ecmult_multi_var, 1);
+
+    /* Both algorithms and the automatic choice, for n = 1 .. POINTS, each with a scratch space that holds all n. */
+    strauss_scratch = secp256k1_scratch_space_create(data.ctx, secp256k1_strauss_scratch_size(POINTS) + STRAUSS_SCRATCH_OBJECTS*ALIGNMENT);
+    for (p = 1; p <= POINTS; p *= 2) {
+        data.scratch = strauss_scratch;
+        if (have_flag(argc, argv, "strauss")) run_test(&data, "strauss", ecmult_multi_strauss, p);
+        if (have_flag(argc, argv, "pippenger")) run_test(&data, "pippenger", ecmult_multi_pippenger, p);
+        if (have_flag(argc, argv, "auto")) run_test(&data, "auto", secp256k1_ecmult_multi_var, p);
+    }
+    secp256k1_scratch_space_destroy(strauss_scratch);
+
+    free(data.scalars);
+    free(data.pubkeys);
+    secp256k1_context_destroy(data.ctx);
+    return 0;
+}
@@ -308,6 +308,19 @@ void bench_context_sign(void* arg) {
     }
 }
 
+/* what a wallet pays before its first signature: building both tables, unless they are static, and one sign */
+void bench_context_first_sign(void* arg) {
+    int i;
+    bench_inv_t *data = (bench_inv_t*)arg;
+
+    for (i = 0; i < 20; i++) {
+        secp256k1_context *ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+        secp256k1_ecdsa_signature sig;
+        CHECK(secp256k1_ecdsa_sign(ctx, &sig, data->data, data->data + 32, NULL, NULL));
+        secp256k1_context_destroy(ctx);
+    }
+}
+
 #ifndef USE_NUM_NONE
 void bench_num_jacobi(void* arg) {
     int i;
@@ -374,6 +387,7 @@ int main(int argc, char **argv) {
 
     if (have_flag(argc, argv, "context") || have_flag(argc, argv, "verify")) run_benchmark("context_verify", bench_context_verify, bench_setup, NULL, &data, 10, 20);
     if (have_flag(argc, argv, "context") || have_flag(argc, argv, "sign")) run_benchmark("context_sign", bench_context_sign, bench_setup, NULL, &data, 10, 200);
+    if (have_flag(argc, argv, "context") || have_flag(argc, argv, "startup")) run_benchmark("context_first_sign", bench_context_first_sign, bench_setup, NULL, &data, 10, 20);
 
 #ifndef USE_NUM_NONE
     if (have_flag(argc, argv, "num") || have_flag(argc, argv, "jacobi")) run_benchmark("num_jacobi", bench_num_jacobi, bench_setup, NULL, &data, 10, 200000);
@@ -30,6 +30,17 @@ typedef struct {
 #endif
 } benchmark_verify_t;
 
+#define BATCH_MAX 1024
+#define BATCH_ITERS 2048
+
+typedef struct {
+    secp256k1_context *ctx;
+    secp256k1_ecdsa_signature sigs[BATCH_MAX];
+    unsigned char msgs[BATCH_MAX * 32];
+    secp256k1_pubkey pubkeys[BATCH_MAX];
+    size_t batch;
+} benchmark_verify_batch_t;
+
 static void benchmark_verify(void* arg) {
     int i;
     benchmark_verify_t* data = (benchmark_verify_t*)arg;
@@ -49,6 +60,17 @@ static void benchmark_verify(void* arg) {
     }
 }
 
+static void benchmark_verify_batch(void* arg) {
+    size_t i;
+    benchmark_verify_batch_t* data = (benchmark_verify_batch_t*)arg;
+
+    for (i = 0; i < BATCH_ITERS; i += data->batch) {
+        size_t failed;
+        size_t off = i % BATCH_MAX;
+        CHECK(secp256k1_ecdsa_verify_batch(data->ctx, &failed, &data->sigs[off], &data->msgs[32 * off], &data->pubkeys[off], data->batch) == 1);
+    }
+}
+
 #ifdef ENABLE_OPENSSL_TESTS
 static void benchmark_verify_openssl(void* arg) {
     int i;
@@ -84,6 +106,8 @@ int main(void) {
     secp256k1_pubkey pubkey;
     secp256k1_ecdsa_signature sig;
     benchmark_verify_t data;
+    static benchmark_verify_batch_t batch;
+    char name[64];
 
     data.ctx = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
 
@@ -101,6 +125,24 @@ int main(void) {
     CHECK(secp256k1_ec_pubkey_serialize(data.ctx, data.pubkey, &data.pubkeylen, &pubkey, SECP256K1_EC_COMPRESSED) == 1);
 
     run_benchmark("ecdsa_verify", benchmark_verify, NULL, NULL, &data, 10, 20000);
+
+    /* Distinct keys and messages, timed per signature. */
+    batch.ctx = data.ctx;
+    for (i = 0; i < BATCH_MAX; i++) {
+        unsigned char key[32];
+        memcpy(key, data.key, 32);
+        key[28] = i >> 8;
+        key[29] = i & 0xFF;
+        memcpy(&batch.msgs[32 * i], data.msg, 32);
+        batch.msgs[32 * i] = i >> 8;
+        batch.msgs[32 * i + 1] = i & 0xFF;
+        CHECK(secp256k1_ec_pubkey_create(batch.ctx, &batch.pubkeys[i], key));
+        CHECK(secp256k1_ecdsa_sign(batch.ctx, &batch.sigs[i], &batch.msgs[32 * i], key, NULL, NULL));
+    }
+    for (batch.batch = 1; batch.batch <= BATCH_MAX; batch.batch *= 4) {
+        sprintf(name, "ecdsa_verify_batch_%d", (int)batch.batch);
+        run_benchmark(name, benchmark_verify_batch, NULL, NULL, &batch, 10, BATCH_ITERS);
+    }
 #ifdef ENABLE_OPENSSL_TESTS
     data.ec_group = EC_GROUP_new_by_curve_name(NID_secp256k1);
     run_benchmark("ecdsa_verify_openssl", benchmark_verify_openssl, NULL, NULL, &data, 10, 20000);
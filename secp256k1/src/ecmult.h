@@ -9,6 +9,8 @@
 
 #include "num.h"
 #include "group.h"
+#include "scalar.h"
+#include "scratch.h"
 
 typedef struct {
     /* For accelerating the computation of a*P + b*G: */
@@ -25,7 +27,30 @@ static void secp256k1_ecmult_context_clone(secp256k1_ecmult_context *dst,
 static void secp256k1_ecmult_context_clear(secp256k1_ecmult_context *ctx);
 static int secp256k1_ecmult_context_is_built(const secp256k1_ecmult_context *ctx);
 
-/** Double multiply: R = na*A + ng*G */
+/** Double multiply: R = na*A + ng*G. ng may be NULL, meaning zero. */
 static void secp256k1_ecmult(const secp256k1_ecmult_context *ctx, secp256k1_gej *r, const secp256k1_gej *a, const secp256k1_scalar *na, const secp256k1_scalar *ng);
 
+/** Supplies the idx-th scalar and point of a multi-multiplication; returns 0 to abort it. */
+typedef int (secp256k1_ecmult_multi_callback)(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data);
+
+/**
+ * Multi-multiply: R = inp_g_sc * G + sum_i ni * Ai.
+ * Chooses the right algorithm for a given number of points and scratch space
+ * size. Strauss' wNAF interleaving is used for small numbers of points,
+ * Pippenger's bucket method above ECMULT_PIPPENGER_THRESHOLD. Points are split
+ * into batches that fit the scratch space; with no scratch space, or one too
+ * small for a single point, each point gets its own secp256k1_ecmult. Nothing
+ * is allocated on the heap.
+ * Returns: 1 on success (including when inp_g_sc is NULL and n is 0)
+ *          0 if the callback returned 0 for some point
+ * Args:    ctx:     an ecmult context with precomputed G tables (cannot be NULL)
+ *          scratch: scratch space for the batches (can be NULL)
+ * Out:     r:       the result (cannot be NULL)
+ * In:      inp_g_sc: scalar for the generator, NULL means zero
+ *          cb:       callback returning the points and their scalars
+ *          cbdata:   passed through to cb
+ *          n:        number of points, excluding the generator
+ */
+static int secp256k1_ecmult_multi_var(const secp256k1_ecmult_context *ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n);
+
 #endif
@@ -7,11 +7,14 @@
 #define USE_BASIC_CONFIG 1
 
 #include "basic-config.h"
+#undef USE_ECMULT_STATIC_PRECOMPUTATION
+
 #include "include/secp256k1.h"
 #include "field_impl.h"
 #include "scalar_impl.h"
 #include "group_impl.h"
 #include "ecmult_gen_impl.h"
+#include "ecmult_impl.h"
 
 static void default_error_callback_fn(const char* str, void* data) {
     (void)data;
@@ -24,10 +27,24 @@ static const secp256k1_callback default_error_callback = {
     NULL
 };
 
+static void print_table(FILE *fp, const secp256k1_ge_storage *table, int n) {
+    int i;
+    for (i = 0; i != n; i++) {
+        fprintf(fp,"    SC(%uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu)", SECP256K1_GE_STORAGE_CONST_GET(table[i]));
+        if (i != n - 1) {
+            fprintf(fp,",\n");
+        } else {
+            fprintf(fp,"\n");
+        }
+    }
+}
+
 int main(int argc, char **argv) {
     secp256k1_ecmult_gen_context ctx;
-    int inner;
+    secp256k1_ge_storage *pre_g;
+    secp256k1_gej gj;
     int outer;
+    int i;
     FILE* fp;
 
     (void)argc;
@@ -38,26 +55,23 @@ int main(int argc, char **argv) {
         fprintf(stderr, "Could not open src/ecmult_static_context.h for writing!\n");
         return -1;
     }
-    
+
     fprintf(fp, "#ifndef _SECP256K1_ECMULT_STATIC_CONTEXT_\n");
     fprintf(fp, "#define _SECP256K1_ECMULT_STATIC_CONTEXT_\n");
     fprintf(fp, "#include \"group.h\"\n");
     fprintf(fp, "#define SC SECP256K1_GE_STORAGE_CONST\n");
-    fprintf(fp, "static const secp256k1_ge_storage secp256k1_ecmult_static_context[64][16] = {\n");
+    /* the header is included from both ecmult_impl.h and ecmult_gen_impl.h, so check the configured sizes only */
+    fprintf(fp, "#if ECMULT_GEN_PREC_BITS != %d || ECMULT_WINDOW_SIZE != %d\n", ECMULT_GEN_PREC_BITS, ECMULT_WINDOW_SIZE);
+    fprintf(fp, "   #error configuration mismatch, invalid ECMULT_GEN_PREC_BITS or ECMULT_WINDOW_SIZE. Try deleting ecmult_static_context.h before the build.\n");
+    fprintf(fp, "#endif\n");
+    fprintf(fp, "static const secp256k1_ge_storage secp256k1_ecmult_static_context[%d][%d] = {\n", ECMULT_GEN_PREC_N, ECMULT_GEN_PREC_G);
 
     secp256k1_ecmult_gen_context_init(&ctx);
     secp256k1_ecmult_gen_context_build(&ctx, &default_error_callback);
-    for(outer = 0; outer != 64; outer++) {
+    for(outer = 0; outer != ECMULT_GEN_PREC_N; outer++) {
         fprintf(fp,"{\n");
-        for(inner = 0; inner != 16; inner++) {
-            fprintf(fp,"    SC(%uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu, %uu)", SECP256K1_GE_STORAGE_CONST_GET((*ctx.prec)[outer][inner]));
-            if (inner != 15) {
-                fprintf(fp,",\n");
-            } else {
-                fprintf(fp,"\n");
-            }
-        }
-        if (outer != 63) {
+        print_table(fp, (*ctx.prec)[outer], ECMULT_GEN_PREC_G);
+        if (outer != ECMULT_GEN_PREC_N - 1) {
             fprintf(fp,"},\n");
         } else {
             fprintf(fp,"}\n");
@@ -65,10 +79,29 @@ int main(int argc, char **argv) {
     }
     fprintf(fp,"};\n");
     secp256k1_ecmult_gen_context_clear(&ctx);
-    
+
+    /* The verification tables: odd multiples of G, and of 2^128*G for builds with the endomorphism. */
+    pre_g = (secp256k1_ge_storage*)checked_malloc(&default_error_callback, sizeof(*pre_g) * ECMULT_TABLE_SIZE(WINDOW_G));
+    secp256k1_gej_set_ge(&gj, &secp256k1_ge_const_g);
+    secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(WINDOW_G), pre_g, &gj, &default_error_callback);
+    fprintf(fp, "static const secp256k1_ge_storage secp256k1_ecmult_static_pre_g[%d] = {\n", ECMULT_TABLE_SIZE(WINDOW_G));
+    print_table(fp, pre_g, ECMULT_TABLE_SIZE(WINDOW_G));
+    fprintf(fp,"};\n");
+
+    for (i = 0; i < 128; i++) {
+        secp256k1_gej_double_var(&gj, &gj, NULL);
+    }
+    secp256k1_ecmult_odd_multiples_table_storage_var(ECMULT_TABLE_SIZE(WINDOW_G), pre_g, &gj, &default_error_callback);
+    fprintf(fp, "#ifdef USE_ENDOMORPHISM\n");
+    fprintf(fp, "static const secp256k1_ge_storage secp256k1_ecmult_static_pre_g_128[%d] = {\n", ECMULT_TABLE_SIZE(WINDOW_G));
+    print_table(fp, pre_g, ECMULT_TABLE_SIZE(WINDOW_G));
+    fprintf(fp,"};\n");
+    fprintf(fp, "#endif\n");
+    free(pre_g);
+
     fprintf(fp, "#undef SC\n");
     fprintf(fp, "#endif\n");
     fclose(fp);
-    
+
     return 0;
 }
@@ -243,6 +243,33 @@ static void secp256k1_scalar_inverse_var(secp256k1_scalar *r, const secp256k1_sc
 #endif
 }
 
+static void secp256k1_scalar_inverse_all_var(secp256k1_scalar *r, const secp256k1_scalar *a, size_t len) {
+    secp256k1_scalar u;
+    size_t i;
+    if (len < 1) {
+        return;
+    }
+
+    VERIFY_CHECK((r + len <= a) || (a + len <= r));
+
+    r[0] = a[0];
+
+    i = 0;
+    while (++i < len) {
+        secp256k1_scalar_mul(&r[i], &r[i - 1], &a[i]);
+    }
+
+    secp256k1_scalar_inverse_var(&u, &r[--i]);
+
+    while (i > 0) {
+        size_t j = i--;
+        secp256k1_scalar_mul(&r[j], &r[i], &u);
+        secp256k1_scalar_mul(&u, &u, &a[j]);
+    }
+
+    r[0] = u;
+}
+
 #ifdef USE_ENDOMORPHISM
 #if defined(EXHAUSTIVE_TEST_ORDER)
 /**
@@ -318,7 +345,14 @@ static void secp256k1_scalar_split_lambda(secp256k1_scalar *r1, secp256k1_scalar
     );
     VERIFY_CHECK(r1 != a);
     VERIFY_CHECK(r2 != a);
-    /* these _var calls are constant time since the shift amount is constant */
+    /* This function runs on secret scalars in ecmult_const, so it must stay constant time. The _var calls
+     * below are: mul_shift_var only branches on the shift amount, which is constant here, and rounds with
+     * the branch-free cadd_bit. Everything else is constant time scalar arithmetic.
+     *
+     * The results (or their negations) are below 2^128: g1 and g2 are off by at most 1/2 in 2^272, so c1
+     * and c2 are within 1/2 + 2^-17 of b2*a/n and -b1*a/n. That keeps |r1| below (1/2 + 2^-17)*(|a1| + |a2|)
+     * and |r2| below (1/2 + 2^-17)*(|b1| + |b2|), both under 2^128. wnaf_const and the 128-bit wNAFs in
+     * ecmult rely on this bound. */
     secp256k1_scalar_mul_shift_var(&c1, a, &g1, 272);
     secp256k1_scalar_mul_shift_var(&c2, a, &g2, 272);
     secp256k1_scalar_mul(&c1, &c1, &minus_b1);
@@ -0,0 +1,39 @@
+/**********************************************************************
+ * Copyright (c) 2017 Andrew Poelstra                                 *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_SCRATCH_
+#define _SECP256K1_SCRATCH_
+
+#include <stddef.h>
+
+#include "util.h"
+
+/* The typedef is used internally; the struct name is used in the public API
+ * (where it is exposed as a different typedef) */
+typedef struct secp256k1_scratch_space_struct {
+    void *data;
+    size_t alloc_size;
+    size_t max_size;
+} secp256k1_scratch;
+
+/** Allocates a scratch space of max_size bytes, the only allocation made for it. */
+static secp256k1_scratch* secp256k1_scratch_create(const secp256k1_callback* error_callback, size_t max_size);
+
+static void secp256k1_scratch_destroy(secp256k1_scratch* scratch);
+
+/** Returns the number of bytes still available to n_objects allocations, after their alignment padding. */
+static size_t secp256k1_scratch_max_allocation(const secp256k1_scratch* scratch, size_t n_objects);
+
+/** Returns a pointer to size bytes of the scratch space, or NULL if there is not enough room left. */
+static void *secp256k1_scratch_alloc(secp256k1_scratch* scratch, size_t size);
+
+/** Returns the current position in the scratch space, to be passed to secp256k1_scratch_apply_checkpoint. */
+static size_t secp256k1_scratch_checkpoint(const secp256k1_scratch* scratch);
+
+/** Releases everything allocated since checkpoint was taken. */
+static void secp256k1_scratch_apply_checkpoint(secp256k1_scratch* scratch, size_t checkpoint);
+
+#endif
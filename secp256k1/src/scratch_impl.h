@@ -0,0 +1,66 @@
+/**********************************************************************
+ * Copyright (c) 2017 Andrew Poelstra                                 *
+ * Distributed under the MIT software license, see the accompanying   *
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php.*
+ **********************************************************************/
+
+#ifndef _SECP256K1_SCRATCH_IMPL_H_
+#define _SECP256K1_SCRATCH_IMPL_H_
+
+#include "scratch.h"
+
+/* Every allocation is padded to a multiple of ALIGNMENT bytes, so that any object type can follow another. */
+#define ALIGNMENT 16
+#define ROUND_TO_ALIGN(size) (((size) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT)
+
+static secp256k1_scratch* secp256k1_scratch_create(const secp256k1_callback* error_callback, size_t max_size) {
+    secp256k1_scratch* ret = (secp256k1_scratch*)checked_malloc(error_callback, sizeof(*ret));
+    if (ret != NULL) {
+        ret->data = checked_malloc(error_callback, max_size > 0 ? max_size : 1);
+        if (ret->data == NULL) {
+            free(ret);
+            return NULL;
+        }
+        ret->alloc_size = 0;
+        ret->max_size = max_size;
+    }
+    return ret;
+}
+
+static void secp256k1_scratch_destroy(secp256k1_scratch* scratch) {
+    if (scratch != NULL) {
+        VERIFY_CHECK(scratch->alloc_size == 0);
+        free(scratch->data);
+        free(scratch);
+    }
+}
+
+static size_t secp256k1_scratch_max_allocation(const secp256k1_scratch* scratch, size_t n_objects) {
+    size_t left = scratch->max_size - scratch->alloc_size;
+    if (left <= (ALIGNMENT - 1) * n_objects) {
+        return 0;
+    }
+    return left - (ALIGNMENT - 1) * n_objects;
+}
+
+static void *secp256k1_scratch_alloc(secp256k1_scratch* scratch, size_t size) {
+    void *ret;
+    size = ROUND_TO_ALIGN(size);
+    if (size > scratch->max_size - scratch->alloc_size) {
+        return NULL;
+    }
+    ret = (void *) ((unsigned char *) scratch->data + scratch->alloc_size);
+    scratch->alloc_size += size;
+    return ret;
+}
+
+static size_t secp256k1_scratch_checkpoint(const secp256k1_scratch* scratch) {
+    return scratch->alloc_size;
+}
+
+static void secp256k1_scratch_apply_checkpoint(secp256k1_scratch* scratch, size_t checkpoint) {
+    VERIFY_CHECK(checkpoint <= scratch->alloc_size);
+    scratch->alloc_size = checkpoint;
+}
+
+#endif
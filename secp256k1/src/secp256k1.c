@@ -114,6 +114,15 @@ void secp256k1_context_set_error_callback(secp256k1_context* ctx, void (*fun)(co
     ctx->error_callback.data = data;
 }
 
+secp256k1_scratch_space* secp256k1_scratch_space_create(const secp256k1_context* ctx, size_t max_size) {
+    VERIFY_CHECK(ctx != NULL);
+    return secp256k1_scratch_create(&ctx->error_callback, max_size);
+}
+
+void secp256k1_scratch_space_destroy(secp256k1_scratch_space* scratch) {
+    secp256k1_scratch_destroy(scratch);
+}
+
 static int secp256k1_pubkey_load(const secp256k1_context* ctx, secp256k1_ge* ge, const secp256k1_pubkey* pubkey) {
     if (sizeof(secp256k1_ge_storage) == 64) {
         /* When the secp256k1_ge_storage type is exactly 64 byte, use its
@@ -307,6 +316,56 @@ int secp256k1_ecdsa_verify(const secp256k1_context* ctx, const secp256k1_ecdsa_s
             secp256k1_ecdsa_sig_verify(&ctx->ecmult_ctx, &r, &s, &q, &m));
 }
 
+/* Signatures whose s values are inverted together; bounds the stack use of secp256k1_ecdsa_verify_batch. */
+#define ECDSA_VERIFY_BATCH_CHUNK 64
+
+int secp256k1_ecdsa_verify_batch(const secp256k1_context* ctx, size_t *failed, const secp256k1_ecdsa_signature *sigs, const unsigned char *msg32s, const secp256k1_pubkey *pubkeys, size_t n) {
+    secp256k1_scalar r[ECDSA_VERIFY_BATCH_CHUNK], s[ECDSA_VERIFY_BATCH_CHUNK], sn[ECDSA_VERIFY_BATCH_CHUNK];
+    secp256k1_ge q;
+    secp256k1_scalar m;
+    size_t i, j, len, valid;
+    VERIFY_CHECK(ctx != NULL);
+    ARG_CHECK(secp256k1_ecmult_context_is_built(&ctx->ecmult_ctx));
+    ARG_CHECK(n == 0 || msg32s != NULL);
+    ARG_CHECK(n == 0 || sigs != NULL);
+    ARG_CHECK(n == 0 || pubkeys != NULL);
+
+    for (i = 0; i < n; i += len) {
+        len = n - i;
+        if (len > ECDSA_VERIFY_BATCH_CHUNK) {
+            len = ECDSA_VERIFY_BATCH_CHUNK;
+        }
+
+        /* Only the signatures before the first malformed one are verified, so that the failure
+         * reported is always the one with the lowest index. */
+        for (valid = 0; valid < len; valid++) {
+            secp256k1_ecdsa_signature_load(ctx, &r[valid], &s[valid], &sigs[i + valid]);
+            if (secp256k1_scalar_is_zero(&r[valid]) || secp256k1_scalar_is_zero(&s[valid]) || secp256k1_scalar_is_high(&s[valid])) {
+                break;
+            }
+        }
+
+        secp256k1_scalar_inverse_all_var(sn, s, valid);
+
+        for (j = 0; j < valid; j++) {
+            secp256k1_scalar_set_b32(&m, &msg32s[32 * (i + j)], NULL);
+            if (!secp256k1_pubkey_load(ctx, &q, &pubkeys[i + j]) ||
+                !secp256k1_ecdsa_sig_verify_sn(&ctx->ecmult_ctx, &r[j], &sn[j], &q, &m)) {
+                break;
+            }
+        }
+
+        if (j < len) {
+            if (failed != NULL) {
+                *failed = i + j;
+            }
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
 static int nonce_function_rfc6979(unsigned char *nonce32, const unsigned char *msg32, const unsigned char *key32, const unsigned char *algo16, void *data, unsigned int counter) {
    unsigned char keydata[112];
    int keylen = 64;
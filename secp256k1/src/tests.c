@@ -1548,6 +1548,32 @@ void run_scalar_tests(void) {
     }
 }
 
+void run_scalar_inverse_all_var(void) {
+    secp256k1_scalar x[16], xi[16], xii[16];
+    int i;
+    /* Check it's safe to call for 0 elements */
+    secp256k1_scalar_inverse_all_var(xi, x, 0);
+    for (i = 0; i < count; i++) {
+        size_t j;
+        size_t len = secp256k1_rand_int(15) + 1;
+        for (j = 0; j < len; j++) {
+            do {
+                random_scalar_order_test(&x[j]);
+            } while (secp256k1_scalar_is_zero(&x[j]));
+        }
+        secp256k1_scalar_inverse_all_var(xi, x, len);
+        for (j = 0; j < len; j++) {
+            secp256k1_scalar t;
+            secp256k1_scalar_mul(&t, &x[j], &xi[j]);
+            CHECK(secp256k1_scalar_is_one(&t));
+        }
+        secp256k1_scalar_inverse_all_var(xii, xi, len);
+        for (j = 0; j < len; j++) {
+            CHECK(secp256k1_scalar_eq(&x[j], &xii[j]));
+        }
+    }
+}
+
 /***** FIELD TESTS *****/
 
 void random_fe(secp256k1_fe *x) {
@@ -2575,6 +2601,44 @@ void test_constant_wnaf(const secp256k1_scalar *number, int w) {
     CHECK(secp256k1_scalar_eq(&x, &num));
 }
 
+void test_fixed_wnaf(const secp256k1_scalar *number, int w) {
+    secp256k1_scalar x, shift;
+    int wnaf[256] = {0};
+    int i;
+    int skew;
+    secp256k1_scalar num = *number;
+
+    secp256k1_scalar_set_int(&x, 0);
+    secp256k1_scalar_set_int(&shift, 1 << w);
+    /* With USE_ENDOMORPHISM on we only consider 128-bit numbers */
+#ifdef USE_ENDOMORPHISM
+    for (i = 0; i < 16; ++i) {
+        secp256k1_scalar_shr_int(&num, 8);
+    }
+#endif
+    skew = secp256k1_wnaf_fixed(wnaf, &num, w);
+
+    for (i = WNAF_SIZE(w)-1; i >= 0; --i) {
+        secp256k1_scalar t;
+        int v = wnaf[i];
+        CHECK(v == 0 || v & 1);  /* check parity */
+        CHECK(v > -(1 << w)); /* check range above */
+        CHECK(v < (1 << w));  /* check range below */
+
+        secp256k1_scalar_mul(&x, &x, &shift);
+        if (v >= 0) {
+            secp256k1_scalar_set_int(&t, v);
+        } else {
+            secp256k1_scalar_set_int(&t, -v);
+            secp256k1_scalar_negate(&t, &t);
+        }
+        secp256k1_scalar_add(&x, &x, &t);
+    }
+    /* If skew is 1 then add 1 to num */
+    secp256k1_scalar_cadd_bit(&num, 0, skew == 1);
+    CHECK(secp256k1_scalar_eq(&x, &num));
+}
+
 void run_wnaf(void) {
     int i;
     secp256k1_scalar n = {{0}};
@@ -2585,12 +2649,16 @@ void run_wnaf(void) {
     test_constant_wnaf(&n, 4);
     n.d[0] = 2;
     test_constant_wnaf(&n, 4);
+    test_fixed_wnaf(&n, 4);
+    secp256k1_scalar_set_int(&n, 0);
+    test_fixed_wnaf(&n, 4);
     /* Random tests */
     for (i = 0; i < count; i++) {
         random_scalar_order(&n);
         test_wnaf(&n, 4+(i%10));
         test_constant_wnaf_negate(&n);
         test_constant_wnaf(&n, 4 + (i % 10));
+        test_fixed_wnaf(&n, 4 + (i % 10));
     }
     secp256k1_scalar_set_int(&n, 0);
     CHECK(secp256k1_scalar_cond_negate(&n, 1) == -1);
@@ -2599,6 +2667,353 @@ void run_wnaf(void) {
     CHECK(secp256k1_scalar_is_zero(&n));
 }
 
+typedef struct {
+    secp256k1_scalar *sc;
+    secp256k1_ge *pt;
+} ecmult_multi_data;
+
+static int ecmult_multi_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    ecmult_multi_data *data = (ecmult_multi_data*) cbdata;
+    *sc = data->sc[idx];
+    *pt = data->pt[idx];
+    return 1;
+}
+
+static int ecmult_multi_false_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    (void)sc;
+    (void)pt;
+    (void)idx;
+    (void)cbdata;
+    return 0;
+}
+
+typedef int (*ecmult_multi_func)(const secp256k1_ecmult_context*, secp256k1_scratch*, secp256k1_gej*, const secp256k1_scalar*, secp256k1_ecmult_multi_callback cb, void*, size_t);
+
+static int ecmult_multi_strauss_single(const secp256k1_ecmult_context *ecmult_ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n) {
+    return secp256k1_ecmult_strauss_batch(ecmult_ctx, scratch, r, inp_g_sc, cb, cbdata, n, 0);
+}
+
+static int ecmult_multi_pippenger_single(const secp256k1_ecmult_context *ecmult_ctx, secp256k1_scratch *scratch, secp256k1_gej *r, const secp256k1_scalar *inp_g_sc, secp256k1_ecmult_multi_callback cb, void *cbdata, size_t n) {
+    return secp256k1_ecmult_pippenger_batch(ecmult_ctx, scratch, r, inp_g_sc, cb, cbdata, n, 0);
+}
+
+/* Checks that a and b are the same point, whatever their Z. */
+void gej_equals_gej(const secp256k1_gej *a, const secp256k1_gej *b) {
+    secp256k1_gej t;
+    secp256k1_gej_neg(&t, b);
+    secp256k1_gej_add_var(&t, &t, a, NULL);
+    CHECK(secp256k1_gej_is_infinity(&t));
+}
+
+void test_ecmult_multi(secp256k1_scratch *scratch, ecmult_multi_func ecmult_multi) {
+    secp256k1_scalar szero;
+    secp256k1_scalar sc[32];
+    secp256k1_ge pt[32];
+    secp256k1_gej r;
+    secp256k1_gej r2;
+    secp256k1_gej infj;
+    ecmult_multi_data data;
+    int ncount;
+    size_t i, j;
+
+    data.sc = sc;
+    data.pt = pt;
+    secp256k1_scalar_set_int(&szero, 0);
+    secp256k1_gej_set_infinity(&infj);
+
+    /* No points to multiply */
+    CHECK(ecmult_multi(&ctx->ecmult_ctx, scratch, &r, NULL, ecmult_multi_callback, &data, 0));
+    CHECK(secp256k1_gej_is_infinity(&r));
+
+    /* Check 1- and 2-point multiplies against ecmult */
+    for (ncount = 0; ncount < count; ncount++) {
+        secp256k1_ge ptg;
+        secp256k1_gej ptgj;
+        random_scalar_order(&sc[0]);
+        random_scalar_order(&sc[1]);
+
+        random_group_element_test(&ptg);
+        secp256k1_gej_set_ge(&ptgj, &ptg);
+        pt[0] = ptg;
+        pt[1] = secp256k1_ge_const_g;
+
+        /* only G scalar */
+        secp256k1_ecmult(&ctx->ecmult_ctx, &r2, &ptgj, &szero, &sc[0]);
+        CHECK(ecmult_multi(&ctx->ecmult_ctx, scratch, &r, &sc[0], ecmult_multi_callback, &data, 0));
+        gej_equals_gej(&r, &r2);
+
+        /* 1-point */
+        secp256k1_ecmult(&ctx->ecmult_ctx, &r2, &ptgj, &sc[0], &szero);
+        CHECK(ecmult_multi(&ctx->ecmult_ctx, scratch, &r, &szero, ecmult_multi_callback, &data, 1));
+        gej_equals_gej(&r, &r2);
+
+        /* Try to multiply 1 point, but callback returns false */
+        CHECK(!ecmult_multi(&ctx->ecmult_ctx, scratch, &r, &szero, ecmult_multi_false_callback, &data, 1));
+
+        /* 2-point */
+        secp256k1_ecmult(&ctx->ecmult_ctx, &r2, &ptgj, &sc[0], &sc[1]);
+        CHECK(ecmult_multi(&ctx->ecmult_ctx, scratch, &r, &szero, ecmult_multi_callback, &data, 2));
+        gej_equals_gej(&r, &r2);
+
+        /* 2-point with G scalar */
+        CHECK(ecmult_multi(&ctx->ecmult_ctx, scratch, &r, &sc[1], ecmult_multi_callback, &data, 1));
+        gej_equals_gej(&r, &r2);
+    }
+
+    /* Check infinite outputs of various forms */
+    for (ncount = 0; ncount < count; ncount++) {
+        secp256k1_ge ptg;
+        size_t sizes[] = { 2, 10, 32 };
+
+        for (j = 0; j < 3; j++) {
+            for (i = 0; i < 32; i++) {
+                random_scalar_order(&sc[i]);
+                random_group_element_test(&pt[i]);
+                pt[i].infinity = 1;
+            }
+            CHECK(ecmult_multi(&ctx->ecmult_ctx, scratch, &r, &szero, ecmult_multi_callback, &data, sizes[j]));
+            CHECK(secp256k1_gej_is_infinity(&r));
+        }
+
+        for (j = 0; j < 3; j++) {
+            for (i = 0; i < 32; i++) {
+                random_group_element_test(&ptg);
+                pt[i] = ptg;
+                secp256k1_scalar_set_int(&sc[i], 0);
+            }
+            CHECK(ecmult_multi(&ctx->ecmult_ctx, scratch, &r, &szero, ecmult_multi_callback, &data, sizes[j]));
+            CHECK(secp256k1_gej_is_infinity(&r));
+        }
+
+        /* Each point once with a scalar and once negated with the same scalar */
+        for (j = 0; j < 3; j++) {
+            for (i = 0; i < 16; i++) {
+                random_scalar_order(&sc[2*i]);
+                sc[2*i + 1] = sc[2*i];
+                random_group_element_test(&pt[2*i]);
+                secp256k1_ge_neg(&pt[2*i + 1], &pt[2*i]);
+            }
+            CHECK(ecmult_multi(&ctx->ecmult_ctx, scratch, &r, &szero, ecmult_multi_callback, &data, sizes[j]));
+            CHECK(secp256k1_gej_is_infinity(&r));
+        }
+
+        /* One point with scalars that add up to zero */
+        random_group_element_test(&ptg);
+        for (i = 0; i < 16; i++) {
+            random_scalar_order(&sc[2*i]);
+            secp256k1_scalar_negate(&sc[2*i + 1], &sc[2*i]);
+            pt[2*i] = ptg;
+            pt[2*i + 1] = ptg;
+        }
+        CHECK(ecmult_multi(&ctx->ecmult_ctx, scratch, &r, &szero, ecmult_multi_callback, &data, 32));
+        CHECK(secp256k1_gej_is_infinity(&r));
+    }
+
+    /* Random sums, with some zero scalars and points at infinity, against single multiplications */
+    for (ncount = 0; ncount < count; ncount++) {
+        secp256k1_scalar g_sc;
+        size_t n = secp256k1_rand_int(33);
+
+        random_scalar_order(&g_sc);
+        secp256k1_ecmult(&ctx->ecmult_ctx, &r2, &infj, &szero, &g_sc);
+        for (i = 0; i < n; i++) {
+            secp256k1_gej ptgj;
+            random_scalar_order(&sc[i]);
+            random_group_element_test(&pt[i]);
+            if (secp256k1_rand_int(8) == 0) {
+                secp256k1_scalar_set_int(&sc[i], 0);
+            } else if (secp256k1_rand_int(8) == 0) {
+                pt[i].infinity = 1;
+            }
+            secp256k1_gej_set_ge(&ptgj, &pt[i]);
+            secp256k1_ecmult(&ctx->ecmult_ctx, &ptgj, &ptgj, &sc[i], NULL);
+            secp256k1_gej_add_var(&r2, &r2, &ptgj, NULL);
+        }
+        CHECK(ecmult_multi(&ctx->ecmult_ctx, scratch, &r, &g_sc, ecmult_multi_callback, &data, n));
+        gej_equals_gej(&r, &r2);
+    }
+}
+
+void test_secp256k1_pippenger_bucket_window_inv(void) {
+    int i;
+
+    CHECK(secp256k1_pippenger_bucket_window_inv(0) == 0);
+    for(i = 1; i <= PIPPENGER_MAX_BUCKET_WINDOW; i++) {
+#ifdef USE_ENDOMORPHISM
+        /* Bucket_window of 8 is not used with endo */
+        if (i == 8) {
+            continue;
+        }
+#endif
+        CHECK(secp256k1_pippenger_bucket_window(secp256k1_pippenger_bucket_window_inv(i)) == i);
+        if (i != PIPPENGER_MAX_BUCKET_WINDOW) {
+            CHECK(secp256k1_pippenger_bucket_window(secp256k1_pippenger_bucket_window_inv(i)+1) > i);
+        }
+    }
+}
+
+/* The number of points secp256k1_pippenger_max_points and secp256k1_strauss_max_points promise for a random
+ * scratch size really fits: a batch of that many points succeeds, and so does every smaller one. */
+void test_ecmult_multi_max_points(void) {
+    static secp256k1_scalar sc[512];
+    static secp256k1_ge pt[512];
+    secp256k1_scalar szero;
+    ecmult_multi_data data;
+    size_t max_size = secp256k1_pippenger_scratch_size(512, secp256k1_pippenger_bucket_window(512)) + PIPPENGER_SCRATCH_OBJECTS*ALIGNMENT;
+    size_t i;
+    int ncount;
+
+    data.sc = sc;
+    data.pt = pt;
+    secp256k1_scalar_set_int(&szero, 0);
+    for (i = 0; i < 512; i++) {
+        random_scalar_order(&sc[i]);
+        random_group_element_test(&pt[i]);
+    }
+
+    for (ncount = 0; ncount < count; ncount++) {
+        secp256k1_scratch *scratch = secp256k1_scratch_create(&ctx->error_callback, secp256k1_rand_int(max_size));
+        size_t n_pippenger = secp256k1_pippenger_max_points(scratch);
+        size_t n_strauss = secp256k1_strauss_max_points(scratch);
+        secp256k1_gej r;
+
+        CHECK(n_pippenger <= 512 && n_strauss <= n_pippenger);
+        if (n_pippenger > 0) {
+            CHECK(secp256k1_ecmult_pippenger_batch(&ctx->ecmult_ctx, scratch, &r, &szero, ecmult_multi_callback, &data, n_pippenger, 0));
+            CHECK(secp256k1_ecmult_pippenger_batch(&ctx->ecmult_ctx, scratch, &r, &szero, ecmult_multi_callback, &data, secp256k1_rand_int(n_pippenger) + 1, 0));
+        }
+        if (n_strauss > 0) {
+            CHECK(secp256k1_ecmult_strauss_batch(&ctx->ecmult_ctx, scratch, &r, &szero, ecmult_multi_callback, &data, n_strauss, 0));
+        }
+        CHECK(secp256k1_scratch_checkpoint(scratch) == 0);
+        secp256k1_scratch_destroy(scratch);
+    }
+}
+
+void test_ecmult_multi_batch_size_helper(void) {
+    size_t n_batches, n_batch_points, max_n_batch_points, n;
+
+    max_n_batch_points = 0;
+    n = 1;
+    CHECK(secp256k1_ecmult_multi_batch_size_helper(&n_batches, &n_batch_points, max_n_batch_points, n) == 0);
+
+    max_n_batch_points = 1;
+    n = 0;
+    CHECK(secp256k1_ecmult_multi_batch_size_helper(&n_batches, &n_batch_points, max_n_batch_points, n) == 1);
+    CHECK(n_batches == 0);
+    CHECK(n_batch_points == 0);
+
+    max_n_batch_points = 2;
+    n = 5;
+    CHECK(secp256k1_ecmult_multi_batch_size_helper(&n_batches, &n_batch_points, max_n_batch_points, n) == 1);
+    CHECK(n_batches == 3);
+    CHECK(n_batch_points == 2);
+
+    max_n_batch_points = ECMULT_MAX_POINTS_PER_BATCH;
+    n = ECMULT_MAX_POINTS_PER_BATCH;
+    CHECK(secp256k1_ecmult_multi_batch_size_helper(&n_batches, &n_batch_points, max_n_batch_points, n) == 1);
+    CHECK(n_batches == 1);
+    CHECK(n_batch_points == ECMULT_MAX_POINTS_PER_BATCH);
+
+    max_n_batch_points = ECMULT_MAX_POINTS_PER_BATCH + 1;
+    n = ECMULT_MAX_POINTS_PER_BATCH + 1;
+    CHECK(secp256k1_ecmult_multi_batch_size_helper(&n_batches, &n_batch_points, max_n_batch_points, n) == 1);
+    CHECK(n_batches == 2);
+    CHECK(n_batch_points == ECMULT_MAX_POINTS_PER_BATCH/2 + 1);
+
+    max_n_batch_points = 1;
+    n = SIZE_MAX;
+    CHECK(secp256k1_ecmult_multi_batch_size_helper(&n_batches, &n_batch_points, max_n_batch_points, n) == 1);
+    CHECK(n_batches == SIZE_MAX);
+    CHECK(n_batch_points == 1);
+
+    max_n_batch_points = 2;
+    n = SIZE_MAX;
+    CHECK(secp256k1_ecmult_multi_batch_size_helper(&n_batches, &n_batch_points, max_n_batch_points, n) == 1);
+    CHECK(n_batches == SIZE_MAX/2 + 1);
+    CHECK(n_batch_points == 2);
+}
+
+/**
+ * Run secp256k1_ecmult_multi_var with n_points points and scratch spaces that
+ * fit a varying number of them, so that the points are split into batches.
+ */
+void test_ecmult_multi_batching(void) {
+    static const int n_points = 2*ECMULT_PIPPENGER_THRESHOLD;
+    static const int batch_points[] = { 1, 2, 7, 31, ECMULT_PIPPENGER_THRESHOLD - 1, ECMULT_PIPPENGER_THRESHOLD + 1, 2*ECMULT_PIPPENGER_THRESHOLD };
+    secp256k1_scalar scG;
+    secp256k1_scalar szero;
+    secp256k1_scalar *sc = (secp256k1_scalar *)checked_malloc(&ctx->error_callback, sizeof(secp256k1_scalar) * n_points);
+    secp256k1_ge *pt = (secp256k1_ge *)checked_malloc(&ctx->error_callback, sizeof(secp256k1_ge) * n_points);
+    secp256k1_gej r;
+    secp256k1_gej r2;
+    ecmult_multi_data data;
+    int i;
+    secp256k1_scratch *scratch;
+
+    secp256k1_gej_set_infinity(&r2);
+    secp256k1_scalar_set_int(&szero, 0);
+
+    /* Get random scalars and group elements and compute result */
+    random_scalar_order(&scG);
+    secp256k1_ecmult(&ctx->ecmult_ctx, &r2, &r2, &szero, &scG);
+    for(i = 0; i < n_points; i++) {
+        secp256k1_ge ptg;
+        secp256k1_gej ptgj;
+        random_group_element_test(&ptg);
+        secp256k1_gej_set_ge(&ptgj, &ptg);
+        pt[i] = ptg;
+        random_scalar_order(&sc[i]);
+        secp256k1_ecmult(&ctx->ecmult_ctx, &ptgj, &ptgj, &sc[i], NULL);
+        secp256k1_gej_add_var(&r2, &r2, &ptgj, NULL);
+    }
+    data.sc = sc;
+    data.pt = pt;
+
+    /* Without room for a single point every point gets its own multiplication */
+    scratch = secp256k1_scratch_create(&ctx->error_callback, 0);
+    CHECK(secp256k1_ecmult_multi_var(&ctx->ecmult_ctx, scratch, &r, &scG, ecmult_multi_callback, &data, n_points));
+    gej_equals_gej(&r, &r2);
+    secp256k1_scratch_destroy(scratch);
+
+    for(i = 0; i < (int)(sizeof(batch_points) / sizeof(batch_points[0])); i++) {
+        if (batch_points[i] > ECMULT_PIPPENGER_THRESHOLD) {
+            int bucket_window = secp256k1_pippenger_bucket_window(batch_points[i]);
+            size_t scratch_size = secp256k1_pippenger_scratch_size(batch_points[i], bucket_window);
+            scratch = secp256k1_scratch_create(&ctx->error_callback, scratch_size + PIPPENGER_SCRATCH_OBJECTS*ALIGNMENT);
+        } else {
+            size_t scratch_size = secp256k1_strauss_scratch_size(batch_points[i]);
+            scratch = secp256k1_scratch_create(&ctx->error_callback, scratch_size + STRAUSS_SCRATCH_OBJECTS*ALIGNMENT);
+        }
+        CHECK(secp256k1_ecmult_multi_var(&ctx->ecmult_ctx, scratch, &r, &scG, ecmult_multi_callback, &data, n_points));
+        gej_equals_gej(&r, &r2);
+        secp256k1_scratch_destroy(scratch);
+    }
+    free(sc);
+    free(pt);
+}
+
+void run_ecmult_multi_tests(void) {
+    secp256k1_scratch *scratch;
+
+    test_secp256k1_pippenger_bucket_window_inv();
+    test_ecmult_multi_max_points();
+    scratch = secp256k1_scratch_create(&ctx->error_callback, 819200);
+    test_ecmult_multi(scratch, secp256k1_ecmult_multi_var);
+    test_ecmult_multi(NULL, secp256k1_ecmult_multi_var);
+    test_ecmult_multi(scratch, ecmult_multi_pippenger_single);
+    test_ecmult_multi(scratch, ecmult_multi_strauss_single);
+    secp256k1_scratch_destroy(scratch);
+
+    /* Run test_ecmult_multi with space for exactly one point */
+    scratch = secp256k1_scratch_create(&ctx->error_callback, secp256k1_strauss_scratch_size(1) + STRAUSS_SCRATCH_OBJECTS*ALIGNMENT);
+    test_ecmult_multi(scratch, secp256k1_ecmult_multi_var);
+    secp256k1_scratch_destroy(scratch);
+
+    test_ecmult_multi_batch_size_helper();
+    test_ecmult_multi_batching();
+}
+
 void test_ecmult_constants(void) {
     /* Test ecmult_gen() for [0..36) and [order-36..0). */
     secp256k1_scalar x;
@@ -2681,14 +3096,21 @@ void run_ecmult_gen_blind(void) {
 
 #ifdef USE_ENDOMORPHISM
 /***** ENDOMORPHISH TESTS *****/
-void test_scalar_split(void) {
-    secp256k1_scalar full;
-    secp256k1_scalar s1, slam;
+void test_scalar_split(const secp256k1_scalar *full) {
+    static const secp256k1_scalar lambda = SECP256K1_SCALAR_CONST(
+        0x5363AD4CUL, 0xC05C30E0UL, 0xA5261C02UL, 0x8812645AUL,
+        0x122E22EAUL, 0x20816678UL, 0xDF02967CUL, 0x1B23BD72UL
+    );
+    secp256k1_scalar s1, slam, t;
     const unsigned char zero[32] = {0};
     unsigned char tmp[32];
 
-    random_scalar_order_test(&full);
-    secp256k1_scalar_split_lambda(&s1, &slam, &full);
+    secp256k1_scalar_split_lambda(&s1, &slam, full);
+
+    /* check that s1 + slam*lambda gives back the input */
+    secp256k1_scalar_mul(&t, &slam, &lambda);
+    secp256k1_scalar_add(&t, &t, &s1);
+    CHECK(secp256k1_scalar_eq(&t, full));
 
     /* check that both are <= 128 bits in size */
     if (secp256k1_scalar_is_high(&s1)) {
@@ -2705,7 +3127,31 @@ void test_scalar_split(void) {
 }
 
 void run_endomorphism_tests(void) {
-    test_scalar_split();
+    /* the rounding in split_lambda is closest to its bounds near the ends of the range and around lambda */
+    static const secp256k1_scalar edges[] = {
+        SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 0),
+        SECP256K1_SCALAR_CONST(0, 0, 0, 0, 0, 0, 0, 1),
+        SECP256K1_SCALAR_CONST(0, 0, 0, 1, 0, 0, 0, 0),
+        SECP256K1_SCALAR_CONST(0x7FFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL,
+                               0x5D576E73UL, 0x57A4501DUL, 0xDFE92F46UL, 0x681B20A0UL),
+        SECP256K1_SCALAR_CONST(0x80000000UL, 0, 0, 0, 0, 0, 0, 0),
+        SECP256K1_SCALAR_CONST(0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFFUL, 0xFFFFFFFEUL,
+                               0xBAAEDCE6UL, 0xAF48A03BUL, 0xBFD25E8CUL, 0xD0364140UL),
+        SECP256K1_SCALAR_CONST(0x5363AD4CUL, 0xC05C30E0UL, 0xA5261C02UL, 0x8812645AUL,
+                               0x122E22EAUL, 0x20816678UL, 0xDF02967CUL, 0x1B23BD72UL),
+        SECP256K1_SCALAR_CONST(0xAC9C52B3UL, 0x3FA3CF1FUL, 0x5AD9E3FDUL, 0x77ED9BA4UL,
+                               0xA880B9FCUL, 0x8EC739C2UL, 0xE0CFC810UL, 0xB51283CFUL)
+    };
+    int i;
+
+    for (i = 0; i < (int)(sizeof(edges) / sizeof(edges[0])); i++) {
+        test_scalar_split(&edges[i]);
+    }
+    for (i = 0; i < 16 * count; i++) {
+        secp256k1_scalar full;
+        random_scalar_order_test(&full);
+        test_scalar_split(&full);
+    }
 }
 #endif
 
@@ -3641,6 +4087,57 @@ void run_ecdsa_end_to_end(void) {
     }
 }
 
+void test_ecdsa_verify_batch(void) {
+    /* More than ECDSA_VERIFY_BATCH_CHUNK, so that some batches span two chunks. */
+    secp256k1_ecdsa_signature sigs[80];
+    secp256k1_pubkey pubkeys[80];
+    unsigned char msgs[80 * 32];
+    unsigned char key[32];
+    secp256k1_scalar r, s, k;
+    size_t n = secp256k1_rand_int(80) + 1;
+    size_t i, bad, high, failed;
+
+    for (i = 0; i < n; i++) {
+        random_scalar_order_test(&k);
+        secp256k1_scalar_get_b32(key, &k);
+        secp256k1_rand256_test(&msgs[32 * i]);
+        CHECK(secp256k1_ec_pubkey_create(ctx, &pubkeys[i], key) == 1);
+        CHECK(secp256k1_ecdsa_sign(ctx, &sigs[i], &msgs[32 * i], key, NULL, NULL) == 1);
+    }
+
+    failed = n;
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, &failed, sigs, msgs, pubkeys, n) == 1);
+    CHECK(failed == n);
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, NULL, NULL, NULL, NULL, 0) == 1);
+
+    /* A wrong message is reported at its index and agrees with single verification. */
+    bad = secp256k1_rand_int(n);
+    msgs[32 * bad + secp256k1_rand_int(32)] ^= 1 << secp256k1_rand_int(8);
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, &failed, sigs, msgs, pubkeys, n) == 0);
+    CHECK(failed == bad);
+    for (i = 0; i < n; i++) {
+        CHECK(secp256k1_ecdsa_verify(ctx, &sigs[i], &msgs[32 * i], &pubkeys[i]) == (i != bad));
+    }
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, NULL, sigs, msgs, pubkeys, bad) == 1);
+
+    /* A high-S signature is rejected too, and the lower of two failing indices is the one reported. */
+    high = secp256k1_rand_int(n);
+    secp256k1_ecdsa_signature_load(ctx, &r, &s, &sigs[high]);
+    secp256k1_scalar_negate(&s, &s);
+    secp256k1_ecdsa_signature_save(&sigs[high], &r, &s);
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, &failed, sigs, msgs, pubkeys, n) == 0);
+    CHECK(failed == (high < bad ? high : bad));
+    CHECK(secp256k1_ecdsa_verify_batch(ctx, &failed, &sigs[high], &msgs[32 * high], &pubkeys[high], n - high) == 0);
+    CHECK(failed == 0);
+}
+
+void run_ecdsa_verify_batch(void) {
+    int i;
+    for (i = 0; i < count; i++) {
+        test_ecdsa_verify_batch();
+    }
+}
+
 int test_ecdsa_der_parse(const unsigned char *sig, size_t siglen, int certainly_der, int certainly_not_der) {
     static const unsigned char zeroes[32] = {0};
 #ifdef ENABLE_OPENSSL_TESTS
@@ -4471,6 +4968,7 @@ int main(int argc, char **argv) {
 
     /* scalar tests */
     run_scalar_tests();
+    run_scalar_inverse_all_var();
 
     /* field tests */
     run_field_inv();
@@ -4492,6 +4990,7 @@ int main(int argc, char **argv) {
     run_ecmult_constants();
     run_ecmult_gen_blind();
     run_ecmult_const_tests();
+    run_ecmult_multi_tests();
     run_ec_combine();
 
     /* endomorphism tests */
@@ -4515,6 +5014,7 @@ int main(int argc, char **argv) {
     run_ecdsa_der_parse();
     run_ecdsa_sign_verify();
     run_ecdsa_end_to_end();
+    run_ecdsa_verify_batch();
     run_ecdsa_edge_cases();
 #ifdef ENABLE_OPENSSL_TESTS
     run_ecdsa_openssl();
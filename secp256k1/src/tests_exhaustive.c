@@ -98,6 +98,21 @@ void test_exhaustive_endomorphism(const secp256k1_ge *group, int order) {
         ge_equals_ge(&group[i * EXHAUSTIVE_TEST_LAMBDA % EXHAUSTIVE_TEST_ORDER], &res);
     }
 }
+
+void test_exhaustive_split_lambda(int order) {
+    int i;
+    for (i = 0; i < order; i++) {
+        secp256k1_scalar s, s1, slam, lambda, t;
+        secp256k1_scalar_set_int(&s, i);
+        secp256k1_scalar_set_int(&lambda, EXHAUSTIVE_TEST_LAMBDA);
+        secp256k1_scalar_split_lambda(&s1, &slam, &s);
+
+        /* s1 + slam*lambda must give back s */
+        secp256k1_scalar_mul(&t, &slam, &lambda);
+        secp256k1_scalar_add(&t, &t, &s1);
+        CHECK(secp256k1_scalar_eq(&t, &s));
+    }
+}
 #endif
 
 void test_exhaustive_addition(const secp256k1_ge *group, const secp256k1_gej *groupj, int order) {
@@ -182,6 +197,51 @@ void test_exhaustive_ecmult(const secp256k1_context *ctx, const secp256k1_ge *gr
     }
 }
 
+typedef struct {
+    secp256k1_scalar sc[2];
+    secp256k1_ge pt[2];
+} ecmult_multi_data;
+
+static int ecmult_multi_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *cbdata) {
+    ecmult_multi_data *data = (ecmult_multi_data*) cbdata;
+    *sc = data->sc[idx];
+    *pt = data->pt[idx];
+    return 1;
+}
+
+/* At two points ecmult_multi_var only ever picks Strauss, so Pippenger is also run directly. */
+void test_exhaustive_ecmult_multi(const secp256k1_context *ctx, const secp256k1_ge *group, int order) {
+    int i, j, k, x, y;
+    size_t strauss_size = secp256k1_strauss_scratch_size(2) + STRAUSS_SCRATCH_OBJECTS*ALIGNMENT;
+    size_t pippenger_size = secp256k1_pippenger_scratch_size(2, secp256k1_pippenger_bucket_window(2)) + PIPPENGER_SCRATCH_OBJECTS*ALIGNMENT;
+    secp256k1_scratch *scratch = secp256k1_scratch_create(&ctx->error_callback, strauss_size > pippenger_size ? strauss_size : pippenger_size);
+    for (i = 0; i < order; i++) {
+        for (j = 0; j < order; j++) {
+            for (k = 0; k < order; k++) {
+                for (x = 0; x < order; x++) {
+                    for (y = 0; y < order; y++) {
+                        secp256k1_gej tmp;
+                        secp256k1_scalar g_sc;
+                        ecmult_multi_data data;
+
+                        secp256k1_scalar_set_int(&data.sc[0], i);
+                        secp256k1_scalar_set_int(&data.sc[1], j);
+                        secp256k1_scalar_set_int(&g_sc, k);
+                        data.pt[0] = group[x];
+                        data.pt[1] = group[y];
+
+                        CHECK(secp256k1_ecmult_multi_var(&ctx->ecmult_ctx, scratch, &tmp, &g_sc, ecmult_multi_callback, &data, 2));
+                        ge_equals_gej(&group[(i * x + j * y + k) % order], &tmp);
+                        CHECK(secp256k1_ecmult_pippenger_batch(&ctx->ecmult_ctx, scratch, &tmp, &g_sc, ecmult_multi_callback, &data, 2, 0));
+                        ge_equals_gej(&group[(i * x + j * y + k) % order], &tmp);
+                    }
+                }
+            }
+        }
+    }
+    secp256k1_scratch_destroy(scratch);
+}
+
 void r_from_k(secp256k1_scalar *r, const secp256k1_ge *group, int k) {
     secp256k1_fe x;
     unsigned char x_bin[32];
@@ -453,9 +513,11 @@ int main(void) {
     /* Run the tests */
 #ifdef USE_ENDOMORPHISM
     test_exhaustive_endomorphism(group, EXHAUSTIVE_TEST_ORDER);
+    test_exhaustive_split_lambda(EXHAUSTIVE_TEST_ORDER);
 #endif
     test_exhaustive_addition(group, groupj, EXHAUSTIVE_TEST_ORDER);
     test_exhaustive_ecmult(ctx, group, groupj, EXHAUSTIVE_TEST_ORDER);
+    test_exhaustive_ecmult_multi(ctx, group, EXHAUSTIVE_TEST_ORDER);
     test_exhaustive_sign(ctx, group, EXHAUSTIVE_TEST_ORDER);
     test_exhaustive_verify(ctx, group, EXHAUSTIVE_TEST_ORDER);
 